@@ -0,0 +1,82 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+#include <memory>
+#include <vector>
+#include <dsn/utility/string_view.h>
+
+namespace pegasus {
+
+/// An arena for the short-lived memory of one write batch, e.g. the rocksdb keys.
+///
+/// The memory is allocated sequentially from blocks, and is released all at once by reset(),
+/// which keeps the blocks for reuse. So no heap allocation happens once the blocks are enough
+/// for a batch, except for the allocations larger than a block.
+/// Not thread-safe.
+class pegasus_arena
+{
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 4096;
+
+    explicit pegasus_arena(size_t block_size = DEFAULT_BLOCK_SIZE)
+        : _block_size(block_size), _current(0), _used(0)
+    {
+    }
+
+    /// \return memory of `len` bytes, which is valid until reset().
+    char *allocate(size_t len)
+    {
+        if (len > _block_size / 4) {
+            // not to waste the rest of the current block
+            _large_blocks.emplace_back(new char[len]);
+            return _large_blocks.back().get();
+        }
+        if (_current < _blocks.size() && _used + len > _block_size) {
+            _current++;
+            _used = 0;
+        }
+        if (_current == _blocks.size()) {
+            _blocks.emplace_back(new char[_block_size]);
+        }
+        char *p = _blocks[_current].get() + _used;
+        _used += len;
+        return p;
+    }
+
+    /// \return a copy of `data` in the arena.
+    dsn::string_view copy(dsn::string_view data)
+    {
+        if (data.length() == 0) {
+            return dsn::string_view();
+        }
+        char *p = allocate(data.length());
+        ::memcpy(p, data.data(), data.length());
+        return dsn::string_view(p, data.length());
+    }
+
+    /// Releases all the memory allocated, the blocks are kept for reuse.
+    void reset()
+    {
+        _current = 0;
+        _used = 0;
+        _large_blocks.clear();
+    }
+
+    /// \return the count of the blocks kept, not including the large ones.
+    size_t block_count() const { return _blocks.size(); }
+
+private:
+    const size_t _block_size;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    std::vector<std::unique_ptr<char[]>> _large_blocks;
+    // the block being allocated from, and the bytes used in it
+    size_t _current;
+    size_t _used;
+};
+
+} // namespace pegasus
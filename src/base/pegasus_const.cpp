@@ -16,6 +16,27 @@ const std::string ROCKSDB_ENV_USAGE_SCENARIO_NORMAL("normal");
 const std::string ROCKSDB_ENV_USAGE_SCENARIO_PREFER_WRITE("prefer_write");
 const std::string ROCKSDB_ENV_USAGE_SCENARIO_BULK_LOAD("bulk_load");
 
+/// The storage profile of a table can be set by app environment variables as follows, see more
+/// in pegasus_storage_profile:
+/// ```
+/// rocksdb.compression=snappy                      // or per level: none,none,lz4,lz4,lz4,zstd
+/// rocksdb.bottommost_compression=zstd             // or default
+/// rocksdb.bloom_bits_per_key=10                   // 0 means no bloom filter
+/// rocksdb.block_size=4096
+/// rocksdb.cache_index_and_filter_blocks=true
+/// rocksdb.cache_priority=high                     // high, normal or low
+/// ```
+const std::string ROCKSDB_ENV_COMPRESSION_KEY("rocksdb.compression");
+const std::string ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY("rocksdb.bottommost_compression");
+const std::string ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY("rocksdb.bloom_bits_per_key");
+const std::string ROCKSDB_ENV_BLOCK_SIZE_KEY("rocksdb.block_size");
+const std::string ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY(
+    "rocksdb.cache_index_and_filter_blocks");
+const std::string ROCKSDB_ENV_CACHE_PRIORITY_KEY("rocksdb.cache_priority");
+// only reported by query_app_envs, the storage profile requested by the app envs which takes
+// effect when the app is opened next time
+const std::string ROCKSDB_ENV_PENDING_STORAGE_PROFILE_KEY("rocksdb.pending_storage_profile");
+
 /// A task of manual compaction can be triggered by update of app environment variables as follows:
 /// Periodic manual compaction: triggered every day at the given `trigger_time`.
 /// ```
@@ -21,6 +21,14 @@ extern const std::string ROCKSDB_ENV_USAGE_SCENARIO_NORMAL;
 extern const std::string ROCKSDB_ENV_USAGE_SCENARIO_PREFER_WRITE;
 extern const std::string ROCKSDB_ENV_USAGE_SCENARIO_BULK_LOAD;
 
+extern const std::string ROCKSDB_ENV_COMPRESSION_KEY;
+extern const std::string ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY;
+extern const std::string ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY;
+extern const std::string ROCKSDB_ENV_BLOCK_SIZE_KEY;
+extern const std::string ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY;
+extern const std::string ROCKSDB_ENV_CACHE_PRIORITY_KEY;
+extern const std::string ROCKSDB_ENV_PENDING_STORAGE_PROFILE_KEY;
+
 extern const std::string MANUAL_COMPACT_PERIODIC_KEY_PREFIX;
 extern const std::string MANUAL_COMPACT_PERIODIC_TRIGGER_TIME_KEY;
 extern const std::string MANUAL_COMPACT_PERIODIC_DISABLED_KEY;
@@ -0,0 +1,198 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "pegasus_crc64.h"
+
+#include <string.h>
+#include <string>
+#include <dsn/utility/crc.h>
+#include <dsn/c/api_utilities.h>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#endif
+
+namespace pegasus {
+namespace utils {
+
+namespace {
+
+// the reflected polynomial used by dsn::utils::crc64_calc()
+const uint64_t crc64_poly = 0x9a6c9329ac4bc9b5ULL;
+
+struct crc64_tables
+{
+    // table[0] is the byte-at-a-time table, table[k][i] is the crc of byte i
+    // followed by k zero bytes.
+    uint64_t table[8][256];
+
+    // x^191 mod P and x^127 mod P in reflected bit order, to fold the high and low
+    // 64 bits of the 128-bit remainder forward by 128 bits.
+    uint64_t fold_k1;
+    uint64_t fold_k2;
+
+    crc64_tables()
+    {
+        for (int i = 0; i < 256; i++) {
+            uint64_t crc = i;
+            for (int j = 0; j < 8; j++) {
+                crc = (crc >> 1) ^ ((crc & 1) ? crc64_poly : 0);
+            }
+            table[0][i] = crc;
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int i = 0; i < 256; i++) {
+                table[k][i] = (table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xff];
+            }
+        }
+        fold_k1 = x_pow_mod(191);
+        fold_k2 = x_pow_mod(127);
+    }
+
+    // x^n mod P, bit 63 is the coefficient of x^0 in reflected bit order
+    static uint64_t x_pow_mod(int n)
+    {
+        uint64_t r = 1ULL << 63;
+        while (n-- > 0) {
+            r = (r >> 1) ^ ((r & 1) ? crc64_poly : 0);
+        }
+        return r;
+    }
+};
+
+const crc64_tables &tables()
+{
+    static const crc64_tables t;
+    return t;
+}
+
+// the functions below work on the raw crc register, without the initial and final inversion
+
+inline uint64_t crc64_update_bytewise(const uint8_t *data, size_t size, uint64_t crc)
+{
+    const auto &t = tables().table;
+    while (size-- > 0) {
+        crc = t[0][(uint8_t)crc ^ *data++] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+inline uint64_t crc64_update_slicing8(const uint8_t *data, size_t size, uint64_t crc)
+{
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    const auto &t = tables().table;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc ^= word;
+        crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^ t[5][(crc >> 16) & 0xff] ^
+              t[4][(crc >> 24) & 0xff] ^ t[3][(crc >> 32) & 0xff] ^ t[2][(crc >> 40) & 0xff] ^
+              t[1][(crc >> 48) & 0xff] ^ t[0][crc >> 56];
+    }
+#endif
+    return crc64_update_bytewise(data, size, crc);
+}
+
+#if defined(__x86_64__)
+// The message is folded 16 bytes a time into a 128-bit remainder R = H * x^64 + L, where
+// H is the first 8 bytes. As R * x^128 = H * x^192 + L * x^128 (mod P), and carry-less
+// multiplication of two reflected values yields the product multiplied by x, the next
+// remainder is clmul(H, x^191 mod P) ^ clmul(L, x^127 mod P) ^ next 16 bytes.
+// The final remainder has the same crc as the whole message, which is computed by table.
+__attribute__((target("pclmul,sse2"))) uint64_t
+crc64_update_clmul(const uint8_t *data, size_t size, uint64_t crc)
+{
+    if (size < 32) {
+        return crc64_update_slicing8(data, size, crc);
+    }
+
+    const auto &t = tables();
+    const __m128i k = _mm_set_epi64x(t.fold_k2, t.fold_k1);
+    __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    r = _mm_xor_si128(r, _mm_set_epi64x(0, crc));
+    data += 16;
+    size -= 16;
+    for (; size >= 16; size -= 16, data += 16) {
+        __m128i h = _mm_clmulepi64_si128(r, k, 0x00);
+        __m128i l = _mm_clmulepi64_si128(r, k, 0x11);
+        r = _mm_xor_si128(_mm_xor_si128(h, l),
+                          _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+    }
+
+    uint8_t remainder[16];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(remainder), r);
+    crc = crc64_update_slicing8(remainder, sizeof(remainder), 0);
+    return crc64_update_slicing8(data, size, crc);
+}
+#endif
+
+typedef uint64_t (*crc64_func)(const void *, size_t, uint64_t);
+
+uint64_t dsn_crc64_calc(const void *ptr, size_t size, uint64_t init_crc)
+{
+    return dsn::utils::crc64_calc(ptr, size, init_crc);
+}
+
+crc64_func choose_crc64_func()
+{
+    crc64_func func = crc64_clmul_supported() ? &crc64_calc_clmul : &crc64_calc_slicing8;
+
+    // never route keys differently from the clients built with dsn::utils::crc64_calc()
+    std::string data;
+    for (int i = 0; i < 256; i++) {
+        data.push_back(static_cast<char>(i * 131 + 7));
+    }
+    for (size_t len = 0; len <= data.size(); len++) {
+        for (uint64_t init_crc : {0ULL, 0x0123456789abcdefULL}) {
+            if (func(data.data(), len, init_crc) !=
+                dsn::utils::crc64_calc(data.data(), len, init_crc)) {
+                derror("crc64 mismatches with dsn::utils::crc64_calc, fall back to it");
+                return &dsn_crc64_calc;
+            }
+        }
+    }
+    return func;
+}
+
+} // anonymous namespace
+
+uint64_t crc64_calc(const void *ptr, size_t size, uint64_t init_crc)
+{
+    static const crc64_func func = choose_crc64_func();
+    return func(ptr, size, init_crc);
+}
+
+uint64_t crc64_calc_bytewise(const void *ptr, size_t size, uint64_t init_crc)
+{
+    return ~crc64_update_bytewise(static_cast<const uint8_t *>(ptr), size, ~init_crc);
+}
+
+uint64_t crc64_calc_slicing8(const void *ptr, size_t size, uint64_t init_crc)
+{
+    return ~crc64_update_slicing8(static_cast<const uint8_t *>(ptr), size, ~init_crc);
+}
+
+uint64_t crc64_calc_clmul(const void *ptr, size_t size, uint64_t init_crc)
+{
+#if defined(__x86_64__)
+    return ~crc64_update_clmul(static_cast<const uint8_t *>(ptr), size, ~init_crc);
+#else
+    return crc64_calc_slicing8(ptr, size, init_crc);
+#endif
+}
+
+bool crc64_clmul_supported()
+{
+#if defined(__x86_64__)
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_PCLMUL) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace utils
+} // namespace pegasus
@@ -0,0 +1,33 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace pegasus {
+namespace utils {
+
+// CRC64 which gives exactly the same results as dsn::utils::crc64_calc(), used to compute
+// the partition hash of keys. The fastest implementation supported by the cpu is chosen
+// at runtime, and it is verified against dsn::utils::crc64_calc() before being used.
+uint64_t crc64_calc(const void *ptr, size_t size, uint64_t init_crc);
+
+// The implementations below are exposed for test and benchmark.
+
+// Byte-at-a-time table lookup, the same algorithm as dsn::utils::crc64_calc().
+uint64_t crc64_calc_bytewise(const void *ptr, size_t size, uint64_t init_crc);
+
+// Slicing-by-8 table lookup, which processes 8 bytes per iteration.
+uint64_t crc64_calc_slicing8(const void *ptr, size_t size, uint64_t init_crc);
+
+// Folding by carry-less multiplication (PCLMULQDQ), which processes 16 bytes per
+// iteration. Must not be called unless crc64_clmul_supported() is true.
+uint64_t crc64_calc_clmul(const void *ptr, size_t size, uint64_t init_crc);
+
+bool crc64_clmul_supported();
+
+} // namespace utils
+} // namespace pegasus
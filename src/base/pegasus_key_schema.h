@@ -6,13 +6,19 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <algorithm>
+#include <string>
 #include <dsn/utility/ports.h>
 #include <dsn/utility/utils.h>
 #include <dsn/utility/blob.h>
 #include <dsn/utility/utils.h>
 #include <dsn/utility/crc.h>
+#include <dsn/utility/string_view.h>
 #include <dsn/c/api_utilities.h>
 
+#include "pegasus_arena.h"
+#include "pegasus_crc64.h"
+
 namespace pegasus {
 
 // =====================================================================================
@@ -42,6 +48,42 @@ void pegasus_generate_key(::dsn::blob &key, const T &hash_key, const T &sort_key
     key.assign(std::move(buf), 0, len);
 }
 
+// length of the rocksdb key of 'hash_key' and 'sort_key'.
+inline size_t pegasus_key_length(dsn::string_view hash_key, dsn::string_view sort_key)
+{
+    return 2 + hash_key.length() + sort_key.length();
+}
+
+// generate rocksdb key into 'buf' of at least pegasus_key_length() bytes, which may be
+// on the stack or in an arena, so that no heap allocation happens.
+// return the length of the key.
+inline size_t
+pegasus_generate_key(char *buf, dsn::string_view hash_key, dsn::string_view sort_key)
+{
+    dassert(hash_key.length() < UINT16_MAX, "hash key length must be less than UINT16_MAX");
+
+    // hash_key_len is in big endian
+    uint16_t hash_key_len = hash_key.length();
+    *((int16_t *)buf) = htobe16((int16_t)hash_key_len);
+
+    if (hash_key_len > 0) {
+        ::memcpy(buf + 2, hash_key.data(), hash_key_len);
+    }
+    if (sort_key.length() > 0) {
+        ::memcpy(buf + 2 + hash_key_len, sort_key.data(), sort_key.length());
+    }
+    return pegasus_key_length(hash_key, sort_key);
+}
+
+// generate rocksdb key in 'arena'.
+// the key is valid until the arena is reset.
+inline dsn::string_view
+pegasus_generate_key(pegasus_arena &arena, dsn::string_view hash_key, dsn::string_view sort_key)
+{
+    char *buf = arena.allocate(pegasus_key_length(hash_key, sort_key));
+    return dsn::string_view(buf, pegasus_generate_key(buf, hash_key, sort_key));
+}
+
 // generate the adjacent next rocksdb key according to hash key.
 // T may be std::string or ::dsn::blob.
 // data is copied into 'next'.
@@ -81,6 +123,76 @@ void pegasus_generate_next_blob(::dsn::blob &next, const T &hash_key, const T &s
     next = buf.range(0, p - (unsigned char *)(buf.data()) + 1);
 }
 
+// keys are ordered by [hash_key_len][hash_key], so the keys whose hash key starts with
+// 'prefix' are in one contiguous range for each hash key length.
+// return false if 'key' is in one of these ranges, otherwise return true and set 'seek_key'
+// to the smallest key after 'key' which is in these ranges, or clear 'seek_key' if no such
+// key exists.
+inline bool pegasus_hash_key_prefix_seek_key(const char *key,
+                                             size_t key_len,
+                                             const std::string &prefix,
+                                             std::string &seek_key)
+{
+    dassert(key_len >= 2, "key length must be no less than 2");
+
+    // hash_key_len is in big endian
+    uint32_t hash_key_len = be16toh(*(int16_t *)(key));
+    uint32_t next_len;
+    if (hash_key_len < prefix.length()) {
+        // the shortest hash key which can match
+        next_len = prefix.length();
+    } else {
+        int c = ::memcmp(key + 2, prefix.data(), prefix.length());
+        if (c == 0) {
+            return false;
+        }
+        // the prefix range of this length is ahead or already passed
+        next_len = c < 0 ? hash_key_len : hash_key_len + 1;
+    }
+
+    if (next_len >= UINT16_MAX) {
+        seek_key.clear();
+        return true;
+    }
+    uint16_t be_len = htobe16((uint16_t)next_len);
+    seek_key.assign((const char *)&be_len, 2);
+    seek_key.append(prefix);
+    return true;
+}
+
+// return false if the sort key of 'key' starts with 'prefix', otherwise return true and set
+// 'seek_key' to skip the following keys which can not match: it is [hash_key][prefix] if the
+// sort key is less than 'prefix', or the adjacent next key of the hash key if greater.
+inline bool pegasus_sort_key_prefix_seek_key(const char *key,
+                                             size_t key_len,
+                                             const std::string &prefix,
+                                             std::string &seek_key)
+{
+    dassert(key_len >= 2, "key length must be no less than 2");
+
+    // hash_key_len is in big endian
+    uint32_t hash_key_len = be16toh(*(int16_t *)(key));
+    dassert(key_len >= 2 + hash_key_len, "key length must be no less than (2 + hash_key_len)");
+    size_t sort_key_len = key_len - 2 - hash_key_len;
+    int c = ::memcmp(
+        key + 2 + hash_key_len, prefix.data(), std::min(sort_key_len, prefix.length()));
+    if (c == 0 && sort_key_len >= prefix.length()) {
+        return false;
+    }
+
+    seek_key.assign(key, 2 + hash_key_len);
+    if (c <= 0) {
+        seek_key.append(prefix);
+    } else {
+        size_t len = seek_key.length();
+        while (seek_key[len - 1] == (char)0xFF)
+            len--;
+        seek_key.resize(len);
+        seek_key[len - 1]++;
+    }
+    return true;
+}
+
 // restore hash_key and sort_key from rocksdb value.
 // no data copied.
 inline void
@@ -143,10 +255,10 @@ inline uint64_t pegasus_key_hash(const ::dsn::blob &key)
         // hash_key_len > 0, compute hash from hash_key
         dassert(key.length() >= 2 + hash_key_len,
                 "key length must be no less than (2 + hash_key_len)");
-        return dsn::utils::crc64_calc(key.buffer_ptr() + 2, hash_key_len, 0);
+        return utils::crc64_calc(key.buffer_ptr() + 2, hash_key_len, 0);
     } else {
         // hash_key_len == 0, compute hash from sort_key
-        return dsn::utils::crc64_calc(key.buffer_ptr() + 2, key.length() - 2, 0);
+        return utils::crc64_calc(key.buffer_ptr() + 2, key.length() - 2, 0);
     }
 }
 
@@ -17,4 +17,14 @@ using multi_remove_rpc =
 
 using remove_rpc = dsn::rpc_holder<dsn::blob, dsn::apps::update_response>;
 
+using del_range_rpc = dsn::rpc_holder<dsn::apps::del_range_request, dsn::apps::update_response>;
+
+using incr_rpc = dsn::rpc_holder<dsn::apps::incr_request, dsn::apps::incr_response>;
+
+using check_and_set_rpc =
+    dsn::rpc_holder<dsn::apps::check_and_set_request, dsn::apps::check_and_set_response>;
+
+using check_and_mutate_rpc =
+    dsn::rpc_holder<dsn::apps::check_and_mutate_request, dsn::apps::check_and_mutate_response>;
+
 } // namespace pegasus
@@ -0,0 +1,246 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <dsn/utility/ports.h>
+#include <dsn/utility/blob.h>
+#include <dsn/utility/string_view.h>
+#include <dsn/utility/utils.h>
+#include <dsn/c/api_utilities.h>
+
+#include <rrdb/rrdb_types.h>
+
+namespace pegasus {
+
+/// Aggregates the rows of a scan into ::dsn::apps::scan_aggregate, that is, the count and
+/// the sizes of the rows, the count of the hash keys and the sort keys in them, and the
+/// largest rows and hash keys.
+///
+/// It is used on the server to aggregate the rows iterated in one scan rpc, and on the client
+/// to merge the aggregates of all the rpcs of a scan. As the rows of the first and the last
+/// hash keys of an rpc may be continued in the adjacent rpcs, they are returned by the server
+/// in `edge_hash_keys`, and merged by the client with the ones of the adjacent rpcs.
+class pegasus_scan_aggregator
+{
+public:
+    /// \param top_count count of the largest rows and hash keys to keep.
+    /// \param keep_edges true on the server, to return the first and the last hash keys in
+    ///        `edge_hash_keys` instead of counting them.
+    pegasus_scan_aggregator(int32_t top_count, bool keep_edges)
+        : _top_count(std::max(top_count, 0)),
+          _keep_edges(keep_edges),
+          _has_first(false),
+          _has_run(false),
+          _run_sort_key_count(0),
+          _run_size(0)
+    {
+    }
+
+    /// Adds a row of the scan.
+    /// The rows must be added in the order of the scan, so that the rows of one hash key are
+    /// added consecutively.
+    /// \param key the raw rocksdb key, in the layout of pegasus_generate_key().
+    /// \param value_size size of the user data.
+    void add_row(dsn::string_view key, size_t value_size)
+    {
+        dassert(key.length() >= 2, "key length must be no less than 2");
+        uint16_t hash_key_len = be16toh(*(const uint16_t *)key.data());
+        dassert(key.length() >= 2 + hash_key_len,
+                "key length must be no less than (2 + hash_key_len)");
+        dsn::string_view hash_key(key.data() + 2, hash_key_len);
+        int64_t sort_key_size = key.length() - 2 - hash_key_len;
+        int64_t row_size = hash_key_len + sort_key_size + value_size;
+
+        _result.row_count++;
+        _result.hash_key_size_sum += hash_key_len;
+        _result.hash_key_size_max = std::max<int64_t>(_result.hash_key_size_max, hash_key_len);
+        _result.sort_key_size_sum += sort_key_size;
+        _result.sort_key_size_max = std::max(_result.sort_key_size_max, sort_key_size);
+        _result.value_size_sum += value_size;
+        _result.value_size_max = std::max<int64_t>(_result.value_size_max, value_size);
+        _result.row_size_max = std::max(_result.row_size_max, row_size);
+        if (accepted(_top_rows, row_size)) {
+            ::dsn::apps::scan_row_stat row;
+            row.hash_key = to_blob(hash_key);
+            row.sort_key = to_blob(dsn::string_view(key.data() + 2 + hash_key_len,
+                                                    static_cast<size_t>(sort_key_size)));
+            row.size = row_size;
+            push(_top_rows, std::move(row));
+        }
+        add_run(hash_key, 1, row_size);
+        _last_key.assign(key.data(), key.length());
+    }
+
+    /// Merges the aggregates of a scan rpc.
+    /// The rpcs must be merged in the order of the scan, as the rows are added.
+    void merge(const ::dsn::apps::scan_aggregate &part)
+    {
+        _result.row_count += part.row_count;
+        _result.hash_key_size_sum += part.hash_key_size_sum;
+        _result.hash_key_size_max = std::max(_result.hash_key_size_max, part.hash_key_size_max);
+        _result.sort_key_size_sum += part.sort_key_size_sum;
+        _result.sort_key_size_max = std::max(_result.sort_key_size_max, part.sort_key_size_max);
+        _result.value_size_sum += part.value_size_sum;
+        _result.value_size_max = std::max(_result.value_size_max, part.value_size_max);
+        _result.row_size_max = std::max(_result.row_size_max, part.row_size_max);
+        for (const auto &row : part.top_rows) {
+            if (accepted(_top_rows, row.size)) {
+                push(_top_rows, ::dsn::apps::scan_row_stat(row));
+            }
+        }
+
+        // the hash keys between the edges are complete
+        _result.hash_key_count += part.hash_key_count;
+        _result.sort_key_count_max =
+            std::max(_result.sort_key_count_max, part.sort_key_count_max);
+        for (const auto &stat : part.top_hash_keys) {
+            if (accepted(_top_hash_keys, stat.size)) {
+                push(_top_hash_keys, ::dsn::apps::scan_hash_key_stat(stat));
+            }
+        }
+        for (const auto &stat : part.edge_hash_keys) {
+            add_run(dsn::string_view(stat.hash_key.data(), stat.hash_key.length()),
+                    stat.sort_key_count,
+                    stat.size);
+        }
+        if (part.last_key.length() > 0) {
+            _last_key.assign(part.last_key.data(), part.last_key.length());
+        }
+    }
+
+    /// Moves the result out, with the largest rows and hash keys in descending order of size.
+    /// The aggregator should not be used after that.
+    void finish(::dsn::apps::scan_aggregate &result)
+    {
+        if (_keep_edges) {
+            if (_has_first) {
+                _result.edge_hash_keys.emplace_back(std::move(_first));
+            }
+            if (_has_run) {
+                _result.edge_hash_keys.emplace_back(run_stat());
+            }
+        } else {
+            close_run();
+        }
+        _result.top_rows = sorted(std::move(_top_rows));
+        _result.top_hash_keys = sorted(std::move(_top_hash_keys));
+        _result.last_key = to_blob(_last_key);
+        result = std::move(_result);
+    }
+
+    /// \return the count of the rows added or merged.
+    int64_t row_count() const { return _result.row_count; }
+
+private:
+    // add the rows of a hash key, which are merged into the current run if of the same hash key
+    void add_run(dsn::string_view hash_key, int64_t sort_key_count, int64_t size)
+    {
+        if (_has_run && dsn::string_view(_run_hash_key) == hash_key) {
+            _run_sort_key_count += sort_key_count;
+            _run_size += size;
+            return;
+        }
+        close_run();
+        _has_run = true;
+        _run_hash_key.assign(hash_key.data(), hash_key.length());
+        _run_sort_key_count = sort_key_count;
+        _run_size = size;
+    }
+
+    // the current run is complete if followed by another one
+    void close_run()
+    {
+        if (!_has_run) {
+            return;
+        }
+        _has_run = false;
+        if (_keep_edges && !_has_first) {
+            _has_first = true;
+            _first = run_stat();
+            return;
+        }
+        _result.hash_key_count++;
+        _result.sort_key_count_max = std::max(_result.sort_key_count_max, _run_sort_key_count);
+        if (accepted(_top_hash_keys, _run_size)) {
+            push(_top_hash_keys, run_stat());
+        }
+    }
+
+    ::dsn::apps::scan_hash_key_stat run_stat() const
+    {
+        ::dsn::apps::scan_hash_key_stat stat;
+        stat.hash_key = to_blob(_run_hash_key);
+        stat.sort_key_count = _run_sort_key_count;
+        stat.size = _run_size;
+        return stat;
+    }
+
+    // the top items are kept in a min-heap of size, so that the smallest one is replaced
+    template <typename T>
+    static bool greater_size(const T &a, const T &b)
+    {
+        return a.size > b.size;
+    }
+
+    template <typename T>
+    bool accepted(const std::vector<T> &heap, int64_t size) const
+    {
+        return heap.size() < _top_count || (_top_count > 0 && heap.front().size < size);
+    }
+
+    template <typename T>
+    void push(std::vector<T> &heap, T &&item)
+    {
+        if (heap.size() >= _top_count) {
+            std::pop_heap(heap.begin(), heap.end(), greater_size<T>);
+            heap.pop_back();
+        }
+        heap.emplace_back(std::move(item));
+        std::push_heap(heap.begin(), heap.end(), greater_size<T>);
+    }
+
+    template <typename T>
+    static std::vector<T> sorted(std::vector<T> &&heap)
+    {
+        std::sort_heap(heap.begin(), heap.end(), greater_size<T>);
+        return std::move(heap);
+    }
+
+    static ::dsn::blob to_blob(dsn::string_view data)
+    {
+        ::dsn::blob result;
+        if (data.length() > 0) {
+            std::shared_ptr<char> buf(::dsn::utils::make_shared_array<char>(data.length()));
+            ::memcpy(buf.get(), data.data(), data.length());
+            result.assign(std::move(buf), 0, static_cast<unsigned int>(data.length()));
+        }
+        return result;
+    }
+
+private:
+    const size_t _top_count;
+    const bool _keep_edges;
+    ::dsn::apps::scan_aggregate _result;
+    std::vector<::dsn::apps::scan_row_stat> _top_rows;
+    std::vector<::dsn::apps::scan_hash_key_stat> _top_hash_keys;
+    std::string _last_key;
+
+    // the first hash key, kept as an edge if _keep_edges
+    bool _has_first;
+    ::dsn::apps::scan_hash_key_stat _first;
+
+    // the current run of the rows of one hash key, which may be continued
+    bool _has_run;
+    std::string _run_hash_key;
+    int64_t _run_sort_key_count;
+    int64_t _run_size;
+};
+
+} // namespace pegasus
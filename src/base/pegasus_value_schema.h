@@ -6,6 +6,8 @@
 
 #include <stdint.h>
 #include <string.h>
+#include <algorithm>
+#include <cinttypes>
 #include <string>
 #include <vector>
 
@@ -15,13 +17,96 @@
 #include <dsn/utility/endians.h>
 #include <dsn/service_api_c.h>
 #include <rocksdb/slice.h>
+#include <rocksdb/status.h>
+#include <snappy.h>
 
 namespace pegasus {
 
-#define PEGASUS_VALUE_SCHEMA_MAX_VERSION 0
+#define PEGASUS_VALUE_SCHEMA_MAX_VERSION 2
+
+/// The compression types of user_data in the flags of value schema v1 and v2.
+enum class value_compression_type : uint8_t
+{
+    none = 0,
+    snappy = 1,
+};
+
+/// The lowest 3 bits of the flags are the compression type, and the other bits are reserved.
+static const uint8_t VALUE_FLAGS_COMPRESSION_MASK = 0x07;
+
+/// Set in the flags of value schema v2 if user_data is separated into a blob file, then the
+/// blob index of it is stored in place of user_data. A new version is used for this flag
+/// rather than a reserved bit of v1, because v1 readers ignore the reserved bits and would
+/// return the blob index as user_data.
+static const uint8_t VALUE_FLAGS_BLOB_INDEX = 0x08;
+
+/// The position of user_data separated into a blob file (key-value separation).
+///
+/// blob index = [file_number(uint64_t)] [offset(uint64_t)] [size(uint32_t)] [crc(uint32_t)]
+///              [user_data_length(uint32_t)]
+struct pegasus_blob_index
+{
+    static const size_t ENCODED_LENGTH = 28;
+
+    uint64_t file_number;
+    // the offset and the size of the data stored in the blob file, which is compressed if
+    // the compression type in the flags is not none
+    uint64_t offset;
+    uint32_t size;
+    // crc32 of the data stored
+    uint32_t crc;
+    // the length of user_data before compression
+    uint32_t user_data_length;
+};
+
+/// \return the name of the blob file in the rdb directory.
+inline std::string pegasus_blob_file_name(uint64_t file_number)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), "blob.%06" PRIu64, file_number);
+    return buf;
+}
+
+/// \return the length of the header before user_data in the value with given version.
+inline size_t pegasus_value_header_length(int version)
+{
+    return version == 0 ? sizeof(uint32_t) : sizeof(uint32_t) + sizeof(uint8_t);
+}
+
+/// Decompresses user_data of the value in schema v1 according to `flags`.
+/// \param decompressed: set to false if user_data is not compressed, then `user_data` is not set.
+/// \return Corruption if the compressed data can not be decompressed, as the value stored
+/// inline has no checksum of its own.
+inline rocksdb::Status pegasus_decompress_user_data(uint8_t flags,
+                                                    dsn::string_view data,
+                                                    ::dsn::blob &user_data,
+                                                    bool &decompressed)
+{
+    decompressed = false;
+    auto type = static_cast<value_compression_type>(flags & VALUE_FLAGS_COMPRESSION_MASK);
+    if (type == value_compression_type::none) {
+        return rocksdb::Status::OK();
+    }
+    if (type != value_compression_type::snappy) {
+        return rocksdb::Status::Corruption("unsupported value compression type",
+                                           std::to_string(static_cast<int>(type)));
+    }
+
+    size_t length = 0;
+    if (!snappy::GetUncompressedLength(data.data(), data.length(), &length)) {
+        return rocksdb::Status::Corruption("corrupted snappy compressed value");
+    }
+    std::shared_ptr<char> buf(::dsn::utils::make_shared_array<char>(std::max<size_t>(length, 1)));
+    if (!snappy::RawUncompress(data.data(), data.length(), buf.get())) {
+        return rocksdb::Status::Corruption("corrupted snappy compressed value");
+    }
+    user_data.assign(std::move(buf), 0, static_cast<unsigned int>(length));
+    decompressed = true;
+    return rocksdb::Status::OK();
+}
 
 /// Extracts expire_ts from rocksdb value with given version.
-/// The value schema must be in v0.
+/// The value schema must be in v0, v1 or v2.
 /// \return expire_ts in host endian
 inline uint32_t pegasus_extract_expire_ts(int version, dsn::string_view value)
 {
@@ -35,25 +120,147 @@ inline uint32_t pegasus_extract_expire_ts(int version, dsn::string_view value)
 
 /// Extracts user value from a raw rocksdb value.
 /// In order to avoid data copy, the ownership of `raw_value` will be transferred
-/// into `user_data`.
+/// into `user_data`, unless the user value is compressed.
 /// \param user_data: the result.
-inline void pegasus_extract_user_data(int version, std::string &&raw_value, ::dsn::blob &user_data)
+/// \return Corruption if the compressed user value is corrupted.
+inline rocksdb::Status
+pegasus_extract_user_data(int version, std::string &&raw_value, ::dsn::blob &user_data)
 {
     dassert(version <= PEGASUS_VALUE_SCHEMA_MAX_VERSION,
             "value schema version(%d) must be <= %d",
             version,
             PEGASUS_VALUE_SCHEMA_MAX_VERSION);
 
-    dsn::data_input input(raw_value);
-    input.skip(sizeof(uint32_t));
-
-    dsn::string_view view = input.read_str();
+    size_t header_length = pegasus_value_header_length(version);
+    dassert(raw_value.length() >= header_length,
+            "value length(%d) must be >= %d",
+            static_cast<int>(raw_value.length()),
+            static_cast<int>(header_length));
+    dassert(version < 2 || !(raw_value[sizeof(uint32_t)] & VALUE_FLAGS_BLOB_INDEX),
+            "the user data separated into the blob file must be read from the blob file");
+    dsn::string_view view(raw_value.data() + header_length, raw_value.length() - header_length);
+    if (version >= 1) {
+        bool decompressed = false;
+        rocksdb::Status s = pegasus_decompress_user_data(
+            static_cast<uint8_t>(raw_value[sizeof(uint32_t)]), view, user_data, decompressed);
+        if (!s.ok() || decompressed) {
+            return s;
+        }
+    }
 
     // tricky code to avoid memory copy
     auto ptr = const_cast<char *>(view.data());
     auto deleter = [s = new std::string(std::move(raw_value))](char *) { delete s; };
     std::shared_ptr<char> buf(ptr, deleter);
     user_data.assign(std::move(buf), 0, static_cast<unsigned int>(view.length()));
+    return rocksdb::Status::OK();
+}
+
+/// Extracts user value from a raw rocksdb value without any data copy.
+/// Different from the overload above, `user_data` does not own the memory, it
+/// refers to the memory of `raw_value` (e.g. a rocksdb::PinnableSlice), so the
+/// caller must keep `raw_value` alive until `user_data` is no longer used.
+/// The compressed user value is an exception, which is decompressed into the memory
+/// owned by `user_data`.
+/// \param user_data: the result.
+/// \return Corruption if the compressed user value is corrupted.
+inline rocksdb::Status
+pegasus_extract_user_data(int version, dsn::string_view raw_value, ::dsn::blob &user_data)
+{
+    dassert(version <= PEGASUS_VALUE_SCHEMA_MAX_VERSION,
+            "value schema version(%d) must be <= %d",
+            version,
+            PEGASUS_VALUE_SCHEMA_MAX_VERSION);
+
+    size_t header_length = pegasus_value_header_length(version);
+    dassert(raw_value.length() >= header_length,
+            "value length(%d) must be >= %d",
+            static_cast<int>(raw_value.length()),
+            static_cast<int>(header_length));
+    dassert(version < 2 || !(raw_value[sizeof(uint32_t)] & VALUE_FLAGS_BLOB_INDEX),
+            "the user data separated into the blob file must be read from the blob file");
+    dsn::string_view view(raw_value.data() + header_length, raw_value.length() - header_length);
+    if (version >= 1) {
+        bool decompressed = false;
+        rocksdb::Status s = pegasus_decompress_user_data(
+            static_cast<uint8_t>(raw_value[sizeof(uint32_t)]), view, user_data, decompressed);
+        if (!s.ok() || decompressed) {
+            return s;
+        }
+    }
+    user_data.assign(view.data(), 0, static_cast<unsigned int>(view.length()));
+    return rocksdb::Status::OK();
+}
+
+/// \return the flags of the raw value with given version, which is 0 in v0.
+inline uint8_t pegasus_extract_value_flags(int version, dsn::string_view raw_value)
+{
+    if (version == 0 || raw_value.length() < pegasus_value_header_length(version)) {
+        return 0;
+    }
+    return static_cast<uint8_t>(raw_value[sizeof(uint32_t)]);
+}
+
+/// \return true if user_data of the raw value is separated into a blob file, then only the
+/// blob index of it is stored in the raw value.
+inline bool pegasus_value_is_blob_index(int version, dsn::string_view raw_value)
+{
+    return version >= 2 &&
+           (pegasus_extract_value_flags(version, raw_value) & VALUE_FLAGS_BLOB_INDEX) != 0;
+}
+
+/// Extracts the blob index from the raw value, which must be checked by
+/// pegasus_value_is_blob_index() first.
+inline void
+pegasus_extract_blob_index(int version, dsn::string_view raw_value, pegasus_blob_index &index)
+{
+    size_t header_length = pegasus_value_header_length(version);
+    dassert(raw_value.length() == header_length + pegasus_blob_index::ENCODED_LENGTH,
+            "invalid length(%d) of the value with blob index",
+            static_cast<int>(raw_value.length()));
+
+    dsn::data_input input(raw_value);
+    input.skip(header_length);
+    index.file_number = input.read_u64();
+    index.offset = input.read_u64();
+    index.size = input.read_u32();
+    index.crc = input.read_u32();
+    index.user_data_length = input.read_u32();
+}
+
+/// Extracts the length of the user value in the raw value with given version, without
+/// decompressing it or reading it from the blob file.
+/// \param length: the result.
+/// \return Corruption if the compressed user value is corrupted.
+inline rocksdb::Status
+pegasus_extract_user_data_length(int version, dsn::string_view raw_value, size_t &length)
+{
+    if (pegasus_value_is_blob_index(version, raw_value)) {
+        pegasus_blob_index index;
+        pegasus_extract_blob_index(version, raw_value, index);
+        length = index.user_data_length;
+        return rocksdb::Status::OK();
+    }
+
+    size_t header_length = pegasus_value_header_length(version);
+    dassert(raw_value.length() >= header_length,
+            "value length(%d) must be >= %d",
+            static_cast<int>(raw_value.length()),
+            static_cast<int>(header_length));
+    length = raw_value.length() - header_length;
+    auto type = static_cast<value_compression_type>(
+        pegasus_extract_value_flags(version, raw_value) & VALUE_FLAGS_COMPRESSION_MASK);
+    if (type == value_compression_type::none) {
+        return rocksdb::Status::OK();
+    }
+    if (type != value_compression_type::snappy) {
+        return rocksdb::Status::Corruption("unsupported value compression type",
+                                           std::to_string(static_cast<int>(type)));
+    }
+    if (!snappy::GetUncompressedLength(raw_value.data() + header_length, length, &length)) {
+        return rocksdb::Status::Corruption("corrupted snappy compressed value");
+    }
+    return rocksdb::Status::OK();
 }
 
 /// \return true if expired
@@ -77,13 +284,22 @@ inline bool check_if_record_expired(uint32_t value_schema_version,
 class pegasus_value_generator
 {
 public:
+    pegasus_value_generator() : _compression_threshold(0) {}
+
+    /// The user data not smaller than `threshold` bytes are compressed in value schema v1 and
+    /// v2, if the compression saves at least 1/8 of the size. 0 means never compress.
+    void set_compression_threshold(size_t threshold) { _compression_threshold = threshold; }
+
     /// A higher level utility for generating value with given version.
-    /// The value schema must be in v0.
+    /// The value schema must be in v0, v1 or v2.
     rocksdb::SliceParts
     generate_value(int value_schema_version, dsn::string_view user_data, uint32_t expire_ts)
     {
         if (value_schema_version == 0) {
             return generate_value_v0(expire_ts, user_data);
+        } else if (value_schema_version == 1 || value_schema_version == 2) {
+            // v2 is the same as v1 unless the user data is separated into a blob file
+            return generate_value_v1(expire_ts, user_data);
         } else {
             dfatal("unsupported value schema version: %d", value_schema_version);
             __builtin_unreachable();
@@ -112,9 +328,85 @@ public:
         return rocksdb::SliceParts(&_write_slices[0], static_cast<int>(_write_slices.size()));
     }
 
+    /// The flags are added to mark the user data as compressed, so that the large values are
+    /// compressed in the memtable, the sst files of all levels and the replication of them.
+    ///
+    /// rocksdb value (ver 1) = [expire_ts(uint32_t)] [flags(uint8_t)] [user_data(bytes)]
+    /// \internal
+    rocksdb::SliceParts generate_value_v1(uint32_t expire_ts, dsn::string_view user_data)
+    {
+        value_compression_type type = compress_user_data(user_data);
+
+        _write_buf.resize(sizeof(uint32_t));
+        _write_slices.clear();
+
+        dsn::data_output(_write_buf).write_u32(expire_ts);
+        _write_buf.push_back(static_cast<char>(type));
+        _write_slices.emplace_back(_write_buf.data(), _write_buf.size());
+
+        if (user_data.length() > 0) {
+            _write_slices.emplace_back(user_data.data(), user_data.length());
+        }
+
+        return rocksdb::SliceParts(&_write_slices[0], static_cast<int>(_write_slices.size()));
+    }
+
+    /// The user data separated into a blob file is replaced by the blob index of it.
+    ///
+    /// rocksdb value (ver 2) = [expire_ts(uint32_t)] [flags(uint8_t)] [blob_index(28 bytes)]
+    ///
+    /// \param type: the compression type of the data stored in the blob file.
+    rocksdb::SliceParts generate_blob_index_value(uint32_t expire_ts,
+                                                  value_compression_type type,
+                                                  const pegasus_blob_index &index)
+    {
+        _write_buf.resize(sizeof(uint32_t));
+        _write_slices.clear();
+
+        dsn::data_output(_write_buf).write_u32(expire_ts);
+        uint8_t flags = static_cast<uint8_t>(type) | VALUE_FLAGS_BLOB_INDEX;
+        _write_buf.push_back(static_cast<char>(flags));
+        _write_slices.emplace_back(_write_buf.data(), _write_buf.size());
+
+        _blob_index_buf.resize(pegasus_blob_index::ENCODED_LENGTH);
+        dsn::data_output output(_blob_index_buf);
+        output.write_u64(index.file_number);
+        output.write_u64(index.offset);
+        output.write_u32(index.size);
+        output.write_u32(index.crc);
+        output.write_u32(index.user_data_length);
+        _write_slices.emplace_back(_blob_index_buf.data(), _blob_index_buf.size());
+
+        return rocksdb::SliceParts(&_write_slices[0], static_cast<int>(_write_slices.size()));
+    }
+
+    /// Compresses `user_data` if it is not smaller than the compression threshold, then
+    /// `user_data` refers to the compressed data, which is valid until the next call.
+    /// \return the compression type of `user_data`.
+    value_compression_type compress_user_data(dsn::string_view &user_data)
+    {
+        if (_compression_threshold == 0 || user_data.length() < _compression_threshold) {
+            return value_compression_type::none;
+        }
+        _compress_buf.resize(snappy::MaxCompressedLength(user_data.length()));
+        size_t compressed_length = 0;
+        snappy::RawCompress(
+            user_data.data(), user_data.length(), &_compress_buf[0], &compressed_length);
+        if (compressed_length > user_data.length() - user_data.length() / 8) {
+            return value_compression_type::none;
+        }
+        user_data = dsn::string_view(_compress_buf.data(), compressed_length);
+        return value_compression_type::snappy;
+    }
+
 private:
     std::string _write_buf;
     std::vector<rocksdb::Slice> _write_slices;
+
+    size_t _compression_threshold;
+    // the compressed user data of the last value generated
+    std::string _compress_buf;
+    std::string _blob_index_buf;
 };
 
 } // namespace pegasus
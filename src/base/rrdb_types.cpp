@@ -24,6 +24,41 @@ const std::map<int, const char *> _filter_type_VALUES_TO_NAMES(
     ::apache::thrift::TEnumIterator(4, _kfilter_typeValues, _kfilter_typeNames),
     ::apache::thrift::TEnumIterator(-1, NULL, NULL));
 
+int _kcas_check_typeValues[] = {cas_check_type::CT_NO_CHECK,
+                                cas_check_type::CT_VALUE_NOT_EXIST,
+                                cas_check_type::CT_VALUE_NOT_EXIST_OR_EMPTY,
+                                cas_check_type::CT_VALUE_EXIST,
+                                cas_check_type::CT_VALUE_NOT_EMPTY,
+                                cas_check_type::CT_VALUE_MATCH_ANYWHERE,
+                                cas_check_type::CT_VALUE_MATCH_PREFIX,
+                                cas_check_type::CT_VALUE_MATCH_POSTFIX,
+                                cas_check_type::CT_VALUE_BYTES_LESS,
+                                cas_check_type::CT_VALUE_BYTES_LESS_OR_EQUAL,
+                                cas_check_type::CT_VALUE_BYTES_EQUAL,
+                                cas_check_type::CT_VALUE_BYTES_GREATER_OR_EQUAL,
+                                cas_check_type::CT_VALUE_BYTES_GREATER,
+                                cas_check_type::CT_VALUE_INT_LESS,
+                                cas_check_type::CT_VALUE_INT_LESS_OR_EQUAL,
+                                cas_check_type::CT_VALUE_INT_EQUAL,
+                                cas_check_type::CT_VALUE_INT_GREATER_OR_EQUAL,
+                                cas_check_type::CT_VALUE_INT_GREATER};
+const char *_kcas_check_typeNames[] = {
+    "CT_NO_CHECK", "CT_VALUE_NOT_EXIST", "CT_VALUE_NOT_EXIST_OR_EMPTY", "CT_VALUE_EXIST",
+    "CT_VALUE_NOT_EMPTY", "CT_VALUE_MATCH_ANYWHERE", "CT_VALUE_MATCH_PREFIX",
+    "CT_VALUE_MATCH_POSTFIX", "CT_VALUE_BYTES_LESS", "CT_VALUE_BYTES_LESS_OR_EQUAL",
+    "CT_VALUE_BYTES_EQUAL", "CT_VALUE_BYTES_GREATER_OR_EQUAL", "CT_VALUE_BYTES_GREATER",
+    "CT_VALUE_INT_LESS", "CT_VALUE_INT_LESS_OR_EQUAL", "CT_VALUE_INT_EQUAL",
+    "CT_VALUE_INT_GREATER_OR_EQUAL", "CT_VALUE_INT_GREATER"};
+const std::map<int, const char *> _cas_check_type_VALUES_TO_NAMES(
+    ::apache::thrift::TEnumIterator(18, _kcas_check_typeValues, _kcas_check_typeNames),
+    ::apache::thrift::TEnumIterator(-1, NULL, NULL));
+
+int _kmutate_operationValues[] = {mutate_operation::MO_PUT, mutate_operation::MO_DELETE};
+const char *_kmutate_operationNames[] = {"MO_PUT", "MO_DELETE"};
+const std::map<int, const char *> _mutate_operation_VALUES_TO_NAMES(
+    ::apache::thrift::TEnumIterator(2, _kmutate_operationValues, _kmutate_operationNames),
+    ::apache::thrift::TEnumIterator(-1, NULL, NULL));
+
 update_request::~update_request() throw() {}
 
 void update_request::__set_key(const ::dsn::blob &val) { this->key = val; }
@@ -1883,6 +1918,11 @@ void multi_get_response::__set_partition_index(const int32_t val) { this->partit
 
 void multi_get_response::__set_server(const std::string &val) { this->server = val; }
 
+void multi_get_response::__set_resume_sortkey(const ::dsn::blob &val)
+{
+    this->resume_sortkey = val;
+}
+
 uint32_t multi_get_response::read(::apache::thrift::protocol::TProtocol *iprot)
 {
 
@@ -1953,6 +1993,14 @@ uint32_t multi_get_response::read(::apache::thrift::protocol::TProtocol *iprot)
                 xfer += iprot->skip(ftype);
             }
             break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->resume_sortkey.read(iprot);
+                this->__isset.resume_sortkey = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
         default:
             xfer += iprot->skip(ftype);
             break;
@@ -1999,6 +2047,10 @@ uint32_t multi_get_response::write(::apache::thrift::protocol::TProtocol *oprot)
     xfer += oprot->writeString(this->server);
     xfer += oprot->writeFieldEnd();
 
+    xfer += oprot->writeFieldBegin("resume_sortkey", ::apache::thrift::protocol::T_STRUCT, 7);
+    xfer += this->resume_sortkey.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
     xfer += oprot->writeFieldStop();
     xfer += oprot->writeStructEnd();
     return xfer;
@@ -2012,6 +2064,7 @@ void swap(multi_get_response &a, multi_get_response &b)
     swap(a.app_id, b.app_id);
     swap(a.partition_index, b.partition_index);
     swap(a.server, b.server);
+    swap(a.resume_sortkey, b.resume_sortkey);
     swap(a.__isset, b.__isset);
 }
 
@@ -2022,6 +2075,7 @@ multi_get_response::multi_get_response(const multi_get_response &other65)
     app_id = other65.app_id;
     partition_index = other65.partition_index;
     server = other65.server;
+    resume_sortkey = other65.resume_sortkey;
     __isset = other65.__isset;
 }
 multi_get_response::multi_get_response(multi_get_response &&other66)
@@ -2031,6 +2085,7 @@ multi_get_response::multi_get_response(multi_get_response &&other66)
     app_id = std::move(other66.app_id);
     partition_index = std::move(other66.partition_index);
     server = std::move(other66.server);
+    resume_sortkey = std::move(other66.resume_sortkey);
     __isset = std::move(other66.__isset);
 }
 multi_get_response &multi_get_response::operator=(const multi_get_response &other67)
@@ -2040,6 +2095,7 @@ multi_get_response &multi_get_response::operator=(const multi_get_response &othe
     app_id = other67.app_id;
     partition_index = other67.partition_index;
     server = other67.server;
+    resume_sortkey = other67.resume_sortkey;
     __isset = other67.__isset;
     return *this;
 }
@@ -2050,6 +2106,7 @@ multi_get_response &multi_get_response::operator=(multi_get_response &&other68)
     app_id = std::move(other68.app_id);
     partition_index = std::move(other68.partition_index);
     server = std::move(other68.server);
+    resume_sortkey = std::move(other68.resume_sortkey);
     __isset = std::move(other68.__isset);
     return *this;
 }
@@ -2066,16 +2123,18 @@ void multi_get_response::printTo(std::ostream &out) const
         << "partition_index=" << to_string(partition_index);
     out << ", "
         << "server=" << to_string(server);
+    out << ", "
+        << "resume_sortkey=" << to_string(resume_sortkey);
     out << ")";
 }
 
-incr_request::~incr_request() throw() {}
+full_key::~full_key() throw() {}
 
-void incr_request::__set_key(const ::dsn::blob &val) { this->key = val; }
+void full_key::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
 
-void incr_request::__set_increment(const int64_t val) { this->increment = val; }
+void full_key::__set_sort_key(const ::dsn::blob &val) { this->sort_key = val; }
 
-uint32_t incr_request::read(::apache::thrift::protocol::TProtocol *iprot)
+uint32_t full_key::read(::apache::thrift::protocol::TProtocol *iprot)
 {
 
     apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
@@ -2096,16 +2155,16 @@ uint32_t incr_request::read(::apache::thrift::protocol::TProtocol *iprot)
         switch (fid) {
         case 1:
             if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-                xfer += this->key.read(iprot);
-                this->__isset.key = true;
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
             break;
         case 2:
-            if (ftype == ::apache::thrift::protocol::T_I64) {
-                xfer += iprot->readI64(this->increment);
-                this->__isset.increment = true;
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->sort_key.read(iprot);
+                this->__isset.sort_key = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
@@ -2122,18 +2181,18 @@ uint32_t incr_request::read(::apache::thrift::protocol::TProtocol *iprot)
     return xfer;
 }
 
-uint32_t incr_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+uint32_t full_key::write(::apache::thrift::protocol::TProtocol *oprot) const
 {
     uint32_t xfer = 0;
     apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-    xfer += oprot->writeStructBegin("incr_request");
+    xfer += oprot->writeStructBegin("full_key");
 
-    xfer += oprot->writeFieldBegin("key", ::apache::thrift::protocol::T_STRUCT, 1);
-    xfer += this->key.write(oprot);
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
     xfer += oprot->writeFieldEnd();
 
-    xfer += oprot->writeFieldBegin("increment", ::apache::thrift::protocol::T_I64, 2);
-    xfer += oprot->writeI64(this->increment);
+    xfer += oprot->writeFieldBegin("sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->sort_key.write(oprot);
     xfer += oprot->writeFieldEnd();
 
     xfer += oprot->writeFieldStop();
@@ -2141,85 +2200,173 @@ uint32_t incr_request::write(::apache::thrift::protocol::TProtocol *oprot) const
     return xfer;
 }
 
-void swap(incr_request &a, incr_request &b)
+void swap(full_key &a, full_key &b)
 {
     using ::std::swap;
-    swap(a.key, b.key);
-    swap(a.increment, b.increment);
+    swap(a.hash_key, b.hash_key);
+    swap(a.sort_key, b.sort_key);
     swap(a.__isset, b.__isset);
 }
 
-incr_request::incr_request(const incr_request &other69)
+full_key::full_key(const full_key &other69)
 {
-    key = other69.key;
-    increment = other69.increment;
+    hash_key = other69.hash_key;
+    sort_key = other69.sort_key;
     __isset = other69.__isset;
 }
-incr_request::incr_request(incr_request &&other70)
+full_key::full_key(full_key &&other70)
 {
-    key = std::move(other70.key);
-    increment = std::move(other70.increment);
+    hash_key = std::move(other70.hash_key);
+    sort_key = std::move(other70.sort_key);
     __isset = std::move(other70.__isset);
 }
-incr_request &incr_request::operator=(const incr_request &other71)
+full_key &full_key::operator=(const full_key &other71)
 {
-    key = other71.key;
-    increment = other71.increment;
+    hash_key = other71.hash_key;
+    sort_key = other71.sort_key;
     __isset = other71.__isset;
     return *this;
 }
-incr_request &incr_request::operator=(incr_request &&other72)
+full_key &full_key::operator=(full_key &&other72)
 {
-    key = std::move(other72.key);
-    increment = std::move(other72.increment);
+    hash_key = std::move(other72.hash_key);
+    sort_key = std::move(other72.sort_key);
     __isset = std::move(other72.__isset);
     return *this;
 }
-void incr_request::printTo(std::ostream &out) const
+void full_key::printTo(std::ostream &out) const
 {
     using ::apache::thrift::to_string;
-    out << "incr_request(";
-    out << "key=" << to_string(key);
+    out << "full_key(";
+    out << "hash_key=" << to_string(hash_key);
     out << ", "
-        << "increment=" << to_string(increment);
+        << "sort_key=" << to_string(sort_key);
     out << ")";
 }
 
-get_scanner_request::~get_scanner_request() throw() {}
+batch_get_request::~batch_get_request() throw() {}
 
-void get_scanner_request::__set_start_key(const ::dsn::blob &val) { this->start_key = val; }
+void batch_get_request::__set_keys(const std::vector<full_key> &val) { this->keys = val; }
 
-void get_scanner_request::__set_stop_key(const ::dsn::blob &val) { this->stop_key = val; }
+uint32_t batch_get_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
 
-void get_scanner_request::__set_start_inclusive(const bool val) { this->start_inclusive = val; }
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
 
-void get_scanner_request::__set_stop_inclusive(const bool val) { this->stop_inclusive = val; }
+    xfer += iprot->readStructBegin(fname);
 
-void get_scanner_request::__set_batch_size(const int32_t val) { this->batch_size = val; }
+    using ::apache::thrift::protocol::TProtocolException;
 
-void get_scanner_request::__set_no_value(const bool val) { this->no_value = val; }
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->keys.clear();
+                    uint32_t _size73;
+                    ::apache::thrift::protocol::TType _etype76;
+                    xfer += iprot->readListBegin(_etype76, _size73);
+                    this->keys.resize(_size73);
+                    uint32_t _i77;
+                    for (_i77 = 0; _i77 < _size73; ++_i77) {
+                        xfer += this->keys[_i77].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.keys = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
 
-void get_scanner_request::__set_hash_key_filter_type(const filter_type::type val)
-{
-    this->hash_key_filter_type = val;
+    xfer += iprot->readStructEnd();
+
+    return xfer;
 }
 
-void get_scanner_request::__set_hash_key_filter_pattern(const ::dsn::blob &val)
+uint32_t batch_get_request::write(::apache::thrift::protocol::TProtocol *oprot) const
 {
-    this->hash_key_filter_pattern = val;
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("batch_get_request");
+
+    xfer += oprot->writeFieldBegin("keys", ::apache::thrift::protocol::T_LIST, 1);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->keys.size()));
+        std::vector<full_key>::const_iterator _iter78;
+        for (_iter78 = this->keys.begin(); _iter78 != this->keys.end(); ++_iter78) {
+            xfer += (*_iter78).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
 }
 
-void get_scanner_request::__set_sort_key_filter_type(const filter_type::type val)
+void swap(batch_get_request &a, batch_get_request &b)
 {
-    this->sort_key_filter_type = val;
+    using ::std::swap;
+    swap(a.keys, b.keys);
+    swap(a.__isset, b.__isset);
 }
 
-void get_scanner_request::__set_sort_key_filter_pattern(const ::dsn::blob &val)
+batch_get_request::batch_get_request(const batch_get_request &other79)
 {
-    this->sort_key_filter_pattern = val;
+    keys = other79.keys;
+    __isset = other79.__isset;
+}
+batch_get_request::batch_get_request(batch_get_request &&other80)
+{
+    keys = std::move(other80.keys);
+    __isset = std::move(other80.__isset);
+}
+batch_get_request &batch_get_request::operator=(const batch_get_request &other81)
+{
+    keys = other81.keys;
+    __isset = other81.__isset;
+    return *this;
+}
+batch_get_request &batch_get_request::operator=(batch_get_request &&other82)
+{
+    keys = std::move(other82.keys);
+    __isset = std::move(other82.__isset);
+    return *this;
+}
+void batch_get_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "batch_get_request(";
+    out << "keys=" << to_string(keys);
+    out << ")";
 }
 
-uint32_t get_scanner_request::read(::apache::thrift::protocol::TProtocol *iprot)
+full_data::~full_data() throw() {}
+
+void full_data::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void full_data::__set_sort_key(const ::dsn::blob &val) { this->sort_key = val; }
+
+void full_data::__set_value(const ::dsn::blob &val) { this->value = val; }
+
+uint32_t full_data::read(::apache::thrift::protocol::TProtocol *iprot)
 {
 
     apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
@@ -2240,84 +2387,24 @@ uint32_t get_scanner_request::read(::apache::thrift::protocol::TProtocol *iprot)
         switch (fid) {
         case 1:
             if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-                xfer += this->start_key.read(iprot);
-                this->__isset.start_key = true;
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
             break;
         case 2:
             if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-                xfer += this->stop_key.read(iprot);
-                this->__isset.stop_key = true;
+                xfer += this->sort_key.read(iprot);
+                this->__isset.sort_key = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
             break;
         case 3:
-            if (ftype == ::apache::thrift::protocol::T_BOOL) {
-                xfer += iprot->readBool(this->start_inclusive);
-                this->__isset.start_inclusive = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 4:
-            if (ftype == ::apache::thrift::protocol::T_BOOL) {
-                xfer += iprot->readBool(this->stop_inclusive);
-                this->__isset.stop_inclusive = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 5:
-            if (ftype == ::apache::thrift::protocol::T_I32) {
-                xfer += iprot->readI32(this->batch_size);
-                this->__isset.batch_size = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 6:
-            if (ftype == ::apache::thrift::protocol::T_BOOL) {
-                xfer += iprot->readBool(this->no_value);
-                this->__isset.no_value = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 7:
-            if (ftype == ::apache::thrift::protocol::T_I32) {
-                int32_t ecast73;
-                xfer += iprot->readI32(ecast73);
-                this->hash_key_filter_type = (filter_type::type)ecast73;
-                this->__isset.hash_key_filter_type = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 8:
-            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-                xfer += this->hash_key_filter_pattern.read(iprot);
-                this->__isset.hash_key_filter_pattern = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 9:
-            if (ftype == ::apache::thrift::protocol::T_I32) {
-                int32_t ecast74;
-                xfer += iprot->readI32(ecast74);
-                this->sort_key_filter_type = (filter_type::type)ecast74;
-                this->__isset.sort_key_filter_type = true;
-            } else {
-                xfer += iprot->skip(ftype);
-            }
-            break;
-        case 10:
             if (ftype == ::apache::thrift::protocol::T_STRUCT) {
-                xfer += this->sort_key_filter_pattern.read(iprot);
-                this->__isset.sort_key_filter_pattern = true;
+                xfer += this->value.read(iprot);
+                this->__isset.value = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
@@ -2334,52 +2421,22 @@ uint32_t get_scanner_request::read(::apache::thrift::protocol::TProtocol *iprot)
     return xfer;
 }
 
-uint32_t get_scanner_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+uint32_t full_data::write(::apache::thrift::protocol::TProtocol *oprot) const
 {
     uint32_t xfer = 0;
     apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-    xfer += oprot->writeStructBegin("get_scanner_request");
-
-    xfer += oprot->writeFieldBegin("start_key", ::apache::thrift::protocol::T_STRUCT, 1);
-    xfer += this->start_key.write(oprot);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("stop_key", ::apache::thrift::protocol::T_STRUCT, 2);
-    xfer += this->stop_key.write(oprot);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("start_inclusive", ::apache::thrift::protocol::T_BOOL, 3);
-    xfer += oprot->writeBool(this->start_inclusive);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("stop_inclusive", ::apache::thrift::protocol::T_BOOL, 4);
-    xfer += oprot->writeBool(this->stop_inclusive);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("batch_size", ::apache::thrift::protocol::T_I32, 5);
-    xfer += oprot->writeI32(this->batch_size);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("no_value", ::apache::thrift::protocol::T_BOOL, 6);
-    xfer += oprot->writeBool(this->no_value);
-    xfer += oprot->writeFieldEnd();
-
-    xfer += oprot->writeFieldBegin("hash_key_filter_type", ::apache::thrift::protocol::T_I32, 7);
-    xfer += oprot->writeI32((int32_t)this->hash_key_filter_type);
-    xfer += oprot->writeFieldEnd();
+    xfer += oprot->writeStructBegin("full_data");
 
-    xfer +=
-        oprot->writeFieldBegin("hash_key_filter_pattern", ::apache::thrift::protocol::T_STRUCT, 8);
-    xfer += this->hash_key_filter_pattern.write(oprot);
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
     xfer += oprot->writeFieldEnd();
 
-    xfer += oprot->writeFieldBegin("sort_key_filter_type", ::apache::thrift::protocol::T_I32, 9);
-    xfer += oprot->writeI32((int32_t)this->sort_key_filter_type);
+    xfer += oprot->writeFieldBegin("sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->sort_key.write(oprot);
     xfer += oprot->writeFieldEnd();
 
-    xfer +=
-        oprot->writeFieldBegin("sort_key_filter_pattern", ::apache::thrift::protocol::T_STRUCT, 10);
-    xfer += this->sort_key_filter_pattern.write(oprot);
+    xfer += oprot->writeFieldBegin("value", ::apache::thrift::protocol::T_STRUCT, 3);
+    xfer += this->value.write(oprot);
     xfer += oprot->writeFieldEnd();
 
     xfer += oprot->writeFieldStop();
@@ -2387,84 +2444,2344 @@ uint32_t get_scanner_request::write(::apache::thrift::protocol::TProtocol *oprot
     return xfer;
 }
 
-void swap(get_scanner_request &a, get_scanner_request &b)
+void swap(full_data &a, full_data &b)
 {
     using ::std::swap;
-    swap(a.start_key, b.start_key);
-    swap(a.stop_key, b.stop_key);
-    swap(a.start_inclusive, b.start_inclusive);
-    swap(a.stop_inclusive, b.stop_inclusive);
-    swap(a.batch_size, b.batch_size);
-    swap(a.no_value, b.no_value);
-    swap(a.hash_key_filter_type, b.hash_key_filter_type);
-    swap(a.hash_key_filter_pattern, b.hash_key_filter_pattern);
-    swap(a.sort_key_filter_type, b.sort_key_filter_type);
-    swap(a.sort_key_filter_pattern, b.sort_key_filter_pattern);
+    swap(a.hash_key, b.hash_key);
+    swap(a.sort_key, b.sort_key);
+    swap(a.value, b.value);
     swap(a.__isset, b.__isset);
 }
 
-get_scanner_request::get_scanner_request(const get_scanner_request &other75)
-{
-    start_key = other75.start_key;
-    stop_key = other75.stop_key;
-    start_inclusive = other75.start_inclusive;
-    stop_inclusive = other75.stop_inclusive;
-    batch_size = other75.batch_size;
-    no_value = other75.no_value;
-    hash_key_filter_type = other75.hash_key_filter_type;
-    hash_key_filter_pattern = other75.hash_key_filter_pattern;
-    sort_key_filter_type = other75.sort_key_filter_type;
-    sort_key_filter_pattern = other75.sort_key_filter_pattern;
-    __isset = other75.__isset;
-}
-get_scanner_request::get_scanner_request(get_scanner_request &&other76)
-{
-    start_key = std::move(other76.start_key);
-    stop_key = std::move(other76.stop_key);
-    start_inclusive = std::move(other76.start_inclusive);
-    stop_inclusive = std::move(other76.stop_inclusive);
-    batch_size = std::move(other76.batch_size);
-    no_value = std::move(other76.no_value);
-    hash_key_filter_type = std::move(other76.hash_key_filter_type);
-    hash_key_filter_pattern = std::move(other76.hash_key_filter_pattern);
-    sort_key_filter_type = std::move(other76.sort_key_filter_type);
-    sort_key_filter_pattern = std::move(other76.sort_key_filter_pattern);
-    __isset = std::move(other76.__isset);
-}
-get_scanner_request &get_scanner_request::operator=(const get_scanner_request &other77)
-{
-    start_key = other77.start_key;
-    stop_key = other77.stop_key;
-    start_inclusive = other77.start_inclusive;
-    stop_inclusive = other77.stop_inclusive;
-    batch_size = other77.batch_size;
-    no_value = other77.no_value;
-    hash_key_filter_type = other77.hash_key_filter_type;
-    hash_key_filter_pattern = other77.hash_key_filter_pattern;
-    sort_key_filter_type = other77.sort_key_filter_type;
-    sort_key_filter_pattern = other77.sort_key_filter_pattern;
-    __isset = other77.__isset;
+full_data::full_data(const full_data &other83)
+{
+    hash_key = other83.hash_key;
+    sort_key = other83.sort_key;
+    value = other83.value;
+    __isset = other83.__isset;
+}
+full_data::full_data(full_data &&other84)
+{
+    hash_key = std::move(other84.hash_key);
+    sort_key = std::move(other84.sort_key);
+    value = std::move(other84.value);
+    __isset = std::move(other84.__isset);
+}
+full_data &full_data::operator=(const full_data &other85)
+{
+    hash_key = other85.hash_key;
+    sort_key = other85.sort_key;
+    value = other85.value;
+    __isset = other85.__isset;
     return *this;
 }
-get_scanner_request &get_scanner_request::operator=(get_scanner_request &&other78)
-{
-    start_key = std::move(other78.start_key);
-    stop_key = std::move(other78.stop_key);
-    start_inclusive = std::move(other78.start_inclusive);
-    stop_inclusive = std::move(other78.stop_inclusive);
-    batch_size = std::move(other78.batch_size);
-    no_value = std::move(other78.no_value);
-    hash_key_filter_type = std::move(other78.hash_key_filter_type);
-    hash_key_filter_pattern = std::move(other78.hash_key_filter_pattern);
-    sort_key_filter_type = std::move(other78.sort_key_filter_type);
-    sort_key_filter_pattern = std::move(other78.sort_key_filter_pattern);
-    __isset = std::move(other78.__isset);
+full_data &full_data::operator=(full_data &&other86)
+{
+    hash_key = std::move(other86.hash_key);
+    sort_key = std::move(other86.sort_key);
+    value = std::move(other86.value);
+    __isset = std::move(other86.__isset);
     return *this;
 }
-void get_scanner_request::printTo(std::ostream &out) const
+void full_data::printTo(std::ostream &out) const
 {
     using ::apache::thrift::to_string;
-    out << "get_scanner_request(";
+    out << "full_data(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "sort_key=" << to_string(sort_key);
+    out << ", "
+        << "value=" << to_string(value);
+    out << ")";
+}
+
+batch_get_response::~batch_get_response() throw() {}
+
+void batch_get_response::__set_error(const int32_t val) { this->error = val; }
+
+void batch_get_response::__set_data(const std::vector<full_data> &val) { this->data = val; }
+
+void batch_get_response::__set_app_id(const int32_t val) { this->app_id = val; }
+
+void batch_get_response::__set_partition_index(const int32_t val) { this->partition_index = val; }
+
+void batch_get_response::__set_server(const std::string &val) { this->server = val; }
+
+uint32_t batch_get_response::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->error);
+                this->__isset.error = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->data.clear();
+                    uint32_t _size87;
+                    ::apache::thrift::protocol::TType _etype90;
+                    xfer += iprot->readListBegin(_etype90, _size87);
+                    this->data.resize(_size87);
+                    uint32_t _i91;
+                    for (_i91 = 0; _i91 < _size87; ++_i91) {
+                        xfer += this->data[_i91].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.data = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->app_id);
+                this->__isset.app_id = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->partition_index);
+                this->__isset.partition_index = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_STRING) {
+                xfer += iprot->readString(this->server);
+                this->__isset.server = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t batch_get_response::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("batch_get_response");
+
+    xfer += oprot->writeFieldBegin("error", ::apache::thrift::protocol::T_I32, 1);
+    xfer += oprot->writeI32(this->error);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("data", ::apache::thrift::protocol::T_LIST, 2);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->data.size()));
+        std::vector<full_data>::const_iterator _iter92;
+        for (_iter92 = this->data.begin(); _iter92 != this->data.end(); ++_iter92) {
+            xfer += (*_iter92).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("app_id", ::apache::thrift::protocol::T_I32, 3);
+    xfer += oprot->writeI32(this->app_id);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("partition_index", ::apache::thrift::protocol::T_I32, 4);
+    xfer += oprot->writeI32(this->partition_index);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("server", ::apache::thrift::protocol::T_STRING, 5);
+    xfer += oprot->writeString(this->server);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(batch_get_response &a, batch_get_response &b)
+{
+    using ::std::swap;
+    swap(a.error, b.error);
+    swap(a.data, b.data);
+    swap(a.app_id, b.app_id);
+    swap(a.partition_index, b.partition_index);
+    swap(a.server, b.server);
+    swap(a.__isset, b.__isset);
+}
+
+batch_get_response::batch_get_response(const batch_get_response &other93)
+{
+    error = other93.error;
+    data = other93.data;
+    app_id = other93.app_id;
+    partition_index = other93.partition_index;
+    server = other93.server;
+    __isset = other93.__isset;
+}
+batch_get_response::batch_get_response(batch_get_response &&other94)
+{
+    error = std::move(other94.error);
+    data = std::move(other94.data);
+    app_id = std::move(other94.app_id);
+    partition_index = std::move(other94.partition_index);
+    server = std::move(other94.server);
+    __isset = std::move(other94.__isset);
+}
+batch_get_response &batch_get_response::operator=(const batch_get_response &other95)
+{
+    error = other95.error;
+    data = other95.data;
+    app_id = other95.app_id;
+    partition_index = other95.partition_index;
+    server = other95.server;
+    __isset = other95.__isset;
+    return *this;
+}
+batch_get_response &batch_get_response::operator=(batch_get_response &&other96)
+{
+    error = std::move(other96.error);
+    data = std::move(other96.data);
+    app_id = std::move(other96.app_id);
+    partition_index = std::move(other96.partition_index);
+    server = std::move(other96.server);
+    __isset = std::move(other96.__isset);
+    return *this;
+}
+void batch_get_response::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "batch_get_response(";
+    out << "error=" << to_string(error);
+    out << ", "
+        << "data=" << to_string(data);
+    out << ", "
+        << "app_id=" << to_string(app_id);
+    out << ", "
+        << "partition_index=" << to_string(partition_index);
+    out << ", "
+        << "server=" << to_string(server);
+    out << ")";
+}
+
+incr_request::~incr_request() throw() {}
+
+void incr_request::__set_key(const ::dsn::blob &val) { this->key = val; }
+
+void incr_request::__set_increment(const int64_t val) { this->increment = val; }
+
+uint32_t incr_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->key.read(iprot);
+                this->__isset.key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->increment);
+                this->__isset.increment = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t incr_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("incr_request");
+
+    xfer += oprot->writeFieldBegin("key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("increment", ::apache::thrift::protocol::T_I64, 2);
+    xfer += oprot->writeI64(this->increment);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(incr_request &a, incr_request &b)
+{
+    using ::std::swap;
+    swap(a.key, b.key);
+    swap(a.increment, b.increment);
+    swap(a.__isset, b.__isset);
+}
+
+incr_request::incr_request(const incr_request &other97)
+{
+    key = other97.key;
+    increment = other97.increment;
+    __isset = other97.__isset;
+}
+incr_request::incr_request(incr_request &&other98)
+{
+    key = std::move(other98.key);
+    increment = std::move(other98.increment);
+    __isset = std::move(other98.__isset);
+}
+incr_request &incr_request::operator=(const incr_request &other99)
+{
+    key = other99.key;
+    increment = other99.increment;
+    __isset = other99.__isset;
+    return *this;
+}
+incr_request &incr_request::operator=(incr_request &&other100)
+{
+    key = std::move(other100.key);
+    increment = std::move(other100.increment);
+    __isset = std::move(other100.__isset);
+    return *this;
+}
+void incr_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "incr_request(";
+    out << "key=" << to_string(key);
+    out << ", "
+        << "increment=" << to_string(increment);
+    out << ")";
+}
+
+incr_response::~incr_response() throw() {}
+
+void incr_response::__set_error(const int32_t val) { this->error = val; }
+
+void incr_response::__set_new_value(const int64_t val) { this->new_value = val; }
+
+void incr_response::__set_app_id(const int32_t val) { this->app_id = val; }
+
+void incr_response::__set_partition_index(const int32_t val) { this->partition_index = val; }
+
+void incr_response::__set_decree(const int64_t val) { this->decree = val; }
+
+void incr_response::__set_server(const std::string &val) { this->server = val; }
+
+uint32_t incr_response::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->error);
+                this->__isset.error = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->new_value);
+                this->__isset.new_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->app_id);
+                this->__isset.app_id = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->partition_index);
+                this->__isset.partition_index = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->decree);
+                this->__isset.decree = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_STRING) {
+                xfer += iprot->readString(this->server);
+                this->__isset.server = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t incr_response::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("incr_response");
+
+    xfer += oprot->writeFieldBegin("error", ::apache::thrift::protocol::T_I32, 1);
+    xfer += oprot->writeI32(this->error);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("new_value", ::apache::thrift::protocol::T_I64, 2);
+    xfer += oprot->writeI64(this->new_value);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("app_id", ::apache::thrift::protocol::T_I32, 3);
+    xfer += oprot->writeI32(this->app_id);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("partition_index", ::apache::thrift::protocol::T_I32, 4);
+    xfer += oprot->writeI32(this->partition_index);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("decree", ::apache::thrift::protocol::T_I64, 5);
+    xfer += oprot->writeI64(this->decree);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("server", ::apache::thrift::protocol::T_STRING, 6);
+    xfer += oprot->writeString(this->server);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(incr_response &a, incr_response &b)
+{
+    using ::std::swap;
+    swap(a.error, b.error);
+    swap(a.new_value, b.new_value);
+    swap(a.app_id, b.app_id);
+    swap(a.partition_index, b.partition_index);
+    swap(a.decree, b.decree);
+    swap(a.server, b.server);
+    swap(a.__isset, b.__isset);
+}
+
+incr_response::incr_response(const incr_response &other101)
+{
+    error = other101.error;
+    new_value = other101.new_value;
+    app_id = other101.app_id;
+    partition_index = other101.partition_index;
+    decree = other101.decree;
+    server = other101.server;
+    __isset = other101.__isset;
+}
+incr_response::incr_response(incr_response &&other102)
+{
+    error = std::move(other102.error);
+    new_value = std::move(other102.new_value);
+    app_id = std::move(other102.app_id);
+    partition_index = std::move(other102.partition_index);
+    decree = std::move(other102.decree);
+    server = std::move(other102.server);
+    __isset = std::move(other102.__isset);
+}
+incr_response &incr_response::operator=(const incr_response &other103)
+{
+    error = other103.error;
+    new_value = other103.new_value;
+    app_id = other103.app_id;
+    partition_index = other103.partition_index;
+    decree = other103.decree;
+    server = other103.server;
+    __isset = other103.__isset;
+    return *this;
+}
+incr_response &incr_response::operator=(incr_response &&other104)
+{
+    error = std::move(other104.error);
+    new_value = std::move(other104.new_value);
+    app_id = std::move(other104.app_id);
+    partition_index = std::move(other104.partition_index);
+    decree = std::move(other104.decree);
+    server = std::move(other104.server);
+    __isset = std::move(other104.__isset);
+    return *this;
+}
+void incr_response::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "incr_response(";
+    out << "error=" << to_string(error);
+    out << ", "
+        << "new_value=" << to_string(new_value);
+    out << ", "
+        << "app_id=" << to_string(app_id);
+    out << ", "
+        << "partition_index=" << to_string(partition_index);
+    out << ", "
+        << "decree=" << to_string(decree);
+    out << ", "
+        << "server=" << to_string(server);
+    out << ")";
+}
+
+check_and_set_request::~check_and_set_request() throw() {}
+
+void check_and_set_request::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void check_and_set_request::__set_check_sort_key(const ::dsn::blob &val)
+{
+    this->check_sort_key = val;
+}
+
+void check_and_set_request::__set_check_type(const cas_check_type::type val)
+{
+    this->check_type = val;
+}
+
+void check_and_set_request::__set_check_operand(const ::dsn::blob &val)
+{
+    this->check_operand = val;
+}
+
+void check_and_set_request::__set_set_diff_sort_key(const bool val)
+{
+    this->set_diff_sort_key = val;
+}
+
+void check_and_set_request::__set_set_sort_key(const ::dsn::blob &val) { this->set_sort_key = val; }
+
+void check_and_set_request::__set_set_value(const ::dsn::blob &val) { this->set_value = val; }
+
+void check_and_set_request::__set_set_expire_ts_seconds(const int32_t val)
+{
+    this->set_expire_ts_seconds = val;
+}
+
+void check_and_set_request::__set_return_check_value(const bool val)
+{
+    this->return_check_value = val;
+}
+
+uint32_t check_and_set_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_sort_key.read(iprot);
+                this->__isset.check_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                int32_t ecast105;
+                xfer += iprot->readI32(ecast105);
+                this->check_type = (cas_check_type::type)ecast105;
+                this->__isset.check_type = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_operand.read(iprot);
+                this->__isset.check_operand = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->set_diff_sort_key);
+                this->__isset.set_diff_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->set_sort_key.read(iprot);
+                this->__isset.set_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->set_value.read(iprot);
+                this->__isset.set_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 8:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->set_expire_ts_seconds);
+                this->__isset.set_expire_ts_seconds = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 9:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->return_check_value);
+                this->__isset.return_check_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t check_and_set_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("check_and_set_request");
+
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->check_sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_type", ::apache::thrift::protocol::T_I32, 3);
+    xfer += oprot->writeI32((int32_t)this->check_type);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_operand", ::apache::thrift::protocol::T_STRUCT, 4);
+    xfer += this->check_operand.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("set_diff_sort_key", ::apache::thrift::protocol::T_BOOL, 5);
+    xfer += oprot->writeBool(this->set_diff_sort_key);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("set_sort_key", ::apache::thrift::protocol::T_STRUCT, 6);
+    xfer += this->set_sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("set_value", ::apache::thrift::protocol::T_STRUCT, 7);
+    xfer += this->set_value.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("set_expire_ts_seconds", ::apache::thrift::protocol::T_I32, 8);
+    xfer += oprot->writeI32(this->set_expire_ts_seconds);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("return_check_value", ::apache::thrift::protocol::T_BOOL, 9);
+    xfer += oprot->writeBool(this->return_check_value);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(check_and_set_request &a, check_and_set_request &b)
+{
+    using ::std::swap;
+    swap(a.hash_key, b.hash_key);
+    swap(a.check_sort_key, b.check_sort_key);
+    swap(a.check_type, b.check_type);
+    swap(a.check_operand, b.check_operand);
+    swap(a.set_diff_sort_key, b.set_diff_sort_key);
+    swap(a.set_sort_key, b.set_sort_key);
+    swap(a.set_value, b.set_value);
+    swap(a.set_expire_ts_seconds, b.set_expire_ts_seconds);
+    swap(a.return_check_value, b.return_check_value);
+    swap(a.__isset, b.__isset);
+}
+
+check_and_set_request::check_and_set_request(const check_and_set_request &other106)
+{
+    hash_key = other106.hash_key;
+    check_sort_key = other106.check_sort_key;
+    check_type = other106.check_type;
+    check_operand = other106.check_operand;
+    set_diff_sort_key = other106.set_diff_sort_key;
+    set_sort_key = other106.set_sort_key;
+    set_value = other106.set_value;
+    set_expire_ts_seconds = other106.set_expire_ts_seconds;
+    return_check_value = other106.return_check_value;
+    __isset = other106.__isset;
+}
+check_and_set_request::check_and_set_request(check_and_set_request &&other107)
+{
+    hash_key = std::move(other107.hash_key);
+    check_sort_key = std::move(other107.check_sort_key);
+    check_type = std::move(other107.check_type);
+    check_operand = std::move(other107.check_operand);
+    set_diff_sort_key = std::move(other107.set_diff_sort_key);
+    set_sort_key = std::move(other107.set_sort_key);
+    set_value = std::move(other107.set_value);
+    set_expire_ts_seconds = std::move(other107.set_expire_ts_seconds);
+    return_check_value = std::move(other107.return_check_value);
+    __isset = std::move(other107.__isset);
+}
+check_and_set_request &check_and_set_request::operator=(const check_and_set_request &other108)
+{
+    hash_key = other108.hash_key;
+    check_sort_key = other108.check_sort_key;
+    check_type = other108.check_type;
+    check_operand = other108.check_operand;
+    set_diff_sort_key = other108.set_diff_sort_key;
+    set_sort_key = other108.set_sort_key;
+    set_value = other108.set_value;
+    set_expire_ts_seconds = other108.set_expire_ts_seconds;
+    return_check_value = other108.return_check_value;
+    __isset = other108.__isset;
+    return *this;
+}
+check_and_set_request &check_and_set_request::operator=(check_and_set_request &&other109)
+{
+    hash_key = std::move(other109.hash_key);
+    check_sort_key = std::move(other109.check_sort_key);
+    check_type = std::move(other109.check_type);
+    check_operand = std::move(other109.check_operand);
+    set_diff_sort_key = std::move(other109.set_diff_sort_key);
+    set_sort_key = std::move(other109.set_sort_key);
+    set_value = std::move(other109.set_value);
+    set_expire_ts_seconds = std::move(other109.set_expire_ts_seconds);
+    return_check_value = std::move(other109.return_check_value);
+    __isset = std::move(other109.__isset);
+    return *this;
+}
+void check_and_set_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "check_and_set_request(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "check_sort_key=" << to_string(check_sort_key);
+    out << ", "
+        << "check_type=" << to_string(check_type);
+    out << ", "
+        << "check_operand=" << to_string(check_operand);
+    out << ", "
+        << "set_diff_sort_key=" << to_string(set_diff_sort_key);
+    out << ", "
+        << "set_sort_key=" << to_string(set_sort_key);
+    out << ", "
+        << "set_value=" << to_string(set_value);
+    out << ", "
+        << "set_expire_ts_seconds=" << to_string(set_expire_ts_seconds);
+    out << ", "
+        << "return_check_value=" << to_string(return_check_value);
+    out << ")";
+}
+
+check_and_set_response::~check_and_set_response() throw() {}
+
+void check_and_set_response::__set_error(const int32_t val) { this->error = val; }
+
+void check_and_set_response::__set_check_value_returned(const bool val)
+{
+    this->check_value_returned = val;
+}
+
+void check_and_set_response::__set_check_value_exist(const bool val)
+{
+    this->check_value_exist = val;
+}
+
+void check_and_set_response::__set_check_value(const ::dsn::blob &val) { this->check_value = val; }
+
+void check_and_set_response::__set_app_id(const int32_t val) { this->app_id = val; }
+
+void check_and_set_response::__set_partition_index(const int32_t val)
+{
+    this->partition_index = val;
+}
+
+void check_and_set_response::__set_decree(const int64_t val) { this->decree = val; }
+
+void check_and_set_response::__set_server(const std::string &val) { this->server = val; }
+
+uint32_t check_and_set_response::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->error);
+                this->__isset.error = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->check_value_returned);
+                this->__isset.check_value_returned = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->check_value_exist);
+                this->__isset.check_value_exist = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_value.read(iprot);
+                this->__isset.check_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->app_id);
+                this->__isset.app_id = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->partition_index);
+                this->__isset.partition_index = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->decree);
+                this->__isset.decree = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 8:
+            if (ftype == ::apache::thrift::protocol::T_STRING) {
+                xfer += iprot->readString(this->server);
+                this->__isset.server = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t check_and_set_response::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("check_and_set_response");
+
+    xfer += oprot->writeFieldBegin("error", ::apache::thrift::protocol::T_I32, 1);
+    xfer += oprot->writeI32(this->error);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value_returned", ::apache::thrift::protocol::T_BOOL, 2);
+    xfer += oprot->writeBool(this->check_value_returned);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value_exist", ::apache::thrift::protocol::T_BOOL, 3);
+    xfer += oprot->writeBool(this->check_value_exist);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value", ::apache::thrift::protocol::T_STRUCT, 4);
+    xfer += this->check_value.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("app_id", ::apache::thrift::protocol::T_I32, 5);
+    xfer += oprot->writeI32(this->app_id);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("partition_index", ::apache::thrift::protocol::T_I32, 6);
+    xfer += oprot->writeI32(this->partition_index);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("decree", ::apache::thrift::protocol::T_I64, 7);
+    xfer += oprot->writeI64(this->decree);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("server", ::apache::thrift::protocol::T_STRING, 8);
+    xfer += oprot->writeString(this->server);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(check_and_set_response &a, check_and_set_response &b)
+{
+    using ::std::swap;
+    swap(a.error, b.error);
+    swap(a.check_value_returned, b.check_value_returned);
+    swap(a.check_value_exist, b.check_value_exist);
+    swap(a.check_value, b.check_value);
+    swap(a.app_id, b.app_id);
+    swap(a.partition_index, b.partition_index);
+    swap(a.decree, b.decree);
+    swap(a.server, b.server);
+    swap(a.__isset, b.__isset);
+}
+
+check_and_set_response::check_and_set_response(const check_and_set_response &other110)
+{
+    error = other110.error;
+    check_value_returned = other110.check_value_returned;
+    check_value_exist = other110.check_value_exist;
+    check_value = other110.check_value;
+    app_id = other110.app_id;
+    partition_index = other110.partition_index;
+    decree = other110.decree;
+    server = other110.server;
+    __isset = other110.__isset;
+}
+check_and_set_response::check_and_set_response(check_and_set_response &&other111)
+{
+    error = std::move(other111.error);
+    check_value_returned = std::move(other111.check_value_returned);
+    check_value_exist = std::move(other111.check_value_exist);
+    check_value = std::move(other111.check_value);
+    app_id = std::move(other111.app_id);
+    partition_index = std::move(other111.partition_index);
+    decree = std::move(other111.decree);
+    server = std::move(other111.server);
+    __isset = std::move(other111.__isset);
+}
+check_and_set_response &check_and_set_response::operator=(const check_and_set_response &other112)
+{
+    error = other112.error;
+    check_value_returned = other112.check_value_returned;
+    check_value_exist = other112.check_value_exist;
+    check_value = other112.check_value;
+    app_id = other112.app_id;
+    partition_index = other112.partition_index;
+    decree = other112.decree;
+    server = other112.server;
+    __isset = other112.__isset;
+    return *this;
+}
+check_and_set_response &check_and_set_response::operator=(check_and_set_response &&other113)
+{
+    error = std::move(other113.error);
+    check_value_returned = std::move(other113.check_value_returned);
+    check_value_exist = std::move(other113.check_value_exist);
+    check_value = std::move(other113.check_value);
+    app_id = std::move(other113.app_id);
+    partition_index = std::move(other113.partition_index);
+    decree = std::move(other113.decree);
+    server = std::move(other113.server);
+    __isset = std::move(other113.__isset);
+    return *this;
+}
+void check_and_set_response::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "check_and_set_response(";
+    out << "error=" << to_string(error);
+    out << ", "
+        << "check_value_returned=" << to_string(check_value_returned);
+    out << ", "
+        << "check_value_exist=" << to_string(check_value_exist);
+    out << ", "
+        << "check_value=" << to_string(check_value);
+    out << ", "
+        << "app_id=" << to_string(app_id);
+    out << ", "
+        << "partition_index=" << to_string(partition_index);
+    out << ", "
+        << "decree=" << to_string(decree);
+    out << ", "
+        << "server=" << to_string(server);
+    out << ")";
+}
+
+mutate::~mutate() throw() {}
+
+void mutate::__set_operation(const mutate_operation::type val) { this->operation = val; }
+
+void mutate::__set_sort_key(const ::dsn::blob &val) { this->sort_key = val; }
+
+void mutate::__set_value(const ::dsn::blob &val) { this->value = val; }
+
+void mutate::__set_set_expire_ts_seconds(const int32_t val) { this->set_expire_ts_seconds = val; }
+
+uint32_t mutate::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                int32_t ecast114;
+                xfer += iprot->readI32(ecast114);
+                this->operation = (mutate_operation::type)ecast114;
+                this->__isset.operation = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->sort_key.read(iprot);
+                this->__isset.sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->value.read(iprot);
+                this->__isset.value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->set_expire_ts_seconds);
+                this->__isset.set_expire_ts_seconds = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t mutate::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("mutate");
+
+    xfer += oprot->writeFieldBegin("operation", ::apache::thrift::protocol::T_I32, 1);
+    xfer += oprot->writeI32((int32_t)this->operation);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("value", ::apache::thrift::protocol::T_STRUCT, 3);
+    xfer += this->value.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("set_expire_ts_seconds", ::apache::thrift::protocol::T_I32, 4);
+    xfer += oprot->writeI32(this->set_expire_ts_seconds);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(mutate &a, mutate &b)
+{
+    using ::std::swap;
+    swap(a.operation, b.operation);
+    swap(a.sort_key, b.sort_key);
+    swap(a.value, b.value);
+    swap(a.set_expire_ts_seconds, b.set_expire_ts_seconds);
+    swap(a.__isset, b.__isset);
+}
+
+mutate::mutate(const mutate &other115)
+{
+    operation = other115.operation;
+    sort_key = other115.sort_key;
+    value = other115.value;
+    set_expire_ts_seconds = other115.set_expire_ts_seconds;
+    __isset = other115.__isset;
+}
+mutate::mutate(mutate &&other116)
+{
+    operation = std::move(other116.operation);
+    sort_key = std::move(other116.sort_key);
+    value = std::move(other116.value);
+    set_expire_ts_seconds = std::move(other116.set_expire_ts_seconds);
+    __isset = std::move(other116.__isset);
+}
+mutate &mutate::operator=(const mutate &other117)
+{
+    operation = other117.operation;
+    sort_key = other117.sort_key;
+    value = other117.value;
+    set_expire_ts_seconds = other117.set_expire_ts_seconds;
+    __isset = other117.__isset;
+    return *this;
+}
+mutate &mutate::operator=(mutate &&other118)
+{
+    operation = std::move(other118.operation);
+    sort_key = std::move(other118.sort_key);
+    value = std::move(other118.value);
+    set_expire_ts_seconds = std::move(other118.set_expire_ts_seconds);
+    __isset = std::move(other118.__isset);
+    return *this;
+}
+void mutate::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "mutate(";
+    out << "operation=" << to_string(operation);
+    out << ", "
+        << "sort_key=" << to_string(sort_key);
+    out << ", "
+        << "value=" << to_string(value);
+    out << ", "
+        << "set_expire_ts_seconds=" << to_string(set_expire_ts_seconds);
+    out << ")";
+}
+
+check_and_mutate_request::~check_and_mutate_request() throw() {}
+
+void check_and_mutate_request::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void check_and_mutate_request::__set_check_sort_key(const ::dsn::blob &val)
+{
+    this->check_sort_key = val;
+}
+
+void check_and_mutate_request::__set_check_type(const cas_check_type::type val)
+{
+    this->check_type = val;
+}
+
+void check_and_mutate_request::__set_check_operand(const ::dsn::blob &val)
+{
+    this->check_operand = val;
+}
+
+void check_and_mutate_request::__set_mutate_list(const std::vector<mutate> &val)
+{
+    this->mutate_list = val;
+}
+
+void check_and_mutate_request::__set_return_check_value(const bool val)
+{
+    this->return_check_value = val;
+}
+
+uint32_t check_and_mutate_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_sort_key.read(iprot);
+                this->__isset.check_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                int32_t ecast119;
+                xfer += iprot->readI32(ecast119);
+                this->check_type = (cas_check_type::type)ecast119;
+                this->__isset.check_type = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_operand.read(iprot);
+                this->__isset.check_operand = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->mutate_list.clear();
+                    uint32_t _size120;
+                    ::apache::thrift::protocol::TType _etype123;
+                    xfer += iprot->readListBegin(_etype123, _size120);
+                    this->mutate_list.resize(_size120);
+                    uint32_t _i124;
+                    for (_i124 = 0; _i124 < _size120; ++_i124) {
+                        xfer += this->mutate_list[_i124].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.mutate_list = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->return_check_value);
+                this->__isset.return_check_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t check_and_mutate_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("check_and_mutate_request");
+
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->check_sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_type", ::apache::thrift::protocol::T_I32, 3);
+    xfer += oprot->writeI32((int32_t)this->check_type);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_operand", ::apache::thrift::protocol::T_STRUCT, 4);
+    xfer += this->check_operand.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("mutate_list", ::apache::thrift::protocol::T_LIST, 5);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->mutate_list.size()));
+        std::vector<mutate>::const_iterator _iter125;
+        for (_iter125 = this->mutate_list.begin(); _iter125 != this->mutate_list.end();
+             ++_iter125) {
+            xfer += (*_iter125).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("return_check_value", ::apache::thrift::protocol::T_BOOL, 6);
+    xfer += oprot->writeBool(this->return_check_value);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(check_and_mutate_request &a, check_and_mutate_request &b)
+{
+    using ::std::swap;
+    swap(a.hash_key, b.hash_key);
+    swap(a.check_sort_key, b.check_sort_key);
+    swap(a.check_type, b.check_type);
+    swap(a.check_operand, b.check_operand);
+    swap(a.mutate_list, b.mutate_list);
+    swap(a.return_check_value, b.return_check_value);
+    swap(a.__isset, b.__isset);
+}
+
+check_and_mutate_request::check_and_mutate_request(const check_and_mutate_request &other126)
+{
+    hash_key = other126.hash_key;
+    check_sort_key = other126.check_sort_key;
+    check_type = other126.check_type;
+    check_operand = other126.check_operand;
+    mutate_list = other126.mutate_list;
+    return_check_value = other126.return_check_value;
+    __isset = other126.__isset;
+}
+check_and_mutate_request::check_and_mutate_request(check_and_mutate_request &&other127)
+{
+    hash_key = std::move(other127.hash_key);
+    check_sort_key = std::move(other127.check_sort_key);
+    check_type = std::move(other127.check_type);
+    check_operand = std::move(other127.check_operand);
+    mutate_list = std::move(other127.mutate_list);
+    return_check_value = std::move(other127.return_check_value);
+    __isset = std::move(other127.__isset);
+}
+check_and_mutate_request &check_and_mutate_request::
+operator=(const check_and_mutate_request &other128)
+{
+    hash_key = other128.hash_key;
+    check_sort_key = other128.check_sort_key;
+    check_type = other128.check_type;
+    check_operand = other128.check_operand;
+    mutate_list = other128.mutate_list;
+    return_check_value = other128.return_check_value;
+    __isset = other128.__isset;
+    return *this;
+}
+check_and_mutate_request &check_and_mutate_request::operator=(check_and_mutate_request &&other129)
+{
+    hash_key = std::move(other129.hash_key);
+    check_sort_key = std::move(other129.check_sort_key);
+    check_type = std::move(other129.check_type);
+    check_operand = std::move(other129.check_operand);
+    mutate_list = std::move(other129.mutate_list);
+    return_check_value = std::move(other129.return_check_value);
+    __isset = std::move(other129.__isset);
+    return *this;
+}
+void check_and_mutate_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "check_and_mutate_request(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "check_sort_key=" << to_string(check_sort_key);
+    out << ", "
+        << "check_type=" << to_string(check_type);
+    out << ", "
+        << "check_operand=" << to_string(check_operand);
+    out << ", "
+        << "mutate_list=" << to_string(mutate_list);
+    out << ", "
+        << "return_check_value=" << to_string(return_check_value);
+    out << ")";
+}
+
+check_and_mutate_response::~check_and_mutate_response() throw() {}
+
+void check_and_mutate_response::__set_error(const int32_t val) { this->error = val; }
+
+void check_and_mutate_response::__set_check_value_returned(const bool val)
+{
+    this->check_value_returned = val;
+}
+
+void check_and_mutate_response::__set_check_value_exist(const bool val)
+{
+    this->check_value_exist = val;
+}
+
+void check_and_mutate_response::__set_check_value(const ::dsn::blob &val)
+{
+    this->check_value = val;
+}
+
+void check_and_mutate_response::__set_app_id(const int32_t val) { this->app_id = val; }
+
+void check_and_mutate_response::__set_partition_index(const int32_t val)
+{
+    this->partition_index = val;
+}
+
+void check_and_mutate_response::__set_decree(const int64_t val) { this->decree = val; }
+
+void check_and_mutate_response::__set_server(const std::string &val) { this->server = val; }
+
+uint32_t check_and_mutate_response::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->error);
+                this->__isset.error = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->check_value_returned);
+                this->__isset.check_value_returned = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->check_value_exist);
+                this->__isset.check_value_exist = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->check_value.read(iprot);
+                this->__isset.check_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->app_id);
+                this->__isset.app_id = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->partition_index);
+                this->__isset.partition_index = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->decree);
+                this->__isset.decree = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 8:
+            if (ftype == ::apache::thrift::protocol::T_STRING) {
+                xfer += iprot->readString(this->server);
+                this->__isset.server = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t check_and_mutate_response::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("check_and_mutate_response");
+
+    xfer += oprot->writeFieldBegin("error", ::apache::thrift::protocol::T_I32, 1);
+    xfer += oprot->writeI32(this->error);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value_returned", ::apache::thrift::protocol::T_BOOL, 2);
+    xfer += oprot->writeBool(this->check_value_returned);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value_exist", ::apache::thrift::protocol::T_BOOL, 3);
+    xfer += oprot->writeBool(this->check_value_exist);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("check_value", ::apache::thrift::protocol::T_STRUCT, 4);
+    xfer += this->check_value.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("app_id", ::apache::thrift::protocol::T_I32, 5);
+    xfer += oprot->writeI32(this->app_id);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("partition_index", ::apache::thrift::protocol::T_I32, 6);
+    xfer += oprot->writeI32(this->partition_index);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("decree", ::apache::thrift::protocol::T_I64, 7);
+    xfer += oprot->writeI64(this->decree);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("server", ::apache::thrift::protocol::T_STRING, 8);
+    xfer += oprot->writeString(this->server);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(check_and_mutate_response &a, check_and_mutate_response &b)
+{
+    using ::std::swap;
+    swap(a.error, b.error);
+    swap(a.check_value_returned, b.check_value_returned);
+    swap(a.check_value_exist, b.check_value_exist);
+    swap(a.check_value, b.check_value);
+    swap(a.app_id, b.app_id);
+    swap(a.partition_index, b.partition_index);
+    swap(a.decree, b.decree);
+    swap(a.server, b.server);
+    swap(a.__isset, b.__isset);
+}
+
+check_and_mutate_response::check_and_mutate_response(const check_and_mutate_response &other130)
+{
+    error = other130.error;
+    check_value_returned = other130.check_value_returned;
+    check_value_exist = other130.check_value_exist;
+    check_value = other130.check_value;
+    app_id = other130.app_id;
+    partition_index = other130.partition_index;
+    decree = other130.decree;
+    server = other130.server;
+    __isset = other130.__isset;
+}
+check_and_mutate_response::check_and_mutate_response(check_and_mutate_response &&other131)
+{
+    error = std::move(other131.error);
+    check_value_returned = std::move(other131.check_value_returned);
+    check_value_exist = std::move(other131.check_value_exist);
+    check_value = std::move(other131.check_value);
+    app_id = std::move(other131.app_id);
+    partition_index = std::move(other131.partition_index);
+    decree = std::move(other131.decree);
+    server = std::move(other131.server);
+    __isset = std::move(other131.__isset);
+}
+check_and_mutate_response &check_and_mutate_response::
+operator=(const check_and_mutate_response &other132)
+{
+    error = other132.error;
+    check_value_returned = other132.check_value_returned;
+    check_value_exist = other132.check_value_exist;
+    check_value = other132.check_value;
+    app_id = other132.app_id;
+    partition_index = other132.partition_index;
+    decree = other132.decree;
+    server = other132.server;
+    __isset = other132.__isset;
+    return *this;
+}
+check_and_mutate_response &check_and_mutate_response::
+operator=(check_and_mutate_response &&other133)
+{
+    error = std::move(other133.error);
+    check_value_returned = std::move(other133.check_value_returned);
+    check_value_exist = std::move(other133.check_value_exist);
+    check_value = std::move(other133.check_value);
+    app_id = std::move(other133.app_id);
+    partition_index = std::move(other133.partition_index);
+    decree = std::move(other133.decree);
+    server = std::move(other133.server);
+    __isset = std::move(other133.__isset);
+    return *this;
+}
+void check_and_mutate_response::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "check_and_mutate_response(";
+    out << "error=" << to_string(error);
+    out << ", "
+        << "check_value_returned=" << to_string(check_value_returned);
+    out << ", "
+        << "check_value_exist=" << to_string(check_value_exist);
+    out << ", "
+        << "check_value=" << to_string(check_value);
+    out << ", "
+        << "app_id=" << to_string(app_id);
+    out << ", "
+        << "partition_index=" << to_string(partition_index);
+    out << ", "
+        << "decree=" << to_string(decree);
+    out << ", "
+        << "server=" << to_string(server);
+    out << ")";
+}
+
+del_range_request::~del_range_request() throw() {}
+
+void del_range_request::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void del_range_request::__set_start_sort_key(const ::dsn::blob &val) { this->start_sort_key = val; }
+
+void del_range_request::__set_stop_sort_key(const ::dsn::blob &val) { this->stop_sort_key = val; }
+
+void del_range_request::__set_start_inclusive(const bool val) { this->start_inclusive = val; }
+
+void del_range_request::__set_stop_inclusive(const bool val) { this->stop_inclusive = val; }
+
+uint32_t del_range_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->start_sort_key.read(iprot);
+                this->__isset.start_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->stop_sort_key.read(iprot);
+                this->__isset.stop_sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->start_inclusive);
+                this->__isset.start_inclusive = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->stop_inclusive);
+                this->__isset.stop_inclusive = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t del_range_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("del_range_request");
+
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("start_sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->start_sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("stop_sort_key", ::apache::thrift::protocol::T_STRUCT, 3);
+    xfer += this->stop_sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("start_inclusive", ::apache::thrift::protocol::T_BOOL, 4);
+    xfer += oprot->writeBool(this->start_inclusive);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("stop_inclusive", ::apache::thrift::protocol::T_BOOL, 5);
+    xfer += oprot->writeBool(this->stop_inclusive);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(del_range_request &a, del_range_request &b)
+{
+    using ::std::swap;
+    swap(a.hash_key, b.hash_key);
+    swap(a.start_sort_key, b.start_sort_key);
+    swap(a.stop_sort_key, b.stop_sort_key);
+    swap(a.start_inclusive, b.start_inclusive);
+    swap(a.stop_inclusive, b.stop_inclusive);
+    swap(a.__isset, b.__isset);
+}
+
+del_range_request::del_range_request(const del_range_request &other134)
+{
+    hash_key = other134.hash_key;
+    start_sort_key = other134.start_sort_key;
+    stop_sort_key = other134.stop_sort_key;
+    start_inclusive = other134.start_inclusive;
+    stop_inclusive = other134.stop_inclusive;
+    __isset = other134.__isset;
+}
+del_range_request::del_range_request(del_range_request &&other135)
+{
+    hash_key = std::move(other135.hash_key);
+    start_sort_key = std::move(other135.start_sort_key);
+    stop_sort_key = std::move(other135.stop_sort_key);
+    start_inclusive = std::move(other135.start_inclusive);
+    stop_inclusive = std::move(other135.stop_inclusive);
+    __isset = std::move(other135.__isset);
+}
+del_range_request &del_range_request::operator=(const del_range_request &other136)
+{
+    hash_key = other136.hash_key;
+    start_sort_key = other136.start_sort_key;
+    stop_sort_key = other136.stop_sort_key;
+    start_inclusive = other136.start_inclusive;
+    stop_inclusive = other136.stop_inclusive;
+    __isset = other136.__isset;
+    return *this;
+}
+del_range_request &del_range_request::operator=(del_range_request &&other137)
+{
+    hash_key = std::move(other137.hash_key);
+    start_sort_key = std::move(other137.start_sort_key);
+    stop_sort_key = std::move(other137.stop_sort_key);
+    start_inclusive = std::move(other137.start_inclusive);
+    stop_inclusive = std::move(other137.stop_inclusive);
+    __isset = std::move(other137.__isset);
+    return *this;
+}
+void del_range_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "del_range_request(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "start_sort_key=" << to_string(start_sort_key);
+    out << ", "
+        << "stop_sort_key=" << to_string(stop_sort_key);
+    out << ", "
+        << "start_inclusive=" << to_string(start_inclusive);
+    out << ", "
+        << "stop_inclusive=" << to_string(stop_inclusive);
+    out << ")";
+}
+
+get_scanner_request::~get_scanner_request() throw() {}
+
+void get_scanner_request::__set_start_key(const ::dsn::blob &val) { this->start_key = val; }
+
+void get_scanner_request::__set_stop_key(const ::dsn::blob &val) { this->stop_key = val; }
+
+void get_scanner_request::__set_start_inclusive(const bool val) { this->start_inclusive = val; }
+
+void get_scanner_request::__set_stop_inclusive(const bool val) { this->stop_inclusive = val; }
+
+void get_scanner_request::__set_batch_size(const int32_t val) { this->batch_size = val; }
+
+void get_scanner_request::__set_no_value(const bool val) { this->no_value = val; }
+
+void get_scanner_request::__set_hash_key_filter_type(const filter_type::type val)
+{
+    this->hash_key_filter_type = val;
+}
+
+void get_scanner_request::__set_hash_key_filter_pattern(const ::dsn::blob &val)
+{
+    this->hash_key_filter_pattern = val;
+}
+
+void get_scanner_request::__set_sort_key_filter_type(const filter_type::type val)
+{
+    this->sort_key_filter_type = val;
+}
+
+void get_scanner_request::__set_sort_key_filter_pattern(const ::dsn::blob &val)
+{
+    this->sort_key_filter_pattern = val;
+}
+
+void get_scanner_request::__set_max_iteration_count(const int32_t val)
+{
+    this->max_iteration_count = val;
+}
+
+void get_scanner_request::__set_max_iteration_time_ms(const int32_t val)
+{
+    this->max_iteration_time_ms = val;
+}
+
+void get_scanner_request::__set_max_response_bytes(const int32_t val)
+{
+    this->max_response_bytes = val;
+}
+
+void get_scanner_request::__set_full_scan(const bool val) { this->full_scan = val; }
+
+void get_scanner_request::__set_aggregate(const bool val) { this->aggregate = val; }
+
+void get_scanner_request::__set_aggregate_top_count(const int32_t val)
+{
+    this->aggregate_top_count = val;
+}
+
+uint32_t get_scanner_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->start_key.read(iprot);
+                this->__isset.start_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->stop_key.read(iprot);
+                this->__isset.stop_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->start_inclusive);
+                this->__isset.start_inclusive = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->stop_inclusive);
+                this->__isset.stop_inclusive = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->batch_size);
+                this->__isset.batch_size = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->no_value);
+                this->__isset.no_value = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                int32_t ecast138;
+                xfer += iprot->readI32(ecast138);
+                this->hash_key_filter_type = (filter_type::type)ecast138;
+                this->__isset.hash_key_filter_type = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 8:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key_filter_pattern.read(iprot);
+                this->__isset.hash_key_filter_pattern = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 9:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                int32_t ecast139;
+                xfer += iprot->readI32(ecast139);
+                this->sort_key_filter_type = (filter_type::type)ecast139;
+                this->__isset.sort_key_filter_type = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 10:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->sort_key_filter_pattern.read(iprot);
+                this->__isset.sort_key_filter_pattern = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 11:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->max_iteration_count);
+                this->__isset.max_iteration_count = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 12:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->max_iteration_time_ms);
+                this->__isset.max_iteration_time_ms = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 13:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->max_response_bytes);
+                this->__isset.max_response_bytes = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 14:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->full_scan);
+                this->__isset.full_scan = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 15:
+            if (ftype == ::apache::thrift::protocol::T_BOOL) {
+                xfer += iprot->readBool(this->aggregate);
+                this->__isset.aggregate = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 16:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->aggregate_top_count);
+                this->__isset.aggregate_top_count = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t get_scanner_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("get_scanner_request");
+
+    xfer += oprot->writeFieldBegin("start_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->start_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("stop_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->stop_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("start_inclusive", ::apache::thrift::protocol::T_BOOL, 3);
+    xfer += oprot->writeBool(this->start_inclusive);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("stop_inclusive", ::apache::thrift::protocol::T_BOOL, 4);
+    xfer += oprot->writeBool(this->stop_inclusive);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("batch_size", ::apache::thrift::protocol::T_I32, 5);
+    xfer += oprot->writeI32(this->batch_size);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("no_value", ::apache::thrift::protocol::T_BOOL, 6);
+    xfer += oprot->writeBool(this->no_value);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("hash_key_filter_type", ::apache::thrift::protocol::T_I32, 7);
+    xfer += oprot->writeI32((int32_t)this->hash_key_filter_type);
+    xfer += oprot->writeFieldEnd();
+
+    xfer +=
+        oprot->writeFieldBegin("hash_key_filter_pattern", ::apache::thrift::protocol::T_STRUCT, 8);
+    xfer += this->hash_key_filter_pattern.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key_filter_type", ::apache::thrift::protocol::T_I32, 9);
+    xfer += oprot->writeI32((int32_t)this->sort_key_filter_type);
+    xfer += oprot->writeFieldEnd();
+
+    xfer +=
+        oprot->writeFieldBegin("sort_key_filter_pattern", ::apache::thrift::protocol::T_STRUCT, 10);
+    xfer += this->sort_key_filter_pattern.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("max_iteration_count", ::apache::thrift::protocol::T_I32, 11);
+    xfer += oprot->writeI32(this->max_iteration_count);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("max_iteration_time_ms", ::apache::thrift::protocol::T_I32, 12);
+    xfer += oprot->writeI32(this->max_iteration_time_ms);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("max_response_bytes", ::apache::thrift::protocol::T_I32, 13);
+    xfer += oprot->writeI32(this->max_response_bytes);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("full_scan", ::apache::thrift::protocol::T_BOOL, 14);
+    xfer += oprot->writeBool(this->full_scan);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("aggregate", ::apache::thrift::protocol::T_BOOL, 15);
+    xfer += oprot->writeBool(this->aggregate);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("aggregate_top_count", ::apache::thrift::protocol::T_I32, 16);
+    xfer += oprot->writeI32(this->aggregate_top_count);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(get_scanner_request &a, get_scanner_request &b)
+{
+    using ::std::swap;
+    swap(a.start_key, b.start_key);
+    swap(a.stop_key, b.stop_key);
+    swap(a.start_inclusive, b.start_inclusive);
+    swap(a.stop_inclusive, b.stop_inclusive);
+    swap(a.batch_size, b.batch_size);
+    swap(a.no_value, b.no_value);
+    swap(a.hash_key_filter_type, b.hash_key_filter_type);
+    swap(a.hash_key_filter_pattern, b.hash_key_filter_pattern);
+    swap(a.sort_key_filter_type, b.sort_key_filter_type);
+    swap(a.sort_key_filter_pattern, b.sort_key_filter_pattern);
+    swap(a.max_iteration_count, b.max_iteration_count);
+    swap(a.max_iteration_time_ms, b.max_iteration_time_ms);
+    swap(a.max_response_bytes, b.max_response_bytes);
+    swap(a.full_scan, b.full_scan);
+    swap(a.aggregate, b.aggregate);
+    swap(a.aggregate_top_count, b.aggregate_top_count);
+    swap(a.__isset, b.__isset);
+}
+
+get_scanner_request::get_scanner_request(const get_scanner_request &other140)
+{
+    start_key = other140.start_key;
+    stop_key = other140.stop_key;
+    start_inclusive = other140.start_inclusive;
+    stop_inclusive = other140.stop_inclusive;
+    batch_size = other140.batch_size;
+    no_value = other140.no_value;
+    hash_key_filter_type = other140.hash_key_filter_type;
+    hash_key_filter_pattern = other140.hash_key_filter_pattern;
+    sort_key_filter_type = other140.sort_key_filter_type;
+    sort_key_filter_pattern = other140.sort_key_filter_pattern;
+    max_iteration_count = other140.max_iteration_count;
+    max_iteration_time_ms = other140.max_iteration_time_ms;
+    max_response_bytes = other140.max_response_bytes;
+    full_scan = other140.full_scan;
+    aggregate = other140.aggregate;
+    aggregate_top_count = other140.aggregate_top_count;
+    __isset = other140.__isset;
+}
+get_scanner_request::get_scanner_request(get_scanner_request &&other141)
+{
+    start_key = std::move(other141.start_key);
+    stop_key = std::move(other141.stop_key);
+    start_inclusive = std::move(other141.start_inclusive);
+    stop_inclusive = std::move(other141.stop_inclusive);
+    batch_size = std::move(other141.batch_size);
+    no_value = std::move(other141.no_value);
+    hash_key_filter_type = std::move(other141.hash_key_filter_type);
+    hash_key_filter_pattern = std::move(other141.hash_key_filter_pattern);
+    sort_key_filter_type = std::move(other141.sort_key_filter_type);
+    sort_key_filter_pattern = std::move(other141.sort_key_filter_pattern);
+    max_iteration_count = std::move(other141.max_iteration_count);
+    max_iteration_time_ms = std::move(other141.max_iteration_time_ms);
+    max_response_bytes = std::move(other141.max_response_bytes);
+    full_scan = std::move(other141.full_scan);
+    aggregate = std::move(other141.aggregate);
+    aggregate_top_count = std::move(other141.aggregate_top_count);
+    __isset = std::move(other141.__isset);
+}
+get_scanner_request &get_scanner_request::operator=(const get_scanner_request &other142)
+{
+    start_key = other142.start_key;
+    stop_key = other142.stop_key;
+    start_inclusive = other142.start_inclusive;
+    stop_inclusive = other142.stop_inclusive;
+    batch_size = other142.batch_size;
+    no_value = other142.no_value;
+    hash_key_filter_type = other142.hash_key_filter_type;
+    hash_key_filter_pattern = other142.hash_key_filter_pattern;
+    sort_key_filter_type = other142.sort_key_filter_type;
+    sort_key_filter_pattern = other142.sort_key_filter_pattern;
+    max_iteration_count = other142.max_iteration_count;
+    max_iteration_time_ms = other142.max_iteration_time_ms;
+    max_response_bytes = other142.max_response_bytes;
+    full_scan = other142.full_scan;
+    aggregate = other142.aggregate;
+    aggregate_top_count = other142.aggregate_top_count;
+    __isset = other142.__isset;
+    return *this;
+}
+get_scanner_request &get_scanner_request::operator=(get_scanner_request &&other143)
+{
+    start_key = std::move(other143.start_key);
+    stop_key = std::move(other143.stop_key);
+    start_inclusive = std::move(other143.start_inclusive);
+    stop_inclusive = std::move(other143.stop_inclusive);
+    batch_size = std::move(other143.batch_size);
+    no_value = std::move(other143.no_value);
+    hash_key_filter_type = std::move(other143.hash_key_filter_type);
+    hash_key_filter_pattern = std::move(other143.hash_key_filter_pattern);
+    sort_key_filter_type = std::move(other143.sort_key_filter_type);
+    sort_key_filter_pattern = std::move(other143.sort_key_filter_pattern);
+    max_iteration_count = std::move(other143.max_iteration_count);
+    max_iteration_time_ms = std::move(other143.max_iteration_time_ms);
+    max_response_bytes = std::move(other143.max_response_bytes);
+    full_scan = std::move(other143.full_scan);
+    aggregate = std::move(other143.aggregate);
+    aggregate_top_count = std::move(other143.aggregate_top_count);
+    __isset = std::move(other143.__isset);
+    return *this;
+}
+void get_scanner_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "get_scanner_request(";
     out << "start_key=" << to_string(start_key);
     out << ", "
         << "stop_key=" << to_string(stop_key);
@@ -2481,17 +4798,451 @@ void get_scanner_request::printTo(std::ostream &out) const
     out << ", "
         << "hash_key_filter_pattern=" << to_string(hash_key_filter_pattern);
     out << ", "
-        << "sort_key_filter_type=" << to_string(sort_key_filter_type);
+        << "sort_key_filter_type=" << to_string(sort_key_filter_type);
+    out << ", "
+        << "sort_key_filter_pattern=" << to_string(sort_key_filter_pattern);
+    out << ", "
+        << "max_iteration_count=" << to_string(max_iteration_count);
+    out << ", "
+        << "max_iteration_time_ms=" << to_string(max_iteration_time_ms);
+    out << ", "
+        << "max_response_bytes=" << to_string(max_response_bytes);
+    out << ", "
+        << "full_scan=" << to_string(full_scan);
+    out << ", "
+        << "aggregate=" << to_string(aggregate);
+    out << ", "
+        << "aggregate_top_count=" << to_string(aggregate_top_count);
+    out << ")";
+}
+
+scan_request::~scan_request() throw() {}
+
+void scan_request::__set_context_id(const int64_t val) { this->context_id = val; }
+
+void scan_request::__set_batch_size(const int32_t val) { this->batch_size = val; }
+
+uint32_t scan_request::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->context_id);
+                this->__isset.context_id = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_I32) {
+                xfer += iprot->readI32(this->batch_size);
+                this->__isset.batch_size = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t scan_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("scan_request");
+
+    xfer += oprot->writeFieldBegin("context_id", ::apache::thrift::protocol::T_I64, 1);
+    xfer += oprot->writeI64(this->context_id);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("batch_size", ::apache::thrift::protocol::T_I32, 2);
+    xfer += oprot->writeI32(this->batch_size);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(scan_request &a, scan_request &b)
+{
+    using ::std::swap;
+    swap(a.context_id, b.context_id);
+    swap(a.batch_size, b.batch_size);
+    swap(a.__isset, b.__isset);
+}
+
+scan_request::scan_request(const scan_request &other144)
+{
+    context_id = other144.context_id;
+    batch_size = other144.batch_size;
+    __isset = other144.__isset;
+}
+scan_request::scan_request(scan_request &&other145)
+{
+    context_id = std::move(other145.context_id);
+    batch_size = std::move(other145.batch_size);
+    __isset = std::move(other145.__isset);
+}
+scan_request &scan_request::operator=(const scan_request &other146)
+{
+    context_id = other146.context_id;
+    batch_size = other146.batch_size;
+    __isset = other146.__isset;
+    return *this;
+}
+scan_request &scan_request::operator=(scan_request &&other147)
+{
+    context_id = std::move(other147.context_id);
+    batch_size = std::move(other147.batch_size);
+    __isset = std::move(other147.__isset);
+    return *this;
+}
+void scan_request::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "scan_request(";
+    out << "context_id=" << to_string(context_id);
+    out << ", "
+        << "batch_size=" << to_string(batch_size);
+    out << ")";
+}
+
+scan_row_stat::~scan_row_stat() throw() {}
+
+void scan_row_stat::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void scan_row_stat::__set_sort_key(const ::dsn::blob &val) { this->sort_key = val; }
+
+void scan_row_stat::__set_size(const int64_t val) { this->size = val; }
+
+uint32_t scan_row_stat::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->sort_key.read(iprot);
+                this->__isset.sort_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->size);
+                this->__isset.size = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t scan_row_stat::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("scan_row_stat");
+
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key", ::apache::thrift::protocol::T_STRUCT, 2);
+    xfer += this->sort_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("size", ::apache::thrift::protocol::T_I64, 3);
+    xfer += oprot->writeI64(this->size);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(scan_row_stat &a, scan_row_stat &b)
+{
+    using ::std::swap;
+    swap(a.hash_key, b.hash_key);
+    swap(a.sort_key, b.sort_key);
+    swap(a.size, b.size);
+    swap(a.__isset, b.__isset);
+}
+
+scan_row_stat::scan_row_stat(const scan_row_stat &other148)
+{
+    hash_key = other148.hash_key;
+    sort_key = other148.sort_key;
+    size = other148.size;
+    __isset = other148.__isset;
+}
+scan_row_stat::scan_row_stat(scan_row_stat &&other149)
+{
+    hash_key = std::move(other149.hash_key);
+    sort_key = std::move(other149.sort_key);
+    size = std::move(other149.size);
+    __isset = std::move(other149.__isset);
+}
+scan_row_stat &scan_row_stat::operator=(const scan_row_stat &other150)
+{
+    hash_key = other150.hash_key;
+    sort_key = other150.sort_key;
+    size = other150.size;
+    __isset = other150.__isset;
+    return *this;
+}
+scan_row_stat &scan_row_stat::operator=(scan_row_stat &&other151)
+{
+    hash_key = std::move(other151.hash_key);
+    sort_key = std::move(other151.sort_key);
+    size = std::move(other151.size);
+    __isset = std::move(other151.__isset);
+    return *this;
+}
+void scan_row_stat::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "scan_row_stat(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "sort_key=" << to_string(sort_key);
+    out << ", "
+        << "size=" << to_string(size);
+    out << ")";
+}
+
+scan_hash_key_stat::~scan_hash_key_stat() throw() {}
+
+void scan_hash_key_stat::__set_hash_key(const ::dsn::blob &val) { this->hash_key = val; }
+
+void scan_hash_key_stat::__set_sort_key_count(const int64_t val) { this->sort_key_count = val; }
+
+void scan_hash_key_stat::__set_size(const int64_t val) { this->size = val; }
+
+uint32_t scan_hash_key_stat::read(::apache::thrift::protocol::TProtocol *iprot)
+{
+
+    apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
+    uint32_t xfer = 0;
+    std::string fname;
+    ::apache::thrift::protocol::TType ftype;
+    int16_t fid;
+
+    xfer += iprot->readStructBegin(fname);
+
+    using ::apache::thrift::protocol::TProtocolException;
+
+    while (true) {
+        xfer += iprot->readFieldBegin(fname, ftype, fid);
+        if (ftype == ::apache::thrift::protocol::T_STOP) {
+            break;
+        }
+        switch (fid) {
+        case 1:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->hash_key.read(iprot);
+                this->__isset.hash_key = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->sort_key_count);
+                this->__isset.sort_key_count = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->size);
+                this->__isset.size = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        default:
+            xfer += iprot->skip(ftype);
+            break;
+        }
+        xfer += iprot->readFieldEnd();
+    }
+
+    xfer += iprot->readStructEnd();
+
+    return xfer;
+}
+
+uint32_t scan_hash_key_stat::write(::apache::thrift::protocol::TProtocol *oprot) const
+{
+    uint32_t xfer = 0;
+    apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
+    xfer += oprot->writeStructBegin("scan_hash_key_stat");
+
+    xfer += oprot->writeFieldBegin("hash_key", ::apache::thrift::protocol::T_STRUCT, 1);
+    xfer += this->hash_key.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key_count", ::apache::thrift::protocol::T_I64, 2);
+    xfer += oprot->writeI64(this->sort_key_count);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("size", ::apache::thrift::protocol::T_I64, 3);
+    xfer += oprot->writeI64(this->size);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldStop();
+    xfer += oprot->writeStructEnd();
+    return xfer;
+}
+
+void swap(scan_hash_key_stat &a, scan_hash_key_stat &b)
+{
+    using ::std::swap;
+    swap(a.hash_key, b.hash_key);
+    swap(a.sort_key_count, b.sort_key_count);
+    swap(a.size, b.size);
+    swap(a.__isset, b.__isset);
+}
+
+scan_hash_key_stat::scan_hash_key_stat(const scan_hash_key_stat &other152)
+{
+    hash_key = other152.hash_key;
+    sort_key_count = other152.sort_key_count;
+    size = other152.size;
+    __isset = other152.__isset;
+}
+scan_hash_key_stat::scan_hash_key_stat(scan_hash_key_stat &&other153)
+{
+    hash_key = std::move(other153.hash_key);
+    sort_key_count = std::move(other153.sort_key_count);
+    size = std::move(other153.size);
+    __isset = std::move(other153.__isset);
+}
+scan_hash_key_stat &scan_hash_key_stat::operator=(const scan_hash_key_stat &other154)
+{
+    hash_key = other154.hash_key;
+    sort_key_count = other154.sort_key_count;
+    size = other154.size;
+    __isset = other154.__isset;
+    return *this;
+}
+scan_hash_key_stat &scan_hash_key_stat::operator=(scan_hash_key_stat &&other155)
+{
+    hash_key = std::move(other155.hash_key);
+    sort_key_count = std::move(other155.sort_key_count);
+    size = std::move(other155.size);
+    __isset = std::move(other155.__isset);
+    return *this;
+}
+void scan_hash_key_stat::printTo(std::ostream &out) const
+{
+    using ::apache::thrift::to_string;
+    out << "scan_hash_key_stat(";
+    out << "hash_key=" << to_string(hash_key);
+    out << ", "
+        << "sort_key_count=" << to_string(sort_key_count);
     out << ", "
-        << "sort_key_filter_pattern=" << to_string(sort_key_filter_pattern);
+        << "size=" << to_string(size);
     out << ")";
 }
 
-scan_request::~scan_request() throw() {}
+scan_aggregate::~scan_aggregate() throw() {}
 
-void scan_request::__set_context_id(const int64_t val) { this->context_id = val; }
+void scan_aggregate::__set_row_count(const int64_t val) { this->row_count = val; }
 
-uint32_t scan_request::read(::apache::thrift::protocol::TProtocol *iprot)
+void scan_aggregate::__set_hash_key_size_sum(const int64_t val) { this->hash_key_size_sum = val; }
+
+void scan_aggregate::__set_hash_key_size_max(const int64_t val) { this->hash_key_size_max = val; }
+
+void scan_aggregate::__set_sort_key_size_sum(const int64_t val) { this->sort_key_size_sum = val; }
+
+void scan_aggregate::__set_sort_key_size_max(const int64_t val) { this->sort_key_size_max = val; }
+
+void scan_aggregate::__set_value_size_sum(const int64_t val) { this->value_size_sum = val; }
+
+void scan_aggregate::__set_value_size_max(const int64_t val) { this->value_size_max = val; }
+
+void scan_aggregate::__set_row_size_max(const int64_t val) { this->row_size_max = val; }
+
+void scan_aggregate::__set_top_rows(const std::vector<scan_row_stat> &val) { this->top_rows = val; }
+
+void scan_aggregate::__set_hash_key_count(const int64_t val) { this->hash_key_count = val; }
+
+void scan_aggregate::__set_sort_key_count_max(const int64_t val) { this->sort_key_count_max = val; }
+
+void scan_aggregate::__set_top_hash_keys(const std::vector<scan_hash_key_stat> &val)
+{
+    this->top_hash_keys = val;
+}
+
+void scan_aggregate::__set_edge_hash_keys(const std::vector<scan_hash_key_stat> &val)
+{
+    this->edge_hash_keys = val;
+}
+
+void scan_aggregate::__set_last_key(const ::dsn::blob &val) { this->last_key = val; }
+
+uint32_t scan_aggregate::read(::apache::thrift::protocol::TProtocol *iprot)
 {
 
     apache::thrift::protocol::TInputRecursionTracker tracker(*iprot);
@@ -2512,8 +5263,145 @@ uint32_t scan_request::read(::apache::thrift::protocol::TProtocol *iprot)
         switch (fid) {
         case 1:
             if (ftype == ::apache::thrift::protocol::T_I64) {
-                xfer += iprot->readI64(this->context_id);
-                this->__isset.context_id = true;
+                xfer += iprot->readI64(this->row_count);
+                this->__isset.row_count = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 2:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->hash_key_size_sum);
+                this->__isset.hash_key_size_sum = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 3:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->hash_key_size_max);
+                this->__isset.hash_key_size_max = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 4:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->sort_key_size_sum);
+                this->__isset.sort_key_size_sum = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 5:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->sort_key_size_max);
+                this->__isset.sort_key_size_max = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 6:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->value_size_sum);
+                this->__isset.value_size_sum = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->value_size_max);
+                this->__isset.value_size_max = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 8:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->row_size_max);
+                this->__isset.row_size_max = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 9:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->top_rows.clear();
+                    uint32_t _size156;
+                    ::apache::thrift::protocol::TType _etype159;
+                    xfer += iprot->readListBegin(_etype159, _size156);
+                    this->top_rows.resize(_size156);
+                    uint32_t _i160;
+                    for (_i160 = 0; _i160 < _size156; ++_i160) {
+                        xfer += this->top_rows[_i160].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.top_rows = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 10:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->hash_key_count);
+                this->__isset.hash_key_count = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 11:
+            if (ftype == ::apache::thrift::protocol::T_I64) {
+                xfer += iprot->readI64(this->sort_key_count_max);
+                this->__isset.sort_key_count_max = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 12:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->top_hash_keys.clear();
+                    uint32_t _size161;
+                    ::apache::thrift::protocol::TType _etype164;
+                    xfer += iprot->readListBegin(_etype164, _size161);
+                    this->top_hash_keys.resize(_size161);
+                    uint32_t _i165;
+                    for (_i165 = 0; _i165 < _size161; ++_i165) {
+                        xfer += this->top_hash_keys[_i165].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.top_hash_keys = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 13:
+            if (ftype == ::apache::thrift::protocol::T_LIST) {
+                {
+                    this->edge_hash_keys.clear();
+                    uint32_t _size166;
+                    ::apache::thrift::protocol::TType _etype169;
+                    xfer += iprot->readListBegin(_etype169, _size166);
+                    this->edge_hash_keys.resize(_size166);
+                    uint32_t _i170;
+                    for (_i170 = 0; _i170 < _size166; ++_i170) {
+                        xfer += this->edge_hash_keys[_i170].read(iprot);
+                    }
+                    xfer += iprot->readListEnd();
+                }
+                this->__isset.edge_hash_keys = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
+        case 14:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->last_key.read(iprot);
+                this->__isset.last_key = true;
             } else {
                 xfer += iprot->skip(ftype);
             }
@@ -2530,14 +5418,92 @@ uint32_t scan_request::read(::apache::thrift::protocol::TProtocol *iprot)
     return xfer;
 }
 
-uint32_t scan_request::write(::apache::thrift::protocol::TProtocol *oprot) const
+uint32_t scan_aggregate::write(::apache::thrift::protocol::TProtocol *oprot) const
 {
     uint32_t xfer = 0;
     apache::thrift::protocol::TOutputRecursionTracker tracker(*oprot);
-    xfer += oprot->writeStructBegin("scan_request");
+    xfer += oprot->writeStructBegin("scan_aggregate");
 
-    xfer += oprot->writeFieldBegin("context_id", ::apache::thrift::protocol::T_I64, 1);
-    xfer += oprot->writeI64(this->context_id);
+    xfer += oprot->writeFieldBegin("row_count", ::apache::thrift::protocol::T_I64, 1);
+    xfer += oprot->writeI64(this->row_count);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("hash_key_size_sum", ::apache::thrift::protocol::T_I64, 2);
+    xfer += oprot->writeI64(this->hash_key_size_sum);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("hash_key_size_max", ::apache::thrift::protocol::T_I64, 3);
+    xfer += oprot->writeI64(this->hash_key_size_max);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key_size_sum", ::apache::thrift::protocol::T_I64, 4);
+    xfer += oprot->writeI64(this->sort_key_size_sum);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key_size_max", ::apache::thrift::protocol::T_I64, 5);
+    xfer += oprot->writeI64(this->sort_key_size_max);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("value_size_sum", ::apache::thrift::protocol::T_I64, 6);
+    xfer += oprot->writeI64(this->value_size_sum);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("value_size_max", ::apache::thrift::protocol::T_I64, 7);
+    xfer += oprot->writeI64(this->value_size_max);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("row_size_max", ::apache::thrift::protocol::T_I64, 8);
+    xfer += oprot->writeI64(this->row_size_max);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("top_rows", ::apache::thrift::protocol::T_LIST, 9);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->top_rows.size()));
+        std::vector<scan_row_stat>::const_iterator _iter171;
+        for (_iter171 = this->top_rows.begin(); _iter171 != this->top_rows.end(); ++_iter171) {
+            xfer += (*_iter171).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("hash_key_count", ::apache::thrift::protocol::T_I64, 10);
+    xfer += oprot->writeI64(this->hash_key_count);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("sort_key_count_max", ::apache::thrift::protocol::T_I64, 11);
+    xfer += oprot->writeI64(this->sort_key_count_max);
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("top_hash_keys", ::apache::thrift::protocol::T_LIST, 12);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->top_hash_keys.size()));
+        std::vector<scan_hash_key_stat>::const_iterator _iter172;
+        for (_iter172 = this->top_hash_keys.begin(); _iter172 != this->top_hash_keys.end();
+             ++_iter172) {
+            xfer += (*_iter172).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("edge_hash_keys", ::apache::thrift::protocol::T_LIST, 13);
+    {
+        xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
+                                      static_cast<uint32_t>(this->edge_hash_keys.size()));
+        std::vector<scan_hash_key_stat>::const_iterator _iter173;
+        for (_iter173 = this->edge_hash_keys.begin(); _iter173 != this->edge_hash_keys.end();
+             ++_iter173) {
+            xfer += (*_iter173).write(oprot);
+        }
+        xfer += oprot->writeListEnd();
+    }
+    xfer += oprot->writeFieldEnd();
+
+    xfer += oprot->writeFieldBegin("last_key", ::apache::thrift::protocol::T_STRUCT, 14);
+    xfer += this->last_key.write(oprot);
     xfer += oprot->writeFieldEnd();
 
     xfer += oprot->writeFieldStop();
@@ -2545,40 +5511,131 @@ uint32_t scan_request::write(::apache::thrift::protocol::TProtocol *oprot) const
     return xfer;
 }
 
-void swap(scan_request &a, scan_request &b)
+void swap(scan_aggregate &a, scan_aggregate &b)
 {
     using ::std::swap;
-    swap(a.context_id, b.context_id);
+    swap(a.row_count, b.row_count);
+    swap(a.hash_key_size_sum, b.hash_key_size_sum);
+    swap(a.hash_key_size_max, b.hash_key_size_max);
+    swap(a.sort_key_size_sum, b.sort_key_size_sum);
+    swap(a.sort_key_size_max, b.sort_key_size_max);
+    swap(a.value_size_sum, b.value_size_sum);
+    swap(a.value_size_max, b.value_size_max);
+    swap(a.row_size_max, b.row_size_max);
+    swap(a.top_rows, b.top_rows);
+    swap(a.hash_key_count, b.hash_key_count);
+    swap(a.sort_key_count_max, b.sort_key_count_max);
+    swap(a.top_hash_keys, b.top_hash_keys);
+    swap(a.edge_hash_keys, b.edge_hash_keys);
+    swap(a.last_key, b.last_key);
     swap(a.__isset, b.__isset);
 }
 
-scan_request::scan_request(const scan_request &other79)
-{
-    context_id = other79.context_id;
-    __isset = other79.__isset;
-}
-scan_request::scan_request(scan_request &&other80)
-{
-    context_id = std::move(other80.context_id);
-    __isset = std::move(other80.__isset);
-}
-scan_request &scan_request::operator=(const scan_request &other81)
-{
-    context_id = other81.context_id;
-    __isset = other81.__isset;
+scan_aggregate::scan_aggregate(const scan_aggregate &other174)
+{
+    row_count = other174.row_count;
+    hash_key_size_sum = other174.hash_key_size_sum;
+    hash_key_size_max = other174.hash_key_size_max;
+    sort_key_size_sum = other174.sort_key_size_sum;
+    sort_key_size_max = other174.sort_key_size_max;
+    value_size_sum = other174.value_size_sum;
+    value_size_max = other174.value_size_max;
+    row_size_max = other174.row_size_max;
+    top_rows = other174.top_rows;
+    hash_key_count = other174.hash_key_count;
+    sort_key_count_max = other174.sort_key_count_max;
+    top_hash_keys = other174.top_hash_keys;
+    edge_hash_keys = other174.edge_hash_keys;
+    last_key = other174.last_key;
+    __isset = other174.__isset;
+}
+scan_aggregate::scan_aggregate(scan_aggregate &&other175)
+{
+    row_count = std::move(other175.row_count);
+    hash_key_size_sum = std::move(other175.hash_key_size_sum);
+    hash_key_size_max = std::move(other175.hash_key_size_max);
+    sort_key_size_sum = std::move(other175.sort_key_size_sum);
+    sort_key_size_max = std::move(other175.sort_key_size_max);
+    value_size_sum = std::move(other175.value_size_sum);
+    value_size_max = std::move(other175.value_size_max);
+    row_size_max = std::move(other175.row_size_max);
+    top_rows = std::move(other175.top_rows);
+    hash_key_count = std::move(other175.hash_key_count);
+    sort_key_count_max = std::move(other175.sort_key_count_max);
+    top_hash_keys = std::move(other175.top_hash_keys);
+    edge_hash_keys = std::move(other175.edge_hash_keys);
+    last_key = std::move(other175.last_key);
+    __isset = std::move(other175.__isset);
+}
+scan_aggregate &scan_aggregate::operator=(const scan_aggregate &other176)
+{
+    row_count = other176.row_count;
+    hash_key_size_sum = other176.hash_key_size_sum;
+    hash_key_size_max = other176.hash_key_size_max;
+    sort_key_size_sum = other176.sort_key_size_sum;
+    sort_key_size_max = other176.sort_key_size_max;
+    value_size_sum = other176.value_size_sum;
+    value_size_max = other176.value_size_max;
+    row_size_max = other176.row_size_max;
+    top_rows = other176.top_rows;
+    hash_key_count = other176.hash_key_count;
+    sort_key_count_max = other176.sort_key_count_max;
+    top_hash_keys = other176.top_hash_keys;
+    edge_hash_keys = other176.edge_hash_keys;
+    last_key = other176.last_key;
+    __isset = other176.__isset;
     return *this;
 }
-scan_request &scan_request::operator=(scan_request &&other82)
-{
-    context_id = std::move(other82.context_id);
-    __isset = std::move(other82.__isset);
+scan_aggregate &scan_aggregate::operator=(scan_aggregate &&other177)
+{
+    row_count = std::move(other177.row_count);
+    hash_key_size_sum = std::move(other177.hash_key_size_sum);
+    hash_key_size_max = std::move(other177.hash_key_size_max);
+    sort_key_size_sum = std::move(other177.sort_key_size_sum);
+    sort_key_size_max = std::move(other177.sort_key_size_max);
+    value_size_sum = std::move(other177.value_size_sum);
+    value_size_max = std::move(other177.value_size_max);
+    row_size_max = std::move(other177.row_size_max);
+    top_rows = std::move(other177.top_rows);
+    hash_key_count = std::move(other177.hash_key_count);
+    sort_key_count_max = std::move(other177.sort_key_count_max);
+    top_hash_keys = std::move(other177.top_hash_keys);
+    edge_hash_keys = std::move(other177.edge_hash_keys);
+    last_key = std::move(other177.last_key);
+    __isset = std::move(other177.__isset);
     return *this;
 }
-void scan_request::printTo(std::ostream &out) const
+void scan_aggregate::printTo(std::ostream &out) const
 {
     using ::apache::thrift::to_string;
-    out << "scan_request(";
-    out << "context_id=" << to_string(context_id);
+    out << "scan_aggregate(";
+    out << "row_count=" << to_string(row_count);
+    out << ", "
+        << "hash_key_size_sum=" << to_string(hash_key_size_sum);
+    out << ", "
+        << "hash_key_size_max=" << to_string(hash_key_size_max);
+    out << ", "
+        << "sort_key_size_sum=" << to_string(sort_key_size_sum);
+    out << ", "
+        << "sort_key_size_max=" << to_string(sort_key_size_max);
+    out << ", "
+        << "value_size_sum=" << to_string(value_size_sum);
+    out << ", "
+        << "value_size_max=" << to_string(value_size_max);
+    out << ", "
+        << "row_size_max=" << to_string(row_size_max);
+    out << ", "
+        << "top_rows=" << to_string(top_rows);
+    out << ", "
+        << "hash_key_count=" << to_string(hash_key_count);
+    out << ", "
+        << "sort_key_count_max=" << to_string(sort_key_count_max);
+    out << ", "
+        << "top_hash_keys=" << to_string(top_hash_keys);
+    out << ", "
+        << "edge_hash_keys=" << to_string(edge_hash_keys);
+    out << ", "
+        << "last_key=" << to_string(last_key);
     out << ")";
 }
 
@@ -2596,6 +5653,8 @@ void scan_response::__set_partition_index(const int32_t val) { this->partition_i
 
 void scan_response::__set_server(const std::string &val) { this->server = val; }
 
+void scan_response::__set_aggregate(const scan_aggregate &val) { this->aggregate = val; }
+
 uint32_t scan_response::read(::apache::thrift::protocol::TProtocol *iprot)
 {
 
@@ -2627,13 +5686,13 @@ uint32_t scan_response::read(::apache::thrift::protocol::TProtocol *iprot)
             if (ftype == ::apache::thrift::protocol::T_LIST) {
                 {
                     this->kvs.clear();
-                    uint32_t _size83;
-                    ::apache::thrift::protocol::TType _etype86;
-                    xfer += iprot->readListBegin(_etype86, _size83);
-                    this->kvs.resize(_size83);
-                    uint32_t _i87;
-                    for (_i87 = 0; _i87 < _size83; ++_i87) {
-                        xfer += this->kvs[_i87].read(iprot);
+                    uint32_t _size178;
+                    ::apache::thrift::protocol::TType _etype181;
+                    xfer += iprot->readListBegin(_etype181, _size178);
+                    this->kvs.resize(_size178);
+                    uint32_t _i182;
+                    for (_i182 = 0; _i182 < _size178; ++_i182) {
+                        xfer += this->kvs[_i182].read(iprot);
                     }
                     xfer += iprot->readListEnd();
                 }
@@ -2674,6 +5733,14 @@ uint32_t scan_response::read(::apache::thrift::protocol::TProtocol *iprot)
                 xfer += iprot->skip(ftype);
             }
             break;
+        case 7:
+            if (ftype == ::apache::thrift::protocol::T_STRUCT) {
+                xfer += this->aggregate.read(iprot);
+                this->__isset.aggregate = true;
+            } else {
+                xfer += iprot->skip(ftype);
+            }
+            break;
         default:
             xfer += iprot->skip(ftype);
             break;
@@ -2700,9 +5767,9 @@ uint32_t scan_response::write(::apache::thrift::protocol::TProtocol *oprot) cons
     {
         xfer += oprot->writeListBegin(::apache::thrift::protocol::T_STRUCT,
                                       static_cast<uint32_t>(this->kvs.size()));
-        std::vector<key_value>::const_iterator _iter88;
-        for (_iter88 = this->kvs.begin(); _iter88 != this->kvs.end(); ++_iter88) {
-            xfer += (*_iter88).write(oprot);
+        std::vector<key_value>::const_iterator _iter183;
+        for (_iter183 = this->kvs.begin(); _iter183 != this->kvs.end(); ++_iter183) {
+            xfer += (*_iter183).write(oprot);
         }
         xfer += oprot->writeListEnd();
     }
@@ -2724,6 +5791,10 @@ uint32_t scan_response::write(::apache::thrift::protocol::TProtocol *oprot) cons
     xfer += oprot->writeString(this->server);
     xfer += oprot->writeFieldEnd();
 
+    xfer += oprot->writeFieldBegin("aggregate", ::apache::thrift::protocol::T_STRUCT, 7);
+    xfer += this->aggregate.write(oprot);
+    xfer += oprot->writeFieldEnd();
+
     xfer += oprot->writeFieldStop();
     xfer += oprot->writeStructEnd();
     return xfer;
@@ -2738,49 +5809,54 @@ void swap(scan_response &a, scan_response &b)
     swap(a.app_id, b.app_id);
     swap(a.partition_index, b.partition_index);
     swap(a.server, b.server);
+    swap(a.aggregate, b.aggregate);
     swap(a.__isset, b.__isset);
 }
 
-scan_response::scan_response(const scan_response &other89)
-{
-    error = other89.error;
-    kvs = other89.kvs;
-    context_id = other89.context_id;
-    app_id = other89.app_id;
-    partition_index = other89.partition_index;
-    server = other89.server;
-    __isset = other89.__isset;
-}
-scan_response::scan_response(scan_response &&other90)
-{
-    error = std::move(other90.error);
-    kvs = std::move(other90.kvs);
-    context_id = std::move(other90.context_id);
-    app_id = std::move(other90.app_id);
-    partition_index = std::move(other90.partition_index);
-    server = std::move(other90.server);
-    __isset = std::move(other90.__isset);
-}
-scan_response &scan_response::operator=(const scan_response &other91)
-{
-    error = other91.error;
-    kvs = other91.kvs;
-    context_id = other91.context_id;
-    app_id = other91.app_id;
-    partition_index = other91.partition_index;
-    server = other91.server;
-    __isset = other91.__isset;
+scan_response::scan_response(const scan_response &other184)
+{
+    error = other184.error;
+    kvs = other184.kvs;
+    context_id = other184.context_id;
+    app_id = other184.app_id;
+    partition_index = other184.partition_index;
+    server = other184.server;
+    aggregate = other184.aggregate;
+    __isset = other184.__isset;
+}
+scan_response::scan_response(scan_response &&other185)
+{
+    error = std::move(other185.error);
+    kvs = std::move(other185.kvs);
+    context_id = std::move(other185.context_id);
+    app_id = std::move(other185.app_id);
+    partition_index = std::move(other185.partition_index);
+    server = std::move(other185.server);
+    aggregate = std::move(other185.aggregate);
+    __isset = std::move(other185.__isset);
+}
+scan_response &scan_response::operator=(const scan_response &other186)
+{
+    error = other186.error;
+    kvs = other186.kvs;
+    context_id = other186.context_id;
+    app_id = other186.app_id;
+    partition_index = other186.partition_index;
+    server = other186.server;
+    aggregate = other186.aggregate;
+    __isset = other186.__isset;
     return *this;
 }
-scan_response &scan_response::operator=(scan_response &&other92)
+scan_response &scan_response::operator=(scan_response &&other187)
 {
-    error = std::move(other92.error);
-    kvs = std::move(other92.kvs);
-    context_id = std::move(other92.context_id);
-    app_id = std::move(other92.app_id);
-    partition_index = std::move(other92.partition_index);
-    server = std::move(other92.server);
-    __isset = std::move(other92.__isset);
+    error = std::move(other187.error);
+    kvs = std::move(other187.kvs);
+    context_id = std::move(other187.context_id);
+    app_id = std::move(other187.app_id);
+    partition_index = std::move(other187.partition_index);
+    server = std::move(other187.server);
+    aggregate = std::move(other187.aggregate);
+    __isset = std::move(other187.__isset);
     return *this;
 }
 void scan_response::printTo(std::ostream &out) const
@@ -2798,6 +5874,8 @@ void scan_response::printTo(std::ostream &out) const
         << "partition_index=" << to_string(partition_index);
     out << ", "
         << "server=" << to_string(server);
+    out << ", "
+        << "aggregate=" << to_string(aggregate);
     out << ")";
 }
 }
@@ -22,11 +22,15 @@ namespace client {
 
 #define ROCSKDB_ERROR_START -1000
 
+DEFINE_TASK_CODE_RPC(RPC_CM_QUERY_PARTITION_CONFIG_BY_INDEX,
+                     TASK_PRIORITY_COMMON,
+                     ::dsn::THREAD_POOL_DEFAULT)
+
 std::unordered_map<int, std::string> pegasus_client_impl::_client_error_to_string;
 std::unordered_map<int, int> pegasus_client_impl::_server_error_to_client;
 
 pegasus_client_impl::pegasus_client_impl(const char *cluster_name, const char *app_name)
-    : _cluster_name(cluster_name), _app_name(app_name)
+    : _cluster_name(cluster_name), _app_name(app_name), _partition_count(0)
 {
     _server_uri = "dsn://" + _cluster_name + "/" + _app_name;
     _server_uri_address.assign_uri(_server_uri.c_str());
@@ -481,6 +485,37 @@ void pegasus_client_impl::async_multi_get(const std::string &hash_key,
                        partition_hash);
 }
 
+int pegasus_client_impl::get_multi_get_pager(const std::string &hash_key,
+                                             const std::string &start_sortkey,
+                                             const std::string &stop_sortkey,
+                                             const multi_get_options &options,
+                                             multi_get_pager *&pager,
+                                             int max_fetch_count,
+                                             int max_fetch_size,
+                                             int timeout_milliseconds)
+{
+    // check params
+    if (hash_key.size() == 0) {
+        derror("invalid hash key: hash key should not be empty");
+        return PERR_INVALID_HASH_KEY;
+    }
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        return PERR_INVALID_HASH_KEY;
+    }
+
+    pager = new pegasus_multi_get_pager_impl(_client,
+                                             hash_key,
+                                             start_sortkey,
+                                             stop_sortkey,
+                                             options,
+                                             max_fetch_count,
+                                             max_fetch_size,
+                                             timeout_milliseconds);
+    return PERR_OK;
+}
+
 int pegasus_client_impl::multi_get_sortkeys(const std::string &hash_key,
                                             std::set<std::string> &sort_keys,
                                             int max_fetch_count,
@@ -560,6 +595,161 @@ void pegasus_client_impl::async_multi_get_sortkeys(const std::string &hash_key,
                        partition_hash);
 }
 
+int pegasus_client_impl::batch_get(
+    const std::vector<std::pair<std::string, std::string>> &keys,
+    std::map<std::pair<std::string, std::string>, std::string> &values,
+    int timeout_milliseconds)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback =
+        [&](int err, std::map<std::pair<std::string, std::string>, std::string> &&_values) {
+            ret = err;
+            values = std::move(_values);
+            op_completed.notify();
+        };
+    async_batch_get(keys, std::move(callback), timeout_milliseconds);
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::async_batch_get(
+    const std::vector<std::pair<std::string, std::string>> &keys,
+    async_batch_get_callback_t &&callback,
+    int timeout_milliseconds)
+{
+    // check params
+    if (keys.empty()) {
+        derror("invalid keys: keys should not be empty for batch_get");
+        if (callback != nullptr)
+            callback(PERR_INVALID_VALUE,
+                     std::map<std::pair<std::string, std::string>, std::string>());
+        return;
+    }
+    for (auto &key : keys) {
+        if (key.first.size() >= UINT16_MAX) {
+            derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+                   (int)key.first.size());
+            if (callback != nullptr)
+                callback(PERR_INVALID_HASH_KEY,
+                         std::map<std::pair<std::string, std::string>, std::string>());
+            return;
+        }
+    }
+
+    int partition_count = _partition_count.load();
+    if (partition_count > 0) {
+        batch_get_by_partition(partition_count, keys, std::move(callback), timeout_milliseconds);
+        return;
+    }
+
+    // the partition count is unknown yet, query it from the meta server
+    auto new_callback = [ this, keys, user_callback = std::move(callback), timeout_milliseconds ](
+        ::dsn::error_code err, dsn_message_t req, dsn_message_t resp) mutable
+    {
+        configuration_query_by_index_response response;
+        if (err == ERR_OK) {
+            ::dsn::unmarshall(resp, response);
+            err = response.err;
+        }
+        if (err != ERR_OK) {
+            if (user_callback != nullptr)
+                user_callback(get_client_error(int(err)),
+                              std::map<std::pair<std::string, std::string>, std::string>());
+            return;
+        }
+        _partition_count.store(response.partition_count);
+        batch_get_by_partition(
+            response.partition_count, keys, std::move(user_callback), timeout_milliseconds);
+    };
+
+    configuration_query_by_index_request req;
+    req.app_name = _app_name;
+    ::dsn::rpc::call(_meta_server,
+                     RPC_CM_QUERY_PARTITION_CONFIG_BY_INDEX,
+                     req,
+                     nullptr,
+                     std::move(new_callback),
+                     std::chrono::milliseconds(timeout_milliseconds),
+                     0,
+                     0);
+}
+
+void pegasus_client_impl::batch_get_by_partition(
+    int partition_count,
+    const std::vector<std::pair<std::string, std::string>> &keys,
+    async_batch_get_callback_t &&callback,
+    int timeout_milliseconds)
+{
+    // partition_index => <partition_hash, request>
+    std::map<int, std::pair<uint64_t, ::dsn::apps::batch_get_request>> requests;
+    for (auto &key : keys) {
+        ::dsn::blob raw_key;
+        pegasus_generate_key(raw_key, key.first, key.second);
+        uint64_t partition_hash = pegasus_key_hash(raw_key);
+        auto &entry = requests[partition_hash % (uint64_t)partition_count];
+        entry.first = partition_hash;
+        ::dsn::apps::full_key full_key;
+        full_key.hash_key = ::dsn::blob(key.first.data(), 0, key.first.size());
+        full_key.sort_key = ::dsn::blob(key.second.data(), 0, key.second.size());
+        entry.second.keys.emplace_back(std::move(full_key));
+    }
+
+    struct batch_get_context
+    {
+        ::dsn::service::zlock lock;
+        int remaining;
+        int error;
+        std::map<std::pair<std::string, std::string>, std::string> values;
+        async_batch_get_callback_t callback;
+    };
+    auto context = std::make_shared<batch_get_context>();
+    context->remaining = requests.size();
+    context->error = PERR_OK;
+    context->callback = std::move(callback);
+
+    for (auto &kv : requests) {
+        auto new_callback = [this, context](
+            ::dsn::error_code err, dsn_message_t req, dsn_message_t resp)
+        {
+            ::dsn::apps::batch_get_response response;
+            if (err == ::dsn::ERR_OK) {
+                ::dsn::unmarshall(resp, response);
+            } else if (err != ::dsn::ERR_TIMEOUT) {
+                // the partition count may be changed, query it again on the next call
+                _partition_count.store(0);
+            }
+            int ret = get_client_error(
+                err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+
+            bool finished;
+            {
+                ::dsn::service::zauto_lock l(context->lock);
+                if (ret == PERR_OK) {
+                    for (auto &data : response.data) {
+                        std::string hash_key(data.hash_key.data(), data.hash_key.length());
+                        std::string sort_key(data.sort_key.data(), data.sort_key.length());
+                        context->values.emplace(
+                            std::make_pair(std::move(hash_key), std::move(sort_key)),
+                            std::string(data.value.data(), data.value.length()));
+                    }
+                } else {
+                    context->error = ret;
+                }
+                finished = (--context->remaining == 0);
+            }
+            if (finished && context->callback != nullptr) {
+                context->callback(context->error, std::move(context->values));
+            }
+        };
+        _client->batch_get(kv.second.second,
+                           std::move(new_callback),
+                           std::chrono::milliseconds(timeout_milliseconds),
+                           0,
+                           kv.second.first);
+    }
+}
+
 int pegasus_client_impl::exist(const std::string &hash_key,
                                const std::string &sort_key,
                                int timeout_milliseconds,
@@ -611,6 +801,49 @@ int pegasus_client_impl::sortkey_count(const std::string &hash_key,
                                                : int(pr.first));
 }
 
+int pegasus_client_impl::approximate_sortkey_count(const std::string &hash_key,
+                                                   int64_t &count,
+                                                   int timeout_milliseconds,
+                                                   internal_info *info)
+{
+    // check params
+    if (hash_key.size() == 0) {
+        derror("invalid hash key: hash key should not be empty for approximate_sortkey_count");
+        return PERR_INVALID_HASH_KEY;
+    }
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        return PERR_INVALID_HASH_KEY;
+    }
+
+    ::dsn::blob tmp_key;
+    pegasus_generate_key(tmp_key, hash_key, std::string());
+    auto partition_hash = pegasus_key_hash(tmp_key);
+    auto pr = _client->approximate_sortkey_count_sync(
+        ::dsn::blob(hash_key.data(), 0, hash_key.length()),
+        std::chrono::milliseconds(timeout_milliseconds),
+        0,
+        partition_hash);
+    if (pr.first == ERR_OK && pr.second.error == 0) {
+        count = pr.second.count;
+    }
+    if (info != nullptr) {
+        if (pr.first == ERR_OK) {
+            info->app_id = pr.second.app_id;
+            info->partition_index = pr.second.partition_index;
+            info->decree = -1;
+            info->server = pr.second.server;
+        } else {
+            info->app_id = -1;
+            info->partition_index = -1;
+            info->decree = -1;
+        }
+    }
+    return get_client_error(pr.first == ERR_OK ? get_rocksdb_server_error(pr.second.error)
+                                               : int(pr.first));
+}
+
 int pegasus_client_impl::del(const std::string &hash_key,
                              const std::string &sort_key,
                              int timeout_milliseconds,
@@ -757,6 +990,384 @@ void pegasus_client_impl::async_multi_del(const std::string &hash_key,
                           partition_hash);
 }
 
+int pegasus_client_impl::del_range(const std::string &hash_key,
+                                   const std::string &start_sort_key,
+                                   const std::string &stop_sort_key,
+                                   bool start_inclusive,
+                                   bool stop_inclusive,
+                                   int timeout_milliseconds,
+                                   internal_info *info)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback = [&](int err, internal_info &&_info) {
+        ret = err;
+        if (info != nullptr)
+            (*info) = std::move(_info);
+        op_completed.notify();
+    };
+    async_del_range(hash_key,
+                    start_sort_key,
+                    stop_sort_key,
+                    start_inclusive,
+                    stop_inclusive,
+                    std::move(callback),
+                    timeout_milliseconds);
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::async_del_range(const std::string &hash_key,
+                                          const std::string &start_sort_key,
+                                          const std::string &stop_sort_key,
+                                          bool start_inclusive,
+                                          bool stop_inclusive,
+                                          async_del_callback_t &&callback,
+                                          int timeout_milliseconds)
+{
+    // check params
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        if (callback != nullptr)
+            callback(PERR_INVALID_HASH_KEY, internal_info());
+        return;
+    }
+
+    ::dsn::apps::del_range_request req;
+    req.hash_key.assign(hash_key.c_str(), 0, hash_key.size());
+    req.start_sort_key.assign(start_sort_key.c_str(), 0, start_sort_key.size());
+    req.stop_sort_key.assign(stop_sort_key.c_str(), 0, stop_sort_key.size());
+    req.start_inclusive = start_inclusive;
+    req.stop_inclusive = stop_inclusive;
+
+    ::dsn::blob tmp_key;
+    pegasus_generate_key(tmp_key, req.hash_key, ::dsn::blob());
+    auto partition_hash = pegasus_key_hash(tmp_key);
+    auto new_callback = [user_callback = std::move(callback)](
+        ::dsn::error_code err, dsn_message_t req, dsn_message_t resp)
+    {
+        if (user_callback == nullptr) {
+            return;
+        }
+        ::dsn::apps::update_response response;
+        internal_info info;
+        if (err == ::dsn::ERR_OK) {
+            ::dsn::unmarshall(resp, response);
+            info.app_id = response.app_id;
+            info.partition_index = response.partition_index;
+            info.decree = response.decree;
+            info.server = response.server;
+        }
+        int ret =
+            get_client_error(err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+        user_callback(ret, std::move(info));
+    };
+    _client->del_range(req,
+                       std::move(new_callback),
+                       std::chrono::milliseconds(timeout_milliseconds),
+                       0,
+                       partition_hash);
+}
+
+int pegasus_client_impl::incr(const std::string &hash_key,
+                              const std::string &sort_key,
+                              int64_t increment,
+                              int64_t &new_value,
+                              int timeout_milliseconds,
+                              internal_info *info)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback = [&](int err, int64_t _new_value, internal_info &&_info) {
+        ret = err;
+        new_value = _new_value;
+        if (info != nullptr)
+            (*info) = std::move(_info);
+        op_completed.notify();
+    };
+    async_incr(hash_key, sort_key, increment, std::move(callback), timeout_milliseconds);
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::async_incr(const std::string &hash_key,
+                                     const std::string &sort_key,
+                                     int64_t increment,
+                                     async_incr_callback_t &&callback,
+                                     int timeout_milliseconds)
+{
+    // check params
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        if (callback != nullptr)
+            callback(PERR_INVALID_HASH_KEY, 0, internal_info());
+        return;
+    }
+
+    ::dsn::apps::incr_request req;
+    pegasus_generate_key(req.key, hash_key, sort_key);
+    req.increment = increment;
+    auto partition_hash = pegasus_key_hash(req.key);
+
+    auto new_callback = [user_callback = std::move(callback)](
+        ::dsn::error_code err, dsn_message_t req, dsn_message_t resp)
+    {
+        if (user_callback == nullptr) {
+            return;
+        }
+        ::dsn::apps::incr_response response;
+        internal_info info;
+        if (err == ::dsn::ERR_OK) {
+            ::dsn::unmarshall(resp, response);
+            info.app_id = response.app_id;
+            info.partition_index = response.partition_index;
+            info.decree = response.decree;
+            info.server = response.server;
+        }
+        int ret =
+            get_client_error(err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+        user_callback(ret, ret == PERR_OK ? response.new_value : 0, std::move(info));
+    };
+    _client->incr(req,
+                  std::move(new_callback),
+                  std::chrono::milliseconds(timeout_milliseconds),
+                  0,
+                  partition_hash);
+}
+
+int pegasus_client_impl::check_and_set(const std::string &hash_key,
+                                       const std::string &check_sort_key,
+                                       cas_check_type check_type,
+                                       const std::string &check_operand,
+                                       const std::string &set_sort_key,
+                                       const std::string &set_value,
+                                       const check_and_set_options &options,
+                                       check_and_set_results &results,
+                                       int timeout_milliseconds,
+                                       internal_info *info)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback = [&](int err, check_and_set_results &&_results, internal_info &&_info) {
+        ret = err;
+        results = std::move(_results);
+        if (info != nullptr)
+            (*info) = std::move(_info);
+        op_completed.notify();
+    };
+    async_check_and_set(hash_key,
+                        check_sort_key,
+                        check_type,
+                        check_operand,
+                        set_sort_key,
+                        set_value,
+                        options,
+                        std::move(callback),
+                        timeout_milliseconds);
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::async_check_and_set(const std::string &hash_key,
+                                              const std::string &check_sort_key,
+                                              cas_check_type check_type,
+                                              const std::string &check_operand,
+                                              const std::string &set_sort_key,
+                                              const std::string &set_value,
+                                              const check_and_set_options &options,
+                                              async_check_and_set_callback_t &&callback,
+                                              int timeout_milliseconds)
+{
+    // check params
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        if (callback != nullptr)
+            callback(PERR_INVALID_HASH_KEY, check_and_set_results(), internal_info());
+        return;
+    }
+
+    ::dsn::apps::check_and_set_request req;
+    req.hash_key.assign(hash_key.c_str(), 0, hash_key.size());
+    req.check_sort_key.assign(check_sort_key.c_str(), 0, check_sort_key.size());
+    req.check_type = (dsn::apps::cas_check_type::type)check_type;
+    req.check_operand.assign(check_operand.c_str(), 0, check_operand.size());
+    if (check_sort_key != set_sort_key) {
+        req.set_diff_sort_key = true;
+        req.set_sort_key.assign(set_sort_key.c_str(), 0, set_sort_key.size());
+    }
+    req.set_value.assign(set_value.c_str(), 0, set_value.size());
+    if (options.set_value_ttl_seconds == 0)
+        req.set_expire_ts_seconds = 0;
+    else
+        req.set_expire_ts_seconds = options.set_value_ttl_seconds + utils::epoch_now();
+    req.return_check_value = options.return_check_value;
+
+    ::dsn::blob tmp_key;
+    pegasus_generate_key(tmp_key, req.hash_key, ::dsn::blob());
+    auto partition_hash = pegasus_key_hash(tmp_key);
+    auto new_callback = [user_callback = std::move(callback)](
+        ::dsn::error_code err, dsn_message_t req, dsn_message_t resp)
+    {
+        if (user_callback == nullptr) {
+            return;
+        }
+        check_and_set_results results;
+        internal_info info;
+        ::dsn::apps::check_and_set_response response;
+        if (err == ::dsn::ERR_OK) {
+            ::dsn::unmarshall(resp, response);
+            if (response.check_value_returned) {
+                results.check_value_returned = true;
+                if (response.check_value_exist) {
+                    results.check_value_exist = true;
+                    results.check_value.assign(response.check_value.data(),
+                                               response.check_value.length());
+                }
+            }
+            info.app_id = response.app_id;
+            info.partition_index = response.partition_index;
+            info.decree = response.decree;
+            info.server = response.server;
+        }
+        int ret =
+            get_client_error(err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+        if (ret == PERR_OK) {
+            results.set_succeed = true;
+        } else if (ret == PERR_TRY_AGAIN) {
+            // check not passed, it's not an error
+            ret = PERR_OK;
+        }
+        user_callback(ret, std::move(results), std::move(info));
+    };
+    _client->check_and_set(req,
+                           std::move(new_callback),
+                           std::chrono::milliseconds(timeout_milliseconds),
+                           0,
+                           partition_hash);
+}
+
+int pegasus_client_impl::check_and_mutate(const std::string &hash_key,
+                                          const std::string &check_sort_key,
+                                          cas_check_type check_type,
+                                          const std::string &check_operand,
+                                          const mutations &mutations,
+                                          const check_and_mutate_options &options,
+                                          check_and_mutate_results &results,
+                                          int timeout_milliseconds,
+                                          internal_info *info)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback = [&](int err, check_and_mutate_results &&_results, internal_info &&_info) {
+        ret = err;
+        results = std::move(_results);
+        if (info != nullptr)
+            (*info) = std::move(_info);
+        op_completed.notify();
+    };
+    async_check_and_mutate(hash_key,
+                           check_sort_key,
+                           check_type,
+                           check_operand,
+                           mutations,
+                           options,
+                           std::move(callback),
+                           timeout_milliseconds);
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::async_check_and_mutate(const std::string &hash_key,
+                                                 const std::string &check_sort_key,
+                                                 cas_check_type check_type,
+                                                 const std::string &check_operand,
+                                                 const mutations &mutations,
+                                                 const check_and_mutate_options &options,
+                                                 async_check_and_mutate_callback_t &&callback,
+                                                 int timeout_milliseconds)
+{
+    // check params
+    if (hash_key.size() >= UINT16_MAX) {
+        derror("invalid hash key: hash key length should be less than UINT16_MAX, but %d",
+               (int)hash_key.size());
+        if (callback != nullptr)
+            callback(PERR_INVALID_HASH_KEY, check_and_mutate_results(), internal_info());
+        return;
+    }
+
+    if (mutations.empty()) {
+        derror("invalid mutations: mutations should not be empty.");
+        if (callback != nullptr)
+            callback(PERR_INVALID_ARGUMENT, check_and_mutate_results(), internal_info());
+        return;
+    }
+
+    ::dsn::apps::check_and_mutate_request req;
+    req.hash_key.assign(hash_key.c_str(), 0, hash_key.size());
+    req.check_sort_key.assign(check_sort_key.c_str(), 0, check_sort_key.size());
+    req.check_type = (dsn::apps::cas_check_type::type)check_type;
+    req.check_operand.assign(check_operand.c_str(), 0, check_operand.size());
+    uint32_t epoch_now = utils::epoch_now();
+    for (const mutations::mutate &mu : mutations.get_mutations()) {
+        req.mutate_list.emplace_back();
+        ::dsn::apps::mutate &m = req.mutate_list.back();
+        m.operation = (dsn::apps::mutate_operation::type)mu.op;
+        m.sort_key.assign(mu.sort_key.c_str(), 0, mu.sort_key.size());
+        if (mu.op == mutations::MO_PUT) {
+            m.value.assign(mu.value.c_str(), 0, mu.value.size());
+            m.set_expire_ts_seconds =
+                mu.set_value_ttl_seconds == 0 ? 0 : mu.set_value_ttl_seconds + epoch_now;
+        }
+    }
+    req.return_check_value = options.return_check_value;
+
+    ::dsn::blob tmp_key;
+    pegasus_generate_key(tmp_key, req.hash_key, ::dsn::blob());
+    auto partition_hash = pegasus_key_hash(tmp_key);
+    auto new_callback = [user_callback = std::move(callback)](
+        ::dsn::error_code err, dsn_message_t req, dsn_message_t resp)
+    {
+        if (user_callback == nullptr) {
+            return;
+        }
+        check_and_mutate_results results;
+        internal_info info;
+        ::dsn::apps::check_and_mutate_response response;
+        if (err == ::dsn::ERR_OK) {
+            ::dsn::unmarshall(resp, response);
+            if (response.check_value_returned) {
+                results.check_value_returned = true;
+                if (response.check_value_exist) {
+                    results.check_value_exist = true;
+                    results.check_value.assign(response.check_value.data(),
+                                               response.check_value.length());
+                }
+            }
+            info.app_id = response.app_id;
+            info.partition_index = response.partition_index;
+            info.decree = response.decree;
+            info.server = response.server;
+        }
+        int ret =
+            get_client_error(err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+        if (ret == PERR_OK) {
+            results.mutate_succeed = true;
+        } else if (ret == PERR_TRY_AGAIN) {
+            // check not passed, it's not an error
+            ret = PERR_OK;
+        }
+        user_callback(ret, std::move(results), std::move(info));
+    };
+    _client->check_and_mutate(req,
+                              std::move(new_callback),
+                              std::chrono::milliseconds(timeout_milliseconds),
+                              0,
+                              partition_hash);
+}
+
 int pegasus_client_impl::ttl(const std::string &hash_key,
                              const std::string &sort_key,
                              int &ttl_seconds,
@@ -866,9 +1477,6 @@ int pegasus_client_impl::get_scanner(const std::string &hash_key,
     return PERR_OK;
 }
 
-DEFINE_TASK_CODE_RPC(RPC_CM_QUERY_PARTITION_CONFIG_BY_INDEX,
-                     TASK_PRIORITY_COMMON,
-                     ::dsn::THREAD_POOL_DEFAULT)
 void pegasus_client_impl::async_get_unordered_scanners(
     int max_split_count,
     const scan_options &options,
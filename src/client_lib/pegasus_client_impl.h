@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <string>
 #include <pegasus/client.h>
 #include <rrdb/rrdb.client.h>
 #include "base/pegasus_key_schema.h"
+#include "base/pegasus_scan_aggregator.h"
 #include "base/pegasus_utils.h"
 
 namespace pegasus {
@@ -94,6 +97,15 @@ public:
                                  int max_fetch_size = 1000000,
                                  int timeout_milliseconds = 5000) override;
 
+    virtual int get_multi_get_pager(const std::string &hashkey,
+                                    const std::string &start_sortkey,
+                                    const std::string &stop_sortkey,
+                                    const multi_get_options &options,
+                                    multi_get_pager *&pager,
+                                    int max_fetch_count = 100,
+                                    int max_fetch_size = 1000000,
+                                    int timeout_milliseconds = 5000) override;
+
     virtual int multi_get_sortkeys(const std::string &hashkey,
                                    std::set<std::string> &sortkeys,
                                    int max_fetch_count = 100,
@@ -107,6 +119,14 @@ public:
                                           int max_fetch_size = 1000000,
                                           int timeout_milliseconds = 5000) override;
 
+    virtual int batch_get(const std::vector<std::pair<std::string, std::string>> &keys,
+                          std::map<std::pair<std::string, std::string>, std::string> &values,
+                          int timeout_milliseconds = 5000) override;
+
+    virtual void async_batch_get(const std::vector<std::pair<std::string, std::string>> &keys,
+                                 async_batch_get_callback_t &&callback = nullptr,
+                                 int timeout_milliseconds = 5000) override;
+
     virtual int exist(const std::string &hashkey,
                       const std::string &sortkey,
                       int timeout_milliseconds = 5000,
@@ -117,6 +137,11 @@ public:
                               int timeout_milliseconds = 5000,
                               internal_info *info = NULL) override;
 
+    virtual int approximate_sortkey_count(const std::string &hashkey,
+                                          int64_t &count,
+                                          int timeout_milliseconds = 5000,
+                                          internal_info *info = NULL) override;
+
     virtual int del(const std::string &hashkey,
                     const std::string &sortkey,
                     int timeout_milliseconds = 5000,
@@ -138,6 +163,75 @@ public:
                                  async_multi_del_callback_t &&callback = nullptr,
                                  int timeout_milliseconds = 5000) override;
 
+    virtual int del_range(const std::string &hashkey,
+                          const std::string &start_sortkey,
+                          const std::string &stop_sortkey,
+                          bool start_inclusive = true,
+                          bool stop_inclusive = false,
+                          int timeout_milliseconds = 5000,
+                          internal_info *info = NULL) override;
+
+    virtual void async_del_range(const std::string &hashkey,
+                                 const std::string &start_sortkey,
+                                 const std::string &stop_sortkey,
+                                 bool start_inclusive,
+                                 bool stop_inclusive,
+                                 async_del_callback_t &&callback = nullptr,
+                                 int timeout_milliseconds = 5000) override;
+
+    virtual int incr(const std::string &hashkey,
+                     const std::string &sortkey,
+                     int64_t increment,
+                     int64_t &new_value,
+                     int timeout_milliseconds = 5000,
+                     internal_info *info = NULL) override;
+
+    virtual void async_incr(const std::string &hashkey,
+                            const std::string &sortkey,
+                            int64_t increment,
+                            async_incr_callback_t &&callback = nullptr,
+                            int timeout_milliseconds = 5000) override;
+
+    virtual int check_and_set(const std::string &hash_key,
+                              const std::string &check_sort_key,
+                              cas_check_type check_type,
+                              const std::string &check_operand,
+                              const std::string &set_sort_key,
+                              const std::string &set_value,
+                              const check_and_set_options &options,
+                              check_and_set_results &results,
+                              int timeout_milliseconds = 5000,
+                              internal_info *info = NULL) override;
+
+    virtual void async_check_and_set(const std::string &hash_key,
+                                     const std::string &check_sort_key,
+                                     cas_check_type check_type,
+                                     const std::string &check_operand,
+                                     const std::string &set_sort_key,
+                                     const std::string &set_value,
+                                     const check_and_set_options &options,
+                                     async_check_and_set_callback_t &&callback = nullptr,
+                                     int timeout_milliseconds = 5000) override;
+
+    virtual int check_and_mutate(const std::string &hash_key,
+                                 const std::string &check_sort_key,
+                                 cas_check_type check_type,
+                                 const std::string &check_operand,
+                                 const mutations &mutations,
+                                 const check_and_mutate_options &options,
+                                 check_and_mutate_results &results,
+                                 int timeout_milliseconds = 5000,
+                                 internal_info *info = NULL) override;
+
+    virtual void async_check_and_mutate(const std::string &hash_key,
+                                        const std::string &check_sort_key,
+                                        cas_check_type check_type,
+                                        const std::string &check_operand,
+                                        const mutations &mutations,
+                                        const check_and_mutate_options &options,
+                                        async_check_and_mutate_callback_t &&callback = nullptr,
+                                        int timeout_milliseconds = 5000) override;
+
     virtual int ttl(const std::string &hashkey,
                     const std::string &sortkey,
                     int &ttl_seconds,
@@ -179,6 +273,10 @@ public:
 
         void async_next(async_scan_next_callback_t &&) override;
 
+        int aggregate(int top_count, scan_aggregate &result, internal_info *info = NULL) override;
+
+        void async_aggregate(int top_count, async_scan_aggregate_callback_t &&callback) override;
+
         bool safe_destructible() const override;
 
         pegasus_scanner_wrapper get_smart_wrapper() override;
@@ -205,17 +303,52 @@ public:
         std::vector<::dsn::apps::key_value> _kvs;
         internal_info _info;
         int32_t _p;
+        // the last key returned in this split, from which the scan restarts if the context
+        // is lost. it is kept over the empty batches returned when the server limits are reached
+        ::dsn::blob _last_key;
+        // batch size of the next RPC call, adapted to the observed response size
+        int32_t _batch_size;
+        // the batches fetched ahead of _kvs if prefetch is enabled
+        std::deque<std::vector<::dsn::apps::key_value>> _prefetched;
+        int64_t _prefetched_bytes;
 
         int64_t _context;
         mutable ::dsn::service::zlock _lock;
         std::list<async_scan_next_callback_t> _queue;
         volatile bool _rpc_started;
 
+        // not null during async_aggregate(), which merges the aggregates of the scan rpcs
+        std::unique_ptr<pegasus_scan_aggregator> _aggregator;
+        int _aggregate_top_count;
+        async_scan_aggregate_callback_t _aggregate_callback;
+
+        // shared with the scan rpcs in flight, as a prefetch rpc may be responded after the
+        // scanner is destroyed
+        struct rpc_guard
+        {
+            ::dsn::service::zlock lock;
+            pegasus_scanner_impl *scanner; // null after the scanner is destroyed
+            ::dsn::apps::rrdb_client *client;
+        };
+        std::shared_ptr<rpc_guard> _rpc_guard;
+
         void _async_next_internal();
         void _start_scan();
         void _next_batch();
+        void _try_prefetch();
         void _on_scan_response(::dsn::error_code, dsn_message_t, dsn_message_t);
+        void _on_scan_response(::dsn::error_code err, ::dsn::apps::scan_response &&response);
+        void _update_info(::dsn::error_code err, const ::dsn::apps::scan_response &response);
+        void _push_batch(::dsn::apps::scan_response &response);
+        static void _on_guarded_scan_response(const std::shared_ptr<rpc_guard> &guard,
+                                              uint64_t hash,
+                                              ::dsn::error_code err,
+                                              dsn_message_t resp);
         void _split_reset();
+        void _adapt_batch_size(const std::vector<::dsn::apps::key_value> &kvs);
+        void _aggregate_next();
+        void _merge_aggregate(::dsn::apps::scan_response &response);
+        void _on_aggregate_done(int ret);
 
     private:
         static const char _holder[];
@@ -223,6 +356,39 @@ public:
         static const ::dsn::blob _max;
     };
 
+    class pegasus_multi_get_pager_impl : public multi_get_pager
+    {
+    public:
+        int next_page(std::map<std::string, std::string> &values,
+                      internal_info *info = NULL) override;
+
+        pegasus_multi_get_pager_impl(::dsn::apps::rrdb_client *client,
+                                     const std::string &hash_key,
+                                     const std::string &start_sortkey,
+                                     const std::string &stop_sortkey,
+                                     const multi_get_options &options,
+                                     int max_fetch_count,
+                                     int max_fetch_size,
+                                     int timeout_milliseconds);
+
+    private:
+        // move the range to the rest of it after an incomplete page
+        int _resume(const ::dsn::apps::multi_get_response &response);
+
+    private:
+        ::dsn::apps::rrdb_client *_client;
+        std::string _hash_key;
+        // the rest of the sort key range, narrowed after each page
+        std::string _start_sortkey;
+        std::string _stop_sortkey;
+        multi_get_options _options;
+        int _max_fetch_count;
+        int _max_fetch_size;
+        int _timeout_milliseconds;
+        uint64_t _partition_hash;
+        bool _completed;
+    };
+
 private:
     class pegasus_scanner_impl_wrapper : public abstract_pegasus_scanner
     {
@@ -240,8 +406,21 @@ private:
         {
             return _p->next(hashkey, sortkey, value, info);
         }
+
+        void async_aggregate(int top_count, async_scan_aggregate_callback_t &&callback) override;
+
+        int aggregate(int top_count, scan_aggregate &result, internal_info *info) override
+        {
+            return _p->aggregate(top_count, result, info);
+        }
     };
 
+    // group the keys by partition and send one batch_get rpc to each partition.
+    void batch_get_by_partition(int partition_count,
+                                const std::vector<std::pair<std::string, std::string>> &keys,
+                                async_batch_get_callback_t &&callback,
+                                int timeout_milliseconds);
+
     static int get_client_error(int server_error);
     static int get_rocksdb_server_error(int rocskdb_error);
 
@@ -252,6 +431,9 @@ private:
     ::dsn::rpc_address _server_uri_address;
     ::dsn::rpc_address _meta_server;
     ::dsn::apps::rrdb_client *_client;
+    // partition count of the app, queried from meta server on the first batch_get.
+    // 0 means unknown.
+    std::atomic<int> _partition_count;
 
     ///
     /// \brief _client_error_to_string
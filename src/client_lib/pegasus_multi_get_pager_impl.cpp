@@ -0,0 +1,145 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "pegasus_client_impl.h"
+
+using namespace ::dsn;
+
+namespace pegasus {
+namespace client {
+
+pegasus_client_impl::pegasus_multi_get_pager_impl::pegasus_multi_get_pager_impl(
+    ::dsn::apps::rrdb_client *client,
+    const std::string &hash_key,
+    const std::string &start_sortkey,
+    const std::string &stop_sortkey,
+    const multi_get_options &options,
+    int max_fetch_count,
+    int max_fetch_size,
+    int timeout_milliseconds)
+    : _client(client),
+      _hash_key(hash_key),
+      _start_sortkey(start_sortkey),
+      _stop_sortkey(stop_sortkey),
+      _options(options),
+      _max_fetch_count(max_fetch_count),
+      _max_fetch_size(max_fetch_size),
+      _timeout_milliseconds(timeout_milliseconds),
+      _completed(false)
+{
+    ::dsn::blob tmp_key;
+    pegasus_generate_key(tmp_key, _hash_key, std::string());
+    _partition_hash = pegasus_key_hash(tmp_key);
+}
+
+int pegasus_client_impl::pegasus_multi_get_pager_impl::next_page(
+    std::map<std::string, std::string> &values, internal_info *info)
+{
+    values.clear();
+    if (_completed) {
+        return PERR_SCAN_COMPLETE;
+    }
+
+    ::dsn::apps::multi_get_request req;
+    req.hash_key = ::dsn::blob(_hash_key.data(), 0, _hash_key.size());
+    req.start_sortkey = ::dsn::blob(_start_sortkey.data(), 0, _start_sortkey.size());
+    req.stop_sortkey = ::dsn::blob(_stop_sortkey.data(), 0, _stop_sortkey.size());
+    req.start_inclusive = _options.start_inclusive;
+    req.stop_inclusive = _options.stop_inclusive;
+    req.max_kv_count = _max_fetch_count;
+    req.max_kv_size = _max_fetch_size;
+    req.no_value = _options.no_value;
+    req.reverse = _options.reverse;
+    req.sort_key_filter_type = (dsn::apps::filter_type::type)_options.sort_key_filter_type;
+    req.sort_key_filter_pattern = ::dsn::blob(
+        _options.sort_key_filter_pattern.data(), 0, _options.sort_key_filter_pattern.size());
+
+    ::dsn::utils::notify_event op_completed;
+    ::dsn::error_code err;
+    ::dsn::apps::multi_get_response response;
+    _client->multi_get(req,
+                       [&](::dsn::error_code ec, dsn_message_t, dsn_message_t resp) {
+                           err = ec;
+                           if (ec == ::dsn::ERR_OK) {
+                               ::unmarshall(resp, response);
+                           }
+                           op_completed.notify();
+                       },
+                       std::chrono::milliseconds(_timeout_milliseconds),
+                       0,
+                       _partition_hash);
+    op_completed.wait();
+
+    if (err != ::dsn::ERR_OK) {
+        return get_client_error(int(err));
+    }
+    if (info != nullptr) {
+        info->app_id = response.app_id;
+        info->partition_index = response.partition_index;
+        info->server = response.server;
+    }
+    int ret = get_client_error(get_rocksdb_server_error(response.error));
+    if (ret == PERR_OK) {
+        // the last page
+        _completed = true;
+    } else if (ret == PERR_INCOMPLETE) {
+        ret = _resume(response);
+    }
+    if (ret == PERR_OK) {
+        for (auto &kv : response.kvs) {
+            values.emplace(std::string(kv.key.data(), kv.key.length()),
+                           std::string(kv.value.data(), kv.value.length()));
+        }
+    }
+    return ret;
+}
+
+int pegasus_client_impl::pegasus_multi_get_pager_impl::_resume(
+    const ::dsn::apps::multi_get_response &response)
+{
+    if (response.__isset.resume_sortkey) {
+        std::string resume(response.resume_sortkey.data(), response.resume_sortkey.length());
+        if (!_options.reverse) {
+            _start_sortkey = std::move(resume);
+            _options.start_inclusive = true;
+        } else if (!resume.empty()) {
+            _stop_sortkey = std::move(resume);
+            _options.stop_inclusive = true;
+        } else {
+            // the empty stop sort key means no limit, so only the empty sort key is left
+            // as ["", "\0")
+            _start_sortkey.clear();
+            _options.start_inclusive = true;
+            _stop_sortkey.assign(1, '\0');
+            _options.stop_inclusive = false;
+        }
+        return PERR_OK;
+    }
+
+    // the old servers return no resume_sortkey, so resume after the last record returned,
+    // which iterates again the records expired or filtered out after it
+    if (response.kvs.empty()) {
+        derror("no resume_sortkey and no record returned by %s, can not resume multi_get",
+               response.server.c_str());
+        return PERR_INCOMPLETE;
+    }
+    if (!_options.reverse) {
+        const ::dsn::blob &last = response.kvs.back().key;
+        _start_sortkey.assign(last.data(), last.length());
+        _options.start_inclusive = false;
+    } else {
+        // the records are ascending ordered even if reverse
+        const ::dsn::blob &last = response.kvs.front().key;
+        if (last.length() == 0) {
+            // no sort key is less than the empty one
+            _completed = true;
+        } else {
+            _stop_sortkey.assign(last.data(), last.length());
+            _options.stop_inclusive = false;
+        }
+    }
+    return PERR_OK;
+}
+}
+} // namespace
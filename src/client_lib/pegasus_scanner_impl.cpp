@@ -11,6 +11,18 @@ using namespace pegasus;
 namespace pegasus {
 namespace client {
 
+// the target response size to adapt the batch size to, if not given by scan_options
+static const int64_t DEFAULT_TARGET_RESPONSE_BYTES = 1024 * 1024;
+
+static int64_t kvs_bytes(const std::vector<::dsn::apps::key_value> &kvs)
+{
+    int64_t bytes = 0;
+    for (const auto &kv : kvs) {
+        bytes += kv.key.length() + kv.value.length();
+    }
+    return bytes;
+}
+
 pegasus_client_impl::pegasus_scanner_impl::pegasus_scanner_impl(::dsn::apps::rrdb_client *client,
                                                                 std::vector<uint64_t> &&hash,
                                                                 const scan_options &options)
@@ -31,9 +43,15 @@ pegasus_client_impl::pegasus_scanner_impl::pegasus_scanner_impl(::dsn::apps::rrd
       _options(options),
       _splits_hash(std::move(hash)),
       _p(-1),
+      _batch_size(options.batch_size),
+      _prefetched_bytes(0),
       _context(SCAN_CONTEXT_ID_COMPLETED),
-      _rpc_started(false)
+      _rpc_started(false),
+      _aggregate_top_count(0),
+      _rpc_guard(std::make_shared<rpc_guard>())
 {
+    _rpc_guard->scanner = this;
+    _rpc_guard->client = client;
 }
 
 int pegasus_client_impl::pegasus_scanner_impl::next(std::string &hashkey,
@@ -74,10 +92,62 @@ void pegasus_client_impl::pegasus_scanner_impl::async_next(async_scan_next_callb
     }
 }
 
+int pegasus_client_impl::pegasus_scanner_impl::aggregate(int top_count,
+                                                         scan_aggregate &result,
+                                                         internal_info *info)
+{
+    ::dsn::utils::notify_event op_completed;
+    int ret = -1;
+    auto callback = [&](int err, scan_aggregate &&aggregate, internal_info &&ii) {
+        ret = err;
+        result = std::move(aggregate);
+        if (info) {
+            (*info) = std::move(ii);
+        }
+        op_completed.notify();
+    };
+    async_aggregate(top_count, std::move(callback));
+    op_completed.wait();
+    return ret;
+}
+
+void pegasus_client_impl::pegasus_scanner_impl::async_aggregate(
+    int top_count, async_scan_aggregate_callback_t &&callback)
+{
+    bool rpc_started;
+    {
+        ::dsn::service::zauto_lock l(_lock);
+        dassert(_queue.empty() && _aggregator == nullptr,
+                "aggregate should not be called concurrently with next or aggregate");
+        _aggregator.reset(new pegasus_scan_aggregator(top_count, false));
+        _aggregate_top_count = top_count;
+        _aggregate_callback = std::move(callback);
+
+        // the rest k-v of the current batch and the prefetched ones
+        for (++_p; _p < _kvs.size(); ++_p) {
+            _aggregator->add_row(dsn::string_view(_kvs[_p].key.data(), _kvs[_p].key.length()),
+                                 _kvs[_p].value.length());
+        }
+        for (const auto &kvs : _prefetched) {
+            for (const auto &kv : kvs) {
+                _aggregator->add_row(dsn::string_view(kv.key.data(), kv.key.length()),
+                                     kv.value.length());
+            }
+        }
+        _prefetched.clear();
+        _prefetched_bytes = 0;
+        rpc_started = _rpc_started;
+    }
+    if (!rpc_started) {
+        // otherwise continued when the prefetch rpc in flight responded
+        _aggregate_next();
+    }
+}
+
 bool pegasus_client_impl::pegasus_scanner_impl::safe_destructible() const
 {
     ::dsn::service::zauto_lock l(_lock);
-    return _queue.empty();
+    return _queue.empty() && _aggregator == nullptr;
 }
 
 pegasus_client::pegasus_scanner_wrapper
@@ -95,6 +165,19 @@ void pegasus_client_impl::pegasus_scanner_impl::_async_next_internal()
     std::list<async_scan_next_callback_t> temp;
     while (true) {
         while (++_p >= _kvs.size()) {
+            if (!_prefetched.empty()) {
+                _kvs = std::move(_prefetched.front());
+                _prefetched.pop_front();
+                _prefetched_bytes -= kvs_bytes(_kvs);
+                _p = -1;
+                _try_prefetch();
+                continue;
+            }
+            if (_rpc_started) {
+                // the prefetch rpc in flight will continue when responded
+                _lock.unlock();
+                return;
+            }
             if (_context == SCAN_CONTEXT_ID_COMPLETED) {
                 // reach the end of one partition
                 if (_splits_hash.empty()) {
@@ -161,35 +244,133 @@ void pegasus_client_impl::pegasus_scanner_impl::_async_next_internal()
     }
 }
 
+// the scan rpcs of aggregate are sent one by one, so no lock is needed
+void pegasus_client_impl::pegasus_scanner_impl::_aggregate_next()
+{
+    while (_context == SCAN_CONTEXT_ID_COMPLETED) {
+        if (_splits_hash.empty()) {
+            // all completed
+            _on_aggregate_done(PERR_OK);
+            return;
+        }
+        _hash = _splits_hash.back();
+        _splits_hash.pop_back();
+        _split_reset();
+    }
+    if (_context == SCAN_CONTEXT_ID_NOT_EXIST) {
+        _start_scan();
+    } else {
+        _next_batch();
+    }
+}
+
+void pegasus_client_impl::pegasus_scanner_impl::_merge_aggregate(
+    ::dsn::apps::scan_response &response)
+{
+    if (response.kvs.empty()) {
+        _aggregator->merge(response.aggregate);
+        if (response.aggregate.last_key.length() > 0) {
+            _last_key = response.aggregate.last_key;
+        }
+    } else {
+        // the servers not supporting aggregate return the k-v, which are aggregated here
+        for (const auto &kv : response.kvs) {
+            _aggregator->add_row(dsn::string_view(kv.key.data(), kv.key.length()),
+                                 kv.value.length());
+        }
+        _last_key = response.kvs.back().key;
+    }
+    _context = response.context_id;
+}
+
+void pegasus_client_impl::pegasus_scanner_impl::_on_aggregate_done(int ret)
+{
+    ::dsn::apps::scan_aggregate result;
+    _aggregator->finish(result);
+    async_scan_aggregate_callback_t callback = std::move(_aggregate_callback);
+    internal_info info(_info);
+    if (ret == PERR_OK) {
+        info.app_id = -1;
+        info.partition_index = -1;
+        info.decree = -1;
+    }
+    {
+        ::dsn::service::zauto_lock l(_lock);
+        _aggregator.reset();
+    }
+    // ATTENTION: after the aggregator is reset, member variables can not be used anymore
+
+    if (callback) {
+        scan_aggregate aggregate;
+        aggregate.row_count = result.row_count;
+        aggregate.hash_key_count = result.hash_key_count;
+        aggregate.sort_key_count_max = result.sort_key_count_max;
+        aggregate.hash_key_size_sum = result.hash_key_size_sum;
+        aggregate.hash_key_size_max = result.hash_key_size_max;
+        aggregate.sort_key_size_sum = result.sort_key_size_sum;
+        aggregate.sort_key_size_max = result.sort_key_size_max;
+        aggregate.value_size_sum = result.value_size_sum;
+        aggregate.value_size_max = result.value_size_max;
+        aggregate.row_size_max = result.row_size_max;
+        for (const auto &row : result.top_rows) {
+            aggregate.top_rows.emplace_back();
+            aggregate.top_rows.back().hash_key = row.hash_key.to_string();
+            aggregate.top_rows.back().sort_key = row.sort_key.to_string();
+            aggregate.top_rows.back().size = row.size;
+        }
+        for (const auto &stat : result.top_hash_keys) {
+            aggregate.top_hash_keys.emplace_back();
+            aggregate.top_hash_keys.back().hash_key = stat.hash_key.to_string();
+            aggregate.top_hash_keys.back().sort_key_count = stat.sort_key_count;
+            aggregate.top_hash_keys.back().size = stat.size;
+        }
+        callback(ret, std::move(aggregate), std::move(info));
+    }
+}
+
 void pegasus_client_impl::pegasus_scanner_impl::_next_batch()
 {
     ::dsn::apps::scan_request req;
     req.context_id = _context;
+    req.batch_size = _batch_size;
 
     dassert(!_rpc_started, "");
     _rpc_started = true;
     _client->scan(req,
-                  [this](::dsn::error_code err, dsn_message_t req, dsn_message_t resp) mutable {
-                      _on_scan_response(err, req, resp);
+                  [ guard = _rpc_guard, hash = _hash ](
+                      ::dsn::error_code err, dsn_message_t req, dsn_message_t resp) {
+                      _on_guarded_scan_response(guard, hash, err, resp);
                   },
                   std::chrono::milliseconds(_options.timeout_ms),
                   0,
                   _hash);
 }
 
+// _lock is held
+void pegasus_client_impl::pegasus_scanner_impl::_try_prefetch()
+{
+    if (_options.prefetch_batch_count <= 0 || _rpc_started || _aggregator != nullptr ||
+        _context < SCAN_CONTEXT_ID_VALID_MIN ||
+        (int)_prefetched.size() >= _options.prefetch_batch_count ||
+        (_options.prefetch_max_bytes > 0 && _prefetched_bytes >= _options.prefetch_max_bytes)) {
+        return;
+    }
+    _next_batch();
+}
+
 void pegasus_client_impl::pegasus_scanner_impl::_start_scan()
 {
     ::dsn::apps::get_scanner_request req;
-    if (_kvs.empty()) {
+    if (_last_key.length() == 0) {
         req.start_key = _start_key;
         req.start_inclusive = _options.start_inclusive;
     } else {
-        req.start_key = _kvs.back().key;
+        req.start_key = _last_key;
         req.start_inclusive = false;
     }
     req.stop_key = _stop_key;
     req.stop_inclusive = _options.stop_inclusive;
-    req.batch_size = _options.batch_size;
+    req.batch_size = _batch_size;
     req.hash_key_filter_type = (dsn::apps::filter_type::type)_options.hash_key_filter_type;
     req.hash_key_filter_pattern = ::dsn::blob(
         _options.hash_key_filter_pattern.data(), 0, _options.hash_key_filter_pattern.size());
@@ -197,6 +378,12 @@ void pegasus_client_impl::pegasus_scanner_impl::_start_scan()
     req.sort_key_filter_pattern = ::dsn::blob(
         _options.sort_key_filter_pattern.data(), 0, _options.sort_key_filter_pattern.size());
     req.no_value = _options.no_value;
+    req.max_iteration_count = _options.max_iteration_count;
+    req.max_iteration_time_ms = _options.max_iteration_time_ms;
+    req.max_response_bytes = _options.max_response_bytes;
+    req.full_scan = _options.full_scan;
+    req.aggregate = (_aggregator != nullptr);
+    req.aggregate_top_count = _aggregate_top_count;
 
     dassert(!_rpc_started, "");
     _rpc_started = true;
@@ -209,43 +396,102 @@ void pegasus_client_impl::pegasus_scanner_impl::_start_scan()
                          _hash);
 }
 
+// the scan rpc may be sent for prefetching with no one waiting for the response, in which case
+// the scanner may be destroyed before the response
+/*static*/ void pegasus_client_impl::pegasus_scanner_impl::_on_guarded_scan_response(
+    const std::shared_ptr<rpc_guard> &guard,
+    uint64_t hash,
+    ::dsn::error_code err,
+    dsn_message_t resp)
+{
+    ::dsn::apps::scan_response response;
+    if (err == ERR_OK) {
+        ::dsn::unmarshall(resp, response);
+    }
+
+    guard->lock.lock();
+    pegasus_scanner_impl *scanner = guard->scanner;
+    if (scanner == nullptr) {
+        guard->lock.unlock();
+        if (err == ERR_OK && response.error == 0 &&
+            response.context_id >= SCAN_CONTEXT_ID_VALID_MIN) {
+            guard->client->clear_scanner(response.context_id, 0, hash);
+        }
+        return;
+    }
+
+    scanner->_lock.lock();
+    if (!scanner->_queue.empty() || scanner->_aggregator != nullptr) {
+        // some one is waiting for the response, so the scanner is alive until it is handled
+        scanner->_lock.unlock();
+        guard->lock.unlock();
+        scanner->_on_scan_response(err, std::move(response));
+        return;
+    }
+
+    // no one is waiting, buffer the k-v and go on prefetching. the scanner can not be
+    // destroyed until the guard is unlocked
+    scanner->_rpc_started = false;
+    scanner->_update_info(err, response);
+    if (err == ERR_OK && response.error == 0) {
+        scanner->_push_batch(response);
+        scanner->_try_prefetch();
+    } else {
+        // the scan restarts from the last key when the buffered k-v are consumed
+        scanner->_context = SCAN_CONTEXT_ID_NOT_EXIST;
+    }
+    scanner->_lock.unlock();
+    guard->lock.unlock();
+}
+
 void pegasus_client_impl::pegasus_scanner_impl::_on_scan_response(::dsn::error_code err,
                                                                   dsn_message_t req,
                                                                   dsn_message_t resp)
 {
-    dassert(_rpc_started, "");
-    _rpc_started = false;
     ::dsn::apps::scan_response response;
     if (err == ERR_OK) {
         ::dsn::unmarshall(resp, response);
-        _info.app_id = response.app_id;
-        _info.partition_index = response.partition_index;
-        _info.decree = -1;
-        _info.server = response.server;
+    }
+    _on_scan_response(err, std::move(response));
+}
 
+void pegasus_client_impl::pegasus_scanner_impl::_on_scan_response(
+    ::dsn::error_code err, ::dsn::apps::scan_response &&response)
+{
+    dassert(_rpc_started, "");
+    _rpc_started = false;
+    _update_info(err, response);
+    if (err == ERR_OK) {
         if (response.error == 0) {
+            if (_aggregator != nullptr) {
+                _merge_aggregate(response);
+                _aggregate_next();
+                return;
+            }
             _lock.lock();
-            _kvs = std::move(response.kvs);
-            _p = -1;
-            _context = response.context_id;
+            _push_batch(response);
             _async_next_internal();
             return;
         } else if (get_rocksdb_server_error(response.error) == PERR_NOT_FOUND) {
+            if (_aggregator != nullptr) {
+                _context = SCAN_CONTEXT_ID_NOT_EXIST;
+                _aggregate_next();
+                return;
+            }
             _lock.lock();
             _context = SCAN_CONTEXT_ID_NOT_EXIST;
             _async_next_internal();
             return;
         }
-    } else {
-        _info.app_id = -1;
-        _info.partition_index = -1;
-        _info.decree = -1;
-        _info.server = "";
     }
 
     // error occured
     auto ret =
         get_client_error(err == ERR_OK ? get_rocksdb_server_error(response.error) : int(err));
+    if (_aggregator != nullptr) {
+        _on_aggregate_done(ret);
+        return;
+    }
     internal_info info = _info;
     std::list<async_scan_next_callback_t> temp;
     _lock.lock();
@@ -260,22 +506,68 @@ void pegasus_client_impl::pegasus_scanner_impl::_on_scan_response(::dsn::error_c
     }
 }
 
+void pegasus_client_impl::pegasus_scanner_impl::_update_info(
+    ::dsn::error_code err, const ::dsn::apps::scan_response &response)
+{
+    if (err == ERR_OK) {
+        _info.app_id = response.app_id;
+        _info.partition_index = response.partition_index;
+        _info.decree = -1;
+        _info.server = response.server;
+    } else {
+        _info.app_id = -1;
+        _info.partition_index = -1;
+        _info.decree = -1;
+        _info.server = "";
+    }
+}
+
+// _lock is held
+void pegasus_client_impl::pegasus_scanner_impl::_push_batch(::dsn::apps::scan_response &response)
+{
+    if (!response.kvs.empty()) {
+        _last_key = response.kvs.back().key;
+        _adapt_batch_size(response.kvs);
+        _prefetched_bytes += kvs_bytes(response.kvs);
+        _prefetched.emplace_back(std::move(response.kvs));
+    }
+    _context = response.context_id;
+}
+
 void pegasus_client_impl::pegasus_scanner_impl::_split_reset()
 {
     _kvs.clear();
+    _prefetched.clear();
+    _prefetched_bytes = 0;
     _p = -1;
+    _last_key = ::dsn::blob();
     _context = SCAN_CONTEXT_ID_NOT_EXIST;
 }
 
+void pegasus_client_impl::pegasus_scanner_impl::_adapt_batch_size(
+    const std::vector<::dsn::apps::key_value> &kvs)
+{
+    int64_t average_bytes = std::max<int64_t>(kvs_bytes(kvs) / kvs.size(), 1);
+    int64_t target_bytes = _options.max_response_bytes > 0 ? _options.max_response_bytes
+                                                           : DEFAULT_TARGET_RESPONSE_BYTES;
+    _batch_size = (int32_t)std::max<int64_t>(
+        std::min<int64_t>(target_bytes / average_bytes, _options.batch_size), 1);
+}
+
 pegasus_client_impl::pegasus_scanner_impl::~pegasus_scanner_impl()
 {
+    {
+        dsn::service::zauto_lock l(_rpc_guard->lock);
+        _rpc_guard->scanner = nullptr;
+    }
+
     dsn::service::zauto_lock l(_lock);
 
-    dassert(!_rpc_started, "all scan-rpc should be completed here");
+    // only a prefetch rpc may be in flight here, whose context is cleared when responded
     dassert(_queue.empty(), "queue should be empty");
 
     if (_client) {
-        if (_context >= SCAN_CONTEXT_ID_VALID_MIN)
+        if (!_rpc_started && _context >= SCAN_CONTEXT_ID_VALID_MIN)
             _client->clear_scanner(_context, 0, _hash);
         _client = nullptr;
     }
@@ -298,6 +590,18 @@ void pegasus_client_impl::pegasus_scanner_impl_wrapper::async_next(
     });
 }
 
+void pegasus_client_impl::pegasus_scanner_impl_wrapper::async_aggregate(
+    int top_count, async_scan_aggregate_callback_t &&callback)
+{
+    // wrap shared_ptr _p with callback
+    _p->async_aggregate(
+        top_count,
+        [ __p = _p, user_callback = std::move(callback) ](
+            int error_code, scan_aggregate &&aggregate, internal_info &&info) {
+            user_callback(error_code, std::move(aggregate), std::move(info));
+        });
+}
+
 const char pegasus_client_impl::pegasus_scanner_impl::_holder[] = {'\x00', '\x00', '\xFF', '\xFF'};
 const ::dsn::blob pegasus_client_impl::pegasus_scanner_impl::_min = ::dsn::blob(_holder, 0, 2);
 const ::dsn::blob pegasus_client_impl::pegasus_scanner_impl::_max = ::dsn::blob(_holder, 2, 2);
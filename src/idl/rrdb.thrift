@@ -10,6 +10,42 @@ enum filter_type
     FT_MATCH_POSTFIX
 }
 
+enum cas_check_type
+{
+    CT_NO_CHECK,
+
+    // appearance
+    CT_VALUE_NOT_EXIST,               // value is not exist
+    CT_VALUE_NOT_EXIST_OR_EMPTY,      // value is not exist or value is empty
+    CT_VALUE_EXIST,                   // value is exist
+    CT_VALUE_NOT_EMPTY,               // value is exist and not empty
+
+    // match
+    CT_VALUE_MATCH_ANYWHERE,          // operand matches anywhere in value
+    CT_VALUE_MATCH_PREFIX,            // operand matches prefix in value
+    CT_VALUE_MATCH_POSTFIX,           // operand matches postfix in value
+
+    // bytes compare
+    CT_VALUE_BYTES_LESS,              // bytes compare: value < operand
+    CT_VALUE_BYTES_LESS_OR_EQUAL,     // bytes compare: value <= operand
+    CT_VALUE_BYTES_EQUAL,             // bytes compare: value == operand
+    CT_VALUE_BYTES_GREATER_OR_EQUAL,  // bytes compare: value >= operand
+    CT_VALUE_BYTES_GREATER,           // bytes compare: value > operand
+
+    // int compare: first transfer bytes to int64; then compare by int value
+    CT_VALUE_INT_LESS,                // int compare: value < operand
+    CT_VALUE_INT_LESS_OR_EQUAL,       // int compare: value <= operand
+    CT_VALUE_INT_EQUAL,               // int compare: value == operand
+    CT_VALUE_INT_GREATER_OR_EQUAL,    // int compare: value >= operand
+    CT_VALUE_INT_GREATER              // int compare: value > operand
+}
+
+enum mutate_operation
+{
+    MO_PUT,
+    MO_DELETE
+}
+
 struct update_request
 {
     1:dsn.blob      key;
@@ -106,6 +142,37 @@ struct multi_get_response
     3:i32           app_id;
     4:i32           partition_index;
     6:string        server;
+    // valid if error is kIncomplete: the sort key of the first record not yet iterated, from
+    // which the next request can resume as the inclusive start_sortkey (or the inclusive
+    // stop_sortkey if reverse), without iterating again the records expired or filtered out
+    7:dsn.blob      resume_sortkey;
+}
+
+struct full_key
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      sort_key;
+}
+
+struct batch_get_request
+{
+    1:list<full_key> keys; // should not be empty, keys may have different hash_keys
+}
+
+struct full_data
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      sort_key;
+    3:dsn.blob      value;
+}
+
+struct batch_get_response
+{
+    1:i32           error;
+    2:list<full_data> data; // only contains the keys found, in the same order as request
+    3:i32           app_id;
+    4:i32           partition_index;
+    5:string        server;
 }
 
 struct incr_request
@@ -114,6 +181,84 @@ struct incr_request
     2:i64           increment;
 }
 
+struct incr_response
+{
+    1:i32           error;
+    2:i64           new_value;
+    3:i32           app_id;
+    4:i32           partition_index;
+    5:i64           decree;
+    6:string        server;
+}
+
+struct check_and_set_request
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      check_sort_key;
+    3:cas_check_type check_type;
+    4:dsn.blob      check_operand;
+    5:bool          set_diff_sort_key; // if false, use check_sort_key as set_sort_key
+    6:dsn.blob      set_sort_key; // used only if set_diff_sort_key is true
+    7:dsn.blob      set_value;
+    8:i32           set_expire_ts_seconds;
+    9:bool          return_check_value;
+}
+
+struct check_and_set_response
+{
+    1:i32           error; // return kTryAgain if check not passed.
+                           // return kInvalidArgument if check type is int compare and
+                           // check_operand/check_value is not integer or out of range.
+    2:bool          check_value_returned;
+    3:bool          check_value_exist; // used only if check_value_returned is true
+    4:dsn.blob      check_value; // used only if check_value_returned and check_value_exist is true
+    5:i32           app_id;
+    6:i32           partition_index;
+    7:i64           decree;
+    8:string        server;
+}
+
+struct mutate
+{
+    1:mutate_operation operation;
+    2:dsn.blob      sort_key;
+    3:dsn.blob      value; // set null if operation is MO_DELETE
+    4:i32           set_expire_ts_seconds; // set 0 if operation is MO_DELETE
+}
+
+struct check_and_mutate_request
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      check_sort_key;
+    3:cas_check_type check_type;
+    4:dsn.blob      check_operand;
+    5:list<mutate>  mutate_list;
+    6:bool          return_check_value;
+}
+
+struct check_and_mutate_response
+{
+    1:i32           error; // return kTryAgain if check not passed.
+                           // return kInvalidArgument if check type is int compare and
+                           // check_operand/check_value is not integer or out of range.
+    2:bool          check_value_returned;
+    3:bool          check_value_exist; // used only if check_value_returned is true
+    4:dsn.blob      check_value; // used only if check_value_returned and check_value_exist is true
+    5:i32           app_id;
+    6:i32           partition_index;
+    7:i64           decree;
+    8:string        server;
+}
+
+struct del_range_request
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      start_sort_key;
+    3:dsn.blob      stop_sort_key; // empty means max sort key of the hash key
+    4:bool          start_inclusive;
+    5:bool          stop_inclusive;
+}
+
 struct get_scanner_request
 {
     1:dsn.blob  start_key;
@@ -126,11 +271,60 @@ struct get_scanner_request
     8:dsn.blob     hash_key_filter_pattern;
     9:filter_type  sort_key_filter_type;
     10:dsn.blob    sort_key_filter_pattern;
+    // the limits of one rpc call, the smaller one of them and the server side limits is used,
+    // and 0 means only the server side limits are used
+    11:i32         max_iteration_count;
+    12:i32         max_iteration_time_ms;
+    13:i32         max_response_bytes;
+    // for the scans over a large range, which iterate without filling the block cache and
+    // with readahead, and in shorter time slices to yield the replica threads to other reads
+    14:bool        full_scan;
+    // return the aggregates of the rows (see scan_aggregate) instead of the rows themselves,
+    // with the top_count largest rows and hash keys
+    15:bool        aggregate;
+    16:i32         aggregate_top_count;
 }
 
 struct scan_request
 {
     1:i64           context_id;
+    2:i32           batch_size; // 0 means the batch size of get_scanner
+}
+
+struct scan_row_stat
+{
+    1:dsn.blob      hash_key;
+    2:dsn.blob      sort_key;
+    3:i64           size; // size of the hash key, the sort key and the value
+}
+
+struct scan_hash_key_stat
+{
+    1:dsn.blob      hash_key;
+    2:i64           sort_key_count;
+    3:i64           size; // total size of the rows
+}
+
+// the aggregates of the rows iterated in one scan rpc
+struct scan_aggregate
+{
+    1:i64           row_count;
+    2:i64           hash_key_size_sum;
+    3:i64           hash_key_size_max;
+    4:i64           sort_key_size_sum;
+    5:i64           sort_key_size_max;
+    6:i64           value_size_sum;
+    7:i64           value_size_max;
+    8:i64           row_size_max;
+    9:list<scan_row_stat> top_rows; // the largest rows, in descending order of size
+    // the rows of the first and the last hash keys of an rpc may be continued in the adjacent
+    // rpcs, so they are returned in edge_hash_keys to be merged by the client, and only the
+    // hash keys between them are counted in hash_key_count, sort_key_count_max and top_hash_keys
+    10:i64          hash_key_count;
+    11:i64          sort_key_count_max;
+    12:list<scan_hash_key_stat> top_hash_keys; // the largest hash keys, in descending order
+    13:list<scan_hash_key_stat> edge_hash_keys;
+    14:dsn.blob     last_key; // the last key aggregated, from which the scan can be restarted
 }
 
 struct scan_response
@@ -141,6 +335,7 @@ struct scan_response
     4:i32           app_id;
     5:i32           partition_index;
     6:string        server;
+    7:scan_aggregate aggregate; // only for the scans with aggregate set
 }
 
 service rrdb
@@ -149,9 +344,15 @@ service rrdb
     update_response multi_put(1:multi_put_request request);
     update_response remove(1:dsn.blob key);
     multi_remove_response multi_remove(1:multi_remove_request request);
+    update_response del_range(1:del_range_request request);
+    incr_response incr(1:incr_request request);
+    check_and_set_response check_and_set(1:check_and_set_request request);
+    check_and_mutate_response check_and_mutate(1:check_and_mutate_request request);
     read_response get(1:dsn.blob key);
     multi_get_response multi_get(1:multi_get_request request);
+    batch_get_response batch_get(1:batch_get_request request);
     count_response sortkey_count(1:dsn.blob hash_key);
+    count_response approximate_sortkey_count(1:dsn.blob hash_key);
     ttl_response ttl(1:dsn.blob key);
 
     scan_response get_scanner(1:get_scanner_request request);
@@ -72,6 +72,163 @@ public:
         FT_MATCH_POSTFIX = 3
     };
 
+    enum cas_check_type
+    {
+        CT_NO_CHECK = 0,
+
+        // appearance
+        CT_VALUE_NOT_EXIST = 1,          // value is not exist
+        CT_VALUE_NOT_EXIST_OR_EMPTY = 2, // value is not exist or value is empty
+        CT_VALUE_EXIST = 3,              // value is exist
+        CT_VALUE_NOT_EMPTY = 4,          // value is exist and not empty
+
+        // match
+        CT_VALUE_MATCH_ANYWHERE = 5, // operand matches anywhere in value
+        CT_VALUE_MATCH_PREFIX = 6,   // operand matches prefix in value
+        CT_VALUE_MATCH_POSTFIX = 7,  // operand matches postfix in value
+
+        // bytes compare
+        CT_VALUE_BYTES_LESS = 8,              // bytes compare: value < operand
+        CT_VALUE_BYTES_LESS_OR_EQUAL = 9,     // bytes compare: value <= operand
+        CT_VALUE_BYTES_EQUAL = 10,            // bytes compare: value == operand
+        CT_VALUE_BYTES_GREATER_OR_EQUAL = 11, // bytes compare: value >= operand
+        CT_VALUE_BYTES_GREATER = 12,          // bytes compare: value > operand
+
+        // int compare: first transfer bytes to int64; then compare by int value
+        CT_VALUE_INT_LESS = 13,             // int compare: value < operand
+        CT_VALUE_INT_LESS_OR_EQUAL = 14,    // int compare: value <= operand
+        CT_VALUE_INT_EQUAL = 15,            // int compare: value == operand
+        CT_VALUE_INT_GREATER_OR_EQUAL = 16, // int compare: value >= operand
+        CT_VALUE_INT_GREATER = 17           // int compare: value > operand
+    };
+
+    struct check_and_set_options
+    {
+        int set_value_ttl_seconds; // time to live in seconds of the set value, 0 means no ttl.
+        bool return_check_value;   // if return the check value in results.
+        check_and_set_options() : set_value_ttl_seconds(0), return_check_value(false) {}
+    };
+
+    struct check_and_set_results
+    {
+        bool set_succeed;          // if set value succeed.
+        bool check_value_returned; // if the check value is returned.
+        bool check_value_exist;    // can be used only when check_value_returned is true.
+        std::string check_value;   // can be used only when check_value_exist is true.
+        check_and_set_results()
+            : set_succeed(false), check_value_returned(false), check_value_exist(false)
+        {
+        }
+    };
+
+    class mutations
+    {
+    public:
+        enum operation
+        {
+            MO_PUT = 0,
+            MO_DELETE = 1
+        };
+
+        struct mutate
+        {
+            operation op;
+            std::string sort_key;
+            std::string value;
+            int set_value_ttl_seconds; // 0 means no ttl, used only if op is MO_PUT
+            mutate() : op(MO_PUT), set_value_ttl_seconds(0) {}
+        };
+
+        /// put sort_key with value, will be applied in order of being added.
+        void set(const std::string &sort_key, const std::string &value, int ttl_seconds = 0)
+        {
+            mutate mu;
+            mu.op = MO_PUT;
+            mu.sort_key = sort_key;
+            mu.value = value;
+            mu.set_value_ttl_seconds = ttl_seconds;
+            _mutations.emplace_back(std::move(mu));
+        }
+
+        /// delete sort_key, will be applied in order of being added.
+        void del(const std::string &sort_key)
+        {
+            mutate mu;
+            mu.op = MO_DELETE;
+            mu.sort_key = sort_key;
+            _mutations.emplace_back(std::move(mu));
+        }
+
+        bool empty() const { return _mutations.empty(); }
+
+        const std::vector<mutate> &get_mutations() const { return _mutations; }
+
+    private:
+        std::vector<mutate> _mutations;
+    };
+
+    struct check_and_mutate_options
+    {
+        bool return_check_value; // if return the check value in results.
+        check_and_mutate_options() : return_check_value(false) {}
+    };
+
+    struct check_and_mutate_results
+    {
+        bool mutate_succeed;       // if mutate succeed.
+        bool check_value_returned; // if the check value is returned.
+        bool check_value_exist;    // can be used only when check_value_returned is true.
+        std::string check_value;   // can be used only when check_value_exist is true.
+        check_and_mutate_results()
+            : mutate_succeed(false), check_value_returned(false), check_value_exist(false)
+        {
+        }
+    };
+
+    struct scan_aggregate
+    {
+        struct row_stat
+        {
+            std::string hash_key;
+            std::string sort_key;
+            int64_t size; // size of the hash key, the sort key and the value
+            row_stat() : size(0) {}
+        };
+        struct hash_key_stat
+        {
+            std::string hash_key;
+            int64_t sort_key_count;
+            int64_t size; // total size of the rows
+            hash_key_stat() : sort_key_count(0), size(0) {}
+        };
+
+        int64_t row_count;
+        int64_t hash_key_count;
+        int64_t sort_key_count_max; // max count of sort keys in one hash key
+        int64_t hash_key_size_sum;  // sum over the rows
+        int64_t hash_key_size_max;
+        int64_t sort_key_size_sum;
+        int64_t sort_key_size_max;
+        int64_t value_size_sum;
+        int64_t value_size_max;
+        int64_t row_size_max;
+        std::vector<row_stat> top_rows;           // the largest rows, in descending order
+        std::vector<hash_key_stat> top_hash_keys; // the largest hash keys, in descending order
+        scan_aggregate()
+            : row_count(0),
+              hash_key_count(0),
+              sort_key_count_max(0),
+              hash_key_size_sum(0),
+              hash_key_size_max(0),
+              sort_key_size_sum(0),
+              sort_key_size_max(0),
+              value_size_sum(0),
+              value_size_max(0),
+              row_size_max(0)
+        {
+        }
+    };
+
     struct multi_get_options
     {
         bool start_inclusive;
@@ -110,6 +267,23 @@ public:
         filter_type sort_key_filter_type;
         std::string sort_key_filter_pattern;
         bool no_value; // only fetch hash_key and sort_key, but not fetch value
+        // the limits of one RPC call, the server side limits are used if they are smaller,
+        // and 0 means only the server side limits are used. the RPC call returns less than
+        // batch_size k-v if any limit is reached, and the scan continues with the next call.
+        int max_iteration_count;   // max count of k-v iterated, including expired and filtered
+        int max_iteration_time_ms; // max time of iteration, in milliseconds
+        int max_response_bytes;    // max bytes of k-v returned, and batch_size is decreased
+                                   // to fit in it (or 1MB if it is 0) for large k-v
+        // for the scans over a large range (e.g. the whole table), which are isolated from the
+        // online reads: the server iterates without filling the block cache and with readahead,
+        // and in shorter time slices to yield the threads to other requests
+        bool full_scan;
+        // read-ahead of the k-v: while the k-v of one batch are consumed, the next batches are
+        // fetched one by one, until prefetch_batch_count batches or prefetch_max_bytes bytes
+        // of k-v are buffered. 0 prefetch_batch_count means no read-ahead, and 0
+        // prefetch_max_bytes means no limit of bytes
+        int prefetch_batch_count;
+        int prefetch_max_bytes;
         scan_options()
             : timeout_ms(5000),
               batch_size(1000),
@@ -117,7 +291,13 @@ public:
               stop_inclusive(false),
               hash_key_filter_type(FT_NO_FILTER),
               sort_key_filter_type(FT_NO_FILTER),
-              no_value(false)
+              no_value(false),
+              max_iteration_count(0),
+              max_iteration_time_ms(0),
+              max_response_bytes(0),
+              full_scan(false),
+              prefetch_batch_count(0),
+              prefetch_max_bytes(0)
         {
         }
         scan_options(const scan_options &o)
@@ -129,7 +309,13 @@ public:
               hash_key_filter_pattern(o.hash_key_filter_pattern),
               sort_key_filter_type(o.sort_key_filter_type),
               sort_key_filter_pattern(o.sort_key_filter_pattern),
-              no_value(o.no_value)
+              no_value(o.no_value),
+              max_iteration_count(o.max_iteration_count),
+              max_iteration_time_ms(o.max_iteration_time_ms),
+              max_response_bytes(o.max_response_bytes),
+              full_scan(o.full_scan),
+              prefetch_batch_count(o.prefetch_batch_count),
+              prefetch_max_bytes(o.prefetch_max_bytes)
         {
         }
     };
@@ -150,16 +336,34 @@ public:
     typedef std::function<void(
         int /*error_code*/, std::set<std::string> && /*sortkeys*/, internal_info && /*info*/)>
         async_multi_get_sortkeys_callback_t;
+    typedef std::function<void(
+        int /*error_code*/,
+        std::map<std::pair<std::string, std::string>, std::string> && /*values*/)>
+        async_batch_get_callback_t;
     typedef std::function<void(int /*error_code*/, internal_info && /*info*/)> async_del_callback_t;
     typedef std::function<void(
         int /*error_code*/, int64_t /*deleted_count*/, internal_info && /*info*/)>
         async_multi_del_callback_t;
+    typedef std::function<void(
+        int /*error_code*/, int64_t /*new_value*/, internal_info && /*info*/)>
+        async_incr_callback_t;
+    typedef std::function<void(int /*error_code*/,
+                               check_and_set_results && /*results*/,
+                               internal_info && /*info*/)>
+        async_check_and_set_callback_t;
+    typedef std::function<void(int /*error_code*/,
+                               check_and_mutate_results && /*results*/,
+                               internal_info && /*info*/)>
+        async_check_and_mutate_callback_t;
     typedef std::function<void(int /*error_code*/,
                                std::string && /*hash_key*/,
                                std::string && /*sort_key*/,
                                std::string && /*value*/,
                                internal_info && /*info*/)>
         async_scan_next_callback_t;
+    typedef std::function<void(
+        int /*error_code*/, scan_aggregate && /*aggregate*/, internal_info && /*info*/)>
+        async_scan_aggregate_callback_t;
     typedef std::function<void(int /*error_code*/, pegasus_scanner * /*hash_scanner*/)>
         async_get_scanner_callback_t;
     typedef std::function<void(int /*error_code*/, std::vector<pegasus_scanner *> && /*scanners*/)>
@@ -200,6 +404,31 @@ public:
         ///
         virtual void async_next(async_scan_next_callback_t &&callback) = 0;
 
+        ///
+        /// \brief aggregate the rest k-v of this scanner on the server side,
+        /// only the aggregates instead of the k-v are transferred to the client
+        /// it should not be called concurrently with next() or async_next()
+        /// \param top_count
+        /// count of the largest rows and hash keys to return
+        /// \param result
+        /// the aggregates of the k-v
+        /// \return
+        /// int, the error indicates whether or not the operation is succeeded.
+        /// this error can be converted to a string using get_error_string()
+        ///
+        virtual int
+        aggregate(int top_count, scan_aggregate &result, internal_info *info = NULL) = 0;
+
+        ///
+        /// \brief async aggregate the rest k-v of this scanner on the server side
+        /// it should not be called concurrently with next() or async_next()
+        /// \param top_count
+        /// count of the largest rows and hash keys to return
+        /// \param callback
+        /// status and the aggregates will be passed to callback
+        ///
+        virtual void async_aggregate(int top_count, async_scan_aggregate_callback_t &&callback) = 0;
+
         virtual ~abstract_pegasus_scanner() {}
     };
 
@@ -225,6 +454,31 @@ public:
         virtual pegasus_scanner_wrapper get_smart_wrapper() = 0;
     };
 
+    class multi_get_pager
+    {
+    public:
+        ///
+        /// \brief get the next page of the k-v in the sort key range
+        /// not thread-safe
+        /// each page is fetched by one multi_get rpc, which resumes from where the previous one
+        /// stopped, so that the records are iterated on the server only once, even if they are
+        /// expired or filtered out
+        /// \param values
+        /// the <sortkey,value> pairs of the page, which is empty if all the records iterated
+        /// by the rpc are expired or filtered out
+        /// \return
+        /// int, the error indicates whether or not the operation is succeeded.
+        /// this error can be converted to a string using get_error_string()
+        /// PERR_OK means a page got
+        /// PERR_SCAN_COMPLETE means all pages have been got before this call
+        /// otherwise some error orrured
+        ///
+        virtual int next_page(std::map<std::string, std::string> &values,
+                              internal_info *info = NULL) = 0;
+
+        virtual ~multi_get_pager() {}
+    };
+
 public:
     // destructor
     virtual ~pegasus_client() {}
@@ -507,6 +761,40 @@ public:
                                  int max_fetch_size = 1000000,
                                  int timeout_milliseconds = 5000) = 0;
 
+    ///
+    /// \brief get multi_get pager
+    ///     get pager to fetch the sort key range of a hash key page by page, which is used
+    ///     for the hash keys too large to be fetched by one multi_get.
+    /// \param hashkey
+    /// used to decide which partition to get this k-v.
+    /// \param start_sortkey
+    /// the start sort key.
+    /// \param stop_sortkey
+    /// the stop sort key, empty string means fetch until the last.
+    /// \param options
+    /// the multi-get options.
+    /// \param pager
+    /// out param, used to get the pages
+    /// this pointer should be deleted when all pages got
+    /// \param max_fetch_count
+    /// max count of k-v pairs in one page. max_fetch_count <= 0 means no limit.
+    /// \param max_fetch_size
+    /// max size of k-v pairs in one page. max_fetch_size <= 0 means no limit.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value for one page, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    ///
+    virtual int get_multi_get_pager(const std::string &hashkey,
+                                    const std::string &start_sortkey,
+                                    const std::string &stop_sortkey,
+                                    const multi_get_options &options,
+                                    multi_get_pager *&pager,
+                                    int max_fetch_count = 100,
+                                    int max_fetch_size = 1000000,
+                                    int timeout_milliseconds = 5000) = 0;
+
     ///
     /// \brief multi_get_sortkeys
     ///     get multiple sort keys by hash key from the cluster.
@@ -558,6 +846,46 @@ public:
                                           int max_fetch_size = 1000000,
                                           int timeout_milliseconds = 5000) = 0;
 
+    ///
+    /// \brief batch_get
+    ///     get multiple values by keys from the cluster, the keys may have different hashkeys.
+    ///     keys are grouped by partition, and each partition is accessed by only one rpc.
+    /// \param keys
+    /// the <hashkey,sortkey> pairs to be fetched, should not be empty.
+    /// \param values
+    /// the returned <<hashkey,sortkey>,value> pairs will be put into it.
+    /// if data is not found for some <hashkey,sortkey>, then it will not appear in the map.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    /// returns PERR_OK if fetch done, even no data is returned.
+    /// if some partitions failed, returns the error of one of them, and values only
+    /// contains the data fetched from the succeeded partitions.
+    ///
+    virtual int batch_get(const std::vector<std::pair<std::string, std::string>> &keys,
+                          std::map<std::pair<std::string, std::string>, std::string> &values,
+                          int timeout_milliseconds = 5000) = 0;
+
+    ///
+    /// \brief asynchronous batch_get
+    ///     get multiple values by keys from the cluster, the keys may have different hashkeys.
+    ///     keys are grouped by partition, and each partition is accessed by only one rpc.
+    ///     will not be blocked, return immediately.
+    /// \param keys
+    /// the <hashkey,sortkey> pairs to be fetched, should not be empty.
+    /// \param callback
+    /// the callback function will be invoked after all partitions finished or error occurred.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// void.
+    ///
+    virtual void async_batch_get(const std::vector<std::pair<std::string, std::string>> &keys,
+                                 async_batch_get_callback_t &&callback = nullptr,
+                                 int timeout_milliseconds = 5000) = 0;
+
     ///
     /// \brief exist
     ///     check value exist by key from the cluster.
@@ -596,6 +924,27 @@ public:
                               int timeout_milliseconds = 5000,
                               internal_info *info = NULL) = 0;
 
+    ///
+    /// \brief approximate_sortkey_count
+    ///     get the estimated sortkey count by hashkey from the cluster, which is much cheaper
+    ///     than sortkey_count for the hashkeys with many sortkeys, as the data is not scanned.
+    ///     the expired and deleted records not yet compacted may also be counted. the small
+    ///     hashkeys are still counted exactly.
+    /// \param hashkey
+    /// used to decide which partition to get this k-v
+    /// \param count
+    /// the returned estimated sortkey count
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    ///
+    virtual int approximate_sortkey_count(const std::string &hashkey,
+                                          int64_t &count,
+                                          int timeout_milliseconds = 5000,
+                                          internal_info *info = NULL) = 0;
+
     ///
     /// \brief del
     ///     del stored k-v by key from cluster
@@ -678,6 +1027,265 @@ public:
                                  async_multi_del_callback_t &&callback = nullptr,
                                  int timeout_milliseconds = 5000) = 0;
 
+    ///
+    /// \brief del_range
+    ///     delete all the k-v of hashkey within the sortkey range from the cluster.
+    ///     the deletion is done on the server side by one range deletion,
+    ///     which is much cheaper than scanning and deleting the sortkeys one by one.
+    /// \param hashkey
+    /// used to decide which partition to del the k-v
+    /// \param start_sortkey
+    /// sortkey to start with
+    /// \param stop_sortkey
+    /// sortkey to stop. ""(empty string) represents the max sortkey of the hashkey
+    /// \param start_inclusive
+    /// whether the start_sortkey is included
+    /// \param stop_inclusive
+    /// whether the stop_sortkey is included, ignored if stop_sortkey is empty
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    ///
+    virtual int del_range(const std::string &hashkey,
+                          const std::string &start_sortkey,
+                          const std::string &stop_sortkey,
+                          bool start_inclusive = true,
+                          bool stop_inclusive = false,
+                          int timeout_milliseconds = 5000,
+                          internal_info *info = NULL) = 0;
+
+    ///
+    /// \brief asynchronous del_range
+    ///     delete all the k-v of hashkey within the sortkey range from the cluster.
+    ///     will not be blocked, return immediately.
+    /// \param hashkey
+    /// used to decide which partition to del the k-v
+    /// \param start_sortkey
+    /// sortkey to start with
+    /// \param stop_sortkey
+    /// sortkey to stop. ""(empty string) represents the max sortkey of the hashkey
+    /// \param start_inclusive
+    /// whether the start_sortkey is included
+    /// \param stop_inclusive
+    /// whether the stop_sortkey is included, ignored if stop_sortkey is empty
+    /// \param callback
+    /// the callback function will be invoked after operation finished or error occurred.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// void.
+    ///
+    virtual void async_del_range(const std::string &hashkey,
+                                 const std::string &start_sortkey,
+                                 const std::string &stop_sortkey,
+                                 bool start_inclusive,
+                                 bool stop_inclusive,
+                                 async_del_callback_t &&callback = nullptr,
+                                 int timeout_milliseconds = 5000) = 0;
+
+    ///
+    /// \brief incr
+    ///     atomically increment value by key from the cluster.
+    ///     key is composed of hashkey and sortkey. must provide both to get the value.
+    ///
+    ///     the increment semantic is the same as redis:
+    ///       - if old data is not found or empty, then set initial value to 0.
+    ///       - if old data is not an integer or out of range, then return PERR_INVALID_ARGUMENT.
+    ///       - if new value is out of range, then return PERR_INVALID_ARGUMENT.
+    ///       - ttl of the old data is kept.
+    /// \param hashkey
+    /// used to decide which partition to put this k-v
+    /// \param sortkey
+    /// all the k-v under hashkey will be sorted by sortkey.
+    /// \param increment
+    /// the value we want to increment, may be negative.
+    /// \param new_value
+    /// out param to return the new value if increment succeed.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string()
+    ///
+    virtual int incr(const std::string &hashkey,
+                     const std::string &sortkey,
+                     int64_t increment,
+                     int64_t &new_value,
+                     int timeout_milliseconds = 5000,
+                     internal_info *info = NULL) = 0;
+
+    ///
+    /// \brief asynchronous incr
+    ///     atomically increment value by key from the cluster.
+    ///     will not be blocked, return immediately.
+    ///
+    ///     the increment semantic is the same as redis, see incr().
+    /// \param hashkey
+    /// used to decide which partition to put this k-v
+    /// \param sortkey
+    /// all the k-v under hashkey will be sorted by sortkey.
+    /// \param increment
+    /// the value we want to increment, may be negative.
+    /// \param callback
+    /// the callback function will be invoked after operation finished or error occurred.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// void.
+    ///
+    virtual void async_incr(const std::string &hashkey,
+                            const std::string &sortkey,
+                            int64_t increment,
+                            async_incr_callback_t &&callback = nullptr,
+                            int timeout_milliseconds = 5000) = 0;
+
+    ///
+    /// \brief check_and_set
+    ///     atomically check and set value by key from the cluster.
+    ///     the value will be set if and only if check passed.
+    ///     the sort key for checking and setting can be the same or different.
+    /// \param hash_key
+    /// used to decide which partition to get this k-v
+    /// \param check_sort_key
+    /// the sort key to check.
+    /// \param check_type
+    /// the check type.
+    /// \param check_operand
+    /// the check operand.
+    /// \param set_sort_key
+    /// the sort key to set value if check passed.
+    /// \param set_value
+    /// the value to set if check passed.
+    /// \param options
+    /// the check-and-set options.
+    /// \param results
+    /// the check-and-set results.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    /// if check type is int compare, and check_operand/check_value is not integer
+    /// or out of range, then return PERR_INVALID_ARGUMENT.
+    /// if check not passed, PERR_OK is returned with results.set_succeed = false.
+    ///
+    virtual int check_and_set(const std::string &hash_key,
+                              const std::string &check_sort_key,
+                              cas_check_type check_type,
+                              const std::string &check_operand,
+                              const std::string &set_sort_key,
+                              const std::string &set_value,
+                              const check_and_set_options &options,
+                              check_and_set_results &results,
+                              int timeout_milliseconds = 5000,
+                              internal_info *info = NULL) = 0;
+
+    ///
+    /// \brief asynchronous check_and_set
+    ///     atomically check and set value by key from the cluster.
+    ///     will not be blocked, return immediately.
+    /// \param hash_key
+    /// used to decide which partition to get this k-v
+    /// \param check_sort_key
+    /// the sort key to check.
+    /// \param check_type
+    /// the check type.
+    /// \param check_operand
+    /// the check operand.
+    /// \param set_sort_key
+    /// the sort key to set value if check passed.
+    /// \param set_value
+    /// the value to set if check passed.
+    /// \param options
+    /// the check-and-set options.
+    /// \param callback
+    /// the callback function will be invoked after operation finished or error occurred.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// void.
+    ///
+    virtual void async_check_and_set(const std::string &hash_key,
+                                     const std::string &check_sort_key,
+                                     cas_check_type check_type,
+                                     const std::string &check_operand,
+                                     const std::string &set_sort_key,
+                                     const std::string &set_value,
+                                     const check_and_set_options &options,
+                                     async_check_and_set_callback_t &&callback = nullptr,
+                                     int timeout_milliseconds = 5000) = 0;
+
+    ///
+    /// \brief check_and_mutate
+    ///     atomically check and mutate from the cluster.
+    ///     the mutations will be applied in one write batch if and only if check passed.
+    /// \param hash_key
+    /// used to decide which partition to get this k-v
+    /// \param check_sort_key
+    /// the sort key to check.
+    /// \param check_type
+    /// the check type.
+    /// \param check_operand
+    /// the check operand.
+    /// \param mutations
+    /// the list of mutations to perform if check condition is satisfied, should not be empty.
+    /// \param options
+    /// the check-and-mutate options.
+    /// \param results
+    /// the check-and-mutate results.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// int, the error indicates whether or not the operation is succeeded.
+    /// this error can be converted to a string using get_error_string().
+    /// if check type is int compare, and check_operand/check_value is not integer
+    /// or out of range, then return PERR_INVALID_ARGUMENT.
+    /// if check not passed, PERR_OK is returned with results.mutate_succeed = false.
+    ///
+    virtual int check_and_mutate(const std::string &hash_key,
+                                 const std::string &check_sort_key,
+                                 cas_check_type check_type,
+                                 const std::string &check_operand,
+                                 const mutations &mutations,
+                                 const check_and_mutate_options &options,
+                                 check_and_mutate_results &results,
+                                 int timeout_milliseconds = 5000,
+                                 internal_info *info = NULL) = 0;
+
+    ///
+    /// \brief asynchronous check_and_mutate
+    ///     atomically check and mutate from the cluster.
+    ///     will not be blocked, return immediately.
+    /// \param hash_key
+    /// used to decide which partition to get this k-v
+    /// \param check_sort_key
+    /// the sort key to check.
+    /// \param check_type
+    /// the check type.
+    /// \param check_operand
+    /// the check operand.
+    /// \param mutations
+    /// the list of mutations to perform if check condition is satisfied, should not be empty.
+    /// \param options
+    /// the check-and-mutate options.
+    /// \param callback
+    /// the callback function will be invoked after operation finished or error occurred.
+    /// \param timeout_milliseconds
+    /// if wait longer than this value, will return time out error
+    /// \return
+    /// void.
+    ///
+    virtual void async_check_and_mutate(const std::string &hash_key,
+                                        const std::string &check_sort_key,
+                                        cas_check_type check_type,
+                                        const std::string &check_operand,
+                                        const mutations &mutations,
+                                        const check_and_mutate_options &options,
+                                        async_check_and_mutate_callback_t &&callback = nullptr,
+                                        int timeout_milliseconds = 5000) = 0;
+
     ///
     /// \brief ttl (time to live)
     ///     get ttl in seconds of this k-v.
@@ -189,6 +189,182 @@ public:
                                 reply_thread_hash);
     }
 
+    // ---------- call RPC_RRDB_RRDB_DEL_RANGE ------------
+    // - synchronous
+    std::pair<::dsn::error_code, update_response>
+    del_range_sync(const del_range_request &args,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                   int thread_hash = 0, // if thread_hash == 0 && partition_hash != 0, thread_hash
+                                        // is computed from partition_hash
+                   uint64_t partition_hash = 0,
+                   dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<update_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_DEL_RANGE,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack del_range_request and update_response
+    template <typename TCallback>
+    ::dsn::task_ptr del_range(const del_range_request &args,
+                              TCallback &&callback,
+                              std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                              int request_thread_hash = 0, // if thread_hash == 0 && partition_hash
+                                                           // != 0, thread_hash is computed from
+                                                           // partition_hash
+                              uint64_t request_partition_hash = 0,
+                              int reply_thread_hash = 0,
+                              dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_DEL_RANGE,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
+    // ---------- call RPC_RRDB_RRDB_INCR ------------
+    // - synchronous
+    std::pair<::dsn::error_code, incr_response>
+    incr_sync(const incr_request &args,
+              std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+              int thread_hash = 0, // if thread_hash == 0 && partition_hash != 0, thread_hash is
+                                   // computed from partition_hash
+              uint64_t partition_hash = 0,
+              dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<incr_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_INCR,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack incr_request and incr_response
+    template <typename TCallback>
+    ::dsn::task_ptr incr(const incr_request &args,
+                         TCallback &&callback,
+                         std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                         int request_thread_hash = 0, // if thread_hash == 0 && partition_hash != 0,
+                                                      // thread_hash is computed from partition_hash
+                         uint64_t request_partition_hash = 0,
+                         int reply_thread_hash = 0,
+                         dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_INCR,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
+    // ---------- call RPC_RRDB_RRDB_CHECK_AND_SET ------------
+    // - synchronous
+    std::pair<::dsn::error_code, check_and_set_response>
+    check_and_set_sync(const check_and_set_request &args,
+                       std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                       int thread_hash = 0, // if thread_hash == 0 && partition_hash != 0,
+                                            // thread_hash is computed from partition_hash
+                       uint64_t partition_hash = 0,
+                       dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<check_and_set_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_CHECK_AND_SET,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack check_and_set_request and check_and_set_response
+    template <typename TCallback>
+    ::dsn::task_ptr check_and_set(const check_and_set_request &args,
+                                  TCallback &&callback,
+                                  std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                                  int request_thread_hash = 0, // if thread_hash == 0 &&
+                                                               // partition_hash != 0, thread_hash
+                                                               // is computed from partition_hash
+                                  uint64_t request_partition_hash = 0,
+                                  int reply_thread_hash = 0,
+                                  dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_CHECK_AND_SET,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
+    // ---------- call RPC_RRDB_RRDB_CHECK_AND_MUTATE ------------
+    // - synchronous
+    std::pair<::dsn::error_code, check_and_mutate_response>
+    check_and_mutate_sync(const check_and_mutate_request &args,
+                          std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                          int thread_hash = 0, // if thread_hash == 0 && partition_hash != 0,
+                                               // thread_hash is computed from partition_hash
+                          uint64_t partition_hash = 0,
+                          dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<check_and_mutate_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_CHECK_AND_MUTATE,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack check_and_mutate_request and check_and_mutate_response
+    template <typename TCallback>
+    ::dsn::task_ptr check_and_mutate(const check_and_mutate_request &args,
+                                     TCallback &&callback,
+                                     std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                                     int request_thread_hash = 0, // if thread_hash == 0 &&
+                                                                  // partition_hash != 0,
+                                                                  // thread_hash is computed from
+                                                                  // partition_hash
+                                     uint64_t request_partition_hash = 0,
+                                     int reply_thread_hash = 0,
+                                     dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_CHECK_AND_MUTATE,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
     // ---------- call RPC_RRDB_RRDB_GET ------------
     // - synchronous
     std::pair<::dsn::error_code, read_response>
@@ -276,6 +452,50 @@ public:
                                 reply_thread_hash);
     }
 
+    // ---------- call RPC_RRDB_RRDB_BATCH_GET ------------
+    // - synchronous
+    std::pair<::dsn::error_code, batch_get_response>
+    batch_get_sync(const batch_get_request &args,
+                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                   int thread_hash = 0, // if thread_hash == 0 && partition_hash != 0, thread_hash
+                                        // is computed from partition_hash
+                   uint64_t partition_hash = 0,
+                   dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<batch_get_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_BATCH_GET,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack batch_get_request and batch_get_response
+    template <typename TCallback>
+    ::dsn::task_ptr batch_get(const batch_get_request &args,
+                              TCallback &&callback,
+                              std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                              int request_thread_hash = 0, // if thread_hash == 0 && partition_hash
+                                                           // != 0, thread_hash is computed from
+                                                           // partition_hash
+                              uint64_t request_partition_hash = 0,
+                              int reply_thread_hash = 0,
+                              dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_BATCH_GET,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
     // ---------- call RPC_RRDB_RRDB_SORTKEY_COUNT ------------
     // - synchronous
     std::pair<::dsn::error_code, count_response>
@@ -320,6 +540,53 @@ public:
                                 reply_thread_hash);
     }
 
+    // ---------- call RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT ------------
+    // - synchronous
+    std::pair<::dsn::error_code, count_response>
+    approximate_sortkey_count_sync(const ::dsn::blob &args,
+                                   std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                                   int thread_hash = 0, // if thread_hash == 0 && partition_hash !=
+                                                        // 0, thread_hash is computed from
+                                                        // partition_hash
+                                   uint64_t partition_hash = 0,
+                                   dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::wait_and_unwrap<count_response>(
+            ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                             RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT,
+                             args,
+                             &_tracker,
+                             empty_rpc_handler,
+                             timeout,
+                             thread_hash,
+                             partition_hash));
+    }
+
+    // - asynchronous with on-stack ::dsn::blob and count_response
+    template <typename TCallback>
+    ::dsn::task_ptr approximate_sortkey_count(const ::dsn::blob &args,
+                                              TCallback &&callback,
+                                              std::chrono::milliseconds timeout = std::chrono::milliseconds(0),
+                                              int request_thread_hash = 0, // if thread_hash == 0 &&
+                                                                           // partition_hash != 0,
+                                                                           // thread_hash is
+                                                                           // computed from
+                                                                           // partition_hash
+                                              uint64_t request_partition_hash = 0,
+                                              int reply_thread_hash = 0,
+                                              dsn::optional<::dsn::rpc_address> server_addr = dsn::none)
+    {
+        return ::dsn::rpc::call(server_addr.unwrap_or(_server),
+                                RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT,
+                                args,
+                                &_tracker,
+                                std::forward<TCallback>(callback),
+                                timeout,
+                                request_thread_hash,
+                                request_partition_hash,
+                                reply_thread_hash);
+    }
+
     // ---------- call RPC_RRDB_RRDB_TTL ------------
     // - synchronous
     std::pair<::dsn::error_code, ttl_response>
@@ -4,12 +4,20 @@
 namespace dsn {
 namespace apps {
 DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_PUT, true)
+// multi_put, multi_remove and incr are batched only if the config `batch_multi_key_writes` of
+// the server is enabled, see pegasus_server_impl
 DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_MULTI_PUT, false)
 DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_REMOVE, true)
 DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_MULTI_REMOVE, false)
+DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_DEL_RANGE, false)
+DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_INCR, false)
+DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_CHECK_AND_SET, false)
+DEFINE_STORAGE_WRITE_RPC_CODE(RPC_RRDB_RRDB_CHECK_AND_MUTATE, false)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_GET)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_MULTI_GET)
+DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_BATCH_GET)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_SORTKEY_COUNT)
+DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_TTL)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_GET_SCANNER)
 DEFINE_STORAGE_READ_RPC_CODE(RPC_RRDB_RRDB_SCAN)
@@ -50,6 +50,37 @@ protected:
         multi_remove_response resp;
         reply(resp);
     }
+    // RPC_RRDB_RRDB_DEL_RANGE
+    virtual void on_del_range(const del_range_request &args,
+                              ::dsn::rpc_replier<update_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_DEL_RANGE ... (not implemented) " << std::endl;
+        update_response resp;
+        reply(resp);
+    }
+    // RPC_RRDB_RRDB_INCR
+    virtual void on_incr(const incr_request &args, ::dsn::rpc_replier<incr_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_INCR ... (not implemented) " << std::endl;
+        incr_response resp;
+        reply(resp);
+    }
+    // RPC_RRDB_RRDB_CHECK_AND_SET
+    virtual void on_check_and_set(const check_and_set_request &args,
+                                  ::dsn::rpc_replier<check_and_set_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_CHECK_AND_SET ... (not implemented) " << std::endl;
+        check_and_set_response resp;
+        reply(resp);
+    }
+    // RPC_RRDB_RRDB_CHECK_AND_MUTATE
+    virtual void on_check_and_mutate(const check_and_mutate_request &args,
+                                     ::dsn::rpc_replier<check_and_mutate_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_CHECK_AND_MUTATE ... (not implemented) " << std::endl;
+        check_and_mutate_response resp;
+        reply(resp);
+    }
     // RPC_RRDB_RRDB_GET
     virtual void on_get(const ::dsn::blob &args, ::dsn::rpc_replier<read_response> &reply)
     {
@@ -65,6 +96,14 @@ protected:
         multi_get_response resp;
         reply(resp);
     }
+    // RPC_RRDB_RRDB_BATCH_GET
+    virtual void on_batch_get(const batch_get_request &args,
+                              ::dsn::rpc_replier<batch_get_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_BATCH_GET ... (not implemented) " << std::endl;
+        batch_get_response resp;
+        reply(resp);
+    }
     // RPC_RRDB_RRDB_SORTKEY_COUNT
     virtual void on_sortkey_count(const ::dsn::blob &args,
                                   ::dsn::rpc_replier<count_response> &reply)
@@ -73,6 +112,15 @@ protected:
         count_response resp;
         reply(resp);
     }
+    // RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT
+    virtual void on_approximate_sortkey_count(const ::dsn::blob &args,
+                                              ::dsn::rpc_replier<count_response> &reply)
+    {
+        std::cout << "... exec RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT ... (not implemented) "
+                  << std::endl;
+        count_response resp;
+        reply(resp);
+    }
     // RPC_RRDB_RRDB_TTL
     virtual void on_ttl(const ::dsn::blob &args, ::dsn::rpc_replier<ttl_response> &reply)
     {
@@ -106,9 +154,18 @@ protected:
         register_async_rpc_handler(RPC_RRDB_RRDB_PUT, "put", on_put);
         register_async_rpc_handler(RPC_RRDB_RRDB_MULTI_PUT, "multi_put", on_multi_put);
         register_async_rpc_handler(RPC_RRDB_RRDB_REMOVE, "remove", on_multi_remove);
+        register_async_rpc_handler(RPC_RRDB_RRDB_DEL_RANGE, "del_range", on_del_range);
+        register_async_rpc_handler(RPC_RRDB_RRDB_INCR, "incr", on_incr);
+        register_async_rpc_handler(RPC_RRDB_RRDB_CHECK_AND_SET, "check_and_set", on_check_and_set);
+        register_async_rpc_handler(
+            RPC_RRDB_RRDB_CHECK_AND_MUTATE, "check_and_mutate", on_check_and_mutate);
         register_async_rpc_handler(RPC_RRDB_RRDB_GET, "get", on_get);
         register_async_rpc_handler(RPC_RRDB_RRDB_MULTI_GET, "multi_get", on_multi_get);
+        register_async_rpc_handler(RPC_RRDB_RRDB_BATCH_GET, "batch_get", on_batch_get);
         register_async_rpc_handler(RPC_RRDB_RRDB_SORTKEY_COUNT, "sortkey_count", on_sortkey_count);
+        register_async_rpc_handler(RPC_RRDB_RRDB_APPROXIMATE_SORTKEY_COUNT,
+                                   "approximate_sortkey_count",
+                                   on_approximate_sortkey_count);
         register_async_rpc_handler(RPC_RRDB_RRDB_TTL, "ttl", on_ttl);
         register_async_rpc_handler(RPC_RRDB_RRDB_GET_SCANNER, "get_scanner", on_get_scanner);
         register_async_rpc_handler(RPC_RRDB_RRDB_SCAN, "scan", on_scan);
@@ -140,6 +197,29 @@ private:
     {
         svc->on_multi_remove(args, reply);
     }
+    static void on_del_range(rrdb_service *svc,
+                             const del_range_request &args,
+                             ::dsn::rpc_replier<update_response> &reply)
+    {
+        svc->on_del_range(args, reply);
+    }
+    static void
+    on_incr(rrdb_service *svc, const incr_request &args, ::dsn::rpc_replier<incr_response> &reply)
+    {
+        svc->on_incr(args, reply);
+    }
+    static void on_check_and_set(rrdb_service *svc,
+                                 const check_and_set_request &args,
+                                 ::dsn::rpc_replier<check_and_set_response> &reply)
+    {
+        svc->on_check_and_set(args, reply);
+    }
+    static void on_check_and_mutate(rrdb_service *svc,
+                                    const check_and_mutate_request &args,
+                                    ::dsn::rpc_replier<check_and_mutate_response> &reply)
+    {
+        svc->on_check_and_mutate(args, reply);
+    }
     static void
     on_get(rrdb_service *svc, const ::dsn::blob &args, ::dsn::rpc_replier<read_response> &reply)
     {
@@ -151,12 +231,24 @@ private:
     {
         svc->on_multi_get(args, reply);
     }
+    static void on_batch_get(rrdb_service *svc,
+                             const batch_get_request &args,
+                             ::dsn::rpc_replier<batch_get_response> &reply)
+    {
+        svc->on_batch_get(args, reply);
+    }
     static void on_sortkey_count(rrdb_service *svc,
                                  const ::dsn::blob &args,
                                  ::dsn::rpc_replier<count_response> &reply)
     {
         svc->on_sortkey_count(args, reply);
     }
+    static void on_approximate_sortkey_count(rrdb_service *svc,
+                                             const ::dsn::blob &args,
+                                             ::dsn::rpc_replier<count_response> &reply)
+    {
+        svc->on_approximate_sortkey_count(args, reply);
+    }
     static void
     on_ttl(rrdb_service *svc, const ::dsn::blob &args, ::dsn::rpc_replier<ttl_response> &reply)
     {
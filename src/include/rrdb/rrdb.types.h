@@ -17,9 +17,23 @@ GENERATED_TYPE_SERIALIZATION(multi_remove_request, THRIFT)
 GENERATED_TYPE_SERIALIZATION(multi_remove_response, THRIFT)
 GENERATED_TYPE_SERIALIZATION(multi_get_request, THRIFT)
 GENERATED_TYPE_SERIALIZATION(multi_get_response, THRIFT)
+GENERATED_TYPE_SERIALIZATION(full_key, THRIFT)
+GENERATED_TYPE_SERIALIZATION(batch_get_request, THRIFT)
+GENERATED_TYPE_SERIALIZATION(full_data, THRIFT)
+GENERATED_TYPE_SERIALIZATION(batch_get_response, THRIFT)
 GENERATED_TYPE_SERIALIZATION(incr_request, THRIFT)
+GENERATED_TYPE_SERIALIZATION(incr_response, THRIFT)
+GENERATED_TYPE_SERIALIZATION(check_and_set_request, THRIFT)
+GENERATED_TYPE_SERIALIZATION(check_and_set_response, THRIFT)
+GENERATED_TYPE_SERIALIZATION(mutate, THRIFT)
+GENERATED_TYPE_SERIALIZATION(check_and_mutate_request, THRIFT)
+GENERATED_TYPE_SERIALIZATION(check_and_mutate_response, THRIFT)
+GENERATED_TYPE_SERIALIZATION(del_range_request, THRIFT)
 GENERATED_TYPE_SERIALIZATION(get_scanner_request, THRIFT)
 GENERATED_TYPE_SERIALIZATION(scan_request, THRIFT)
+GENERATED_TYPE_SERIALIZATION(scan_row_stat, THRIFT)
+GENERATED_TYPE_SERIALIZATION(scan_hash_key_stat, THRIFT)
+GENERATED_TYPE_SERIALIZATION(scan_aggregate, THRIFT)
 GENERATED_TYPE_SERIALIZATION(scan_response, THRIFT)
 }
 }
\ No newline at end of file
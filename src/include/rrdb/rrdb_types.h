@@ -33,6 +33,44 @@ struct filter_type
 
 extern const std::map<int, const char *> _filter_type_VALUES_TO_NAMES;
 
+struct cas_check_type
+{
+    enum type
+    {
+        CT_NO_CHECK = 0,
+        CT_VALUE_NOT_EXIST = 1,
+        CT_VALUE_NOT_EXIST_OR_EMPTY = 2,
+        CT_VALUE_EXIST = 3,
+        CT_VALUE_NOT_EMPTY = 4,
+        CT_VALUE_MATCH_ANYWHERE = 5,
+        CT_VALUE_MATCH_PREFIX = 6,
+        CT_VALUE_MATCH_POSTFIX = 7,
+        CT_VALUE_BYTES_LESS = 8,
+        CT_VALUE_BYTES_LESS_OR_EQUAL = 9,
+        CT_VALUE_BYTES_EQUAL = 10,
+        CT_VALUE_BYTES_GREATER_OR_EQUAL = 11,
+        CT_VALUE_BYTES_GREATER = 12,
+        CT_VALUE_INT_LESS = 13,
+        CT_VALUE_INT_LESS_OR_EQUAL = 14,
+        CT_VALUE_INT_EQUAL = 15,
+        CT_VALUE_INT_GREATER_OR_EQUAL = 16,
+        CT_VALUE_INT_GREATER = 17
+    };
+};
+
+extern const std::map<int, const char *> _cas_check_type_VALUES_TO_NAMES;
+
+struct mutate_operation
+{
+    enum type
+    {
+        MO_PUT = 0,
+        MO_DELETE = 1
+    };
+};
+
+extern const std::map<int, const char *> _mutate_operation_VALUES_TO_NAMES;
+
 class update_request;
 
 class update_response;
@@ -55,12 +93,40 @@ class multi_get_request;
 
 class multi_get_response;
 
+class full_key;
+
+class batch_get_request;
+
+class full_data;
+
+class batch_get_response;
+
 class incr_request;
 
+class incr_response;
+
+class check_and_set_request;
+
+class check_and_set_response;
+
+class mutate;
+
+class check_and_mutate_request;
+
+class check_and_mutate_response;
+
+class del_range_request;
+
 class get_scanner_request;
 
 class scan_request;
 
+class scan_row_stat;
+
+class scan_hash_key_stat;
+
+class scan_aggregate;
+
 class scan_response;
 
 typedef struct _update_request__isset
@@ -805,7 +871,12 @@ inline std::ostream &operator<<(std::ostream &out, const multi_get_request &obj)
 typedef struct _multi_get_response__isset
 {
     _multi_get_response__isset()
-        : error(false), kvs(false), app_id(false), partition_index(false), server(false)
+        : error(false),
+          kvs(false),
+          app_id(false),
+          partition_index(false),
+          server(false),
+          resume_sortkey(false)
     {
     }
     bool error : 1;
@@ -813,6 +884,7 @@ typedef struct _multi_get_response__isset
     bool app_id : 1;
     bool partition_index : 1;
     bool server : 1;
+    bool resume_sortkey : 1;
 } _multi_get_response__isset;
 
 class multi_get_response
@@ -830,6 +902,7 @@ public:
     int32_t app_id;
     int32_t partition_index;
     std::string server;
+    ::dsn::blob resume_sortkey;
 
     _multi_get_response__isset __isset;
 
@@ -843,6 +916,8 @@ public:
 
     void __set_server(const std::string &val);
 
+    void __set_resume_sortkey(const ::dsn::blob &val);
+
     bool operator==(const multi_get_response &rhs) const
     {
         if (!(error == rhs.error))
@@ -855,6 +930,8 @@ public:
             return false;
         if (!(server == rhs.server))
             return false;
+        if (!(resume_sortkey == rhs.resume_sortkey))
+            return false;
         return true;
     }
     bool operator!=(const multi_get_response &rhs) const { return !(*this == rhs); }
@@ -875,43 +952,43 @@ inline std::ostream &operator<<(std::ostream &out, const multi_get_response &obj
     return out;
 }
 
-typedef struct _incr_request__isset
+typedef struct _full_key__isset
 {
-    _incr_request__isset() : key(false), increment(false) {}
-    bool key : 1;
-    bool increment : 1;
-} _incr_request__isset;
+    _full_key__isset() : hash_key(false), sort_key(false) {}
+    bool hash_key : 1;
+    bool sort_key : 1;
+} _full_key__isset;
 
-class incr_request
+class full_key
 {
 public:
-    incr_request(const incr_request &);
-    incr_request(incr_request &&);
-    incr_request &operator=(const incr_request &);
-    incr_request &operator=(incr_request &&);
-    incr_request() : increment(0) {}
+    full_key(const full_key &);
+    full_key(full_key &&);
+    full_key &operator=(const full_key &);
+    full_key &operator=(full_key &&);
+    full_key() {}
 
-    virtual ~incr_request() throw();
-    ::dsn::blob key;
-    int64_t increment;
+    virtual ~full_key() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob sort_key;
 
-    _incr_request__isset __isset;
+    _full_key__isset __isset;
 
-    void __set_key(const ::dsn::blob &val);
+    void __set_hash_key(const ::dsn::blob &val);
 
-    void __set_increment(const int64_t val);
+    void __set_sort_key(const ::dsn::blob &val);
 
-    bool operator==(const incr_request &rhs) const
+    bool operator==(const full_key &rhs) const
     {
-        if (!(key == rhs.key))
+        if (!(hash_key == rhs.hash_key))
             return false;
-        if (!(increment == rhs.increment))
+        if (!(sort_key == rhs.sort_key))
             return false;
         return true;
     }
-    bool operator!=(const incr_request &rhs) const { return !(*this == rhs); }
+    bool operator!=(const full_key &rhs) const { return !(*this == rhs); }
 
-    bool operator<(const incr_request &) const;
+    bool operator<(const full_key &) const;
 
     uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
     uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
@@ -919,119 +996,45 @@ public:
     virtual void printTo(std::ostream &out) const;
 };
 
-void swap(incr_request &a, incr_request &b);
+void swap(full_key &a, full_key &b);
 
-inline std::ostream &operator<<(std::ostream &out, const incr_request &obj)
+inline std::ostream &operator<<(std::ostream &out, const full_key &obj)
 {
     obj.printTo(out);
     return out;
 }
 
-typedef struct _get_scanner_request__isset
+typedef struct _batch_get_request__isset
 {
-    _get_scanner_request__isset()
-        : start_key(false),
-          stop_key(false),
-          start_inclusive(false),
-          stop_inclusive(false),
-          batch_size(false),
-          no_value(false),
-          hash_key_filter_type(false),
-          hash_key_filter_pattern(false),
-          sort_key_filter_type(false),
-          sort_key_filter_pattern(false)
-    {
-    }
-    bool start_key : 1;
-    bool stop_key : 1;
-    bool start_inclusive : 1;
-    bool stop_inclusive : 1;
-    bool batch_size : 1;
-    bool no_value : 1;
-    bool hash_key_filter_type : 1;
-    bool hash_key_filter_pattern : 1;
-    bool sort_key_filter_type : 1;
-    bool sort_key_filter_pattern : 1;
-} _get_scanner_request__isset;
+    _batch_get_request__isset() : keys(false) {}
+    bool keys : 1;
+} _batch_get_request__isset;
 
-class get_scanner_request
+class batch_get_request
 {
 public:
-    get_scanner_request(const get_scanner_request &);
-    get_scanner_request(get_scanner_request &&);
-    get_scanner_request &operator=(const get_scanner_request &);
-    get_scanner_request &operator=(get_scanner_request &&);
-    get_scanner_request()
-        : start_inclusive(0),
-          stop_inclusive(0),
-          batch_size(0),
-          no_value(0),
-          hash_key_filter_type((filter_type::type)0),
-          sort_key_filter_type((filter_type::type)0)
-    {
-    }
-
-    virtual ~get_scanner_request() throw();
-    ::dsn::blob start_key;
-    ::dsn::blob stop_key;
-    bool start_inclusive;
-    bool stop_inclusive;
-    int32_t batch_size;
-    bool no_value;
-    filter_type::type hash_key_filter_type;
-    ::dsn::blob hash_key_filter_pattern;
-    filter_type::type sort_key_filter_type;
-    ::dsn::blob sort_key_filter_pattern;
-
-    _get_scanner_request__isset __isset;
-
-    void __set_start_key(const ::dsn::blob &val);
-
-    void __set_stop_key(const ::dsn::blob &val);
-
-    void __set_start_inclusive(const bool val);
-
-    void __set_stop_inclusive(const bool val);
-
-    void __set_batch_size(const int32_t val);
-
-    void __set_no_value(const bool val);
-
-    void __set_hash_key_filter_type(const filter_type::type val);
+    batch_get_request(const batch_get_request &);
+    batch_get_request(batch_get_request &&);
+    batch_get_request &operator=(const batch_get_request &);
+    batch_get_request &operator=(batch_get_request &&);
+    batch_get_request() {}
 
-    void __set_hash_key_filter_pattern(const ::dsn::blob &val);
+    virtual ~batch_get_request() throw();
+    std::vector<full_key> keys;
 
-    void __set_sort_key_filter_type(const filter_type::type val);
+    _batch_get_request__isset __isset;
 
-    void __set_sort_key_filter_pattern(const ::dsn::blob &val);
+    void __set_keys(const std::vector<full_key> &val);
 
-    bool operator==(const get_scanner_request &rhs) const
+    bool operator==(const batch_get_request &rhs) const
     {
-        if (!(start_key == rhs.start_key))
-            return false;
-        if (!(stop_key == rhs.stop_key))
-            return false;
-        if (!(start_inclusive == rhs.start_inclusive))
-            return false;
-        if (!(stop_inclusive == rhs.stop_inclusive))
-            return false;
-        if (!(batch_size == rhs.batch_size))
-            return false;
-        if (!(no_value == rhs.no_value))
-            return false;
-        if (!(hash_key_filter_type == rhs.hash_key_filter_type))
-            return false;
-        if (!(hash_key_filter_pattern == rhs.hash_key_filter_pattern))
-            return false;
-        if (!(sort_key_filter_type == rhs.sort_key_filter_type))
-            return false;
-        if (!(sort_key_filter_pattern == rhs.sort_key_filter_pattern))
+        if (!(keys == rhs.keys))
             return false;
         return true;
     }
-    bool operator!=(const get_scanner_request &rhs) const { return !(*this == rhs); }
+    bool operator!=(const batch_get_request &rhs) const { return !(*this == rhs); }
 
-    bool operator<(const get_scanner_request &) const;
+    bool operator<(const batch_get_request &) const;
 
     uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
     uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
@@ -1039,45 +1042,57 @@ public:
     virtual void printTo(std::ostream &out) const;
 };
 
-void swap(get_scanner_request &a, get_scanner_request &b);
+void swap(batch_get_request &a, batch_get_request &b);
 
-inline std::ostream &operator<<(std::ostream &out, const get_scanner_request &obj)
+inline std::ostream &operator<<(std::ostream &out, const batch_get_request &obj)
 {
     obj.printTo(out);
     return out;
 }
 
-typedef struct _scan_request__isset
+typedef struct _full_data__isset
 {
-    _scan_request__isset() : context_id(false) {}
-    bool context_id : 1;
-} _scan_request__isset;
+    _full_data__isset() : hash_key(false), sort_key(false), value(false) {}
+    bool hash_key : 1;
+    bool sort_key : 1;
+    bool value : 1;
+} _full_data__isset;
 
-class scan_request
+class full_data
 {
 public:
-    scan_request(const scan_request &);
-    scan_request(scan_request &&);
-    scan_request &operator=(const scan_request &);
-    scan_request &operator=(scan_request &&);
-    scan_request() : context_id(0) {}
+    full_data(const full_data &);
+    full_data(full_data &&);
+    full_data &operator=(const full_data &);
+    full_data &operator=(full_data &&);
+    full_data() {}
 
-    virtual ~scan_request() throw();
-    int64_t context_id;
+    virtual ~full_data() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob sort_key;
+    ::dsn::blob value;
 
-    _scan_request__isset __isset;
+    _full_data__isset __isset;
 
-    void __set_context_id(const int64_t val);
+    void __set_hash_key(const ::dsn::blob &val);
 
-    bool operator==(const scan_request &rhs) const
+    void __set_sort_key(const ::dsn::blob &val);
+
+    void __set_value(const ::dsn::blob &val);
+
+    bool operator==(const full_data &rhs) const
     {
-        if (!(context_id == rhs.context_id))
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(sort_key == rhs.sort_key))
+            return false;
+        if (!(value == rhs.value))
             return false;
         return true;
     }
-    bool operator!=(const scan_request &rhs) const { return !(*this == rhs); }
+    bool operator!=(const full_data &rhs) const { return !(*this == rhs); }
 
-    bool operator<(const scan_request &) const;
+    bool operator<(const full_data &) const;
 
     uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
     uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
@@ -1085,57 +1100,48 @@ public:
     virtual void printTo(std::ostream &out) const;
 };
 
-void swap(scan_request &a, scan_request &b);
+void swap(full_data &a, full_data &b);
 
-inline std::ostream &operator<<(std::ostream &out, const scan_request &obj)
+inline std::ostream &operator<<(std::ostream &out, const full_data &obj)
 {
     obj.printTo(out);
     return out;
 }
 
-typedef struct _scan_response__isset
+typedef struct _batch_get_response__isset
 {
-    _scan_response__isset()
-        : error(false),
-          kvs(false),
-          context_id(false),
-          app_id(false),
-          partition_index(false),
-          server(false)
+    _batch_get_response__isset()
+        : error(false), data(false), app_id(false), partition_index(false), server(false)
     {
     }
     bool error : 1;
-    bool kvs : 1;
-    bool context_id : 1;
+    bool data : 1;
     bool app_id : 1;
     bool partition_index : 1;
     bool server : 1;
-} _scan_response__isset;
+} _batch_get_response__isset;
 
-class scan_response
+class batch_get_response
 {
 public:
-    scan_response(const scan_response &);
-    scan_response(scan_response &&);
-    scan_response &operator=(const scan_response &);
-    scan_response &operator=(scan_response &&);
-    scan_response() : error(0), context_id(0), app_id(0), partition_index(0), server() {}
+    batch_get_response(const batch_get_response &);
+    batch_get_response(batch_get_response &&);
+    batch_get_response &operator=(const batch_get_response &);
+    batch_get_response &operator=(batch_get_response &&);
+    batch_get_response() : error(0), app_id(0), partition_index(0), server() {}
 
-    virtual ~scan_response() throw();
+    virtual ~batch_get_response() throw();
     int32_t error;
-    std::vector<key_value> kvs;
-    int64_t context_id;
+    std::vector<full_data> data;
     int32_t app_id;
     int32_t partition_index;
     std::string server;
 
-    _scan_response__isset __isset;
+    _batch_get_response__isset __isset;
 
     void __set_error(const int32_t val);
 
-    void __set_kvs(const std::vector<key_value> &val);
-
-    void __set_context_id(const int64_t val);
+    void __set_data(const std::vector<full_data> &val);
 
     void __set_app_id(const int32_t val);
 
@@ -1143,13 +1149,11 @@ public:
 
     void __set_server(const std::string &val);
 
-    bool operator==(const scan_response &rhs) const
+    bool operator==(const batch_get_response &rhs) const
     {
         if (!(error == rhs.error))
             return false;
-        if (!(kvs == rhs.kvs))
-            return false;
-        if (!(context_id == rhs.context_id))
+        if (!(data == rhs.data))
             return false;
         if (!(app_id == rhs.app_id))
             return false;
@@ -1159,6 +1163,1273 @@ public:
             return false;
         return true;
     }
+    bool operator!=(const batch_get_response &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const batch_get_response &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(batch_get_response &a, batch_get_response &b);
+
+inline std::ostream &operator<<(std::ostream &out, const batch_get_response &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _incr_request__isset
+{
+    _incr_request__isset() : key(false), increment(false) {}
+    bool key : 1;
+    bool increment : 1;
+} _incr_request__isset;
+
+class incr_request
+{
+public:
+    incr_request(const incr_request &);
+    incr_request(incr_request &&);
+    incr_request &operator=(const incr_request &);
+    incr_request &operator=(incr_request &&);
+    incr_request() : increment(0) {}
+
+    virtual ~incr_request() throw();
+    ::dsn::blob key;
+    int64_t increment;
+
+    _incr_request__isset __isset;
+
+    void __set_key(const ::dsn::blob &val);
+
+    void __set_increment(const int64_t val);
+
+    bool operator==(const incr_request &rhs) const
+    {
+        if (!(key == rhs.key))
+            return false;
+        if (!(increment == rhs.increment))
+            return false;
+        return true;
+    }
+    bool operator!=(const incr_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const incr_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(incr_request &a, incr_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const incr_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _incr_response__isset
+{
+    _incr_response__isset()
+        : error(false),
+          new_value(false),
+          app_id(false),
+          partition_index(false),
+          decree(false),
+          server(false)
+    {
+    }
+    bool error : 1;
+    bool new_value : 1;
+    bool app_id : 1;
+    bool partition_index : 1;
+    bool decree : 1;
+    bool server : 1;
+} _incr_response__isset;
+
+class incr_response
+{
+public:
+    incr_response(const incr_response &);
+    incr_response(incr_response &&);
+    incr_response &operator=(const incr_response &);
+    incr_response &operator=(incr_response &&);
+    incr_response() : error(0), new_value(0), app_id(0), partition_index(0), decree(0), server() {}
+
+    virtual ~incr_response() throw();
+    int32_t error;
+    int64_t new_value;
+    int32_t app_id;
+    int32_t partition_index;
+    int64_t decree;
+    std::string server;
+
+    _incr_response__isset __isset;
+
+    void __set_error(const int32_t val);
+
+    void __set_new_value(const int64_t val);
+
+    void __set_app_id(const int32_t val);
+
+    void __set_partition_index(const int32_t val);
+
+    void __set_decree(const int64_t val);
+
+    void __set_server(const std::string &val);
+
+    bool operator==(const incr_response &rhs) const
+    {
+        if (!(error == rhs.error))
+            return false;
+        if (!(new_value == rhs.new_value))
+            return false;
+        if (!(app_id == rhs.app_id))
+            return false;
+        if (!(partition_index == rhs.partition_index))
+            return false;
+        if (!(decree == rhs.decree))
+            return false;
+        if (!(server == rhs.server))
+            return false;
+        return true;
+    }
+    bool operator!=(const incr_response &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const incr_response &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(incr_response &a, incr_response &b);
+
+inline std::ostream &operator<<(std::ostream &out, const incr_response &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _check_and_set_request__isset
+{
+    _check_and_set_request__isset()
+        : hash_key(false),
+          check_sort_key(false),
+          check_type(false),
+          check_operand(false),
+          set_diff_sort_key(false),
+          set_sort_key(false),
+          set_value(false),
+          set_expire_ts_seconds(false),
+          return_check_value(false)
+    {
+    }
+    bool hash_key : 1;
+    bool check_sort_key : 1;
+    bool check_type : 1;
+    bool check_operand : 1;
+    bool set_diff_sort_key : 1;
+    bool set_sort_key : 1;
+    bool set_value : 1;
+    bool set_expire_ts_seconds : 1;
+    bool return_check_value : 1;
+} _check_and_set_request__isset;
+
+class check_and_set_request
+{
+public:
+    check_and_set_request(const check_and_set_request &);
+    check_and_set_request(check_and_set_request &&);
+    check_and_set_request &operator=(const check_and_set_request &);
+    check_and_set_request &operator=(check_and_set_request &&);
+    check_and_set_request()
+        : check_type((cas_check_type::type)0),
+          set_diff_sort_key(0),
+          set_expire_ts_seconds(0),
+          return_check_value(0)
+    {
+    }
+
+    virtual ~check_and_set_request() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob check_sort_key;
+    cas_check_type::type check_type;
+    ::dsn::blob check_operand;
+    bool set_diff_sort_key;
+    ::dsn::blob set_sort_key;
+    ::dsn::blob set_value;
+    int32_t set_expire_ts_seconds;
+    bool return_check_value;
+
+    _check_and_set_request__isset __isset;
+
+    void __set_hash_key(const ::dsn::blob &val);
+
+    void __set_check_sort_key(const ::dsn::blob &val);
+
+    void __set_check_type(const cas_check_type::type val);
+
+    void __set_check_operand(const ::dsn::blob &val);
+
+    void __set_set_diff_sort_key(const bool val);
+
+    void __set_set_sort_key(const ::dsn::blob &val);
+
+    void __set_set_value(const ::dsn::blob &val);
+
+    void __set_set_expire_ts_seconds(const int32_t val);
+
+    void __set_return_check_value(const bool val);
+
+    bool operator==(const check_and_set_request &rhs) const
+    {
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(check_sort_key == rhs.check_sort_key))
+            return false;
+        if (!(check_type == rhs.check_type))
+            return false;
+        if (!(check_operand == rhs.check_operand))
+            return false;
+        if (!(set_diff_sort_key == rhs.set_diff_sort_key))
+            return false;
+        if (!(set_sort_key == rhs.set_sort_key))
+            return false;
+        if (!(set_value == rhs.set_value))
+            return false;
+        if (!(set_expire_ts_seconds == rhs.set_expire_ts_seconds))
+            return false;
+        if (!(return_check_value == rhs.return_check_value))
+            return false;
+        return true;
+    }
+    bool operator!=(const check_and_set_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const check_and_set_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(check_and_set_request &a, check_and_set_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const check_and_set_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _check_and_set_response__isset
+{
+    _check_and_set_response__isset()
+        : error(false),
+          check_value_returned(false),
+          check_value_exist(false),
+          check_value(false),
+          app_id(false),
+          partition_index(false),
+          decree(false),
+          server(false)
+    {
+    }
+    bool error : 1;
+    bool check_value_returned : 1;
+    bool check_value_exist : 1;
+    bool check_value : 1;
+    bool app_id : 1;
+    bool partition_index : 1;
+    bool decree : 1;
+    bool server : 1;
+} _check_and_set_response__isset;
+
+class check_and_set_response
+{
+public:
+    check_and_set_response(const check_and_set_response &);
+    check_and_set_response(check_and_set_response &&);
+    check_and_set_response &operator=(const check_and_set_response &);
+    check_and_set_response &operator=(check_and_set_response &&);
+    check_and_set_response()
+        : error(0),
+          check_value_returned(0),
+          check_value_exist(0),
+          app_id(0),
+          partition_index(0),
+          decree(0),
+          server()
+    {
+    }
+
+    virtual ~check_and_set_response() throw();
+    int32_t error;
+    bool check_value_returned;
+    bool check_value_exist;
+    ::dsn::blob check_value;
+    int32_t app_id;
+    int32_t partition_index;
+    int64_t decree;
+    std::string server;
+
+    _check_and_set_response__isset __isset;
+
+    void __set_error(const int32_t val);
+
+    void __set_check_value_returned(const bool val);
+
+    void __set_check_value_exist(const bool val);
+
+    void __set_check_value(const ::dsn::blob &val);
+
+    void __set_app_id(const int32_t val);
+
+    void __set_partition_index(const int32_t val);
+
+    void __set_decree(const int64_t val);
+
+    void __set_server(const std::string &val);
+
+    bool operator==(const check_and_set_response &rhs) const
+    {
+        if (!(error == rhs.error))
+            return false;
+        if (!(check_value_returned == rhs.check_value_returned))
+            return false;
+        if (!(check_value_exist == rhs.check_value_exist))
+            return false;
+        if (!(check_value == rhs.check_value))
+            return false;
+        if (!(app_id == rhs.app_id))
+            return false;
+        if (!(partition_index == rhs.partition_index))
+            return false;
+        if (!(decree == rhs.decree))
+            return false;
+        if (!(server == rhs.server))
+            return false;
+        return true;
+    }
+    bool operator!=(const check_and_set_response &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const check_and_set_response &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(check_and_set_response &a, check_and_set_response &b);
+
+inline std::ostream &operator<<(std::ostream &out, const check_and_set_response &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _mutate__isset
+{
+    _mutate__isset() : operation(false), sort_key(false), value(false), set_expire_ts_seconds(false)
+    {
+    }
+    bool operation : 1;
+    bool sort_key : 1;
+    bool value : 1;
+    bool set_expire_ts_seconds : 1;
+} _mutate__isset;
+
+class mutate
+{
+public:
+    mutate(const mutate &);
+    mutate(mutate &&);
+    mutate &operator=(const mutate &);
+    mutate &operator=(mutate &&);
+    mutate() : operation((mutate_operation::type)0), set_expire_ts_seconds(0) {}
+
+    virtual ~mutate() throw();
+    mutate_operation::type operation;
+    ::dsn::blob sort_key;
+    ::dsn::blob value;
+    int32_t set_expire_ts_seconds;
+
+    _mutate__isset __isset;
+
+    void __set_operation(const mutate_operation::type val);
+
+    void __set_sort_key(const ::dsn::blob &val);
+
+    void __set_value(const ::dsn::blob &val);
+
+    void __set_set_expire_ts_seconds(const int32_t val);
+
+    bool operator==(const mutate &rhs) const
+    {
+        if (!(operation == rhs.operation))
+            return false;
+        if (!(sort_key == rhs.sort_key))
+            return false;
+        if (!(value == rhs.value))
+            return false;
+        if (!(set_expire_ts_seconds == rhs.set_expire_ts_seconds))
+            return false;
+        return true;
+    }
+    bool operator!=(const mutate &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const mutate &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(mutate &a, mutate &b);
+
+inline std::ostream &operator<<(std::ostream &out, const mutate &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _check_and_mutate_request__isset
+{
+    _check_and_mutate_request__isset()
+        : hash_key(false),
+          check_sort_key(false),
+          check_type(false),
+          check_operand(false),
+          mutate_list(false),
+          return_check_value(false)
+    {
+    }
+    bool hash_key : 1;
+    bool check_sort_key : 1;
+    bool check_type : 1;
+    bool check_operand : 1;
+    bool mutate_list : 1;
+    bool return_check_value : 1;
+} _check_and_mutate_request__isset;
+
+class check_and_mutate_request
+{
+public:
+    check_and_mutate_request(const check_and_mutate_request &);
+    check_and_mutate_request(check_and_mutate_request &&);
+    check_and_mutate_request &operator=(const check_and_mutate_request &);
+    check_and_mutate_request &operator=(check_and_mutate_request &&);
+    check_and_mutate_request() : check_type((cas_check_type::type)0), return_check_value(0) {}
+
+    virtual ~check_and_mutate_request() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob check_sort_key;
+    cas_check_type::type check_type;
+    ::dsn::blob check_operand;
+    std::vector<mutate> mutate_list;
+    bool return_check_value;
+
+    _check_and_mutate_request__isset __isset;
+
+    void __set_hash_key(const ::dsn::blob &val);
+
+    void __set_check_sort_key(const ::dsn::blob &val);
+
+    void __set_check_type(const cas_check_type::type val);
+
+    void __set_check_operand(const ::dsn::blob &val);
+
+    void __set_mutate_list(const std::vector<mutate> &val);
+
+    void __set_return_check_value(const bool val);
+
+    bool operator==(const check_and_mutate_request &rhs) const
+    {
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(check_sort_key == rhs.check_sort_key))
+            return false;
+        if (!(check_type == rhs.check_type))
+            return false;
+        if (!(check_operand == rhs.check_operand))
+            return false;
+        if (!(mutate_list == rhs.mutate_list))
+            return false;
+        if (!(return_check_value == rhs.return_check_value))
+            return false;
+        return true;
+    }
+    bool operator!=(const check_and_mutate_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const check_and_mutate_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(check_and_mutate_request &a, check_and_mutate_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const check_and_mutate_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _check_and_mutate_response__isset
+{
+    _check_and_mutate_response__isset()
+        : error(false),
+          check_value_returned(false),
+          check_value_exist(false),
+          check_value(false),
+          app_id(false),
+          partition_index(false),
+          decree(false),
+          server(false)
+    {
+    }
+    bool error : 1;
+    bool check_value_returned : 1;
+    bool check_value_exist : 1;
+    bool check_value : 1;
+    bool app_id : 1;
+    bool partition_index : 1;
+    bool decree : 1;
+    bool server : 1;
+} _check_and_mutate_response__isset;
+
+class check_and_mutate_response
+{
+public:
+    check_and_mutate_response(const check_and_mutate_response &);
+    check_and_mutate_response(check_and_mutate_response &&);
+    check_and_mutate_response &operator=(const check_and_mutate_response &);
+    check_and_mutate_response &operator=(check_and_mutate_response &&);
+    check_and_mutate_response()
+        : error(0),
+          check_value_returned(0),
+          check_value_exist(0),
+          app_id(0),
+          partition_index(0),
+          decree(0),
+          server()
+    {
+    }
+
+    virtual ~check_and_mutate_response() throw();
+    int32_t error;
+    bool check_value_returned;
+    bool check_value_exist;
+    ::dsn::blob check_value;
+    int32_t app_id;
+    int32_t partition_index;
+    int64_t decree;
+    std::string server;
+
+    _check_and_mutate_response__isset __isset;
+
+    void __set_error(const int32_t val);
+
+    void __set_check_value_returned(const bool val);
+
+    void __set_check_value_exist(const bool val);
+
+    void __set_check_value(const ::dsn::blob &val);
+
+    void __set_app_id(const int32_t val);
+
+    void __set_partition_index(const int32_t val);
+
+    void __set_decree(const int64_t val);
+
+    void __set_server(const std::string &val);
+
+    bool operator==(const check_and_mutate_response &rhs) const
+    {
+        if (!(error == rhs.error))
+            return false;
+        if (!(check_value_returned == rhs.check_value_returned))
+            return false;
+        if (!(check_value_exist == rhs.check_value_exist))
+            return false;
+        if (!(check_value == rhs.check_value))
+            return false;
+        if (!(app_id == rhs.app_id))
+            return false;
+        if (!(partition_index == rhs.partition_index))
+            return false;
+        if (!(decree == rhs.decree))
+            return false;
+        if (!(server == rhs.server))
+            return false;
+        return true;
+    }
+    bool operator!=(const check_and_mutate_response &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const check_and_mutate_response &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(check_and_mutate_response &a, check_and_mutate_response &b);
+
+inline std::ostream &operator<<(std::ostream &out, const check_and_mutate_response &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _del_range_request__isset
+{
+    _del_range_request__isset()
+        : hash_key(false),
+          start_sort_key(false),
+          stop_sort_key(false),
+          start_inclusive(false),
+          stop_inclusive(false)
+    {
+    }
+    bool hash_key : 1;
+    bool start_sort_key : 1;
+    bool stop_sort_key : 1;
+    bool start_inclusive : 1;
+    bool stop_inclusive : 1;
+} _del_range_request__isset;
+
+class del_range_request
+{
+public:
+    del_range_request(const del_range_request &);
+    del_range_request(del_range_request &&);
+    del_range_request &operator=(const del_range_request &);
+    del_range_request &operator=(del_range_request &&);
+    del_range_request() : start_inclusive(0), stop_inclusive(0) {}
+
+    virtual ~del_range_request() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob start_sort_key;
+    ::dsn::blob stop_sort_key;
+    bool start_inclusive;
+    bool stop_inclusive;
+
+    _del_range_request__isset __isset;
+
+    void __set_hash_key(const ::dsn::blob &val);
+
+    void __set_start_sort_key(const ::dsn::blob &val);
+
+    void __set_stop_sort_key(const ::dsn::blob &val);
+
+    void __set_start_inclusive(const bool val);
+
+    void __set_stop_inclusive(const bool val);
+
+    bool operator==(const del_range_request &rhs) const
+    {
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(start_sort_key == rhs.start_sort_key))
+            return false;
+        if (!(stop_sort_key == rhs.stop_sort_key))
+            return false;
+        if (!(start_inclusive == rhs.start_inclusive))
+            return false;
+        if (!(stop_inclusive == rhs.stop_inclusive))
+            return false;
+        return true;
+    }
+    bool operator!=(const del_range_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const del_range_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(del_range_request &a, del_range_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const del_range_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _get_scanner_request__isset
+{
+    _get_scanner_request__isset()
+        : start_key(false),
+          stop_key(false),
+          start_inclusive(false),
+          stop_inclusive(false),
+          batch_size(false),
+          no_value(false),
+          hash_key_filter_type(false),
+          hash_key_filter_pattern(false),
+          sort_key_filter_type(false),
+          sort_key_filter_pattern(false),
+          max_iteration_count(false),
+          max_iteration_time_ms(false),
+          max_response_bytes(false),
+          full_scan(false),
+          aggregate(false),
+          aggregate_top_count(false)
+    {
+    }
+    bool start_key : 1;
+    bool stop_key : 1;
+    bool start_inclusive : 1;
+    bool stop_inclusive : 1;
+    bool batch_size : 1;
+    bool no_value : 1;
+    bool hash_key_filter_type : 1;
+    bool hash_key_filter_pattern : 1;
+    bool sort_key_filter_type : 1;
+    bool sort_key_filter_pattern : 1;
+    bool max_iteration_count : 1;
+    bool max_iteration_time_ms : 1;
+    bool max_response_bytes : 1;
+    bool full_scan : 1;
+    bool aggregate : 1;
+    bool aggregate_top_count : 1;
+} _get_scanner_request__isset;
+
+class get_scanner_request
+{
+public:
+    get_scanner_request(const get_scanner_request &);
+    get_scanner_request(get_scanner_request &&);
+    get_scanner_request &operator=(const get_scanner_request &);
+    get_scanner_request &operator=(get_scanner_request &&);
+    get_scanner_request()
+        : start_inclusive(0),
+          stop_inclusive(0),
+          batch_size(0),
+          no_value(0),
+          hash_key_filter_type((filter_type::type)0),
+          sort_key_filter_type((filter_type::type)0),
+          max_iteration_count(0),
+          max_iteration_time_ms(0),
+          max_response_bytes(0),
+          full_scan(0),
+          aggregate(0),
+          aggregate_top_count(0)
+    {
+    }
+
+    virtual ~get_scanner_request() throw();
+    ::dsn::blob start_key;
+    ::dsn::blob stop_key;
+    bool start_inclusive;
+    bool stop_inclusive;
+    int32_t batch_size;
+    bool no_value;
+    filter_type::type hash_key_filter_type;
+    ::dsn::blob hash_key_filter_pattern;
+    filter_type::type sort_key_filter_type;
+    ::dsn::blob sort_key_filter_pattern;
+    int32_t max_iteration_count;
+    int32_t max_iteration_time_ms;
+    int32_t max_response_bytes;
+    bool full_scan;
+    bool aggregate;
+    int32_t aggregate_top_count;
+
+    _get_scanner_request__isset __isset;
+
+    void __set_start_key(const ::dsn::blob &val);
+
+    void __set_stop_key(const ::dsn::blob &val);
+
+    void __set_start_inclusive(const bool val);
+
+    void __set_stop_inclusive(const bool val);
+
+    void __set_batch_size(const int32_t val);
+
+    void __set_no_value(const bool val);
+
+    void __set_hash_key_filter_type(const filter_type::type val);
+
+    void __set_hash_key_filter_pattern(const ::dsn::blob &val);
+
+    void __set_sort_key_filter_type(const filter_type::type val);
+
+    void __set_sort_key_filter_pattern(const ::dsn::blob &val);
+
+    void __set_max_iteration_count(const int32_t val);
+
+    void __set_max_iteration_time_ms(const int32_t val);
+
+    void __set_max_response_bytes(const int32_t val);
+
+    void __set_full_scan(const bool val);
+
+    void __set_aggregate(const bool val);
+
+    void __set_aggregate_top_count(const int32_t val);
+
+    bool operator==(const get_scanner_request &rhs) const
+    {
+        if (!(start_key == rhs.start_key))
+            return false;
+        if (!(stop_key == rhs.stop_key))
+            return false;
+        if (!(start_inclusive == rhs.start_inclusive))
+            return false;
+        if (!(stop_inclusive == rhs.stop_inclusive))
+            return false;
+        if (!(batch_size == rhs.batch_size))
+            return false;
+        if (!(no_value == rhs.no_value))
+            return false;
+        if (!(hash_key_filter_type == rhs.hash_key_filter_type))
+            return false;
+        if (!(hash_key_filter_pattern == rhs.hash_key_filter_pattern))
+            return false;
+        if (!(sort_key_filter_type == rhs.sort_key_filter_type))
+            return false;
+        if (!(sort_key_filter_pattern == rhs.sort_key_filter_pattern))
+            return false;
+        if (!(max_iteration_count == rhs.max_iteration_count))
+            return false;
+        if (!(max_iteration_time_ms == rhs.max_iteration_time_ms))
+            return false;
+        if (!(max_response_bytes == rhs.max_response_bytes))
+            return false;
+        if (!(full_scan == rhs.full_scan))
+            return false;
+        if (!(aggregate == rhs.aggregate))
+            return false;
+        if (!(aggregate_top_count == rhs.aggregate_top_count))
+            return false;
+        return true;
+    }
+    bool operator!=(const get_scanner_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const get_scanner_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(get_scanner_request &a, get_scanner_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const get_scanner_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _scan_request__isset
+{
+    _scan_request__isset() : context_id(false), batch_size(false) {}
+    bool context_id : 1;
+    bool batch_size : 1;
+} _scan_request__isset;
+
+class scan_request
+{
+public:
+    scan_request(const scan_request &);
+    scan_request(scan_request &&);
+    scan_request &operator=(const scan_request &);
+    scan_request &operator=(scan_request &&);
+    scan_request() : context_id(0), batch_size(0) {}
+
+    virtual ~scan_request() throw();
+    int64_t context_id;
+    int32_t batch_size;
+
+    _scan_request__isset __isset;
+
+    void __set_context_id(const int64_t val);
+
+    void __set_batch_size(const int32_t val);
+
+    bool operator==(const scan_request &rhs) const
+    {
+        if (!(context_id == rhs.context_id))
+            return false;
+        if (!(batch_size == rhs.batch_size))
+            return false;
+        return true;
+    }
+    bool operator!=(const scan_request &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const scan_request &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(scan_request &a, scan_request &b);
+
+inline std::ostream &operator<<(std::ostream &out, const scan_request &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _scan_row_stat__isset
+{
+    _scan_row_stat__isset() : hash_key(false), sort_key(false), size(false) {}
+    bool hash_key : 1;
+    bool sort_key : 1;
+    bool size : 1;
+} _scan_row_stat__isset;
+
+class scan_row_stat
+{
+public:
+    scan_row_stat(const scan_row_stat &);
+    scan_row_stat(scan_row_stat &&);
+    scan_row_stat &operator=(const scan_row_stat &);
+    scan_row_stat &operator=(scan_row_stat &&);
+    scan_row_stat() : size(0) {}
+
+    virtual ~scan_row_stat() throw();
+    ::dsn::blob hash_key;
+    ::dsn::blob sort_key;
+    int64_t size;
+
+    _scan_row_stat__isset __isset;
+
+    void __set_hash_key(const ::dsn::blob &val);
+
+    void __set_sort_key(const ::dsn::blob &val);
+
+    void __set_size(const int64_t val);
+
+    bool operator==(const scan_row_stat &rhs) const
+    {
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(sort_key == rhs.sort_key))
+            return false;
+        if (!(size == rhs.size))
+            return false;
+        return true;
+    }
+    bool operator!=(const scan_row_stat &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const scan_row_stat &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(scan_row_stat &a, scan_row_stat &b);
+
+inline std::ostream &operator<<(std::ostream &out, const scan_row_stat &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _scan_hash_key_stat__isset
+{
+    _scan_hash_key_stat__isset() : hash_key(false), sort_key_count(false), size(false) {}
+    bool hash_key : 1;
+    bool sort_key_count : 1;
+    bool size : 1;
+} _scan_hash_key_stat__isset;
+
+class scan_hash_key_stat
+{
+public:
+    scan_hash_key_stat(const scan_hash_key_stat &);
+    scan_hash_key_stat(scan_hash_key_stat &&);
+    scan_hash_key_stat &operator=(const scan_hash_key_stat &);
+    scan_hash_key_stat &operator=(scan_hash_key_stat &&);
+    scan_hash_key_stat() : sort_key_count(0), size(0) {}
+
+    virtual ~scan_hash_key_stat() throw();
+    ::dsn::blob hash_key;
+    int64_t sort_key_count;
+    int64_t size;
+
+    _scan_hash_key_stat__isset __isset;
+
+    void __set_hash_key(const ::dsn::blob &val);
+
+    void __set_sort_key_count(const int64_t val);
+
+    void __set_size(const int64_t val);
+
+    bool operator==(const scan_hash_key_stat &rhs) const
+    {
+        if (!(hash_key == rhs.hash_key))
+            return false;
+        if (!(sort_key_count == rhs.sort_key_count))
+            return false;
+        if (!(size == rhs.size))
+            return false;
+        return true;
+    }
+    bool operator!=(const scan_hash_key_stat &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const scan_hash_key_stat &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(scan_hash_key_stat &a, scan_hash_key_stat &b);
+
+inline std::ostream &operator<<(std::ostream &out, const scan_hash_key_stat &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _scan_aggregate__isset
+{
+    _scan_aggregate__isset()
+        : row_count(false),
+          hash_key_size_sum(false),
+          hash_key_size_max(false),
+          sort_key_size_sum(false),
+          sort_key_size_max(false),
+          value_size_sum(false),
+          value_size_max(false),
+          row_size_max(false),
+          top_rows(false),
+          hash_key_count(false),
+          sort_key_count_max(false),
+          top_hash_keys(false),
+          edge_hash_keys(false),
+          last_key(false)
+    {
+    }
+    bool row_count : 1;
+    bool hash_key_size_sum : 1;
+    bool hash_key_size_max : 1;
+    bool sort_key_size_sum : 1;
+    bool sort_key_size_max : 1;
+    bool value_size_sum : 1;
+    bool value_size_max : 1;
+    bool row_size_max : 1;
+    bool top_rows : 1;
+    bool hash_key_count : 1;
+    bool sort_key_count_max : 1;
+    bool top_hash_keys : 1;
+    bool edge_hash_keys : 1;
+    bool last_key : 1;
+} _scan_aggregate__isset;
+
+class scan_aggregate
+{
+public:
+    scan_aggregate(const scan_aggregate &);
+    scan_aggregate(scan_aggregate &&);
+    scan_aggregate &operator=(const scan_aggregate &);
+    scan_aggregate &operator=(scan_aggregate &&);
+    scan_aggregate()
+        : row_count(0),
+          hash_key_size_sum(0),
+          hash_key_size_max(0),
+          sort_key_size_sum(0),
+          sort_key_size_max(0),
+          value_size_sum(0),
+          value_size_max(0),
+          row_size_max(0),
+          hash_key_count(0),
+          sort_key_count_max(0)
+    {
+    }
+
+    virtual ~scan_aggregate() throw();
+    int64_t row_count;
+    int64_t hash_key_size_sum;
+    int64_t hash_key_size_max;
+    int64_t sort_key_size_sum;
+    int64_t sort_key_size_max;
+    int64_t value_size_sum;
+    int64_t value_size_max;
+    int64_t row_size_max;
+    std::vector<scan_row_stat> top_rows;
+    int64_t hash_key_count;
+    int64_t sort_key_count_max;
+    std::vector<scan_hash_key_stat> top_hash_keys;
+    std::vector<scan_hash_key_stat> edge_hash_keys;
+    ::dsn::blob last_key;
+
+    _scan_aggregate__isset __isset;
+
+    void __set_row_count(const int64_t val);
+
+    void __set_hash_key_size_sum(const int64_t val);
+
+    void __set_hash_key_size_max(const int64_t val);
+
+    void __set_sort_key_size_sum(const int64_t val);
+
+    void __set_sort_key_size_max(const int64_t val);
+
+    void __set_value_size_sum(const int64_t val);
+
+    void __set_value_size_max(const int64_t val);
+
+    void __set_row_size_max(const int64_t val);
+
+    void __set_top_rows(const std::vector<scan_row_stat> &val);
+
+    void __set_hash_key_count(const int64_t val);
+
+    void __set_sort_key_count_max(const int64_t val);
+
+    void __set_top_hash_keys(const std::vector<scan_hash_key_stat> &val);
+
+    void __set_edge_hash_keys(const std::vector<scan_hash_key_stat> &val);
+
+    void __set_last_key(const ::dsn::blob &val);
+
+    bool operator==(const scan_aggregate &rhs) const
+    {
+        if (!(row_count == rhs.row_count))
+            return false;
+        if (!(hash_key_size_sum == rhs.hash_key_size_sum))
+            return false;
+        if (!(hash_key_size_max == rhs.hash_key_size_max))
+            return false;
+        if (!(sort_key_size_sum == rhs.sort_key_size_sum))
+            return false;
+        if (!(sort_key_size_max == rhs.sort_key_size_max))
+            return false;
+        if (!(value_size_sum == rhs.value_size_sum))
+            return false;
+        if (!(value_size_max == rhs.value_size_max))
+            return false;
+        if (!(row_size_max == rhs.row_size_max))
+            return false;
+        if (!(top_rows == rhs.top_rows))
+            return false;
+        if (!(hash_key_count == rhs.hash_key_count))
+            return false;
+        if (!(sort_key_count_max == rhs.sort_key_count_max))
+            return false;
+        if (!(top_hash_keys == rhs.top_hash_keys))
+            return false;
+        if (!(edge_hash_keys == rhs.edge_hash_keys))
+            return false;
+        if (!(last_key == rhs.last_key))
+            return false;
+        return true;
+    }
+    bool operator!=(const scan_aggregate &rhs) const { return !(*this == rhs); }
+
+    bool operator<(const scan_aggregate &) const;
+
+    uint32_t read(::apache::thrift::protocol::TProtocol *iprot);
+    uint32_t write(::apache::thrift::protocol::TProtocol *oprot) const;
+
+    virtual void printTo(std::ostream &out) const;
+};
+
+void swap(scan_aggregate &a, scan_aggregate &b);
+
+inline std::ostream &operator<<(std::ostream &out, const scan_aggregate &obj)
+{
+    obj.printTo(out);
+    return out;
+}
+
+typedef struct _scan_response__isset
+{
+    _scan_response__isset()
+        : error(false),
+          kvs(false),
+          context_id(false),
+          app_id(false),
+          partition_index(false),
+          server(false),
+          aggregate(false)
+    {
+    }
+    bool error : 1;
+    bool kvs : 1;
+    bool context_id : 1;
+    bool app_id : 1;
+    bool partition_index : 1;
+    bool server : 1;
+    bool aggregate : 1;
+} _scan_response__isset;
+
+class scan_response
+{
+public:
+    scan_response(const scan_response &);
+    scan_response(scan_response &&);
+    scan_response &operator=(const scan_response &);
+    scan_response &operator=(scan_response &&);
+    scan_response() : error(0), context_id(0), app_id(0), partition_index(0), server() {}
+
+    virtual ~scan_response() throw();
+    int32_t error;
+    std::vector<key_value> kvs;
+    int64_t context_id;
+    int32_t app_id;
+    int32_t partition_index;
+    std::string server;
+    scan_aggregate aggregate;
+
+    _scan_response__isset __isset;
+
+    void __set_error(const int32_t val);
+
+    void __set_kvs(const std::vector<key_value> &val);
+
+    void __set_context_id(const int64_t val);
+
+    void __set_app_id(const int32_t val);
+
+    void __set_partition_index(const int32_t val);
+
+    void __set_server(const std::string &val);
+
+    void __set_aggregate(const scan_aggregate &val);
+
+    bool operator==(const scan_response &rhs) const
+    {
+        if (!(error == rhs.error))
+            return false;
+        if (!(kvs == rhs.kvs))
+            return false;
+        if (!(context_id == rhs.context_id))
+            return false;
+        if (!(app_id == rhs.app_id))
+            return false;
+        if (!(partition_index == rhs.partition_index))
+            return false;
+        if (!(server == rhs.server))
+            return false;
+        if (!(aggregate == rhs.aggregate))
+            return false;
+        return true;
+    }
     bool operator!=(const scan_response &rhs) const { return !(*this == rhs); }
 
     bool operator<(const scan_response &) const;
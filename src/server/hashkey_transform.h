@@ -0,0 +1,60 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdint.h>
+#include <rocksdb/slice.h>
+#include <rocksdb/slice_transform.h>
+#include <dsn/utility/ports.h>
+
+namespace pegasus {
+namespace server {
+
+// Prefix extractor of rocksdb key: [hash_key_len(uint16_t)] [hash_key(bytes)] [sort_key(bytes)]
+// The prefix is [hash_key_len][hash_key], so that all records of one hash key share the same
+// prefix, which enables prefix bloom filter for the hash-key-scoped reads, e.g. multi_get,
+// sortkey_count and scan on one hash key.
+class HashkeyTransform : public rocksdb::SliceTransform
+{
+public:
+    HashkeyTransform() = default;
+
+    virtual const char *Name() const override { return "pegasus.HashkeyTransform"; }
+
+    virtual rocksdb::Slice Transform(const rocksdb::Slice &src) const override
+    {
+        // only called when InDomain(src) is true
+        // hash_key_len is in big endian
+        uint16_t hash_key_len = be16toh(*(int16_t *)(src.data()));
+        return rocksdb::Slice(src.data(), 2 + hash_key_len);
+    }
+
+    virtual bool InDomain(const rocksdb::Slice &src) const override
+    {
+        // keys shorter than the complete hash key are not in domain, e.g. the keys generated
+        // by pegasus_generate_next_blob() may be truncated.
+        if (src.size() < 2) {
+            return false;
+        }
+        uint16_t hash_key_len = be16toh(*(int16_t *)(src.data()));
+        return src.size() >= 2 + hash_key_len;
+    }
+
+    virtual bool InRange(const rocksdb::Slice &dst) const override
+    {
+        if (dst.size() < 2) {
+            return false;
+        }
+        uint16_t hash_key_len = be16toh(*(int16_t *)(dst.data()));
+        return dst.size() == 2 + hash_key_len;
+    }
+
+    virtual bool SameResultWhenAppended(const rocksdb::Slice &prefix) const override
+    {
+        return false;
+    }
+};
+}
+} // namespace
@@ -8,9 +8,11 @@
 #include <atomic>
 #include <rocksdb/compaction_filter.h>
 #include <rocksdb/merge_operator.h>
+#include <dsn/service_api_c.h>
 
 #include "base/pegasus_utils.h"
 #include "base/pegasus_value_schema.h"
+#include "pegasus_blob_store.h"
 
 namespace pegasus {
 namespace server {
@@ -18,36 +20,109 @@ namespace server {
 class KeyWithTTLCompactionFilter : public rocksdb::CompactionFilter
 {
 public:
-    KeyWithTTLCompactionFilter() : _value_schema_version(0), _enabled(false) {}
+    KeyWithTTLCompactionFilter(uint32_t value_schema_version,
+                               bool enabled,
+                               const std::shared_ptr<pegasus_blob_store> &blob_store)
+        : _value_schema_version(value_schema_version), _enabled(enabled), _blob_store(blob_store)
+    {
+    }
     virtual bool Filter(int /*level*/,
                         const rocksdb::Slice &key,
                         const rocksdb::Slice &existing_value,
                         std::string *new_value,
                         bool *value_changed) const override
     {
-        if (!_enabled.load(std::memory_order_acquire))
+        if (!_enabled)
             return false;
-        return check_if_record_expired(
-            _value_schema_version, utils::epoch_now(), utils::to_string_view(existing_value));
+        if (check_if_record_expired(
+                _value_schema_version, utils::epoch_now(), utils::to_string_view(existing_value)))
+            return true;
+        if (_blob_store != nullptr &&
+            pegasus_value_is_blob_index(_value_schema_version,
+                                        utils::to_string_view(existing_value))) {
+            relocate_blob(key, existing_value, new_value, value_changed);
+        }
+        return false;
     }
     virtual const char *Name() const override { return "KeyWithTTLCompactionFilter"; }
-    void SetValueSchemaVersion(uint32_t version) { _value_schema_version = version; }
-    void EnableFilter() { _enabled.store(true, std::memory_order_release); }
+
 private:
+    // moves the data out of the blob file with much garbage, so that only the blob index is
+    // rewritten by the compaction, and the file can be deleted once no sst file refers to it
+    void relocate_blob(const rocksdb::Slice &key,
+                       const rocksdb::Slice &existing_value,
+                       std::string *new_value,
+                       bool *value_changed) const
+    {
+        dsn::string_view raw_value = utils::to_string_view(existing_value);
+        pegasus_blob_index index;
+        pegasus_extract_blob_index(_value_schema_version, raw_value, index);
+        if (_relocation == nullptr) {
+            _relocation.reset(new pegasus_blob_store::relocation(_blob_store.get()));
+        }
+        if (!_relocation->need_relocate(index))
+            return;
+
+        uint32_t expire_ts = pegasus_extract_expire_ts(_value_schema_version, raw_value);
+        pegasus_blob_index new_index;
+        rocksdb::Status s =
+            _relocation->relocate(utils::to_string_view(key), expire_ts, index, new_index);
+        if (!s.ok()) {
+            // keep the value, the file is relocated by the next compaction
+            derror("relocate blob of file %" PRIu64 " failed, error = %s",
+                   index.file_number,
+                   s.ToString().c_str());
+            return;
+        }
+
+        auto type = static_cast<value_compression_type>(
+            pegasus_extract_value_flags(_value_schema_version, raw_value) &
+            VALUE_FLAGS_COMPRESSION_MASK);
+        rocksdb::SliceParts sparts =
+            _value_generator.generate_blob_index_value(expire_ts, type, new_index);
+        new_value->clear();
+        for (int i = 0; i < sparts.num_parts; i++) {
+            new_value->append(sparts.parts[i].data(), sparts.parts[i].size());
+        }
+        *value_changed = true;
+    }
+
     uint32_t _value_schema_version;
-    std::atomic_bool _enabled; // only process filtering when _enabled == true
+    bool _enabled; // only process filtering when _enabled == true
+    std::shared_ptr<pegasus_blob_store> _blob_store;
+    // the filter is used by only one compaction
+    mutable std::unique_ptr<pegasus_blob_store::relocation> _relocation;
+    mutable pegasus_value_generator _value_generator;
 };
 
 class KeyWithTTLCompactionFilterFactory : public rocksdb::CompactionFilterFactory
 {
 public:
-    KeyWithTTLCompactionFilterFactory() {}
+    KeyWithTTLCompactionFilterFactory() : _value_schema_version(0), _enabled(false) {}
     virtual std::unique_ptr<rocksdb::CompactionFilter>
     CreateCompactionFilter(const rocksdb::CompactionFilter::Context & /*context*/) override
     {
-        return std::unique_ptr<KeyWithTTLCompactionFilter>(new KeyWithTTLCompactionFilter());
+        return std::unique_ptr<KeyWithTTLCompactionFilter>(
+            new KeyWithTTLCompactionFilter(_value_schema_version.load(std::memory_order_acquire),
+                                           _enabled.load(std::memory_order_acquire),
+                                           _blob_store));
     }
     virtual const char *Name() const override { return "KeyWithTTLCompactionFilterFactory"; }
+    void SetValueSchemaVersion(uint32_t version)
+    {
+        _value_schema_version.store(version, std::memory_order_release);
+    }
+    void EnableFilter() { _enabled.store(true, std::memory_order_release); }
+    // must be called before the db is opened
+    void SetBlobStore(std::shared_ptr<pegasus_blob_store> blob_store)
+    {
+        _blob_store = std::move(blob_store);
+    }
+
+private:
+    std::atomic<uint32_t> _value_schema_version;
+    std::atomic_bool _enabled; // only process filtering when _enabled == true
+    std::shared_ptr<pegasus_blob_store> _blob_store;
 };
 }
 } // namespace
@@ -0,0 +1,665 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "pegasus_blob_store.h"
+
+#include <dsn/service_api_c.h>
+#include <dsn/utility/crc.h>
+
+#include "base/pegasus_utils.h"
+#include "pegasus_table_properties_collector.h"
+
+namespace pegasus {
+namespace server {
+
+static const size_t BLOB_RECORD_HEADER_LENGTH = 3 * sizeof(uint32_t);
+static const size_t BLOB_FOOTER_LENGTH = 3 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+static const uint64_t BLOB_FOOTER_MAGIC = 0x70656761626c6f62ULL; // "pegablob"
+
+static bool blob_file_init_from_name(const std::string &name, uint64_t &file_number)
+{
+    return 1 == sscanf(name.c_str(), "blob.%" SCNu64, &file_number) &&
+           name == pegasus_blob_file_name(file_number);
+}
+
+pegasus_blob_store::relocation::~relocation()
+{
+    if (_file_number == 0) {
+        return;
+    }
+    std::shared_ptr<blob_file> file = _store->get_file(_file_number);
+    if (file != nullptr) {
+        rocksdb::Status s = _store->seal(file);
+        if (!s.ok()) {
+            derror("%s: seal blob relocation file %s failed, error = %s",
+                   _store->replica_name(),
+                   file->path.c_str(),
+                   s.ToString().c_str());
+        }
+    }
+}
+
+rocksdb::Status pegasus_blob_store::relocation::relocate(dsn::string_view key,
+                                                         uint32_t expire_ts,
+                                                         const pegasus_blob_index &index,
+                                                         pegasus_blob_index &new_index)
+{
+    ::dsn::blob data;
+    rocksdb::Status s = _store->read(index, data);
+    if (!s.ok()) {
+        return s;
+    }
+
+    std::shared_ptr<blob_file> file;
+    if (_file_number != 0) {
+        file = _store->get_file(_file_number);
+    }
+    if (file == nullptr) {
+        s = _store->new_file(file);
+        if (!s.ok()) {
+            return s;
+        }
+        _file_number = file->number;
+    }
+
+    s = _store->append_to(
+        file, key, dsn::string_view(data.data(), data.length()), expire_ts, new_index);
+    if (!s.ok()) {
+        return s;
+    }
+    new_index.user_data_length = index.user_data_length;
+
+    if (file->size >= _store->_opts.file_size) {
+        _file_number = 0;
+        s = _store->seal(file);
+    }
+    return s;
+}
+
+pegasus_blob_store::reader_pin::reader_pin(pegasus_blob_store *store) : _store(store)
+{
+    while (true) {
+        _gc_round = _store->_gc_round.load();
+        _store->_reader_pins[_gc_round % 2]++;
+        // gc() may advance the round before the pin is counted, then pin in the new round
+        if (_store->_gc_round.load() == _gc_round) {
+            break;
+        }
+        _store->_reader_pins[_gc_round % 2]--;
+    }
+}
+
+pegasus_blob_store::reader_pin::~reader_pin() { _store->_reader_pins[_gc_round % 2]--; }
+
+pegasus_blob_store::pegasus_blob_store(const std::string &replica_name,
+                                       const std::string &dir,
+                                       options opts)
+    : _replica_name(replica_name),
+      _dir(dir),
+      _opts(opts),
+      _env(rocksdb::Env::Default()),
+      _next_file_number(1),
+      _total_size(0),
+      _gc_round(0)
+{
+    _reader_pins[0].store(0);
+    _reader_pins[1].store(0);
+}
+
+pegasus_blob_store::~pegasus_blob_store()
+{
+    dassert(_reader_pins[0].load() == 0 && _reader_pins[1].load() == 0,
+            "the reader pins must be released before the blob store");
+    // the active file is left unsealed, and is regarded as sealed when opened again
+    _active_file = nullptr;
+}
+
+rocksdb::Status pegasus_blob_store::open()
+{
+    std::vector<std::string> children;
+    rocksdb::Status s = _env->GetChildren(_dir, &children);
+    if (!s.ok()) {
+        return s;
+    }
+
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    for (const std::string &name : children) {
+        uint64_t number = 0;
+        if (!blob_file_init_from_name(name, number)) {
+            continue;
+        }
+
+        auto file = std::make_shared<blob_file>();
+        file->number = number;
+        file->path = _dir + "/" + name;
+        s = _env->GetFileSize(file->path, &file->size);
+        if (s.ok()) {
+            s = _env->NewRandomAccessFile(file->path, &file->reader, _env_opts);
+        }
+        if (!s.ok()) {
+            return s;
+        }
+        file->sealed = true;
+        // the memtables are empty when the db is opened
+        file->first_decree = 0;
+        file->last_decree = 0;
+        file->relocating = false;
+        file->obsolete_time_ns = 0;
+        file->obsolete_gc_round = 0;
+        load_footer(*file);
+
+        _files.emplace(number, file);
+        _next_file_number = std::max(_next_file_number, number + 1);
+        _total_size += file->size;
+    }
+
+    ddebug("%s: open blob store succeed, file_count = %d, total_size = %" PRIu64,
+           replica_name(),
+           static_cast<int>(_files.size()),
+           _total_size);
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status pegasus_blob_store::append(dsn::string_view key,
+                                           dsn::string_view data,
+                                           uint32_t expire_ts,
+                                           pegasus_blob_index &index)
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_active_lock);
+    if (_active_file == nullptr) {
+        rocksdb::Status s = new_file(_active_file);
+        if (!s.ok()) {
+            _active_file = nullptr;
+            return s;
+        }
+    }
+
+    rocksdb::Status s = append_to(_active_file, key, data, expire_ts, index);
+    if (!s.ok()) {
+        return s;
+    }
+
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l2(_lock);
+        if (_uncommitted_files.empty() || _uncommitted_files.back() != _active_file) {
+            _uncommitted_files.push_back(_active_file);
+        }
+        _active_file->last_decree = INT64_MAX;
+    }
+
+    if (_active_file->size >= _opts.file_size) {
+        s = seal(_active_file);
+        _active_file = nullptr;
+    }
+    return s;
+}
+
+void pegasus_blob_store::commit(int64_t decree)
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    for (const auto &file : _uncommitted_files) {
+        if (file->first_decree == 0) {
+            file->first_decree = decree;
+        }
+        file->last_decree = decree;
+    }
+    _uncommitted_files.clear();
+}
+
+rocksdb::Status pegasus_blob_store::sync()
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_active_lock);
+    if (_active_file == nullptr) {
+        return rocksdb::Status::OK();
+    }
+    return _active_file->writer->Sync();
+}
+
+rocksdb::Status pegasus_blob_store::seal_active_file()
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_active_lock);
+    if (_active_file == nullptr) {
+        return rocksdb::Status::OK();
+    }
+    rocksdb::Status s = seal(_active_file);
+    _active_file = nullptr;
+    return s;
+}
+
+rocksdb::Status pegasus_blob_store::read(const pegasus_blob_index &index, ::dsn::blob &data)
+{
+    std::shared_ptr<blob_file> file = get_file(index.file_number);
+    if (file == nullptr) {
+        return rocksdb::Status::Corruption("blob file not found",
+                                           pegasus_blob_file_name(index.file_number));
+    }
+
+    std::shared_ptr<char> buf(
+        ::dsn::utils::make_shared_array<char>(std::max<size_t>(index.size, 1)));
+    rocksdb::Slice result;
+    rocksdb::Status s = file->reader->Read(index.offset, index.size, &result, buf.get());
+    if (!s.ok()) {
+        return s;
+    }
+    if (result.size() != index.size) {
+        return rocksdb::Status::Corruption("truncated blob file", file->path);
+    }
+    if (result.data() != buf.get()) {
+        ::memcpy(buf.get(), result.data(), result.size());
+    }
+    if (::dsn::utils::crc32_calc(buf.get(), index.size, 0) != index.crc) {
+        return rocksdb::Status::Corruption("blob crc mismatch", file->path);
+    }
+    data.assign(std::move(buf), 0, index.size);
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status pegasus_blob_store::extract_user_data(int version,
+                                                      dsn::string_view raw_value,
+                                                      ::dsn::blob &user_data)
+{
+    if (!pegasus_value_is_blob_index(version, raw_value)) {
+        return pegasus_extract_user_data(version, raw_value, user_data);
+    }
+
+    pegasus_blob_index index;
+    pegasus_extract_blob_index(version, raw_value, index);
+    ::dsn::blob data;
+    rocksdb::Status s = read(index, data);
+    if (!s.ok()) {
+        return s;
+    }
+    bool decompressed = false;
+    s = pegasus_decompress_user_data(pegasus_extract_value_flags(version, raw_value),
+                                     dsn::string_view(data.data(), data.length()),
+                                     user_data,
+                                     decompressed);
+    if (s.ok() && !decompressed) {
+        user_data = std::move(data);
+    }
+    return s;
+}
+
+rocksdb::Status pegasus_blob_store::extract_user_data(int version,
+                                                      std::string &&raw_value,
+                                                      ::dsn::blob &user_data)
+{
+    if (!pegasus_value_is_blob_index(version, raw_value)) {
+        return pegasus_extract_user_data(version, std::move(raw_value), user_data);
+    }
+    return extract_user_data(version, dsn::string_view(raw_value), user_data);
+}
+
+rocksdb::Status pegasus_blob_store::link_files(const std::string &dir)
+{
+    std::vector<std::shared_ptr<blob_file>> files;
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+        for (const auto &kv : _files) {
+            if (kv.second->sealed) {
+                files.push_back(kv.second);
+            }
+        }
+    }
+
+    for (const auto &file : files) {
+        rocksdb::Status s =
+            _env->LinkFile(file->path, dir + "/" + pegasus_blob_file_name(file->number));
+        if (!s.ok()) {
+            derror("%s: link blob file %s to %s failed, error = %s",
+                   replica_name(),
+                   file->path.c_str(),
+                   dir.c_str(),
+                   s.ToString().c_str());
+            return s;
+        }
+    }
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status pegasus_blob_store::checkpoint(const std::string &dir, int64_t decree)
+{
+    std::shared_ptr<blob_file> copied_file;
+    uint64_t copied_size = 0;
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_active_lock);
+        if (_active_file != nullptr) {
+            int64_t first_decree;
+            {
+                ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l2(_lock);
+                first_decree = _active_file->first_decree;
+                copied_size = _active_file->size;
+            }
+            // otherwise all the records of the active file are written after the checkpoint
+            if (first_decree != 0 && first_decree <= decree) {
+                rocksdb::Status s;
+                if (copied_size < _opts.file_size / 4) {
+                    // the synced part is never modified, so it is copied out of the lock
+                    s = _active_file->writer->Sync();
+                    copied_file = _active_file;
+                } else {
+                    s = seal(_active_file);
+                    _active_file = nullptr;
+                }
+                if (!s.ok()) {
+                    return s;
+                }
+            }
+        }
+    }
+
+    rocksdb::Status s = link_files(dir);
+    if (s.ok() && copied_file != nullptr) {
+        s = copy_file(copied_file, copied_size, dir);
+    }
+    return s;
+}
+
+void pegasus_blob_store::gc(const rocksdb::TablePropertiesCollection &tables,
+                            int64_t last_flushed_decree,
+                            uint32_t epoch_now)
+{
+    // the bytes of each blob file referred by the sst files, which reflect the records dropped
+    // by the compactions, including the expired ones filtered by KeyWithTTLCompactionFilter
+    std::map<uint64_t, uint64_t> refs;
+    bool refs_known = pegasus_table_properties_collector::get_blob_refs(tables, refs);
+
+    uint64_t now_ns = dsn_now_ns();
+    std::vector<std::shared_ptr<blob_file>> deleted;
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+        // the readers pinned after this round refer to the db not older than `tables`, so the
+        // files obsolete in this round are deleted after the readers pinned before are released
+        uint64_t round = _gc_round.load();
+        bool previous_round_pinned = round > 0 && _reader_pins[(round - 1) % 2].load() > 0;
+        uint64_t oldest_pinned_round = previous_round_pinned ? round - 1 : round;
+        for (auto iter = _files.begin(); iter != _files.end();) {
+            blob_file &file = *iter->second;
+            if (!file.sealed || file.last_decree > last_flushed_decree) {
+                ++iter;
+                continue;
+            }
+
+            // the expired records are never read, even if they are not compacted yet
+            bool expired = file.max_expire_ts != NO_EXPIRE_TS &&
+                           check_if_record_expired(epoch_now, file.max_expire_ts);
+            uint64_t ref_bytes = refs[file.number];
+            if (expired || file.max_expire_ts == 0 || (refs_known && ref_bytes == 0)) {
+                if (file.obsolete_time_ns == 0) {
+                    ddebug("%s: blob file %s is obsolete, expired = %s",
+                           replica_name(),
+                           file.path.c_str(),
+                           expired ? "true" : "false");
+                    file.obsolete_time_ns = now_ns;
+                    file.obsolete_gc_round = round;
+                } else if (oldest_pinned_round > file.obsolete_gc_round &&
+                           now_ns - file.obsolete_time_ns >=
+                               _opts.file_delete_delay_seconds * 1000000000) {
+                    _total_size -= file.size;
+                    deleted.push_back(iter->second);
+                    iter = _files.erase(iter);
+                    continue;
+                }
+            } else if (refs_known) {
+                // the relocation file of a compaction may be unreferenced before the
+                // compaction is installed
+                file.obsolete_time_ns = 0;
+                double garbage_ratio = 1.0 - (double)ref_bytes / std::max<uint64_t>(file.size, 1);
+                bool relocating = garbage_ratio >= _opts.gc_garbage_ratio;
+                if (relocating && !file.relocating) {
+                    ddebug("%s: relocate blob file %s by compactions, garbage_ratio = %.2f",
+                           replica_name(),
+                           file.path.c_str(),
+                           garbage_ratio);
+                }
+                file.relocating = relocating;
+            }
+            ++iter;
+        }
+        // the counter of the previous round is reused by the next round
+        if (!previous_round_pinned) {
+            _gc_round++;
+        }
+    }
+
+    for (const auto &file : deleted) {
+        rocksdb::Status s = _env->DeleteFile(file->path);
+        if (s.ok()) {
+            ddebug("%s: delete blob file %s succeed, size = %" PRIu64,
+                   replica_name(),
+                   file->path.c_str(),
+                   file->size);
+        } else {
+            derror("%s: delete blob file %s failed, error = %s",
+                   replica_name(),
+                   file->path.c_str(),
+                   s.ToString().c_str());
+        }
+    }
+}
+
+uint64_t pegasus_blob_store::file_count() const
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    return _files.size();
+}
+
+uint64_t pegasus_blob_store::total_size() const
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    return _total_size;
+}
+
+bool pegasus_blob_store::need_relocate(uint64_t file_number) const
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    auto iter = _files.find(file_number);
+    return iter != _files.end() && iter->second->relocating;
+}
+
+rocksdb::Status pegasus_blob_store::new_file(std::shared_ptr<blob_file> &file)
+{
+    file = std::make_shared<blob_file>();
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+        file->number = _next_file_number++;
+    }
+    file->path = _dir + "/" + pegasus_blob_file_name(file->number);
+    file->size = 0;
+    file->sealed = false;
+    file->first_decree = 0;
+    file->last_decree = 0;
+    file->max_expire_ts = 0;
+    file->relocating = false;
+    file->obsolete_time_ns = 0;
+    file->obsolete_gc_round = 0;
+
+    rocksdb::Status s = _env->NewWritableFile(file->path, &file->writer, _env_opts);
+    if (s.ok()) {
+        s = _env->NewRandomAccessFile(file->path, &file->reader, _env_opts);
+    }
+    if (!s.ok()) {
+        derror("%s: create blob file %s failed, error = %s",
+               replica_name(),
+               file->path.c_str(),
+               s.ToString().c_str());
+        return s;
+    }
+
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    _files.emplace(file->number, file);
+    return s;
+}
+
+rocksdb::Status pegasus_blob_store::append_to(const std::shared_ptr<blob_file> &file,
+                                              dsn::string_view key,
+                                              dsn::string_view data,
+                                              uint32_t expire_ts,
+                                              pegasus_blob_index &index)
+{
+    std::string header(BLOB_RECORD_HEADER_LENGTH, '\0');
+    dsn::data_output output(header);
+    output.write_u32(static_cast<uint32_t>(key.length()));
+    output.write_u32(static_cast<uint32_t>(data.length()));
+    output.write_u32(expire_ts);
+
+    rocksdb::Status s = file->writer->Append(header);
+    if (s.ok()) {
+        s = file->writer->Append(utils::to_rocksdb_slice(key));
+    }
+    if (s.ok()) {
+        s = file->writer->Append(utils::to_rocksdb_slice(data));
+    }
+    if (!s.ok()) {
+        derror("%s: append blob file %s failed, error = %s",
+               replica_name(),
+               file->path.c_str(),
+               s.ToString().c_str());
+        return s;
+    }
+
+    index.file_number = file->number;
+    index.offset = file->size + header.size() + key.length();
+    index.size = static_cast<uint32_t>(data.length());
+    index.crc = ::dsn::utils::crc32_calc(data.data(), data.length(), 0);
+
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    file->size += header.size() + key.length() + data.length();
+    _total_size += header.size() + key.length() + data.length();
+    if (expire_ts == 0) {
+        file->max_expire_ts = NO_EXPIRE_TS;
+    } else if (file->max_expire_ts != NO_EXPIRE_TS) {
+        file->max_expire_ts = std::max(file->max_expire_ts, expire_ts);
+    }
+    return s;
+}
+
+rocksdb::Status pegasus_blob_store::seal(const std::shared_ptr<blob_file> &file)
+{
+    uint32_t max_expire_ts;
+    uint64_t data_size;
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+        max_expire_ts = file->max_expire_ts;
+        data_size = file->size;
+    }
+
+    std::string footer(BLOB_FOOTER_LENGTH, '\0');
+    dsn::data_output output(footer);
+    output.write_u32(max_expire_ts);
+    output.write_u64(data_size);
+    output.write_u32(
+        ::dsn::utils::crc32_calc(footer.data(), sizeof(uint32_t) + sizeof(uint64_t), 0));
+    output.write_u64(BLOB_FOOTER_MAGIC);
+
+    rocksdb::Status s = file->writer->Append(footer);
+    if (s.ok()) {
+        s = file->writer->Sync();
+    }
+    if (s.ok()) {
+        s = file->writer->Close();
+    }
+    if (!s.ok()) {
+        derror("%s: seal blob file %s failed, error = %s",
+               replica_name(),
+               file->path.c_str(),
+               s.ToString().c_str());
+        // the file is sealed anyway, as no more record can be appended to it
+    }
+
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    file->writer.reset();
+    file->sealed = true;
+    if (s.ok()) {
+        file->size += footer.size();
+        _total_size += footer.size();
+    }
+    return s;
+}
+
+rocksdb::Status pegasus_blob_store::copy_file(const std::shared_ptr<blob_file> &file,
+                                              uint64_t size,
+                                              const std::string &dir)
+{
+    // the copy without the footer is regarded as sealed when opened
+    std::string path = dir + "/" + pegasus_blob_file_name(file->number);
+    std::unique_ptr<rocksdb::WritableFile> writer;
+    rocksdb::Status s = _env->NewWritableFile(path, &writer, _env_opts);
+    const size_t buf_size = 1024 * 1024;
+    std::unique_ptr<char[]> buf(new char[buf_size]);
+    for (uint64_t offset = 0; s.ok() && offset < size;) {
+        size_t n = static_cast<size_t>(std::min<uint64_t>(size - offset, buf_size));
+        rocksdb::Slice result;
+        s = file->reader->Read(offset, n, &result, buf.get());
+        if (s.ok() && result.size() != n) {
+            s = rocksdb::Status::Corruption("truncated blob file", file->path);
+        }
+        if (s.ok()) {
+            s = writer->Append(result);
+        }
+        offset += n;
+    }
+    if (s.ok()) {
+        s = writer->Sync();
+    }
+    if (s.ok()) {
+        s = writer->Close();
+    }
+    if (!s.ok()) {
+        derror("%s: copy blob file %s to %s failed, error = %s",
+               replica_name(),
+               file->path.c_str(),
+               dir.c_str(),
+               s.ToString().c_str());
+    }
+    return s;
+}
+
+std::shared_ptr<pegasus_blob_store::blob_file>
+pegasus_blob_store::get_file(uint64_t file_number) const
+{
+    ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_lock);
+    auto iter = _files.find(file_number);
+    return iter == _files.end() ? nullptr : iter->second;
+}
+
+void pegasus_blob_store::load_footer(blob_file &file)
+{
+    // regarded as having records without TTL if the footer is not found
+    file.max_expire_ts = NO_EXPIRE_TS;
+    if (file.size < BLOB_FOOTER_LENGTH) {
+        return;
+    }
+
+    char buf[BLOB_FOOTER_LENGTH];
+    rocksdb::Slice result;
+    rocksdb::Status s =
+        file.reader->Read(file.size - BLOB_FOOTER_LENGTH, BLOB_FOOTER_LENGTH, &result, buf);
+    if (!s.ok() || result.size() != BLOB_FOOTER_LENGTH) {
+        dwarn("%s: read footer of blob file %s failed", replica_name(), file.path.c_str());
+        return;
+    }
+
+    dsn::data_input input(utils::to_string_view(result));
+    uint32_t max_expire_ts = input.read_u32();
+    uint64_t data_size = input.read_u64();
+    uint32_t crc = input.read_u32();
+    uint64_t magic = input.read_u64();
+    if (magic == BLOB_FOOTER_MAGIC && data_size == file.size - BLOB_FOOTER_LENGTH &&
+        crc == ::dsn::utils::crc32_calc(result.data(), sizeof(uint32_t) + sizeof(uint64_t), 0)) {
+        file.max_expire_ts = max_expire_ts;
+    } else {
+        dwarn("%s: footer of blob file %s not found", replica_name(), file.path.c_str());
+    }
+}
+
+void pegasus_blob_flush_listener::OnFlushBegin(rocksdb::DB *db,
+                                               const rocksdb::FlushJobInfo &flush_job_info)
+{
+    rocksdb::Status s = _store->sync();
+    dassert(s.ok(), "sync blob file before flush failed, error = %s", s.ToString().c_str());
+}
+
+} // namespace server
+} // namespace pegasus
@@ -0,0 +1,241 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <rocksdb/env.h>
+#include <rocksdb/listener.h>
+#include <rocksdb/status.h>
+#include <rocksdb/table_properties.h>
+#include <dsn/utility/synchronize.h>
+
+#include "base/pegasus_value_schema.h"
+
+namespace pegasus {
+namespace server {
+
+/// The blob files of a replica, which store the large values separated from the LSM tree
+/// (key-value separation), so that only the small blob indexes of them are rewritten by the
+/// compactions.
+///
+/// The blob files are in the rdb directory, named by pegasus_blob_file_name(), so that they
+/// are moved, restored and learned together with the sst files. A blob file is appended by
+/// only one writer, i.e. the writes of the replica (the active file) or one compaction (the
+/// relocation file), and is never modified after sealed. A sealed file is hard linked into
+/// the checkpoints, and deleted by gc() when no sst file refers to it, or all the records in
+/// it are expired, and no reader pinned before may still read it (see reader_pin).
+///
+/// blob file = [record] ... [record] [footer]
+/// record = [key_length(uint32_t)] [data_length(uint32_t)] [expire_ts(uint32_t)] [key] [data]
+/// footer = [max_expire_ts(uint32_t)] [data_size(uint64_t)] [crc(uint32_t)] [magic(uint64_t)]
+///
+/// The footer is written when the file is sealed, the files without it (e.g. the active file
+/// when the process crashed) are regarded as having records without TTL.
+///
+/// Thread-safe.
+class pegasus_blob_store
+{
+public:
+    static const uint32_t NO_EXPIRE_TS = UINT32_MAX;
+
+    struct options
+    {
+        // the blob file is sealed once it exceeds this size
+        uint64_t file_size = 256 * 1024 * 1024;
+        // the live records of the files with this ratio of garbage are relocated by compactions
+        double gc_garbage_ratio = 0.5;
+        // the unreferenced files are deleted after this time at least, as the relocation file
+        // of a compaction is unreferenced until the compaction is installed
+        uint64_t file_delete_delay_seconds = 600;
+    };
+
+    /// The relocation of one compaction, which copies the live records of the files with
+    /// much garbage into a new file. The file is synced and sealed when the relocation is
+    /// destroyed, which happens before the compaction is installed.
+    /// Not thread-safe.
+    class relocation
+    {
+    public:
+        explicit relocation(pegasus_blob_store *store) : _store(store), _file_number(0) {}
+        ~relocation();
+
+        /// \return true if the data of `index` is in a file to be garbage collected.
+        bool need_relocate(const pegasus_blob_index &index) const
+        {
+            return _store->need_relocate(index.file_number);
+        }
+
+        /// Copies the data of `index` into the relocation file, and `new_index` refers to it.
+        rocksdb::Status relocate(dsn::string_view key,
+                                 uint32_t expire_ts,
+                                 const pegasus_blob_index &index,
+                                 pegasus_blob_index &new_index);
+
+    private:
+        pegasus_blob_store *_store;
+        uint64_t _file_number;
+    };
+
+    /// Keeps the files from being deleted by gc() while the db readers created after it, e.g.
+    /// the iterators of the scan contexts, may read them. Such a reader refers to the version
+    /// of the db when it was created, so it may refer to the files which are no longer referred
+    /// by the latest sst files. The pin is created before the reader, and destroyed after the
+    /// reader and before the store. It takes no lock, as it is created for every read.
+    /// Not thread-safe.
+    class reader_pin
+    {
+    public:
+        explicit reader_pin(pegasus_blob_store *store);
+        ~reader_pin();
+
+        reader_pin(const reader_pin &) = delete;
+        reader_pin &operator=(const reader_pin &) = delete;
+
+    private:
+        pegasus_blob_store *_store;
+        uint64_t _gc_round;
+    };
+
+    pegasus_blob_store(const std::string &replica_name, const std::string &dir, options opts);
+    ~pegasus_blob_store();
+
+    /// Loads the blob files in the directory, which are all regarded as sealed.
+    rocksdb::Status open();
+
+    /// Appends the data of `key` into the active file, and sets `index` to refer to it.
+    /// `index.user_data_length` is left to the caller. Only called by the write thread.
+    rocksdb::Status append(dsn::string_view key,
+                           dsn::string_view data,
+                           uint32_t expire_ts,
+                           pegasus_blob_index &index);
+
+    /// Called after the records appended are written into rocksdb with `decree`, a file is
+    /// not deleted until the memtables of its records are flushed.
+    void commit(int64_t decree);
+
+    /// Syncs the active file, which is called before the memtable is flushed, so that the
+    /// blob indexes in the sst files always refer to durable data.
+    rocksdb::Status sync();
+
+    /// Syncs and seals the active file, the next append creates a new one.
+    rocksdb::Status seal_active_file();
+
+    /// Reads the data stored for `index` into `data`.
+    rocksdb::Status read(const pegasus_blob_index &index, ::dsn::blob &data);
+
+    /// Extracts user_data of the raw value, which is read from the blob file if the value is
+    /// separated. \see pegasus_extract_user_data()
+    rocksdb::Status
+    extract_user_data(int version, dsn::string_view raw_value, ::dsn::blob &user_data);
+    rocksdb::Status extract_user_data(int version, std::string &&raw_value, ::dsn::blob &user_data);
+
+    /// Hard links the sealed files into the checkpoint directory `dir`.
+    rocksdb::Status link_files(const std::string &dir);
+
+    /// Adds the files which may be referred by the sst files of the checkpoint in `dir` with
+    /// records not after `decree`. Besides the sealed files, the active file is added if it
+    /// has records not after `decree`: the synced part of it is copied if it is small,
+    /// otherwise it is sealed and linked, so that the checkpoints do not leave many small
+    /// sealed files.
+    rocksdb::Status checkpoint(const std::string &dir, int64_t decree);
+
+    /// Deletes the files not referred by any sst file in `tables` or with all records expired,
+    /// and chooses the files with much garbage to be relocated by the following compactions.
+    /// \param last_flushed_decree: the files written after it may be referred by the memtables.
+    void gc(const rocksdb::TablePropertiesCollection &tables,
+            int64_t last_flushed_decree,
+            uint32_t epoch_now);
+
+    uint64_t file_count() const;
+    uint64_t total_size() const;
+
+private:
+    struct blob_file
+    {
+        uint64_t number;
+        std::string path;
+        uint64_t size;
+        std::unique_ptr<rocksdb::WritableFile> writer;
+        std::unique_ptr<rocksdb::RandomAccessFile> reader;
+        bool sealed;
+        // the decree of the first record committed in the file, 0 if none or unknown
+        int64_t first_decree;
+        // the records of the file may be in the memtables if > last flushed decree
+        int64_t last_decree;
+        // the max expire_ts of the records, NO_EXPIRE_TS if any record has no TTL,
+        // and 0 if the file is empty
+        uint32_t max_expire_ts;
+        // set by gc()
+        bool relocating;
+        uint64_t obsolete_time_ns;
+        // the gc round when the file became obsolete, the readers pinned in or before the round
+        // may still read it
+        uint64_t obsolete_gc_round;
+    };
+
+    bool need_relocate(uint64_t file_number) const;
+
+    // creates a new file to be appended by one writer
+    rocksdb::Status new_file(std::shared_ptr<blob_file> &file);
+    rocksdb::Status append_to(const std::shared_ptr<blob_file> &file,
+                              dsn::string_view key,
+                              dsn::string_view data,
+                              uint32_t expire_ts,
+                              pegasus_blob_index &index);
+    rocksdb::Status seal(const std::shared_ptr<blob_file> &file);
+    // copies the first `size` bytes of the file into the directory
+    rocksdb::Status
+    copy_file(const std::shared_ptr<blob_file> &file, uint64_t size, const std::string &dir);
+    std::shared_ptr<blob_file> get_file(uint64_t file_number) const;
+    void load_footer(blob_file &file);
+
+    const std::string _replica_name;
+    const std::string _dir;
+    const options _opts;
+    rocksdb::Env *_env;
+    rocksdb::EnvOptions _env_opts;
+
+    mutable ::dsn::utils::ex_lock_nr _lock; // protects the following members
+    std::map<uint64_t, std::shared_ptr<blob_file>> _files;
+    uint64_t _next_file_number;
+    uint64_t _total_size;
+    // the files appended since the last commit
+    std::vector<std::shared_ptr<blob_file>> _uncommitted_files;
+
+    // the count of gc() done, which is advanced only if no reader pinned in the round before
+    // the current one is alive, so that the live readers are pinned in the last two rounds
+    std::atomic<uint64_t> _gc_round;
+    // the count of the live readers pinned in the odd and the even rounds
+    std::atomic<uint64_t> _reader_pins[2];
+
+    // the active file is accessed only by the write thread, except that it may be synced and
+    // sealed by the flushes and the checkpoints, so _active_lock is held by all of them
+    ::dsn::utils::ex_lock_nr _active_lock;
+    std::shared_ptr<blob_file> _active_file;
+
+    const char *replica_name() const { return _replica_name.c_str(); }
+};
+
+/// Syncs the active blob file before the memtable is flushed.
+class pegasus_blob_flush_listener : public rocksdb::EventListener
+{
+public:
+    explicit pegasus_blob_flush_listener(std::shared_ptr<pegasus_blob_store> store)
+        : _store(std::move(store))
+    {
+    }
+
+    void OnFlushBegin(rocksdb::DB *db, const rocksdb::FlushJobInfo &flush_job_info) override;
+
+private:
+    std::shared_ptr<pegasus_blob_store> _store;
+};
+
+} // namespace server
+} // namespace pegasus
@@ -0,0 +1,134 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include <dsn/utility/string_view.h>
+
+#include <rrdb/rrdb_types.h>
+
+namespace pegasus {
+namespace server {
+
+/// The hash key or sort key filter of a request, compiled from the filter type and pattern.
+/// It is built once for a request (or stored in the scan context) and applied to every key,
+/// so that the preprocessing of the pattern is not repeated per key.
+///
+/// FT_MATCH_ANYWHERE is searched by comparing the first and the last bytes of the pattern
+/// with 16 candidate positions at a time by SSE2, and the middle bytes are only compared for
+/// the candidates matching both. The Horspool algorithm is used for the positions left over,
+/// and on the platforms without SSE2.
+class pegasus_filter_matcher
+{
+public:
+    pegasus_filter_matcher() : _type(::dsn::apps::filter_type::FT_NO_FILTER) {}
+
+    pegasus_filter_matcher(::dsn::apps::filter_type::type type, dsn::string_view pattern)
+        : _type(type), _pattern(pattern.data(), pattern.length())
+    {
+        if (_pattern.empty()) {
+            _type = ::dsn::apps::filter_type::FT_NO_FILTER;
+        }
+        if (_type == ::dsn::apps::filter_type::FT_MATCH_ANYWHERE && _pattern.length() > 1) {
+            size_t m = _pattern.length();
+            _shift.assign(256, static_cast<uint32_t>(m));
+            for (size_t i = 0; i + 1 < m; ++i) {
+                _shift[static_cast<uint8_t>(_pattern[i])] = static_cast<uint32_t>(m - 1 - i);
+            }
+        }
+    }
+
+    /// \return true if every key passes, that is, no filter or an empty pattern.
+    bool no_filter() const { return _type == ::dsn::apps::filter_type::FT_NO_FILTER; }
+
+    ::dsn::apps::filter_type::type type() const { return _type; }
+
+    const std::string &pattern() const { return _pattern; }
+
+    /// \return true if the key is valid for the filter.
+    bool match(dsn::string_view key) const
+    {
+        size_t m = _pattern.length();
+        switch (_type) {
+        case ::dsn::apps::filter_type::FT_NO_FILTER:
+            return true;
+        case ::dsn::apps::filter_type::FT_MATCH_ANYWHERE:
+            return key.length() >= m && find(key.data(), key.length());
+        case ::dsn::apps::filter_type::FT_MATCH_PREFIX:
+            return key.length() >= m && ::memcmp(key.data(), _pattern.data(), m) == 0;
+        case ::dsn::apps::filter_type::FT_MATCH_POSTFIX:
+            return key.length() >= m &&
+                   ::memcmp(key.data() + key.length() - m, _pattern.data(), m) == 0;
+        default:
+            return false;
+        }
+    }
+
+private:
+    // require n >= m
+    bool find(const char *s, size_t n) const
+    {
+        const char *p = _pattern.data();
+        size_t m = _pattern.length();
+        if (m == 1) {
+            return ::memchr(s, p[0], n) != nullptr;
+        }
+
+        size_t end = n - m + 1; // the count of the candidate positions
+        size_t i = 0;
+#if defined(__SSE2__)
+        if (end >= 16) {
+            const __m128i first = _mm_set1_epi8(p[0]);
+            const __m128i last = _mm_set1_epi8(p[m - 1]);
+            for (;; i += 16) {
+                if (i + 16 > end) {
+                    // the last block overlaps with the previous one
+                    if (i == end) {
+                        return false;
+                    }
+                    i = end - 16;
+                }
+                __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+                __m128i block_last =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i + m - 1));
+                unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(
+                    _mm_cmpeq_epi8(first, block_first), _mm_cmpeq_epi8(last, block_last))));
+                while (mask != 0) {
+                    size_t pos = i + __builtin_ctz(mask);
+                    if (::memcmp(s + pos + 1, p + 1, m - 2) == 0) {
+                        return true;
+                    }
+                    mask &= mask - 1;
+                }
+                if (i + 16 == end) {
+                    return false;
+                }
+            }
+        }
+#endif
+        // Horspool
+        while (i < end) {
+            char c = s[i + m - 1];
+            if (c == p[m - 1] && ::memcmp(s + i, p, m - 1) == 0) {
+                return true;
+            }
+            i += _shift[static_cast<uint8_t>(c)];
+        }
+        return false;
+    }
+
+private:
+    ::dsn::apps::filter_type::type _type;
+    std::string _pattern;
+    std::vector<uint32_t> _shift; // the Horspool shift table, only for FT_MATCH_ANYWHERE
+};
+
+} // namespace server
+} // namespace pegasus
@@ -0,0 +1,64 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <dsn/utility/synchronize.h>
+
+namespace pegasus {
+namespace server {
+
+/// Picks the replicas to flush when the memtables of all the replicas in this process exceed
+/// the budget of the shared rocksdb::WriteBufferManager. rocksdb only flushes the instance
+/// which is writing then, so the large memtables of the idle replicas may stay in memory for
+/// a long time. Each replica reports the size of its active memtable periodically, and only
+/// the largest ones which free enough memory are flushed, rather than all the replicas with
+/// large memtables flushing at the same time.
+///
+/// Thread-safe.
+class pegasus_memtable_flush_picker
+{
+public:
+    /// Reports the size of the active memtable of the replica.
+    void update(const std::string &replica, uint64_t active_memtable_size)
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+        _sizes[replica] = active_memtable_size;
+    }
+
+    void remove(const std::string &replica)
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+        _sizes.erase(replica);
+    }
+
+    /// \return true if the replica should flush its active memtable, i.e. the memtable is not
+    /// smaller than `min_size`, and the memtables larger than it are not enough to free
+    /// `bytes_to_free`. The ties are broken by the replica names.
+    bool should_flush(const std::string &replica, uint64_t bytes_to_free, uint64_t min_size) const
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+        auto iter = _sizes.find(replica);
+        if (iter == _sizes.end() || iter->second < min_size) {
+            return false;
+        }
+        uint64_t larger_size = 0;
+        for (const auto &kv : _sizes) {
+            if (kv.second > iter->second || (kv.second == iter->second && kv.first < replica)) {
+                larger_size += kv.second;
+            }
+        }
+        return larger_size < bytes_to_free;
+    }
+
+private:
+    mutable ::dsn::utils::ex_lock_nr_spin _lock;
+    // replica name -> the size of the active memtable last reported
+    std::map<std::string, uint64_t> _sizes;
+};
+
+} // namespace server
+} // namespace pegasus
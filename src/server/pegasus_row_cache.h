@@ -0,0 +1,173 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <rocksdb/cache.h>
+#include <dsn/utility/blob.h>
+#include <dsn/utility/string_view.h>
+#include <dsn/utility/utils.h>
+
+namespace pegasus {
+namespace server {
+
+/// A cache of the hot records in front of rocksdb, which stores the decoded user data
+/// and expire_ts keyed by the raw rocksdb key, so that a hit avoids the block cache lookup,
+/// bloom filter check, block decode and value copy of rocksdb::DB::Get().
+///
+/// The underlying LRU cache is shared by all replicas in this process, and the keys are
+/// prefixed with an id unique to each replica. Clearing the cache of a replica is done by
+/// switching to a new id, the entries of the old id are evicted by LRU in the end.
+///
+/// Consistency with writes is kept by a write sequence: the writer increases it before and
+/// after applying a write batch, and erases the written keys in between. A reader takes the
+/// sequence before reading rocksdb, and the record read is not cached if a write is in
+/// progress, or erased right after inserted if any write happened meanwhile.
+class pegasus_row_cache
+{
+public:
+    pegasus_row_cache() : _id(next_id()), _write_seq(0), _max_value_size(0) {}
+
+    /// `cache` may be nullptr, which means the row cache is disabled.
+    void init(std::shared_ptr<rocksdb::Cache> cache, uint32_t max_value_size)
+    {
+        _cache = std::move(cache);
+        _max_value_size = max_value_size;
+    }
+
+    bool enabled() const { return _cache != nullptr; }
+
+    /// The memory usage of the underlying cache shared by all replicas.
+    size_t usage() const { return _cache->GetUsage(); }
+
+    /// Drop all the cached records of this replica.
+    void clear() { _id.store(next_id()); }
+
+    /// \return the ticket to be passed to insert().
+    uint64_t read_begin() const { return _write_seq.load(); }
+
+    /// \return true if hit. `user_data` shares the memory with the cached record.
+    bool lookup(dsn::string_view raw_key, uint32_t &expire_ts, dsn::blob &user_data)
+    {
+        std::string key = cache_key(raw_key);
+        rocksdb::Cache::Handle *handle = _cache->Lookup(key);
+        if (handle == nullptr) {
+            return false;
+        }
+        auto e = static_cast<const entry *>(_cache->Value(handle));
+        expire_ts = e->expire_ts;
+        user_data = e->user_data;
+        _cache->Release(handle);
+        return true;
+    }
+
+    /// The user data is copied into the cache.
+    void insert(uint64_t ticket,
+                dsn::string_view raw_key,
+                uint32_t expire_ts,
+                dsn::string_view user_data)
+    {
+        if ((ticket & 1) != 0 || user_data.length() > _max_value_size) {
+            // a write is in progress, or the value is too large to be cached
+            return;
+        }
+
+        auto e = new entry();
+        e->expire_ts = expire_ts;
+        std::shared_ptr<char> buf(::dsn::utils::make_shared_array<char>(user_data.length()));
+        ::memcpy(buf.get(), user_data.data(), user_data.length());
+        e->user_data.assign(std::move(buf), 0, user_data.length());
+
+        std::string key = cache_key(raw_key);
+        size_t charge = sizeof(entry) + key.length() + user_data.length();
+        _cache->Insert(key, e, charge, &delete_entry);
+
+        if (_write_seq.load() != ticket) {
+            // the record may be overwritten after read
+            erase(raw_key);
+        }
+    }
+
+    void write_begin() { _write_seq.fetch_add(1); }
+
+    void write_end(const std::vector<dsn::string_view> &raw_keys, bool clear_all)
+    {
+        if (clear_all) {
+            clear();
+        } else {
+            for (dsn::string_view raw_key : raw_keys) {
+                erase(raw_key);
+            }
+        }
+        _write_seq.fetch_add(1);
+    }
+
+    void erase(dsn::string_view raw_key)
+    {
+        std::string key = cache_key(raw_key);
+        rocksdb::Cache::Handle *handle = _cache->Lookup(key);
+        if (handle != nullptr) {
+            static_cast<entry *>(_cache->Value(handle))->erased = true;
+            _cache->Release(handle);
+            _cache->Erase(key);
+        }
+    }
+
+    /// The count of the records evicted by LRU from all the replicas, that is to say,
+    /// not including the records erased by writes.
+    static uint64_t evict_count() { return evict_counter().load(std::memory_order_relaxed); }
+
+private:
+    struct entry
+    {
+        uint32_t expire_ts = 0;
+        std::atomic_bool erased{false};
+        dsn::blob user_data;
+    };
+
+    static void delete_entry(const rocksdb::Slice &key, void *value)
+    {
+        auto e = static_cast<entry *>(value);
+        if (!e->erased.load()) {
+            evict_counter().fetch_add(1, std::memory_order_relaxed);
+        }
+        delete e;
+    }
+
+    static std::atomic<uint64_t> &evict_counter()
+    {
+        static std::atomic<uint64_t> s_evict_count(0);
+        return s_evict_count;
+    }
+
+    static uint64_t next_id()
+    {
+        static std::atomic<uint64_t> s_next_id(1);
+        return s_next_id.fetch_add(1);
+    }
+
+    std::string cache_key(dsn::string_view raw_key) const
+    {
+        uint64_t id = _id.load();
+        std::string key;
+        key.reserve(sizeof(id) + raw_key.length());
+        key.append(reinterpret_cast<const char *>(&id), sizeof(id));
+        key.append(raw_key.data(), raw_key.length());
+        return key;
+    }
+
+private:
+    std::shared_ptr<rocksdb::Cache> _cache;
+    std::atomic<uint64_t> _id;
+    std::atomic<uint64_t> _write_seq;
+    uint32_t _max_value_size;
+};
+
+} // namespace server
+} // namespace pegasus
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <list>
 #include <map>
 #include <rocksdb/db.h>
 #include <dsn/tool_api.h>
@@ -11,71 +13,153 @@
 #include <rrdb/rrdb_types.h>
 
 #include "base/pegasus_const.h"
+#include "base/pegasus_utils.h"
+#include "pegasus_blob_store.h"
+#include "pegasus_filter_matcher.h"
 
 namespace pegasus {
 namespace server {
 
+// The limits of one scan rpc, 0 means no limit. The rpc returns early and keeps the context
+// if any of them is reached, so that a scan over sparse or expired data does not block the
+// replica thread for long, and a scan over large values does not produce a huge response.
+struct pegasus_scan_limits
+{
+    uint64_t max_iteration_count = 0;
+    uint64_t max_iteration_time_ns = 0;
+    uint64_t max_response_bytes = 0;
+
+    // the smaller ones of 'server_limits' and the limits of the request, in which the values
+    // not positive mean not limited by the request
+    static pegasus_scan_limits merge(const pegasus_scan_limits &server_limits,
+                                     int32_t max_iteration_count,
+                                     int32_t max_iteration_time_ms,
+                                     int32_t max_response_bytes)
+    {
+        pegasus_scan_limits limits;
+        limits.max_iteration_count =
+            min_limit(server_limits.max_iteration_count, max_iteration_count);
+        limits.max_iteration_time_ns = min_limit(
+            server_limits.max_iteration_time_ns,
+            max_iteration_time_ms > 0 ? max_iteration_time_ms * 1000000ULL : 0);
+        limits.max_response_bytes =
+            min_limit(server_limits.max_response_bytes, max_response_bytes);
+        return limits;
+    }
+
+    // at least one record is iterated before the time limit is checked, to make progress
+    bool reached(uint64_t iteration_count, uint64_t response_bytes, uint64_t start_time_ns) const
+    {
+        return (max_iteration_count > 0 && iteration_count >= max_iteration_count) ||
+               (max_response_bytes > 0 && response_bytes >= max_response_bytes) ||
+               (max_iteration_time_ns > 0 && iteration_count > 0 &&
+                dsn_now_ns() - start_time_ns >= max_iteration_time_ns);
+    }
+
+private:
+    static uint64_t min_limit(uint64_t a, int64_t b)
+    {
+        if (b <= 0) {
+            return a;
+        }
+        return a == 0 ? b : std::min(a, (uint64_t)b);
+    }
+};
+
 struct pegasus_scan_context
 {
-    pegasus_scan_context(std::unique_ptr<rocksdb::Iterator> &&iterator_,
+    pegasus_scan_context(std::unique_ptr<pegasus_blob_store::reader_pin> &&blob_pin_,
+                         std::unique_ptr<rocksdb::Iterator> &&iterator_,
                          const std::string &&stop_,
                          bool stop_inclusive_,
-                         ::dsn::apps::filter_type::type hash_key_filter_type_,
-                         const std::string &&hash_key_filter_pattern_,
-                         ::dsn::apps::filter_type::type sort_key_filter_type_,
-                         const std::string &&sort_key_filter_pattern_,
+                         pegasus_filter_matcher &&hash_key_filter_,
+                         pegasus_filter_matcher &&sort_key_filter_,
                          int32_t batch_size_,
-                         bool no_value_)
+                         bool no_value_,
+                         const pegasus_scan_limits &limits_,
+                         bool aggregate_,
+                         int32_t aggregate_top_count_)
         : _stop_holder(std::move(stop_)),
-          _hash_key_filter_pattern_holder(std::move(hash_key_filter_pattern_)),
-          _sort_key_filter_pattern_holder(std::move(sort_key_filter_pattern_)),
+          _blob_pin(std::move(blob_pin_)),
           iterator(std::move(iterator_)),
           stop(_stop_holder.data(), _stop_holder.size()),
           stop_inclusive(stop_inclusive_),
-          hash_key_filter_type(hash_key_filter_type_),
-          hash_key_filter_pattern(
-              _hash_key_filter_pattern_holder.data(), 0, _hash_key_filter_pattern_holder.length()),
-          sort_key_filter_type(sort_key_filter_type_),
-          sort_key_filter_pattern(
-              _sort_key_filter_pattern_holder.data(), 0, _sort_key_filter_pattern_holder.length()),
+          hash_key_filter(std::move(hash_key_filter_)),
+          sort_key_filter(std::move(sort_key_filter_)),
           batch_size(batch_size_),
-          no_value(no_value_)
+          no_value(no_value_),
+          limits(limits_),
+          aggregate(aggregate_),
+          aggregate_top_count(aggregate_top_count_)
     {
     }
 
 private:
     std::string _stop_holder;
-    std::string _hash_key_filter_pattern_holder;
-    std::string _sort_key_filter_pattern_holder;
+    // keeps the blob files read by the iterator, which is destroyed before it
+    std::unique_ptr<pegasus_blob_store::reader_pin> _blob_pin;
 
 public:
     std::unique_ptr<rocksdb::Iterator> iterator;
     rocksdb::Slice stop;
     bool stop_inclusive;
-    ::dsn::apps::filter_type::type hash_key_filter_type;
-    dsn::blob hash_key_filter_pattern;
-    ::dsn::apps::filter_type::type sort_key_filter_type;
-    dsn::blob sort_key_filter_pattern;
+    pegasus_filter_matcher hash_key_filter;
+    pegasus_filter_matcher sort_key_filter;
     int32_t batch_size;
     bool no_value;
+    pegasus_scan_limits limits;
+    bool aggregate;
+    int32_t aggregate_top_count;
 };
 
+// The cache of the contexts of the unfinished scans, which are fetched out when used and put
+// back after. Each context holds a rocksdb iterator which pins the memtables and sst files,
+// so the cache is bounded by the count of contexts, and the least recently used ones are
+// evicted first. As the contexts are put back on every use, the LRU list is also ordered by
+// the idle time, so the idle ones can be expired from its head by a coarse periodic timer
+// instead of a delayed task for each context.
 class pegasus_context_cache
 {
 public:
-    pegasus_context_cache() : _counter(pegasus::utils::epoch_now() << 20) {}
+    pegasus_context_cache()
+        : _counter(pegasus::utils::epoch_now() << 20), _max_count(0), _evict_count(0)
+    {
+    }
 
-    void clear()
+    // 0 means no limit
+    void set_max_count(size_t max_count)
     {
         ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
-        _map.clear();
+        _max_count = max_count;
     }
 
+    void clear()
+    {
+        std::list<std::pair<int64_t, entry>> evicted;
+        {
+            ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+            _map.clear();
+            evicted.swap(_lru);
+        }
+        // the evicted contexts are destroyed out of the lock in all the methods, as releasing
+        // the iterators may be slow
+    }
+
+    // put the context as the most recently used one, and evict the least recently used ones
+    // if the count exceeds the limit.
     int64_t put(std::unique_ptr<pegasus_scan_context> context)
     {
-        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
-        int64_t handle = _counter++;
-        _map[handle] = std::move(context);
+        std::list<std::pair<int64_t, entry>> evicted;
+        int64_t handle;
+        {
+            ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+            handle = _counter++;
+            _lru.emplace_back(handle, entry{std::move(context), dsn_now_ns()});
+            _map[handle] = std::prev(_lru.end());
+            while (_max_count > 0 && _map.size() > _max_count) {
+                evict_front(evicted);
+            }
+        }
         return handle;
     }
 
@@ -85,15 +169,75 @@ public:
         auto kv = _map.find(handle);
         if (kv == _map.end())
             return nullptr;
-        std::unique_ptr<pegasus_scan_context> ret = std::move(kv->second);
+        std::unique_ptr<pegasus_scan_context> ret = std::move(kv->second->second.context);
+        _lru.erase(kv->second);
         _map.erase(kv);
         return ret;
     }
 
+    // evict the contexts which are not used since 'now_ns - max_idle_ns'.
+    void evict_idle(uint64_t now_ns, uint64_t max_idle_ns)
+    {
+        std::list<std::pair<int64_t, entry>> evicted;
+        {
+            ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+            while (!_lru.empty() && _lru.front().second.put_time_ns + max_idle_ns <= now_ns) {
+                evict_front(evicted);
+            }
+        }
+    }
+
+    // evict the least recently used context, return false if the cache is empty.
+    bool evict_lru()
+    {
+        std::list<std::pair<int64_t, entry>> evicted;
+        {
+            ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+            if (_lru.empty()) {
+                return false;
+            }
+            evict_front(evicted);
+        }
+        return true;
+    }
+
+    size_t size() const
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+        return _map.size();
+    }
+
+    // the count of the contexts evicted since the last call.
+    uint64_t fetch_evict_count()
+    {
+        ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr_spin> l(_lock);
+        uint64_t count = _evict_count;
+        _evict_count = 0;
+        return count;
+    }
+
+private:
+    struct entry
+    {
+        std::unique_ptr<pegasus_scan_context> context;
+        uint64_t put_time_ns;
+    };
+
+    void evict_front(std::list<std::pair<int64_t, entry>> &evicted)
+    {
+        _map.erase(_lru.front().first);
+        evicted.splice(evicted.end(), _lru, _lru.begin());
+        _evict_count++;
+    }
+
 private:
     int64_t _counter;
-    std::unordered_map<int64_t, std::unique_ptr<pegasus_scan_context>> _map;
-    ::dsn::utils::ex_lock_nr_spin _lock;
+    size_t _max_count;
+    uint64_t _evict_count;
+    // ordered by the put time, the least recently used one first
+    std::list<std::pair<int64_t, entry>> _lru;
+    std::unordered_map<int64_t, std::list<std::pair<int64_t, entry>>::iterator> _map;
+    mutable ::dsn::utils::ex_lock_nr_spin _lock;
 };
 }
 }
@@ -5,11 +5,15 @@
 #include "pegasus_server_impl.h"
 
 #include <algorithm>
+#include <limits>
 #include <boost/lexical_cast.hpp>
 #include <rocksdb/convenience.h>
+#include <rocksdb/metadata.h>
 #include <rocksdb/table.h>
 #include <rocksdb/utilities/checkpoint.h>
 #include <rocksdb/filter_policy.h>
+#include <rocksdb/write_buffer_manager.h>
+#include <dsn/tool-api/task_spec.h>
 #include <dsn/utility/utils.h>
 #include <dsn/utility/filesystem.h>
 #include <dsn/dist/fmt_logging.h>
@@ -18,21 +22,26 @@
 #include "base/pegasus_value_schema.h"
 #include "base/pegasus_utils.h"
 #include "pegasus_event_listener.h"
+#include "hashkey_transform.h"
 #include "pegasus_server_write.h"
 
 namespace pegasus {
 namespace server {
 
-// Although we have removed the INCR operator, but we need reserve the code for compatibility
-// reason,
-// because there may be some mutation log entries which include the code. Even if these entries need
-// not to be applied to rocksdb, they may be deserialized.
-DEFINE_TASK_CODE_RPC(RPC_RRDB_RRDB_INCR, TASK_PRIORITY_COMMON, ::dsn::THREAD_POOL_DEFAULT)
-
-DEFINE_TASK_CODE(LPC_PEGASUS_SERVER_DELAY, TASK_PRIORITY_COMMON, ::dsn::THREAD_POOL_DEFAULT)
+DEFINE_TASK_CODE(LPC_UPDATING_SCAN_CONTEXT_CACHE,
+                 TASK_PRIORITY_COMMON,
+                 ::dsn::THREAD_POOL_DEFAULT)
 
 DEFINE_TASK_CODE(LPC_UPDATING_ROCKSDB_SSTSIZE, TASK_PRIORITY_COMMON, THREAD_POOL_REPLICATION_LONG)
 
+DEFINE_TASK_CODE(LPC_UPDATING_ROCKSDB_MEMTABLE_USAGE,
+                 TASK_PRIORITY_COMMON,
+                 THREAD_POOL_REPLICATION_LONG)
+
+DEFINE_TASK_CODE(LPC_BLOB_GC, TASK_PRIORITY_COMMON, THREAD_POOL_REPLICATION_LONG)
+
+DEFINE_TASK_CODE(LPC_TTL_COMPACTION, TASK_PRIORITY_COMMON, THREAD_POOL_COMPACT)
+
 static std::string chkpt_get_dir_name(int64_t decree)
 {
     char buffer[256];
@@ -46,13 +55,64 @@ static bool chkpt_init_from_dir(const char *name, int64_t &decree)
            std::string(name) == chkpt_get_dir_name(decree);
 }
 
+// return the read options for iterating the records of one hash key, which make use of
+// the prefix bloom filter (if enabled) to skip the sst files not containing the hash key.
+static rocksdb::ReadOptions hashkey_read_options(const rocksdb::ReadOptions &base)
+{
+    rocksdb::ReadOptions options = base;
+    options.total_order_seek = false;
+    options.prefix_same_as_start = true;
+    return options;
+}
+
+// return true if all the keys in range [start, stop] have the same hash key.
+static bool is_hashkey_scoped_range(const rocksdb::Slice &start, const rocksdb::Slice &stop)
+{
+    if (start.size() < 2) {
+        return false;
+    }
+    // hash_key_len is in big endian
+    uint16_t hash_key_len = be16toh(*(int16_t *)(start.data()));
+    if (start.size() < 2 + hash_key_len) {
+        return false;
+    }
+    ::dsn::blob hash_key_stop;
+    pegasus_generate_next_blob(hash_key_stop, ::dsn::blob(start.data(), 2, hash_key_len));
+    return stop.compare(rocksdb::Slice(hash_key_stop.data(), hash_key_stop.length())) <= 0;
+}
+
+/*static*/ void pegasus_server_impl::init_write_batching()
+{
+    // the multi-key writes and the incrs are batched with the other writes into one mutation
+    // only if enabled, as the replicas of older versions can not apply such mutations. it
+    // should be enabled after all the replica servers are upgraded.
+    bool batch_multi_key_writes = dsn_config_get_value_bool(
+        "pegasus.server",
+        "batch_multi_key_writes",
+        false,
+        "whether to batch multi_put, multi_remove and incr with the other writes into one "
+        "mutation, enable it only after all the replica servers are upgraded, default false");
+    if (batch_multi_key_writes) {
+        for (dsn::task_code code : {dsn::apps::RPC_RRDB_RRDB_MULTI_PUT,
+                                    dsn::apps::RPC_RRDB_RRDB_MULTI_REMOVE,
+                                    dsn::apps::RPC_RRDB_RRDB_INCR}) {
+            dsn::task_spec::get(code)->rpc_request_is_write_allow_batch = true;
+        }
+    }
+    ddebug("batch_multi_key_writes = %s", batch_multi_key_writes ? "true" : "false");
+}
+
 pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
     : dsn::apps::rrdb_service(r),
       _db(nullptr),
       _is_open(false),
       _value_schema_version(0),
+      _blob_value_threshold(0),
       _last_durable_decree(0),
       _is_checkpointing(false),
+      _fill_cache(true),
+      _may_have_ttl_records(true),
+      _ttl_compaction_stopping(false),
       _manual_compact_svc(this)
 {
     _primary_address = dsn::rpc_address(dsn_primary_address()).to_string();
@@ -61,6 +121,7 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
                                              "rocksdb_verbose_log",
                                              false,
                                              "print verbose log for debugging, default is false");
+
     _abnormal_get_time_threshold_ns = dsn_config_get_value_uint64(
         "pegasus.server",
         "rocksdb_abnormal_get_time_threshold_ns",
@@ -182,36 +243,32 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
         "rocksdb_compression_type",
         "snappy",
         "rocksdb options.compression, default snappy. Supported: none, snappy.");
+    rocksdb::CompressionType compression = rocksdb::kSnappyCompression;
     if (compression_str == "none") {
-        _db_opts.compression = rocksdb::kNoCompression;
+        compression = rocksdb::kNoCompression;
     } else if (compression_str == "snappy") {
-        _db_opts.compression = rocksdb::kSnappyCompression;
+        compression = rocksdb::kSnappyCompression;
     } else {
         dassert("unsupported compression type: %s", compression_str.c_str());
     }
-
-    if (_db_opts.compression != rocksdb::kNoCompression) {
-        // only compress levels >= 2
-        // refer to ColumnFamilyOptions::OptimizeLevelStyleCompaction()
-        _db_opts.compression_per_level.resize(_db_opts.num_levels);
-        for (int i = 0; i < _db_opts.num_levels; ++i) {
-            if (i < 2) {
-                _db_opts.compression_per_level[i] = rocksdb::kNoCompression;
-            } else {
-                _db_opts.compression_per_level[i] = _db_opts.compression;
-            }
-        }
+    // only compress levels >= 2
+    // refer to ColumnFamilyOptions::OptimizeLevelStyleCompaction()
+    if (compression == rocksdb::kNoCompression) {
+        _default_storage_profile.compression_per_level = {rocksdb::kNoCompression};
+    } else {
+        _default_storage_profile.compression_per_level = {
+            rocksdb::kNoCompression, rocksdb::kNoCompression, compression};
     }
 
-    // read rocksdb::BlockBasedTableOptions configurations
-    rocksdb::BlockBasedTableOptions tbl_opts;
+    // read rocksdb::BlockBasedTableOptions configurations, the table factory is created by
+    // pegasus_storage_profile::apply() with them
     // disable table block cache, default: false
     if (dsn_config_get_value_bool("pegasus.server",
                                   "rocksdb_disable_table_block_cache",
                                   false,
                                   "rocksdb tbl_opts.no_block_cache, default false")) {
-        tbl_opts.no_block_cache = true;
-        tbl_opts.block_restart_interval = 4;
+        _tbl_opts.no_block_cache = true;
+        _tbl_opts.block_restart_interval = 4;
     } else {
         // block cache capacity, default 10G
         static uint64_t capacity = dsn_config_get_value_uint64(
@@ -227,27 +284,242 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
             -1,
             "block cache will be sharded into 2^num_shard_bits shards");
 
+        // the ratio of the high priority pool, for the index and filter blocks of the tables
+        // with cache priority high, default 0 (disabled)
+        static double high_pri_pool_ratio = dsn_config_get_value_double(
+            "pegasus.server",
+            "rocksdb_block_cache_high_pri_pool_ratio",
+            0.0,
+            "the ratio of the block cache reserved for the index and filter blocks of the tables "
+            "with the app env rocksdb.cache_priority=high, default 0");
+
         // init block cache
         static std::shared_ptr<rocksdb::Cache> cache =
-            rocksdb::NewLRUCache(capacity, num_shard_bits);
-        tbl_opts.block_cache = cache;
+            rocksdb::NewLRUCache(capacity, num_shard_bits, false, high_pri_pool_ratio);
+        _tbl_opts.block_cache = cache;
     }
 
     // disable bloom filter, default: false
-    if (!dsn_config_get_value_bool("pegasus.server",
-                                   "rocksdb_disable_bloom_filter",
-                                   false,
-                                   "rocksdb tbl_opts.filter_policy, default nullptr")) {
-        tbl_opts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    if (dsn_config_get_value_bool("pegasus.server",
+                                  "rocksdb_disable_bloom_filter",
+                                  false,
+                                  "rocksdb tbl_opts.filter_policy, default nullptr")) {
+        _default_storage_profile.bloom_bits_per_key = 0;
+    }
+
+    // bloom filter type, default: prefix
+    std::string filter_type =
+        dsn_config_get_value_string("pegasus.server",
+                                    "rocksdb_filter_type",
+                                    "prefix",
+                                    "bloom filter type, should be either 'common' or 'prefix'");
+    dassert(filter_type == "common" || filter_type == "prefix",
+            "unsupported filter type: %s",
+            filter_type.c_str());
+    if (filter_type == "prefix") {
+        // use [hash_key_len][hash_key] as the prefix, then both of the prefix and the whole
+        // key are added into the bloom filter, as _tbl_opts.whole_key_filtering is true.
+        _db_opts.prefix_extractor.reset(new HashkeyTransform());
+
+        // rocksdb default: 0
+        _db_opts.memtable_prefix_bloom_size_ratio = dsn_config_get_value_double(
+            "pegasus.server",
+            "rocksdb_memtable_prefix_bloom_size_ratio",
+            0.1,
+            "rocksdb options.memtable_prefix_bloom_size_ratio, default 0.1");
     }
 
-    _db_opts.table_factory.reset(NewBlockBasedTableFactory(tbl_opts));
+    // the tables without the storage profile set by the app envs use the server config
+    _default_storage_profile.block_size = _tbl_opts.block_size;
+    _default_storage_profile.cache_index_and_filter_blocks =
+        _tbl_opts.cache_index_and_filter_blocks;
+    _default_storage_profile.apply(_db_opts, _tbl_opts);
+    _storage_profile = _default_storage_profile;
+    _requested_storage_profile = _default_storage_profile;
+
+    // write buffer manager, shared by all rocksdb instances in one process, default 0 (disabled)
+    static uint64_t total_size_across_write_buffer = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "rocksdb_total_size_across_write_buffer",
+        0,
+        "total size limit of memtables across all rocksdb instances in one pegasus server, "
+        "0 means no limit");
+    if (total_size_across_write_buffer > 0) {
+        // charge memtable memory to block cache, default: false
+        static bool charge_to_block_cache =
+            dsn_config_get_value_bool("pegasus.server",
+                                      "rocksdb_write_buffer_charge_to_block_cache",
+                                      false,
+                                      "whether to charge memtable memory to the block cache, "
+                                      "so that the total memory is limited by block cache "
+                                      "capacity, default false");
+        // init write buffer manager, the memtables of the writing instance will be flushed
+        // when the total size is exceeded.
+        static std::shared_ptr<rocksdb::WriteBufferManager> write_buffer_manager =
+            std::make_shared<rocksdb::WriteBufferManager>(
+                total_size_across_write_buffer,
+                charge_to_block_cache ? _tbl_opts.block_cache : nullptr);
+        _db_opts.write_buffer_manager = write_buffer_manager;
+
+        static std::shared_ptr<pegasus_memtable_flush_picker> memtable_flush_picker =
+            std::make_shared<pegasus_memtable_flush_picker>();
+        _memtable_flush_picker = memtable_flush_picker;
+    }
+
+    // row cache, shared by all replicas in one process, default 0 (disabled)
+    static uint64_t row_cache_capacity = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "row_cache_capacity",
+        0,
+        "row cache capacity for one pegasus server, shared by all replicas, 0 means disabled");
+    if (row_cache_capacity > 0) {
+        // row cache num shard bits, default -1(auto)
+        static int num_shard_bits = (int)dsn_config_get_value_int64(
+            "pegasus.server",
+            "row_cache_num_shard_bits",
+            -1,
+            "row cache will be sharded into 2^num_shard_bits shards");
+        static uint32_t max_value_size = (uint32_t)dsn_config_get_value_uint64(
+            "pegasus.server",
+            "row_cache_max_value_size",
+            1024,
+            "the values larger than this size are not cached by the row cache");
+        static std::shared_ptr<rocksdb::Cache> row_cache =
+            rocksdb::NewLRUCache(row_cache_capacity, num_shard_bits);
+        _row_cache.init(row_cache, max_value_size);
+    }
+    _row_cache_multi_get_max_sort_keys = (uint32_t)dsn_config_get_value_uint64(
+        "pegasus.server",
+        "row_cache_multi_get_max_sort_keys",
+        16,
+        "the row cache is used by multi_get with no more than this count of sort keys specified");
+
+    _value_compression_threshold = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "value_compression_threshold",
+        0,
+        "the values not smaller than this size are compressed by snappy when written, if the "
+        "value schema version is no less than 1. 0 means never compress");
+
+    _blob_value_threshold = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "blob_value_threshold",
+        0,
+        "the values not smaller than this size are separated from the LSM tree into the blob "
+        "files when written, if the value schema version is no less than 2, so that only the "
+        "small blob indexes of them are rewritten by the compactions. 0 means never separate");
+    _blob_opts.file_size =
+        dsn_config_get_value_uint64("pegasus.server",
+                                    "blob_file_size",
+                                    256 * 1024 * 1024,
+                                    "the blob file is sealed once it exceeds this size");
+    _blob_opts.gc_garbage_ratio = dsn_config_get_value_double(
+        "pegasus.server",
+        "blob_gc_garbage_ratio",
+        0.5,
+        "the live values in the blob files with this ratio of garbage are relocated by the "
+        "compactions, so that the files can be deleted");
+    _blob_opts.file_delete_delay_seconds = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "blob_file_delete_delay_seconds",
+        600,
+        "the blob files not referred any more are deleted after this time at least, as the "
+        "relocation file of a compaction is not referred until the compaction is installed, the "
+        "files are also kept until the readers created before are released");
+    _blob_gc_interval_seconds = (uint32_t)dsn_config_get_value_uint64(
+        "pegasus.server", "blob_gc_interval_seconds", 300, "blob_gc_interval_seconds");
+
+    _ttl_compaction_expired_ratio_threshold = dsn_config_get_value_double(
+        "pegasus.server",
+        "ttl_compaction_expired_ratio_threshold",
+        0.5,
+        "the key ranges of the sst files with this estimated ratio of expired records are "
+        "compacted in background to drop the expired records, 0 means disabled");
+    _ttl_compaction_interval_seconds = (uint32_t)dsn_config_get_value_uint64(
+        "pegasus.server",
+        "ttl_compaction_interval_seconds",
+        3600,
+        "the interval to check the sst files for ttl compaction");
+    _ttl_compaction_max_file_count = (uint32_t)dsn_config_get_value_uint64(
+        "pegasus.server",
+        "ttl_compaction_max_file_count",
+        4,
+        "max count of the sst files whose key ranges are compacted by one ttl compaction");
+
+    // the compactions of many replicas at the same time may slow down the online writes, as
+    // they share the disk and the compaction threads of rocksdb, so the count of the running
+    // ttl compactions is limited in one pegasus server, default 1
+    static int32_t ttl_compaction_max_concurrent_count = (int32_t)dsn_config_get_value_uint64(
+        "pegasus.server",
+        "ttl_compaction_max_concurrent_count",
+        1,
+        "max count of the replicas doing ttl compaction at the same time in one pegasus server, "
+        "0 means no limit");
+    static std::atomic<int32_t> running_ttl_compaction_count(0);
+    _ttl_compaction_max_concurrent_count = ttl_compaction_max_concurrent_count;
+    _running_ttl_compaction_count = &running_ttl_compaction_count;
 
     _db_opts.listeners.emplace_back(new pegasus_event_listener());
 
+    _table_properties_collector_factory =
+        std::make_shared<pegasus_table_properties_collector_factory>();
+    _db_opts.table_properties_collector_factories.push_back(_table_properties_collector_factory);
+
+    _key_ttl_compaction_filter_factory = std::make_shared<KeyWithTTLCompactionFilterFactory>();
+    _db_opts.compaction_filter_factory = _key_ttl_compaction_filter_factory;
+
     // disable write ahead logging as replication handles logging instead now
     _wt_opts.disableWAL = true;
 
+    // iterators may cross hash keys (e.g. full scan), so total order seek is used by default
+    // to keep them unaffected by the prefix extractor. the iterators on one hash key should
+    // use hashkey_read_options() to make use of the prefix bloom filter.
+    _rd_opts.total_order_seek = true;
+    _no_fill_cache_rd_opts = _rd_opts;
+    _no_fill_cache_rd_opts.fill_cache = false;
+
+    // the full scans read a large range only once, so they do not fill the block cache to keep
+    // the hot data of online reads in it, and read ahead to reduce the count of disk reads
+    _full_scan_rd_opts = _rd_opts;
+    _full_scan_rd_opts.fill_cache = false;
+    _full_scan_rd_opts.readahead_size = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "full_scan_readahead_size",
+        2 * 1024 * 1024,
+        "the readahead size of the iterators of full scans, in bytes");
+    _full_scan_max_iteration_time_ms = (int32_t)dsn_config_get_value_uint64(
+        "pegasus.server",
+        "full_scan_max_iteration_time_ms",
+        10,
+        "max time of iteration in one full scan rpc, which is usually shorter than "
+        "scan_max_iteration_time_ms to yield the replica threads to online reads more often");
+
+    _approximate_sortkey_count_exact_threshold = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "approximate_sortkey_count_exact_threshold",
+        1024 * 1024,
+        "approximate_sortkey_count counts exactly if the hash key is estimated to be smaller "
+        "than this size in bytes, as the estimation is inaccurate for small ranges");
+
+    _scan_limits.max_iteration_count = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "scan_max_iteration_count",
+        100000,
+        "max count of records iterated by one scan rpc, including the expired and filtered "
+        "ones, 0 means no limit");
+    _scan_limits.max_iteration_time_ns =
+        dsn_config_get_value_uint64("pegasus.server",
+                                    "scan_max_iteration_time_ms",
+                                    100,
+                                    "max time of iteration in one scan rpc, 0 means no limit") *
+        1000000;
+    _scan_limits.max_response_bytes =
+        dsn_config_get_value_uint64("pegasus.server",
+                                    "scan_max_response_bytes",
+                                    4 * 1024 * 1024,
+                                    "max bytes of records returned by one scan rpc, 0 means no "
+                                    "limit");
+
     // get the checkpoint reserve options.
     _checkpoint_reserve_min_count = (uint32_t)dsn_config_get_value_uint64(
         "pegasus.server", "checkpoint_reserve_min_count", 3, "checkpoint_reserve_min_count");
@@ -264,6 +536,37 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
                                               600,
                                               "updating_rocksdb_sstsize_interval_seconds");
 
+    // get the _updating_rocksdb_memtable_usage_interval_seconds.
+    _updating_rocksdb_memtable_usage_interval_seconds =
+        (uint32_t)dsn_config_get_value_uint64("pegasus.server",
+                                              "updating_rocksdb_memtable_usage_interval_seconds",
+                                              10,
+                                              "updating_rocksdb_memtable_usage_interval_seconds");
+
+    _context_cache.set_max_count(dsn_config_get_value_uint64(
+        "pegasus.server",
+        "scan_context_max_count",
+        1000,
+        "max count of the scan contexts of a replica, the least recently used ones are evicted "
+        "if exceeded, 0 means no limit"));
+    _scan_context_max_idle_ns =
+        dsn_config_get_value_uint64("pegasus.server",
+                                    "scan_context_max_idle_seconds",
+                                    300,
+                                    "the scan contexts not used for this time are expired") *
+        1000000000;
+    _scan_context_max_pinned_bytes = dsn_config_get_value_uint64(
+        "pegasus.server",
+        "scan_context_max_pinned_bytes",
+        1024 * 1024 * 1024,
+        "max memory of the flushed memtables pinned by the scan contexts of a replica, the least "
+        "recently used ones are evicted if exceeded, 0 means no limit");
+    _updating_scan_context_cache_interval_seconds =
+        (uint32_t)dsn_config_get_value_uint64("pegasus.server",
+                                              "updating_scan_context_cache_interval_seconds",
+                                              10,
+                                              "updating_scan_context_cache_interval_seconds");
+
     // TODO: move the qps/latency counters and it's statistics to replication_app_base layer
     char str_gpid[128], buf[256];
     snprintf(str_gpid, 128, "%d.%d", _gpid.get_app_id(), _gpid.get_partition_index());
@@ -277,6 +580,10 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
     _pfc_multi_get_qps.init_app_counter(
         "app.pegasus", buf, COUNTER_TYPE_RATE, "statistic the qps of MULTI_GET request");
 
+    snprintf(buf, 255, "batch_get_qps@%s", str_gpid);
+    _pfc_batch_get_qps.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_RATE, "statistic the qps of BATCH_GET request");
+
     snprintf(buf, 255, "scan_qps@%s", str_gpid);
     _pfc_scan_qps.init_app_counter(
         "app.pegasus", buf, COUNTER_TYPE_RATE, "statistic the qps of SCAN request");
@@ -293,12 +600,26 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
                                             COUNTER_TYPE_NUMBER_PERCENTILES,
                                             "statistic the latency of MULTI_GET request");
 
+    snprintf(buf, 255, "batch_get_latency@%s", str_gpid);
+    _pfc_batch_get_latency.init_app_counter("app.pegasus",
+                                            buf,
+                                            COUNTER_TYPE_NUMBER_PERCENTILES,
+                                            "statistic the latency of BATCH_GET request");
+
     snprintf(buf, 255, "scan_latency@%s", str_gpid);
     _pfc_scan_latency.init_app_counter("app.pegasus",
                                        buf,
                                        COUNTER_TYPE_NUMBER_PERCENTILES,
                                        "statistic the latency of SCAN request");
 
+    snprintf(buf, 255, "row_cache_hit@%s", str_gpid);
+    _pfc_row_cache_hit.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_RATE, "statistic the hit qps of the row cache");
+
+    snprintf(buf, 255, "row_cache_miss@%s", str_gpid);
+    _pfc_row_cache_miss.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_RATE, "statistic the miss qps of the row cache");
+
     snprintf(buf, 255, "recent.expire.count@%s", str_gpid);
     _pfc_recent_expire_count.init_app_counter("app.pegasus",
                                               buf,
@@ -325,6 +646,61 @@ pegasus_server_impl::pegasus_server_impl(dsn::replication::replica *r)
     _pfc_sst_size.init_app_counter(
         "app.pegasus", buf, COUNTER_TYPE_NUMBER, "statistic the size of sstable files");
 
+    snprintf(buf, 255, "disk.storage.blob.count@%s", str_gpid);
+    _pfc_blob_count.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_NUMBER, "statistic the count of blob files");
+
+    snprintf(buf, 255, "disk.storage.blob(MB)@%s", str_gpid);
+    _pfc_blob_size.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_NUMBER, "statistic the size of blob files");
+
+    snprintf(buf, 255, "recent.ttl.compaction.count@%s", str_gpid);
+    _pfc_recent_ttl_compaction_count.init_app_counter(
+        "app.pegasus",
+        buf,
+        COUNTER_TYPE_VOLATILE_NUMBER,
+        "statistic the recent count of the sst files compacted for the expired records");
+
+    snprintf(buf, 255, "rdb.memtable.memory_usage@%s", str_gpid);
+    _pfc_memtable_usage.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_NUMBER, "statistic the memory usage of memtables");
+
+    snprintf(buf, 255, "rdb.memtable.pinned_memory_usage@%s", str_gpid);
+    _pfc_pinned_memtable_usage.init_app_counter(
+        "app.pegasus",
+        buf,
+        COUNTER_TYPE_NUMBER,
+        "statistic the memory usage of the flushed memtables pinned by iterators");
+
+    snprintf(buf, 255, "scan_context.count@%s", str_gpid);
+    _pfc_scan_context_count.init_app_counter(
+        "app.pegasus", buf, COUNTER_TYPE_NUMBER, "statistic the count of the scan contexts");
+
+    snprintf(buf, 255, "recent.scan_context.evict.count@%s", str_gpid);
+    _pfc_recent_scan_context_evict_count.init_app_counter(
+        "app.pegasus",
+        buf,
+        COUNTER_TYPE_VOLATILE_NUMBER,
+        "statistic the recent count of the scan contexts expired or evicted");
+
+    _pfc_node_memtable_usage.init_app_counter(
+        "app.pegasus",
+        "rdb.memtable.node_memory_usage",
+        COUNTER_TYPE_NUMBER,
+        "statistic the memory usage of memtables of all replicas in this process");
+
+    _pfc_node_row_cache_usage.init_app_counter(
+        "app.pegasus",
+        "rdb.row_cache.node_memory_usage",
+        COUNTER_TYPE_NUMBER,
+        "statistic the memory usage of the row cache shared by all replicas in this process");
+
+    _pfc_node_row_cache_evict_count.init_app_counter(
+        "app.pegasus",
+        "rdb.row_cache.node_evict_count",
+        COUNTER_TYPE_NUMBER,
+        "statistic the count of records evicted from the row cache since this process started");
+
     updating_rocksdb_sstsize();
 }
 
@@ -516,12 +892,38 @@ void pegasus_server_impl::on_get(const ::dsn::blob &key,
     resp.partition_index = _gpid.get_partition_index();
     resp.server = _primary_address;
 
-    rocksdb::Slice skey(key.data(), key.length());
-    std::string value;
-    rocksdb::Status status = _db->Get(_rd_opts, skey, &value);
+    rocksdb::Status status;
+    uint32_t expire_ts = 0;
+    bool row_cache_hit = false;
+    // pin the value in rocksdb memory (block cache or memtable) to avoid data copy,
+    // the pinned memory is released after the response is serialized by reply().
+    rocksdb::PinnableSlice value;
+    uint64_t row_cache_ticket = _row_cache.enabled() ? _row_cache.read_begin() : 0;
+    if (_row_cache.enabled() && _row_cache.lookup(key, expire_ts, resp.value)) {
+        row_cache_hit = true;
+        _pfc_row_cache_hit->increment();
+    } else {
+        pegasus_blob_store::reader_pin blob_pin(_blob_store.get());
+        rocksdb::Slice skey(key.data(), key.length());
+        status = _db->Get(read_options(), _db->DefaultColumnFamily(), skey, &value);
+        if (status.ok()) {
+            expire_ts =
+                pegasus_extract_expire_ts(_value_schema_version, utils::to_string_view(value));
+            // the expired value is not extracted, which may be read from the blob file
+            if (!::pegasus::check_if_record_expired(utils::epoch_now(), expire_ts)) {
+                status = extract_user_data(utils::to_string_view(value), resp.value);
+            }
+        }
+        if (_row_cache.enabled()) {
+            _pfc_row_cache_miss->increment();
+            if (status.ok() && !::pegasus::check_if_record_expired(utils::epoch_now(), expire_ts)) {
+                _row_cache.insert(row_cache_ticket, key, expire_ts, resp.value);
+            }
+        }
+    }
 
     if (status.ok()) {
-        if (check_if_record_expired(utils::epoch_now(), value)) {
+        if (::pegasus::check_if_record_expired(utils::epoch_now(), expire_ts)) {
             _pfc_recent_expire_count->increment();
             if (_verbose_log) {
                 derror("%s: rocksdb data expired for get from %s",
@@ -529,6 +931,10 @@ void pegasus_server_impl::on_get(const ::dsn::blob &key,
                        reply.to_address().to_string());
             }
             status = rocksdb::Status::NotFound();
+            resp.value = ::dsn::blob();
+            if (row_cache_hit) {
+                _row_cache.erase(key);
+            }
         }
     }
 
@@ -554,7 +960,8 @@ void pegasus_server_impl::on_get(const ::dsn::blob &key,
     if (_abnormal_get_time_threshold_ns || _abnormal_get_size_threshold) {
         uint64_t time_used = dsn_now_ns() - start_time;
         if ((_abnormal_get_time_threshold_ns && time_used >= _abnormal_get_time_threshold_ns) ||
-            (_abnormal_get_size_threshold && value.size() >= _abnormal_get_size_threshold)) {
+            (_abnormal_get_size_threshold &&
+             resp.value.length() >= _abnormal_get_size_threshold)) {
             ::dsn::blob hash_key, sort_key;
             pegasus_restore_key(key, hash_key, sort_key);
             dwarn("%s: rocksdb abnormal get from %s: "
@@ -565,16 +972,13 @@ void pegasus_server_impl::on_get(const ::dsn::blob &key,
                   ::pegasus::utils::c_escape_string(hash_key).c_str(),
                   ::pegasus::utils::c_escape_string(sort_key).c_str(),
                   status.ToString().c_str(),
-                  (int)value.size(),
+                  (int)resp.value.length(),
                   time_used);
             _pfc_recent_abnormal_count->increment();
         }
     }
 
     resp.error = status.code();
-    if (status.ok()) {
-        pegasus_extract_user_data(_value_schema_version, std::move(value), resp.value);
-    }
 
     _pfc_get_latency->set(dsn_now_ns() - start_time);
 
@@ -613,6 +1017,7 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
     int32_t iterate_count = 0;
     int32_t expire_count = 0;
     int32_t filter_count = 0;
+    pegasus_blob_store::reader_pin blob_pin(_blob_store.get());
 
     if (request.sort_keys.empty()) {
         ::dsn::blob range_start_key, range_stop_key;
@@ -682,9 +1087,26 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
             return;
         }
 
-        std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(_rd_opts));
+        pegasus_filter_matcher sort_key_filter(
+            request.sort_key_filter_type,
+            dsn::string_view(request.sort_key_filter_pattern.data(),
+                             request.sort_key_filter_pattern.length()));
+
+        // the upper bound should be alive as long as the iterator
+        ::dsn::blob hash_key_stop_key;
+        pegasus_generate_next_blob(hash_key_stop_key, request.hash_key);
+        rocksdb::Slice hash_key_stop(hash_key_stop_key.data(), hash_key_stop_key.length());
+        std::unique_ptr<rocksdb::Iterator> it;
         bool complete = false;
+        // set if failed to read the value from the blob file
+        rocksdb::Status blob_status;
         if (!request.reverse) {
+            // all keys in range are under the same hash key, so the prefix bloom filter can
+            // be used. the reverse iteration is not optimized, because the seek target may
+            // have a different prefix (the adjacent next hash key).
+            rocksdb::ReadOptions options = hashkey_read_options(read_options());
+            options.iterate_upper_bound = &hash_key_stop;
+            it.reset(_db->NewIterator(options));
             it->Seek(start);
             bool first_exclusive = !start_inclusive;
             while (count < max_kv_count && size < max_kv_size && it->Valid()) {
@@ -712,8 +1134,7 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                 int r = append_key_value_for_multi_get(resp.kvs,
                                                        it->key(),
                                                        it->value(),
-                                                       request.sort_key_filter_type,
-                                                       request.sort_key_filter_pattern,
+                                                       sort_key_filter,
                                                        epoch_now,
                                                        request.no_value);
                 if (r == 1) {
@@ -722,8 +1143,11 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                     size += kv.key.length() + kv.value.length();
                 } else if (r == 2) {
                     expire_count++;
-                } else { // r == 3
+                } else if (r == 3) {
                     filter_count++;
+                } else { // r == 4
+                    blob_status = rocksdb::Status::Corruption("read value failed");
+                    break;
                 }
 
                 if (c == 0) {
@@ -734,7 +1158,14 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
 
                 it->Next();
             }
+
+            if (!complete && blob_status.ok() && it->Valid()) {
+                // stopped by the limits, check if the next record is still in range
+                int c = it->key().compare(stop);
+                complete = c > 0 || (c == 0 && !stop_inclusive);
+            }
         } else { // reverse
+            it.reset(_db->NewIterator(read_options()));
             it->SeekForPrev(stop);
             bool first_exclusive = !stop_inclusive;
             std::vector<::dsn::apps::key_value> reverse_kvs;
@@ -763,8 +1194,7 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                 int r = append_key_value_for_multi_get(reverse_kvs,
                                                        it->key(),
                                                        it->value(),
-                                                       request.sort_key_filter_type,
-                                                       request.sort_key_filter_pattern,
+                                                       sort_key_filter,
                                                        epoch_now,
                                                        request.no_value);
                 if (r == 1) {
@@ -773,8 +1203,11 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                     size += kv.key.length() + kv.value.length();
                 } else if (r == 2) {
                     expire_count++;
-                } else { // r == 3
+                } else if (r == 3) {
                     filter_count++;
+                } else { // r == 4
+                    blob_status = rocksdb::Status::Corruption("read value failed");
+                    break;
                 }
 
                 if (c == 0) {
@@ -786,7 +1219,13 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                 it->Prev();
             }
 
-            if (it->status().ok() && !reverse_kvs.empty()) {
+            if (!complete && blob_status.ok() && it->Valid()) {
+                // stopped by the limits, check if the next record is still in range
+                int c = it->key().compare(start);
+                complete = c < 0 || (c == 0 && !start_inclusive);
+            }
+
+            if (it->status().ok() && blob_status.ok() && !reverse_kvs.empty()) {
                 // revert order to make resp.kvs ordered in sort_key
                 resp.kvs.reserve(reverse_kvs.size());
                 for (int i = reverse_kvs.size() - 1; i >= 0; i--) {
@@ -795,8 +1234,9 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
             }
         }
 
-        resp.error = it->status().code();
-        if (!it->status().ok()) {
+        rocksdb::Status status = blob_status.ok() ? it->status() : blob_status;
+        resp.error = status.code();
+        if (!status.ok()) {
             // error occur
             if (_verbose_log) {
                 derror("%s: rocksdb scan failed for multi_get from %s: "
@@ -805,40 +1245,72 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                        reply.to_address().to_string(),
                        ::pegasus::utils::c_escape_string(request.hash_key).c_str(),
                        request.reverse ? "true" : "false",
-                       it->status().ToString().c_str());
+                       status.ToString().c_str());
             } else {
                 derror("%s: rocksdb scan failed for multi_get from %s: "
                        "reverse = %s, error = %s",
                        replica_name(),
                        reply.to_address().to_string(),
                        request.reverse ? "true" : "false",
-                       it->status().ToString().c_str());
+                       status.ToString().c_str());
             }
             resp.kvs.clear();
         } else if (it->Valid() && !complete) {
-            // scan not completed
+            // scan not completed, resume from the record the iterator stays at, which is under
+            // the hash key as checked above
             resp.error = rocksdb::Status::kIncomplete;
+            rocksdb::Slice key = it->key();
+            size_t prefix_len = 2 + request.hash_key.length();
+            size_t sort_key_len = key.size() - prefix_len;
+            if (sort_key_len > 0) {
+                std::shared_ptr<char> buf(::dsn::utils::make_shared_array<char>(sort_key_len));
+                ::memcpy(buf.get(), key.data() + prefix_len, sort_key_len);
+                resp.resume_sortkey.assign(std::move(buf), 0, sort_key_len);
+            }
         }
     } else {
         bool error_occurred = false;
         rocksdb::Status final_status;
         bool exceed_limit = false;
         std::vector<::dsn::blob> keys_holder;
-        std::vector<rocksdb::Slice> keys;
-        std::vector<std::string> values;
         keys_holder.reserve(request.sort_keys.size());
-        keys.reserve(request.sort_keys.size());
         for (auto &sort_key : request.sort_keys) {
             ::dsn::blob raw_key;
             pegasus_generate_key(raw_key, request.hash_key, sort_key);
-            keys.emplace_back(raw_key.data(), raw_key.length());
             keys_holder.emplace_back(std::move(raw_key));
         }
 
-        std::vector<rocksdb::Status> statuses = _db->MultiGet(_rd_opts, keys, &values);
-        for (int i = 0; i < keys.size(); i++) {
-            rocksdb::Status &status = statuses[i];
-            std::string &value = values[i];
+        // probe the row cache first if only a few sort keys are specified, and read the
+        // missed ones from rocksdb.
+        bool use_row_cache = _row_cache.enabled() &&
+                             request.sort_keys.size() <= _row_cache_multi_get_max_sort_keys;
+        uint64_t row_cache_ticket = use_row_cache ? _row_cache.read_begin() : 0;
+        std::vector<uint32_t> cached_expire_ts(use_row_cache ? keys_holder.size() : 0);
+        std::vector<::dsn::blob> cached_values(use_row_cache ? keys_holder.size() : 0);
+        std::vector<int> key_index(keys_holder.size(), -1); // -1 means hit in the row cache
+        std::vector<rocksdb::Slice> keys;
+        keys.reserve(keys_holder.size());
+        for (int i = 0; i < keys_holder.size(); i++) {
+            if (use_row_cache &&
+                _row_cache.lookup(keys_holder[i], cached_expire_ts[i], cached_values[i])) {
+                continue;
+            }
+            key_index[i] = keys.size();
+            keys.emplace_back(keys_holder[i].data(), keys_holder[i].length());
+        }
+        if (use_row_cache) {
+            _pfc_row_cache_hit->add(keys_holder.size() - keys.size());
+            _pfc_row_cache_miss->add(keys.size());
+        }
+
+        std::vector<std::string> values;
+        std::vector<rocksdb::Status> statuses;
+        if (!keys.empty()) {
+            statuses = _db->MultiGet(read_options(), keys, &values);
+        }
+        for (int i = 0; i < keys_holder.size(); i++) {
+            int k = key_index[i];
+            rocksdb::Status status = k >= 0 ? statuses[k] : rocksdb::Status::OK();
             // print log
             if (!status.ok()) {
                 if (_verbose_log) {
@@ -858,7 +1330,9 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
             }
             // check ttl
             if (status.ok()) {
-                uint32_t expire_ts = pegasus_extract_expire_ts(_value_schema_version, value);
+                uint32_t expire_ts =
+                    k >= 0 ? pegasus_extract_expire_ts(_value_schema_version, values[k])
+                           : cached_expire_ts[i];
                 if (expire_ts > 0 && expire_ts <= epoch_now) {
                     expire_count++;
                     if (_verbose_log) {
@@ -867,6 +1341,16 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                                reply.to_address().to_string());
                     }
                     status = rocksdb::Status::NotFound();
+                    if (k < 0) {
+                        _row_cache.erase(keys_holder[i]);
+                    }
+                } else if (k >= 0 && use_row_cache) {
+                    // extracted once for both the row cache and the response
+                    status = extract_user_data(dsn::string_view(values[k]), cached_values[i]);
+                    if (status.ok()) {
+                        _row_cache.insert(
+                            row_cache_ticket, keys_holder[i], expire_ts, cached_values[i]);
+                    }
                 }
             }
             // extract value
@@ -879,11 +1363,17 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
                 ::dsn::apps::key_value kv;
                 kv.key = request.sort_keys[i];
                 if (!request.no_value) {
-                    pegasus_extract_user_data(_value_schema_version, std::move(value), kv.value);
+                    if (k >= 0 && !use_row_cache) {
+                        status = extract_user_data(std::move(values[k]), kv.value);
+                    } else {
+                        kv.value = std::move(cached_values[i]);
+                    }
+                }
+                if (status.ok()) {
+                    count++;
+                    size += kv.key.length() + kv.value.length();
+                    resp.kvs.emplace_back(std::move(kv));
                 }
-                count++;
-                size += kv.key.length() + kv.value.length();
-                resp.kvs.emplace_back(std::move(kv));
             }
             // if error occurred
             if (!status.ok() && !status.IsNotFound()) {
@@ -948,48 +1438,160 @@ void pegasus_server_impl::on_multi_get(const ::dsn::apps::multi_get_request &req
     reply(resp);
 }
 
-void pegasus_server_impl::on_sortkey_count(const ::dsn::blob &hash_key,
-                                           ::dsn::rpc_replier<::dsn::apps::count_response> &reply)
+void pegasus_server_impl::on_batch_get(const ::dsn::apps::batch_get_request &request,
+                                       ::dsn::rpc_replier<::dsn::apps::batch_get_response> &reply)
 {
     dassert(_is_open, "");
+    _pfc_batch_get_qps->increment();
+    uint64_t start_time = dsn_now_ns();
 
-    ::dsn::apps::count_response resp;
+    ::dsn::apps::batch_get_response resp;
     resp.app_id = _gpid.get_app_id();
     resp.partition_index = _gpid.get_partition_index();
     resp.server = _primary_address;
 
-    // scan
-    ::dsn::blob start_key, stop_key;
-    pegasus_generate_key(start_key, hash_key, ::dsn::blob());
-    pegasus_generate_next_blob(stop_key, hash_key);
-    rocksdb::Slice start(start_key.data(), start_key.length());
-    rocksdb::Slice stop(stop_key.data(), stop_key.length());
-    rocksdb::ReadOptions options = _rd_opts;
-    options.iterate_upper_bound = &stop;
-    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(options));
-    it->Seek(start);
-    resp.count = 0;
+    if (request.keys.empty()) {
+        derror("%s: invalid argument for batch_get from %s: keys should not be empty",
+               replica_name(),
+               reply.to_address().to_string());
+        resp.error = rocksdb::Status::kInvalidArgument;
+        _pfc_batch_get_latency->set(dsn_now_ns() - start_time);
+        reply(resp);
+        return;
+    }
+
+    // all keys of one request are served by a single MultiGet, the same way as
+    // the sort_keys branch of on_multi_get().
+    pegasus_blob_store::reader_pin blob_pin(_blob_store.get());
     uint32_t epoch_now = ::pegasus::utils::epoch_now();
-    uint64_t expire_count = 0;
-    while (it->Valid()) {
-        if (check_if_record_expired(epoch_now, it->value())) {
-            expire_count++;
+    int32_t expire_count = 0;
+    int64_t size = 0;
+    bool error_occurred = false;
+    rocksdb::Status final_status;
+    std::vector<::dsn::blob> keys_holder;
+    std::vector<rocksdb::Slice> keys;
+    std::vector<std::string> values;
+    keys_holder.reserve(request.keys.size());
+    keys.reserve(request.keys.size());
+    for (auto &key : request.keys) {
+        ::dsn::blob raw_key;
+        pegasus_generate_key(raw_key, key.hash_key, key.sort_key);
+        keys.emplace_back(raw_key.data(), raw_key.length());
+        keys_holder.emplace_back(std::move(raw_key));
+    }
+
+    std::vector<rocksdb::Status> statuses = _db->MultiGet(read_options(), keys, &values);
+    for (int i = 0; i < keys.size(); i++) {
+        rocksdb::Status &status = statuses[i];
+        std::string &value = values[i];
+        // print log
+        if (!status.ok()) {
             if (_verbose_log) {
-                derror("%s: rocksdb data expired for sortkey_count from %s",
+                derror("%s: rocksdb get failed for batch_get from %s: "
+                       "hash_key = \"%s\", sort_key = \"%s\", error = %s",
                        replica_name(),
-                       reply.to_address().to_string());
+                       reply.to_address().to_string(),
+                       ::pegasus::utils::c_escape_string(request.keys[i].hash_key).c_str(),
+                       ::pegasus::utils::c_escape_string(request.keys[i].sort_key).c_str(),
+                       status.ToString().c_str());
+            } else if (!status.IsNotFound()) {
+                derror("%s: rocksdb get failed for batch_get from %s: error = %s",
+                       replica_name(),
+                       reply.to_address().to_string(),
+                       status.ToString().c_str());
             }
-        } else {
-            resp.count++;
         }
-        it->Next();
+        // check ttl
+        if (status.ok()) {
+            uint32_t expire_ts = pegasus_extract_expire_ts(_value_schema_version, value);
+            if (expire_ts > 0 && expire_ts <= epoch_now) {
+                expire_count++;
+                if (_verbose_log) {
+                    derror("%s: rocksdb data expired for batch_get from %s",
+                           replica_name(),
+                           reply.to_address().to_string());
+                }
+                status = rocksdb::Status::NotFound();
+            }
+        }
+        // extract value
+        if (status.ok()) {
+            ::dsn::apps::full_data data;
+            data.hash_key = request.keys[i].hash_key;
+            data.sort_key = request.keys[i].sort_key;
+            status = extract_user_data(std::move(value), data.value);
+            if (status.ok()) {
+                size += data.value.length();
+                resp.data.emplace_back(std::move(data));
+            }
+        }
+        // if error occurred
+        if (!status.ok() && !status.IsNotFound()) {
+            error_occurred = true;
+            final_status = status;
+            break;
+        }
+    }
+
+    if (error_occurred) {
+        resp.error = final_status.code();
+        resp.data.clear();
+    } else {
+        resp.error = rocksdb::Status::kOk;
+    }
+
+    if (_abnormal_multi_get_time_threshold_ns || _abnormal_multi_get_size_threshold) {
+        uint64_t time_used = dsn_now_ns() - start_time;
+        if ((_abnormal_multi_get_time_threshold_ns &&
+             time_used >= _abnormal_multi_get_time_threshold_ns) ||
+            (_abnormal_multi_get_size_threshold &&
+             (uint64_t)size >= _abnormal_multi_get_size_threshold)) {
+            dwarn("%s: rocksdb abnormal batch_get from %s: "
+                  "key_count = %d, result_count = %d, result_size = %" PRId64 ", "
+                  "expire_count = %d, time_used = %" PRIu64 " ns",
+                  replica_name(),
+                  reply.to_address().to_string(),
+                  (int)request.keys.size(),
+                  (int)resp.data.size(),
+                  size,
+                  expire_count,
+                  time_used);
+            _pfc_recent_abnormal_count->increment();
+        }
     }
+
     if (expire_count > 0) {
         _pfc_recent_expire_count->add(expire_count);
     }
+    _pfc_batch_get_latency->set(dsn_now_ns() - start_time);
+
+    reply(resp);
+}
+
+void pegasus_server_impl::on_sortkey_count(const ::dsn::blob &hash_key,
+                                           ::dsn::rpc_replier<::dsn::apps::count_response> &reply)
+{
+    dassert(_is_open, "");
+
+    ::dsn::apps::count_response resp;
+    resp.app_id = _gpid.get_app_id();
+    resp.partition_index = _gpid.get_partition_index();
+    resp.server = _primary_address;
+
+    uint64_t expire_count = 0;
+    rocksdb::Status status = count_sort_keys(hash_key, resp.count, expire_count);
+    if (expire_count > 0) {
+        _pfc_recent_expire_count->add(expire_count);
+        if (_verbose_log) {
+            derror("%s: rocksdb data expired for sortkey_count from %s: expire_count = %" PRIu64,
+                   replica_name(),
+                   reply.to_address().to_string(),
+                   expire_count);
+        }
+    }
 
-    resp.error = it->status().code();
-    if (!it->status().ok()) {
+    resp.error = status.code();
+    if (!status.ok()) {
         // error occur
         if (_verbose_log) {
             derror("%s: rocksdb scan failed for sortkey_count from %s: "
@@ -997,12 +1599,12 @@ void pegasus_server_impl::on_sortkey_count(const ::dsn::blob &hash_key,
                    replica_name(),
                    reply.to_address().to_string(),
                    ::pegasus::utils::c_escape_string(hash_key).c_str(),
-                   it->status().ToString().c_str());
+                   status.ToString().c_str());
         } else {
             derror("%s: rocksdb scan failed for sortkey_count from %s: error = %s",
                    replica_name(),
                    reply.to_address().to_string(),
-                   it->status().ToString().c_str());
+                   status.ToString().c_str());
         }
         resp.count = 0;
     }
@@ -1010,6 +1612,111 @@ void pegasus_server_impl::on_sortkey_count(const ::dsn::blob &hash_key,
     reply(resp);
 }
 
+void pegasus_server_impl::on_approximate_sortkey_count(
+    const ::dsn::blob &hash_key, ::dsn::rpc_replier<::dsn::apps::count_response> &reply)
+{
+    dassert(_is_open, "");
+
+    ::dsn::apps::count_response resp;
+    resp.app_id = _gpid.get_app_id();
+    resp.partition_index = _gpid.get_partition_index();
+    resp.server = _primary_address;
+
+    ::dsn::blob start_key, stop_key;
+    pegasus_generate_key(start_key, hash_key, ::dsn::blob());
+    pegasus_generate_next_blob(stop_key, hash_key);
+    rocksdb::Range range(rocksdb::Slice(start_key.data(), start_key.length()),
+                         rocksdb::Slice(stop_key.data(), stop_key.length()));
+
+    // estimate the count by the size of the range divided by the average record size,
+    // the expired and deleted records not yet compacted are also counted.
+    uint64_t files_size = 0;
+    uint64_t memtables_size = 0;
+    _db->GetApproximateSizes(_db->DefaultColumnFamily(),
+                             &range,
+                             1,
+                             &files_size,
+                             rocksdb::DB::SizeApproximationFlags::INCLUDE_FILES);
+    _db->GetApproximateSizes(_db->DefaultColumnFamily(),
+                             &range,
+                             1,
+                             &memtables_size,
+                             rocksdb::DB::SizeApproximationFlags::INCLUDE_MEMTABLES);
+
+    bool estimated = false;
+    if (files_size + memtables_size >= _approximate_sortkey_count_exact_threshold) {
+        rocksdb::TablePropertiesCollection tables;
+        rocksdb::Status status =
+            _db->GetPropertiesOfTablesInRange(_db->DefaultColumnFamily(), &range, 1, &tables);
+        uint64_t entries = 0, data_size = 0, raw_size = 0;
+        if (status.ok()) {
+            for (const auto &kv : tables) {
+                entries += kv.second->num_entries;
+                data_size += kv.second->data_size;
+                raw_size += kv.second->raw_key_size + kv.second->raw_value_size;
+            }
+        }
+        if (entries > 0 && data_size > 0 && raw_size > 0) {
+            // the size of memtables is estimated in the raw size of records, while the size
+            // of files is in the size of data blocks, which may be compressed.
+            resp.count = static_cast<int64_t>((double)files_size * entries / data_size +
+                                              (double)memtables_size * entries / raw_size);
+            resp.error = rocksdb::Status::kOk;
+            estimated = true;
+        }
+    }
+
+    if (!estimated) {
+        // the range is small, or all in the memtables
+        uint64_t expire_count = 0;
+        rocksdb::Status status = count_sort_keys(hash_key, resp.count, expire_count);
+        if (expire_count > 0) {
+            _pfc_recent_expire_count->add(expire_count);
+        }
+        resp.error = status.code();
+        if (!status.ok()) {
+            derror("%s: rocksdb scan failed for approximate_sortkey_count from %s: error = %s",
+                   replica_name(),
+                   reply.to_address().to_string(),
+                   status.ToString().c_str());
+            resp.count = 0;
+        }
+    }
+
+    reply(resp);
+}
+
+rocksdb::Status pegasus_server_impl::count_sort_keys(const ::dsn::blob &hash_key,
+                                                     int64_t &count,
+                                                     uint64_t &expire_count)
+{
+    ::dsn::blob start_key, stop_key;
+    pegasus_generate_key(start_key, hash_key, ::dsn::blob());
+    pegasus_generate_next_blob(stop_key, hash_key);
+    rocksdb::Slice start(start_key.data(), start_key.length());
+    rocksdb::Slice stop(stop_key.data(), stop_key.length());
+    rocksdb::ReadOptions options = hashkey_read_options(read_options());
+    options.iterate_upper_bound = &stop;
+
+    // the values need not be read if no record has TTL, then only the keys are iterated
+    bool check_ttl = _may_have_ttl_records.load();
+
+    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(options));
+    it->Seek(start);
+    count = 0;
+    expire_count = 0;
+    uint32_t epoch_now = ::pegasus::utils::epoch_now();
+    while (it->Valid()) {
+        if (check_ttl && check_if_record_expired(epoch_now, it->value())) {
+            expire_count++;
+        } else {
+            count++;
+        }
+        it->Next();
+    }
+    return it->status();
+}
+
 void pegasus_server_impl::on_ttl(const ::dsn::blob &key,
                                  ::dsn::rpc_replier<::dsn::apps::ttl_response> &reply)
 {
@@ -1022,7 +1729,7 @@ void pegasus_server_impl::on_ttl(const ::dsn::blob &key,
 
     rocksdb::Slice skey(key.data(), key.length());
     std::string value;
-    rocksdb::Status status = _db->Get(_rd_opts, skey, &value);
+    rocksdb::Status status = _db->Get(read_options(), skey, &value);
 
     uint32_t expire_ts;
     uint32_t now_ts = ::pegasus::utils::epoch_now();
@@ -1108,9 +1815,19 @@ void pegasus_server_impl::on_get_scanner(const ::dsn::apps::get_scanner_request
     rocksdb::Slice start(request.start_key.data(), request.start_key.length());
     rocksdb::Slice stop(request.stop_key.data(), request.stop_key.length());
 
+    pegasus_filter_matcher hash_key_filter(
+        request.hash_key_filter_type,
+        dsn::string_view(request.hash_key_filter_pattern.data(),
+                         request.hash_key_filter_pattern.length()));
+    pegasus_filter_matcher sort_key_filter(
+        request.sort_key_filter_type,
+        dsn::string_view(request.sort_key_filter_pattern.data(),
+                         request.sort_key_filter_pattern.length()));
+
     // limit key range by prefix filter
     // because data is not ordered by hash key (hash key "aa" is greater than "b"),
-    // so we can only limit the start range by hash key filter.
+    // so we can only limit the start range by hash key filter, and the keys between the
+    // ranges of different hash key lengths are skipped by seek_by_prefix_filters().
     ::dsn::blob prefix_start_key;
     if (request.hash_key_filter_type == ::dsn::apps::filter_type::FT_MATCH_PREFIX &&
         request.hash_key_filter_pattern.length() > 0) {
@@ -1142,16 +1859,46 @@ void pegasus_server_impl::on_get_scanner(const ::dsn::apps::get_scanner_request
         return;
     }
 
-    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(_rd_opts));
+    // scan on one hash key can make use of the prefix bloom filter
+    const rocksdb::ReadOptions &rd_opts = request.full_scan ? _full_scan_rd_opts : read_options();
+    // the pin is kept in the scan context with the iterator
+    std::unique_ptr<pegasus_blob_store::reader_pin> blob_pin(
+        new pegasus_blob_store::reader_pin(_blob_store.get()));
+    std::unique_ptr<rocksdb::Iterator> it(_db->NewIterator(
+        is_hashkey_scoped_range(start, stop) ? hashkey_read_options(rd_opts) : rd_opts));
     it->Seek(start);
     bool complete = false;
+    // set if failed to read the value from the blob file
+    rocksdb::Status blob_status;
     bool first_exclusive = !start_inclusive;
     uint32_t epoch_now = ::pegasus::utils::epoch_now();
     uint64_t expire_count = 0;
     uint64_t filter_count = 0;
     int32_t count = 0;
-    resp.kvs.reserve(request.batch_size);
-    while (count < request.batch_size && it->Valid()) {
+    uint64_t iteration_count = 0;
+    uint64_t response_bytes = 0;
+    pegasus_scan_limits limits = pegasus_scan_limits::merge(_scan_limits,
+                                                            request.max_iteration_count,
+                                                            request.max_iteration_time_ms,
+                                                            request.max_response_bytes);
+    if (request.full_scan) {
+        limits = pegasus_scan_limits::merge(limits, 0, _full_scan_max_iteration_time_ms, 0);
+    }
+    // the rows are not returned for the aggregate scans, so the rpcs are only bounded by limits
+    int32_t batch_size =
+        request.aggregate ? std::numeric_limits<int32_t>::max() : request.batch_size;
+    pegasus_scan_aggregator aggregator(request.aggregate_top_count, true);
+    pegasus_scan_aggregator *aggregator_ptr = request.aggregate ? &aggregator : nullptr;
+    if (!request.aggregate) {
+        resp.kvs.reserve(request.batch_size);
+    }
+    while (count < batch_size && it->Valid()) {
+        if (limits.reached(iteration_count, response_bytes, start_time)) {
+            // return early and continue in the next scan rpc
+            break;
+        }
+        iteration_count++;
+
         int c = it->key().compare(stop);
         if (c > 0 || (c == 0 && !stop_inclusive)) {
             // out of range
@@ -1168,21 +1915,34 @@ void pegasus_server_impl::on_get_scanner(const ::dsn::apps::get_scanner_request
             }
         }
 
+        int seek_result = seek_by_prefix_filters(it.get(), hash_key_filter, sort_key_filter);
+        if (seek_result == 1) {
+            continue;
+        } else if (seek_result == 2) {
+            complete = true;
+            break;
+        }
+
         int r = append_key_value_for_scan(resp.kvs,
                                           it->key(),
                                           it->value(),
-                                          request.hash_key_filter_type,
-                                          request.hash_key_filter_pattern,
-                                          request.sort_key_filter_type,
-                                          request.sort_key_filter_pattern,
+                                          hash_key_filter,
+                                          sort_key_filter,
                                           epoch_now,
-                                          request.no_value);
+                                          request.no_value,
+                                          aggregator_ptr);
         if (r == 1) {
             count++;
+            if (aggregator_ptr == nullptr) {
+                response_bytes += resp.kvs.back().key.length() + resp.kvs.back().value.length();
+            }
         } else if (r == 2) {
             expire_count++;
-        } else { // r == 3
+        } else if (r == 3) {
             filter_count++;
+        } else { // r == 4
+            blob_status = rocksdb::Status::Corruption("read value failed");
+            break;
         }
 
         if (c == 0) {
@@ -1194,8 +1954,9 @@ void pegasus_server_impl::on_get_scanner(const ::dsn::apps::get_scanner_request
         it->Next();
     }
 
-    resp.error = it->status().code();
-    if (!it->status().ok()) {
+    rocksdb::Status status = blob_status.ok() ? it->status() : blob_status;
+    resp.error = status.code();
+    if (!status.ok()) {
         // error occur
         if (_verbose_log) {
             derror("%s: rocksdb scan failed for get_scanner from %s: "
@@ -1207,44 +1968,39 @@ void pegasus_server_impl::on_get_scanner(const ::dsn::apps::get_scanner_request
                    request.start_inclusive ? "inclusive" : "exclusive",
                    ::pegasus::utils::c_escape_string(stop).c_str(),
                    request.stop_inclusive ? "inclusive" : "exclusive",
-                   request.batch_size,
+                   batch_size,
                    count,
-                   it->status().ToString().c_str());
+                   status.ToString().c_str());
         } else {
             derror("%s: rocksdb scan failed for get_scanner from %s: error = %s",
                    replica_name(),
                    reply.to_address().to_string(),
-                   it->status().ToString().c_str());
+                   status.ToString().c_str());
         }
         resp.kvs.clear();
     } else if (it->Valid() && !complete) {
         // scan not completed
         std::unique_ptr<pegasus_scan_context> context(
-            new pegasus_scan_context(std::move(it),
+            new pegasus_scan_context(std::move(blob_pin),
+                                     std::move(it),
                                      std::string(stop.data(), stop.size()),
                                      request.stop_inclusive,
-                                     request.hash_key_filter_type,
-                                     std::string(request.hash_key_filter_pattern.data(),
-                                                 request.hash_key_filter_pattern.length()),
-                                     request.sort_key_filter_type,
-                                     std::string(request.sort_key_filter_pattern.data(),
-                                                 request.sort_key_filter_pattern.length()),
-                                     request.batch_size,
-                                     request.no_value));
-        int64_t handle = _context_cache.put(std::move(context));
-        resp.context_id = handle;
-        // if the context is used, it will be fetched and re-put into cache,
-        // which will change the handle,
-        // then the delayed task will fetch null context by old handle, and do nothing.
-        ::dsn::tasking::enqueue(LPC_PEGASUS_SERVER_DELAY,
-                                &_tracker,
-                                [this, handle]() { _context_cache.fetch(handle); },
-                                0,
-                                std::chrono::minutes(5));
+                                     std::move(hash_key_filter),
+                                     std::move(sort_key_filter),
+                                     batch_size,
+                                     request.no_value,
+                                     limits,
+                                     request.aggregate,
+                                     request.aggregate_top_count));
+        // the context is expired by updating_scan_context_cache() if not used for long
+        resp.context_id = _context_cache.put(std::move(context));
     } else {
         // scan completed
         resp.context_id = pegasus::SCAN_CONTEXT_ID_COMPLETED;
     }
+    if (aggregator_ptr != nullptr && resp.error == rocksdb::Status::kOk) {
+        aggregator.finish(resp.aggregate);
+    }
 
     if (expire_count > 0) {
         _pfc_recent_expire_count->add(expire_count);
@@ -1271,22 +2027,37 @@ void pegasus_server_impl::on_scan(const ::dsn::apps::scan_request &request,
 
     std::unique_ptr<pegasus_scan_context> context = _context_cache.fetch(request.context_id);
     if (context) {
+        if (request.batch_size > 0 && !context->aggregate) {
+            // the client adapts the batch size to the observed response size
+            context->batch_size = request.batch_size;
+        }
         rocksdb::Iterator *it = context->iterator.get();
         int32_t batch_size = context->batch_size;
+        pegasus_scan_aggregator aggregator(context->aggregate_top_count, true);
+        pegasus_scan_aggregator *aggregator_ptr = context->aggregate ? &aggregator : nullptr;
         const rocksdb::Slice &stop = context->stop;
         bool stop_inclusive = context->stop_inclusive;
-        ::dsn::apps::filter_type::type hash_key_filter_type = context->hash_key_filter_type;
-        const ::dsn::blob &hash_key_filter_pattern = context->hash_key_filter_pattern;
-        ::dsn::apps::filter_type::type sort_key_filter_type = context->hash_key_filter_type;
-        const ::dsn::blob &sort_key_filter_pattern = context->hash_key_filter_pattern;
+        const pegasus_filter_matcher &hash_key_filter = context->hash_key_filter;
+        const pegasus_filter_matcher &sort_key_filter = context->sort_key_filter;
         bool no_value = context->no_value;
         bool complete = false;
+        // set if failed to read the value from the blob file
+        rocksdb::Status blob_status;
         uint32_t epoch_now = ::pegasus::utils::epoch_now();
         uint64_t expire_count = 0;
         uint64_t filter_count = 0;
         int32_t count = 0;
+        uint64_t iteration_count = 0;
+        uint64_t response_bytes = 0;
+        const pegasus_scan_limits &limits = context->limits;
 
         while (count < batch_size && it->Valid()) {
+            if (limits.reached(iteration_count, response_bytes, start_time)) {
+                // return early and continue in the next scan rpc
+                break;
+            }
+            iteration_count++;
+
             int c = it->key().compare(stop);
             if (c > 0 || (c == 0 && !stop_inclusive)) {
                 // out of range
@@ -1294,21 +2065,35 @@ void pegasus_server_impl::on_scan(const ::dsn::apps::scan_request &request,
                 break;
             }
 
+            int seek_result = seek_by_prefix_filters(it, hash_key_filter, sort_key_filter);
+            if (seek_result == 1) {
+                continue;
+            } else if (seek_result == 2) {
+                complete = true;
+                break;
+            }
+
             int r = append_key_value_for_scan(resp.kvs,
                                               it->key(),
                                               it->value(),
-                                              hash_key_filter_type,
-                                              hash_key_filter_pattern,
-                                              sort_key_filter_type,
-                                              sort_key_filter_pattern,
+                                              hash_key_filter,
+                                              sort_key_filter,
                                               epoch_now,
-                                              no_value);
+                                              no_value,
+                                              aggregator_ptr);
             if (r == 1) {
                 count++;
+                if (aggregator_ptr == nullptr) {
+                    response_bytes +=
+                        resp.kvs.back().key.length() + resp.kvs.back().value.length();
+                }
             } else if (r == 2) {
                 expire_count++;
-            } else { // r == 3
+            } else if (r == 3) {
                 filter_count++;
+            } else { // r == 4
+                blob_status = rocksdb::Status::Corruption("read value failed");
+                break;
             }
 
             if (c == 0) {
@@ -1320,8 +2105,9 @@ void pegasus_server_impl::on_scan(const ::dsn::apps::scan_request &request,
             it->Next();
         }
 
-        resp.error = it->status().code();
-        if (!it->status().ok()) {
+        rocksdb::Status status = blob_status.ok() ? it->status() : blob_status;
+        resp.error = status.code();
+        if (!status.ok()) {
             // error occur
             if (_verbose_log) {
                 derror("%s: rocksdb scan failed for scan from %s: "
@@ -1334,27 +2120,24 @@ void pegasus_server_impl::on_scan(const ::dsn::apps::scan_request &request,
                        stop_inclusive ? "inclusive" : "exclusive",
                        batch_size,
                        count,
-                       it->status().ToString().c_str());
+                       status.ToString().c_str());
             } else {
                 derror("%s: rocksdb scan failed for scan from %s: error = %s",
                        replica_name(),
                        reply.to_address().to_string(),
-                       it->status().ToString().c_str());
+                       status.ToString().c_str());
             }
             resp.kvs.clear();
         } else if (it->Valid() && !complete) {
             // scan not completed
-            int64_t handle = _context_cache.put(std::move(context));
-            resp.context_id = handle;
-            ::dsn::tasking::enqueue(LPC_PEGASUS_SERVER_DELAY,
-                                    &_tracker,
-                                    [this, handle]() { _context_cache.fetch(handle); },
-                                    0,
-                                    std::chrono::minutes(5));
+            resp.context_id = _context_cache.put(std::move(context));
         } else {
             // scan completed
             resp.context_id = pegasus::SCAN_CONTEXT_ID_COMPLETED;
         }
+        if (aggregator_ptr != nullptr && resp.error == rocksdb::Status::kOk) {
+            aggregator.finish(resp.aggregate);
+        }
 
         if (expire_count > 0) {
             _pfc_recent_expire_count->add(expire_count);
@@ -1380,7 +2163,6 @@ void pegasus_server_impl::on_clear_scanner(const int64_t &args) { _context_cache
     rocksdb::Options opts = _db_opts;
     opts.create_if_missing = true;
     opts.error_if_exists = false;
-    opts.compaction_filter = &_key_ttl_compaction_filter;
     opts.default_value_schema_version = PEGASUS_VALUE_SCHEMA_MAX_VERSION;
 
     // parse envs for parameters
@@ -1469,8 +2251,33 @@ void pegasus_server_impl::on_clear_scanner(const int64_t &args) { _context_cache
 
     ddebug("%s: start to open rocksDB's rdb(%s)", replica_name(), path.c_str());
 
+    // the blob files are in the rdb directory, which are loaded after the db is opened
+    _blob_store = std::make_shared<pegasus_blob_store>(replica_name(), path, _blob_opts);
+    _key_ttl_compaction_filter_factory->SetBlobStore(_blob_store);
+    opts.listeners.emplace_back(std::make_shared<pegasus_blob_flush_listener>(_blob_store));
+
+    pegasus_storage_profile profile = get_storage_profile(envs);
+    profile.apply(opts, _tbl_opts);
     auto status = rocksdb::DB::Open(opts, path, &_db);
+    if ((status.IsInvalidArgument() || status.IsNotSupported()) &&
+        profile != _default_storage_profile) {
+        // e.g. the compression type is not linked with the binary, the app should still be
+        // opened to serve with the server config
+        derror("%s: open rocksdb with storage profile {%s} failed, retry with the default one, "
+               "error = %s",
+               replica_name(),
+               profile.to_string().c_str(),
+               status.ToString().c_str());
+        profile = _default_storage_profile;
+        profile.apply(opts, _tbl_opts);
+        status = rocksdb::DB::Open(opts, path, &_db);
+    }
     if (status.ok()) {
+        _storage_profile = profile;
+        // the profile requested but not applied is handled by update_app_envs() below
+        _requested_storage_profile = profile;
+        _fill_cache.store(profile.priority != pegasus_storage_profile::cache_priority::low);
+
         _last_committed_decree = _db->GetLastFlushedDecree();
         _value_schema_version = _db->GetValueSchemaVersion();
         if (_value_schema_version > PEGASUS_VALUE_SCHEMA_MAX_VERSION) {
@@ -1482,9 +2289,31 @@ void pegasus_server_impl::on_clear_scanner(const int64_t &args) { _context_cache
             return ::dsn::ERR_LOCAL_APP_FAILURE;
         }
 
+        status = _blob_store->open();
+        if (!status.ok()) {
+            derror("%s: open blob store failed, error = %s",
+                   replica_name(),
+                   status.ToString().c_str());
+            delete _db;
+            _db = nullptr;
+            _blob_store = nullptr;
+            return ::dsn::ERR_LOCAL_APP_FAILURE;
+        }
+
         // only enable filter after correct value_schema_version set
-        _key_ttl_compaction_filter.SetValueSchemaVersion(_value_schema_version);
-        _key_ttl_compaction_filter.EnableFilter();
+        _key_ttl_compaction_filter_factory->SetValueSchemaVersion(_value_schema_version);
+        _key_ttl_compaction_filter_factory->EnableFilter();
+        _table_properties_collector_factory->set_value_schema_version(_value_schema_version);
+
+        // the memtables are empty now, so all the records are in the sst files
+        rocksdb::TablePropertiesCollection tables;
+        rocksdb::Status props_status = _db->GetPropertiesOfAllTables(&tables);
+        _may_have_ttl_records.store(
+            !props_status.ok() ||
+            pegasus_table_properties_collector::may_have_ttl_records(tables));
+        ddebug("%s: may_have_ttl_records = %s",
+               replica_name(),
+               _may_have_ttl_records.load() ? "true" : "false");
 
         // update LastManualCompactFinishTime
         _manual_compact_svc.init_last_finish_time_ms(_db->GetLastManualCompactFinishTime());
@@ -1535,6 +2364,43 @@ void pegasus_server_impl::on_clear_scanner(const int64_t &args) { _context_cache
             0,
             std::chrono::seconds(30));
 
+        dinfo("%s: start the updating memtable usage timer task", replica_name());
+        _updating_rocksdb_memtable_usage_timer_task = ::dsn::tasking::enqueue_timer(
+            LPC_UPDATING_ROCKSDB_MEMTABLE_USAGE,
+            &_tracker,
+            [this]() { this->updating_rocksdb_memtable_usage(); },
+            std::chrono::seconds(_updating_rocksdb_memtable_usage_interval_seconds));
+
+        dinfo("%s: start the updating scan context cache timer task", replica_name());
+        _updating_scan_context_cache_timer_task = ::dsn::tasking::enqueue_timer(
+            LPC_UPDATING_SCAN_CONTEXT_CACHE,
+            &_tracker,
+            [this]() { this->updating_scan_context_cache(); },
+            std::chrono::seconds(_updating_scan_context_cache_interval_seconds));
+
+        dinfo("%s: start the blob gc timer task", replica_name());
+        _blob_gc_timer_task = ::dsn::tasking::enqueue_timer(
+            LPC_BLOB_GC,
+            &_tracker,
+            [this]() { this->blob_gc(); },
+            std::chrono::seconds(_blob_gc_interval_seconds),
+            0,
+            std::chrono::seconds(30));
+
+        if (_ttl_compaction_expired_ratio_threshold > 0) {
+            // the first check is delayed randomly, so that the replicas opened together do not
+            // compact at the same time
+            dinfo("%s: start the ttl compaction timer task", replica_name());
+            _ttl_compaction_stopping.store(false);
+            _ttl_compaction_timer_task = ::dsn::tasking::enqueue_timer(
+                LPC_TTL_COMPACTION,
+                &_tracker,
+                [this]() { this->ttl_compaction(); },
+                std::chrono::seconds(_ttl_compaction_interval_seconds),
+                0,
+                std::chrono::seconds(dsn_random32(60, _ttl_compaction_interval_seconds + 60)));
+        }
+
         // initialize write service after server being initialized.
         _server_write = dsn::make_unique<pegasus_server_write>(this, _verbose_log);
 
@@ -1573,13 +2439,41 @@ void pegasus_server_impl::cancel_background_work(bool wait)
         _updating_rocksdb_sstsize_timer_task->cancel(true);
         _updating_rocksdb_sstsize_timer_task = nullptr;
     }
+    if (_updating_rocksdb_memtable_usage_timer_task != nullptr) {
+        _updating_rocksdb_memtable_usage_timer_task->cancel(true);
+        _updating_rocksdb_memtable_usage_timer_task = nullptr;
+    }
+    if (_memtable_flush_picker != nullptr) {
+        _memtable_flush_picker->remove(replica_name());
+    }
+    if (_updating_scan_context_cache_timer_task != nullptr) {
+        _updating_scan_context_cache_timer_task->cancel(true);
+        _updating_scan_context_cache_timer_task = nullptr;
+    }
+    if (_blob_gc_timer_task != nullptr) {
+        _blob_gc_timer_task->cancel(true);
+        _blob_gc_timer_task = nullptr;
+    }
+    if (_ttl_compaction_timer_task != nullptr) {
+        // the running ttl compaction stops after the current key range, which is aborted by
+        // cancelling the background work, as the db is closed soon
+        _ttl_compaction_stopping.store(true);
+        cancel_background_work(false);
+        _ttl_compaction_timer_task->cancel(true);
+        _ttl_compaction_timer_task = nullptr;
+    }
     _tracker.cancel_outstanding_tasks();
 
     _context_cache.clear();
+    if (_row_cache.enabled()) {
+        _row_cache.clear();
+    }
 
     _is_open = false;
     delete _db;
     _db = nullptr;
+    // released after the db, as the compactions may be relocating the blobs
+    _blob_store = nullptr;
 
     {
         ::dsn::utils::auto_lock<::dsn::utils::ex_lock_nr> l(_checkpoints_lock);
@@ -1595,6 +2489,11 @@ void pegasus_server_impl::cancel_background_work(bool wait)
         }
         _pfc_sst_count->set(0);
         _pfc_sst_size->set(0);
+        _pfc_blob_count->set(0);
+        _pfc_blob_size->set(0);
+        _pfc_memtable_usage->set(0);
+        _pfc_pinned_memtable_usage->set(0);
+        _pfc_scan_context_count->set(0);
     }
 
     ddebug(
@@ -1677,6 +2576,9 @@ private:
     delete chkpt;
     chkpt = nullptr;
 
+    if (status.ok()) {
+        status = checkpoint_blob_files(chkpt_dir);
+    }
     if (!status.ok()) {
         derror(
             "%s: create checkpoint failed, error = %s", replica_name(), status.ToString().c_str());
@@ -1718,6 +2620,13 @@ private:
     return ::dsn::ERR_OK;
 }
 
+rocksdb::Status pegasus_server_impl::checkpoint_blob_files(const std::string &checkpoint_dir)
+{
+    // the sst files of the checkpoint are all flushed, so they do not refer to the blob records
+    // written after the last flushed decree
+    return _blob_store->checkpoint(checkpoint_dir, _db->GetLastFlushedDecree());
+}
+
 // Must be thread safe.
 ::dsn::error_code pegasus_server_impl::async_checkpoint(bool flush_memtable)
 {
@@ -1883,6 +2792,10 @@ private:
     status = chkpt->CreateCheckpointQuick(checkpoint_dir, &ci);
     delete chkpt, chkpt = nullptr;
 
+    if (status.ok()) {
+        status = checkpoint_blob_files(checkpoint_dir);
+    }
+
     if (!status.ok()) {
         derror("%s: async create checkpoint failed, error = %s",
                replica_name(),
@@ -1916,6 +2829,7 @@ private:
         return ::dsn::ERR_OBJECT_NOT_FOUND;
     }
 
+    // the blob files are hard linked into the checkpoint, so they are learned with the sst files
     auto chkpt_dir = ::dsn::utils::filesystem::path_combine(data_dir(), chkpt_get_dir_name(ci));
     state.files.clear();
     if (!::dsn::utils::filesystem::get_subfiles(chkpt_dir, state.files, true)) {
@@ -2032,54 +2946,15 @@ bool pegasus_server_impl::is_filter_type_supported(::dsn::apps::filter_type::typ
            filter_type <= ::dsn::apps::filter_type::FT_MATCH_POSTFIX;
 }
 
-bool pegasus_server_impl::validate_filter(::dsn::apps::filter_type::type filter_type,
-                                          const ::dsn::blob &filter_pattern,
-                                          const ::dsn::blob &value)
-{
-    if (filter_type == ::dsn::apps::filter_type::FT_NO_FILTER || filter_pattern.length() == 0)
-        return true;
-    if (value.length() < filter_pattern.length())
-        return false;
-    switch (filter_type) {
-    case ::dsn::apps::filter_type::FT_MATCH_ANYWHERE: {
-        // brute force search
-        // TODO: improve it according to
-        //   http://old.blog.phusion.nl/2010/12/06/efficient-substring-searching/
-        const char *a1 = value.data();
-        int l1 = value.length();
-        const char *a2 = filter_pattern.data();
-        int l2 = filter_pattern.length();
-        for (int i = 0; i <= l1 - l2; ++i) {
-            int j = 0;
-            while (j < l2 && a1[i + j] == a2[j])
-                ++j;
-            if (j == l2)
-                return true;
-        }
-        return false;
-    }
-    case ::dsn::apps::filter_type::FT_MATCH_PREFIX:
-        return (memcmp(value.data(), filter_pattern.data(), filter_pattern.length()) == 0);
-    case ::dsn::apps::filter_type::FT_MATCH_POSTFIX:
-        return (memcmp(value.data() + value.length() - filter_pattern.length(),
-                       filter_pattern.data(),
-                       filter_pattern.length()) == 0);
-    default:
-        dassert(false, "unsupported filter type: %d", filter_type);
-    }
-    return false;
-}
-
 int pegasus_server_impl::append_key_value_for_scan(
     std::vector<::dsn::apps::key_value> &kvs,
     const rocksdb::Slice &key,
     const rocksdb::Slice &value,
-    ::dsn::apps::filter_type::type hash_key_filter_type,
-    const ::dsn::blob &hash_key_filter_pattern,
-    ::dsn::apps::filter_type::type sort_key_filter_type,
-    const ::dsn::blob &sort_key_filter_pattern,
+    const pegasus_filter_matcher &hash_key_filter,
+    const pegasus_filter_matcher &sort_key_filter,
     uint32_t epoch_now,
-    bool no_value)
+    bool no_value,
+    pegasus_scan_aggregator *aggregator)
 {
     if (check_if_record_expired(epoch_now, value)) {
         if (_verbose_log) {
@@ -2088,49 +2963,80 @@ int pegasus_server_impl::append_key_value_for_scan(
         return 2;
     }
 
-    ::dsn::apps::key_value kv;
-
     // extract raw key
     ::dsn::blob raw_key(key.data(), 0, key.size());
-    if (hash_key_filter_type != ::dsn::apps::filter_type::FT_NO_FILTER ||
-        sort_key_filter_type != ::dsn::apps::filter_type::FT_NO_FILTER) {
+    if (!hash_key_filter.no_filter() || !sort_key_filter.no_filter()) {
         ::dsn::blob hash_key, sort_key;
         pegasus_restore_key(raw_key, hash_key, sort_key);
-        if (hash_key_filter_type != ::dsn::apps::filter_type::FT_NO_FILTER &&
-            !validate_filter(hash_key_filter_type, hash_key_filter_pattern, hash_key)) {
+        if (!hash_key_filter.match(dsn::string_view(hash_key.data(), hash_key.length()))) {
             if (_verbose_log) {
                 derror("%s: hash key filtered for scan", replica_name());
             }
             return 3;
         }
-        if (sort_key_filter_type != ::dsn::apps::filter_type::FT_NO_FILTER &&
-            !validate_filter(sort_key_filter_type, sort_key_filter_pattern, sort_key)) {
+        if (!sort_key_filter.match(dsn::string_view(sort_key.data(), sort_key.length()))) {
             if (_verbose_log) {
                 derror("%s: sort key filtered for scan", replica_name());
             }
             return 3;
         }
     }
-    std::shared_ptr<char> key_buf(::dsn::utils::make_shared_array<char>(raw_key.length()));
-    ::memcpy(key_buf.get(), raw_key.data(), raw_key.length());
-    kv.key.assign(std::move(key_buf), 0, raw_key.length());
+    if (aggregator != nullptr) {
+        // the length is kept in the snappy header or the blob index, no need to decompress
+        // the value or read the blob file
+        size_t length = 0;
+        rocksdb::Status status = pegasus_extract_user_data_length(
+            _value_schema_version, utils::to_string_view(value), length);
+        if (!status.ok()) {
+            derror("%s: extract value length failed, error = %s",
+                   replica_name(),
+                   status.ToString().c_str());
+            return 4;
+        }
+        aggregator->add_row(utils::to_string_view(key), length);
+        return 1;
+    }
 
-    // extract value
-    if (!no_value) {
-        std::string value_buf(value.data(), value.size());
-        pegasus_extract_user_data(_value_schema_version, std::move(value_buf), kv.value);
+    ::dsn::apps::key_value kv;
+    if (!copy_key_value(raw_key, value, no_value, kv).ok()) {
+        return 4;
     }
 
     kvs.emplace_back(std::move(kv));
     return 1;
 }
 
+int pegasus_server_impl::seek_by_prefix_filters(rocksdb::Iterator *it,
+                                                const pegasus_filter_matcher &hash_key_filter,
+                                                const pegasus_filter_matcher &sort_key_filter)
+{
+    bool hash_key_prefix = hash_key_filter.type() == ::dsn::apps::filter_type::FT_MATCH_PREFIX;
+    bool sort_key_prefix = sort_key_filter.type() == ::dsn::apps::filter_type::FT_MATCH_PREFIX;
+    if (!hash_key_prefix && !sort_key_prefix) {
+        return 0;
+    }
+
+    rocksdb::Slice key = it->key();
+    std::string seek_key;
+    if (hash_key_prefix && pegasus_hash_key_prefix_seek_key(
+                               key.data(), key.size(), hash_key_filter.pattern(), seek_key)) {
+        if (seek_key.empty()) {
+            return 2;
+        }
+    } else if (!sort_key_prefix ||
+               !pegasus_sort_key_prefix_seek_key(
+                   key.data(), key.size(), sort_key_filter.pattern(), seek_key)) {
+        return 0;
+    }
+    it->Seek(seek_key);
+    return 1;
+}
+
 int pegasus_server_impl::append_key_value_for_multi_get(
     std::vector<::dsn::apps::key_value> &kvs,
     const rocksdb::Slice &key,
     const rocksdb::Slice &value,
-    ::dsn::apps::filter_type::type sort_key_filter_type,
-    const ::dsn::blob &sort_key_filter_pattern,
+    const pegasus_filter_matcher &sort_key_filter,
     uint32_t epoch_now,
     bool no_value)
 {
@@ -2147,27 +3053,66 @@ int pegasus_server_impl::append_key_value_for_multi_get(
     ::dsn::blob raw_key(key.data(), 0, key.size());
     ::dsn::blob hash_key, sort_key;
     pegasus_restore_key(raw_key, hash_key, sort_key);
-    if (sort_key_filter_type != ::dsn::apps::filter_type::FT_NO_FILTER &&
-        !validate_filter(sort_key_filter_type, sort_key_filter_pattern, sort_key)) {
+    if (!sort_key_filter.match(dsn::string_view(sort_key.data(), sort_key.length()))) {
         if (_verbose_log) {
             derror("%s: sort key filtered for multi get", replica_name());
         }
         return 3;
     }
-    std::shared_ptr<char> sort_key_buf(::dsn::utils::make_shared_array<char>(sort_key.length()));
-    ::memcpy(sort_key_buf.get(), sort_key.data(), sort_key.length());
-    kv.key.assign(std::move(sort_key_buf), 0, sort_key.length());
-
-    // extract value
-    if (!no_value) {
-        std::string value_buf(value.data(), value.size());
-        pegasus_extract_user_data(_value_schema_version, std::move(value_buf), kv.value);
+    if (!copy_key_value(sort_key, value, no_value, kv).ok()) {
+        return 4;
     }
 
     kvs.emplace_back(std::move(kv));
     return 1;
 }
 
+rocksdb::Status pegasus_server_impl::copy_key_value(const ::dsn::blob &key,
+                                                    const rocksdb::Slice &raw_value,
+                                                    bool no_value,
+                                                    ::dsn::apps::key_value &kv)
+{
+    // the memory of iterator is not pinned, so the data should be copied out before
+    // moving the iterator. the key and the user data are copied into one buffer, so
+    // that only one allocation and no intermediate copy is needed for each record.
+    ::dsn::blob user_data;
+    if (!no_value) {
+        rocksdb::Status status = extract_user_data(utils::to_string_view(raw_value), user_data);
+        if (!status.ok()) {
+            derror("%s: extract value failed, error = %s",
+                   replica_name(),
+                   status.ToString().c_str());
+            return status;
+        }
+    }
+
+    std::shared_ptr<char> buf(
+        ::dsn::utils::make_shared_array<char>(key.length() + user_data.length()));
+    if (key.length() > 0) {
+        ::memcpy(buf.get(), key.data(), key.length());
+    }
+    if (user_data.length() > 0) {
+        ::memcpy(buf.get() + key.length(), user_data.data(), user_data.length());
+    }
+    kv.key.assign(buf, 0, key.length());
+    if (!no_value) {
+        kv.value.assign(std::move(buf), key.length(), user_data.length());
+    }
+    return rocksdb::Status::OK();
+}
+
+rocksdb::Status pegasus_server_impl::extract_user_data(dsn::string_view raw_value,
+                                                       ::dsn::blob &user_data)
+{
+    return _blob_store->extract_user_data(_value_schema_version, raw_value, user_data);
+}
+
+rocksdb::Status pegasus_server_impl::extract_user_data(std::string &&raw_value,
+                                                       ::dsn::blob &user_data)
+{
+    return _blob_store->extract_user_data(_value_schema_version, std::move(raw_value), user_data);
+}
+
 // statistic the count and size of files of this type. return (-1,-1) if failed.
 static std::pair<int64_t, int64_t> get_type_file_size(const std::string &path,
                                                       const std::string &type)
@@ -2218,6 +3163,223 @@ void pegasus_server_impl::updating_rocksdb_sstsize()
     }
 }
 
+void pegasus_server_impl::blob_gc()
+{
+    // the last flushed decree is got before the tables, so that the blob files written after
+    // it are not deleted even if they are not referred by the tables got
+    int64_t last_flushed = _db->GetLastFlushedDecree();
+    rocksdb::TablePropertiesCollection tables;
+    rocksdb::Status status = _db->GetPropertiesOfAllTables(&tables);
+    if (!status.ok()) {
+        dwarn("%s: get properties of all tables failed, error = %s",
+              replica_name(),
+              status.ToString().c_str());
+        return;
+    }
+    _blob_store->gc(tables, last_flushed, utils::epoch_now());
+
+    _pfc_blob_count->set(_blob_store->file_count());
+    _pfc_blob_size->set(_blob_store->total_size() / 1048576);
+}
+
+void pegasus_server_impl::ttl_compaction()
+{
+    if (!_may_have_ttl_records.load() || _ttl_compaction_stopping.load()) {
+        return;
+    }
+
+    rocksdb::TablePropertiesCollection tables;
+    rocksdb::Status status = _db->GetPropertiesOfAllTables(&tables);
+    if (!status.ok()) {
+        dwarn("%s: get properties of all tables failed, error = %s",
+              replica_name(),
+              status.ToString().c_str());
+        return;
+    }
+    std::vector<rocksdb::LiveFileMetaData> files;
+    _db->GetLiveFilesMetaData(&files);
+
+    // pick the files with the most expired records
+    uint32_t epoch_now = utils::epoch_now();
+    std::vector<std::pair<double, const rocksdb::LiveFileMetaData *>> picked_files;
+    for (const rocksdb::LiveFileMetaData &file : files) {
+        auto iter = tables.find(file.db_path + file.name);
+        if (iter == tables.end()) {
+            continue;
+        }
+        double ratio =
+            pegasus_table_properties_collector::estimate_expired_ratio(*iter->second, epoch_now);
+        if (ratio >= _ttl_compaction_expired_ratio_threshold) {
+            picked_files.emplace_back(ratio, &file);
+        }
+    }
+    if (picked_files.empty()) {
+        return;
+    }
+    std::sort(picked_files.begin(),
+              picked_files.end(),
+              [](const std::pair<double, const rocksdb::LiveFileMetaData *> &a,
+                 const std::pair<double, const rocksdb::LiveFileMetaData *> &b) {
+                  return a.first > b.first;
+              });
+
+    if (_running_ttl_compaction_count->fetch_add(1) >= _ttl_compaction_max_concurrent_count &&
+        _ttl_compaction_max_concurrent_count > 0) {
+        _running_ttl_compaction_count->fetch_sub(1);
+        ddebug("%s: delay ttl compaction of %d files, as other replicas are compacting",
+               replica_name(),
+               (int)picked_files.size());
+        return;
+    }
+
+    // the files picked may overlap, the range compacted already is skipped
+    std::vector<std::pair<std::string, std::string>> compacted_ranges;
+    uint32_t compacted_count = 0;
+    for (const auto &picked : picked_files) {
+        if (compacted_count >= _ttl_compaction_max_file_count || _ttl_compaction_stopping.load()) {
+            break;
+        }
+        const rocksdb::LiveFileMetaData &file = *picked.second;
+        if (std::any_of(compacted_ranges.begin(),
+                        compacted_ranges.end(),
+                        [&file](const std::pair<std::string, std::string> &range) {
+                            return file.smallestkey <= range.second &&
+                                   range.first <= file.largestkey;
+                        })) {
+            continue;
+        }
+
+        // the bottommost level is compacted as well, where the expired records stay longest.
+        // the automatic compactions are not blocked by this one.
+        rocksdb::CompactRangeOptions options;
+        options.exclusive_manual_compaction = false;
+        options.bottommost_level_compaction = rocksdb::BottommostLevelCompaction::kForce;
+        rocksdb::Slice begin(file.smallestkey);
+        rocksdb::Slice end(file.largestkey);
+        uint64_t start_time = dsn_now_ms();
+        status = _db->CompactRange(options, &begin, &end);
+        ddebug("%s: ttl compaction of file %s finished, level = %d, size = %" PRIu64
+               ", estimated_expired_ratio = %.2f, status = %s, time_used = %" PRIu64 "ms",
+               replica_name(),
+               file.name.c_str(),
+               file.level,
+               (uint64_t)file.size,
+               picked.first,
+               status.ToString().c_str(),
+               dsn_now_ms() - start_time);
+        if (!status.ok()) {
+            // e.g. the db is closing
+            break;
+        }
+        compacted_ranges.emplace_back(file.smallestkey, file.largestkey);
+        compacted_count++;
+        _pfc_recent_ttl_compaction_count->increment();
+    }
+    _running_ttl_compaction_count->fetch_sub(1);
+}
+
+void pegasus_server_impl::updating_rocksdb_memtable_usage()
+{
+    if (_row_cache.enabled()) {
+        _pfc_node_row_cache_usage->set(_row_cache.usage());
+        _pfc_node_row_cache_evict_count->set(pegasus_row_cache::evict_count());
+    }
+
+    uint64_t memtable_usage = 0;
+    if (!_db->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &memtable_usage)) {
+        dwarn("%s: get memtable memory usage failed", replica_name());
+        return;
+    }
+    _pfc_memtable_usage->set(memtable_usage);
+
+    std::shared_ptr<rocksdb::WriteBufferManager> wbm = _db_opts.write_buffer_manager;
+    if (wbm == nullptr || !wbm->enabled()) {
+        return;
+    }
+    size_t node_memtable_usage = wbm->memory_usage();
+    _pfc_node_memtable_usage->set(node_memtable_usage);
+
+    uint64_t active_memtable_size = 0;
+    if (!_db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable,
+                             &active_memtable_size)) {
+        return;
+    }
+    _memtable_flush_picker->update(replica_name(), active_memtable_size);
+
+    // rocksdb only flushes the instance which is writing when the write buffer manager is
+    // full, the large memtables of idle replicas may stay in memory for a long time. so the
+    // largest active memtables across the node, which are larger than half of write buffer
+    // size, are flushed to free a quarter of the budget.
+    if (node_memtable_usage >= wbm->buffer_size() &&
+        _memtable_flush_picker->should_flush(replica_name(),
+                                             node_memtable_usage - wbm->buffer_size() * 3 / 4,
+                                             _db_opts.write_buffer_size / 2)) {
+        ddebug("%s: flush memtable as write buffer is full, node_memtable_usage = %" PRIu64
+               ", active_memtable_size = %" PRIu64,
+               replica_name(),
+               (uint64_t)node_memtable_usage,
+               active_memtable_size);
+        rocksdb::FlushOptions options;
+        options.wait = false;
+        rocksdb::Status status = _db->Flush(options);
+        if (!status.ok()) {
+            derror("%s: flush memtable failed: %s", replica_name(), status.ToString().c_str());
+        }
+    }
+}
+
+void pegasus_server_impl::updating_scan_context_cache()
+{
+    if (!_is_open) {
+        return;
+    }
+
+    _context_cache.evict_idle(dsn_now_ns(), _scan_context_max_idle_ns);
+
+    uint64_t pinned_usage = pinned_memtable_usage();
+    if (_scan_context_max_pinned_bytes > 0 && pinned_usage > _scan_context_max_pinned_bytes) {
+        // a memtable may be pinned by several contexts, or by the others than the contexts
+        // (e.g. the iterators of the running reads), so the evictions freeing nothing in a row
+        // are limited in each round, rather than evicting all the contexts in vain
+        static const size_t max_fruitless_count = 16;
+        size_t count = 0, fruitless_count = 0;
+        while (pinned_usage > _scan_context_max_pinned_bytes &&
+               fruitless_count < max_fruitless_count && _context_cache.evict_lru()) {
+            uint64_t usage = pinned_memtable_usage();
+            fruitless_count = usage < pinned_usage ? 0 : fruitless_count + 1;
+            pinned_usage = usage;
+            count++;
+        }
+        if (count > 0) {
+            dwarn("%s: %d scan contexts evicted as too much memory pinned, "
+                  "pinned_memtable_usage = %" PRIu64,
+                  replica_name(),
+                  (int)count,
+                  pinned_usage);
+        }
+    }
+
+    _pfc_pinned_memtable_usage->set(pinned_usage);
+    _pfc_scan_context_count->set(_context_cache.size());
+    uint64_t evict_count = _context_cache.fetch_evict_count();
+    if (evict_count > 0) {
+        _pfc_recent_scan_context_evict_count->add(evict_count);
+    }
+}
+
+uint64_t pegasus_server_impl::pinned_memtable_usage()
+{
+    // "size-all-mem-tables" includes the pinned memtables, while "cur-size-all-mem-tables"
+    // only includes the active and unflushed ones
+    uint64_t all_usage = 0, cur_usage = 0;
+    if (!_db->GetIntProperty(rocksdb::DB::Properties::kSizeAllMemTables, &all_usage) ||
+        !_db->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables, &cur_usage) ||
+        all_usage < cur_usage) {
+        return 0;
+    }
+    return all_usage - cur_usage;
+}
+
 std::pair<std::string, bool>
 pegasus_server_impl::get_restore_dir_from_env(const std::map<std::string, std::string> &env_kvs)
 {
@@ -2261,12 +3423,67 @@ pegasus_server_impl::get_restore_dir_from_env(const std::map<std::string, std::s
 void pegasus_server_impl::update_app_envs(const std::map<std::string, std::string> &envs)
 {
     update_usage_scenario(envs);
+    update_storage_profile(envs);
     _manual_compact_svc.start_manual_compact_if_needed(envs);
 }
 
 void pegasus_server_impl::query_app_envs(/*out*/ std::map<std::string, std::string> &envs)
 {
     envs[ROCKSDB_ENV_USAGE_SCENARIO_KEY] = _usage_scenario;
+    _storage_profile.to_envs(envs);
+    if (_requested_storage_profile != _storage_profile) {
+        envs[ROCKSDB_ENV_PENDING_STORAGE_PROFILE_KEY] = _requested_storage_profile.to_string();
+    }
+}
+
+pegasus_storage_profile
+pegasus_server_impl::get_storage_profile(const std::map<std::string, std::string> &envs)
+{
+    pegasus_storage_profile profile = _default_storage_profile;
+    for (const std::string &key : profile.update(envs)) {
+        derror("%s: ignore invalid app env[%s] = %s",
+               replica_name(),
+               key.c_str(),
+               envs.at(key).c_str());
+    }
+    return profile;
+}
+
+void pegasus_server_impl::update_storage_profile(const std::map<std::string, std::string> &envs)
+{
+    pegasus_storage_profile profile = get_storage_profile(envs);
+    if (profile == _requested_storage_profile) {
+        return;
+    }
+    _requested_storage_profile = profile;
+
+    // whether the reads fill the block cache is decided by each read, so it takes effect at
+    // once even if the other options wait for the next open
+    bool fill_cache = profile.priority != pegasus_storage_profile::cache_priority::low;
+    if (fill_cache != _fill_cache.load()) {
+        _fill_cache.store(fill_cache);
+        ddebug("%s: reads %s the block cache since now",
+               replica_name(),
+               fill_cache ? "fill" : "do not fill");
+    }
+    if (profile.priority != _storage_profile.priority &&
+        (profile.priority == pegasus_storage_profile::cache_priority::high) ==
+            (_storage_profile.priority == pegasus_storage_profile::cache_priority::high)) {
+        ddebug("%s: update app env[%s] from %s to %s succeed",
+               replica_name(),
+               ROCKSDB_ENV_CACHE_PRIORITY_KEY.c_str(),
+               pegasus_storage_profile::cache_priority_name(_storage_profile.priority),
+               pegasus_storage_profile::cache_priority_name(profile.priority));
+        _storage_profile.priority = profile.priority;
+    }
+
+    if (profile != _storage_profile) {
+        ddebug("%s: storage profile is updated to {%s}, which takes effect when the app is "
+               "opened next time, the current one is {%s}",
+               replica_name(),
+               profile.to_string().c_str(),
+               _storage_profile.to_string().c_str());
+    }
 }
 
 void pegasus_server_impl::update_usage_scenario(const std::map<std::string, std::string> &envs)
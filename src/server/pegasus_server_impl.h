@@ -12,8 +12,15 @@
 #include <rrdb/rrdb_types.h>
 #include <rrdb/rrdb.server.h>
 
+#include "base/pegasus_scan_aggregator.h"
 #include "key_ttl_compaction_filter.h"
+#include "pegasus_blob_store.h"
+#include "pegasus_filter_matcher.h"
+#include "pegasus_memtable_flush_picker.h"
+#include "pegasus_row_cache.h"
 #include "pegasus_scan_context.h"
+#include "pegasus_storage_profile.h"
+#include "pegasus_table_properties_collector.h"
 #include "pagasus_manual_compact_service.h"
 #include "pegasus_write_service.h"
 
@@ -31,6 +38,11 @@ public:
             "pegasus", replication_app_base::create<pegasus::server::pegasus_server_impl>);
         register_rpc_handlers();
     }
+
+    // Sets which writes are batched into one mutation according to the config, called once
+    // when the replica server starts, before any replica is opened.
+    static void init_write_batching();
+
     explicit pegasus_server_impl(dsn::replication::replica *r);
 
     virtual ~pegasus_server_impl() override;
@@ -40,8 +52,13 @@ public:
                         ::dsn::rpc_replier<::dsn::apps::read_response> &reply) override;
     virtual void on_multi_get(const ::dsn::apps::multi_get_request &args,
                               ::dsn::rpc_replier<::dsn::apps::multi_get_response> &reply) override;
+    virtual void on_batch_get(const ::dsn::apps::batch_get_request &args,
+                              ::dsn::rpc_replier<::dsn::apps::batch_get_response> &reply) override;
     virtual void on_sortkey_count(const ::dsn::blob &args,
                                   ::dsn::rpc_replier<::dsn::apps::count_response> &reply) override;
+    virtual void
+    on_approximate_sortkey_count(const ::dsn::blob &args,
+                                 ::dsn::rpc_replier<::dsn::apps::count_response> &reply) override;
     virtual void on_ttl(const ::dsn::blob &key,
                         ::dsn::rpc_replier<::dsn::apps::ttl_response> &reply) override;
     virtual void on_get_scanner(const ::dsn::apps::get_scanner_request &args,
@@ -113,6 +130,11 @@ public:
     ::dsn::error_code copy_checkpoint_to_dir_unsafe(const char *checkpoint_dir,
                                                     /**output*/ int64_t *checkpoint_decree);
 
+    // add the blob files referred by the checkpoint created into it, see
+    // pegasus_blob_store::checkpoint(), which are then learned, backed up and restored together
+    // with the sst files
+    rocksdb::Status checkpoint_blob_files(const std::string &checkpoint_dir);
+
     // get the last checkpoint
     // if succeed:
     //  - the checkpoint files path are put into "state.files"
@@ -153,6 +175,7 @@ private:
     friend class pagasus_manual_compact_service;
     friend class manual_compact_service_test;
     friend class pegasus_write_service;
+    friend class pegasus_write_service_test;
 
     // parse checkpoint directories in the data dir
     // checkpoint directory format is: "checkpoint.{decree}"
@@ -163,43 +186,87 @@ private:
 
     void set_last_durable_decree(int64_t decree) { _last_durable_decree.store(decree); }
 
-    // return 1 if value is appended
+    // return 1 if value is appended, or added to the aggregator if not null
     // return 2 if value is expired
     // return 3 if value is filtered
+    // return 4 if value is failed to read from the blob file or corrupted
     int append_key_value_for_scan(std::vector<::dsn::apps::key_value> &kvs,
                                   const rocksdb::Slice &key,
                                   const rocksdb::Slice &value,
-                                  ::dsn::apps::filter_type::type hash_key_filter_type,
-                                  const ::dsn::blob &hash_key_filter_pattern,
-                                  ::dsn::apps::filter_type::type sort_key_filter_type,
-                                  const ::dsn::blob &sort_key_filter_pattern,
+                                  const pegasus_filter_matcher &hash_key_filter,
+                                  const pegasus_filter_matcher &sort_key_filter,
                                   uint32_t epoch_now,
-                                  bool no_value);
+                                  bool no_value,
+                                  pegasus_scan_aggregator *aggregator);
 
     // return 1 if value is appended
     // return 2 if value is expired
     // return 3 if value is filtered
+    // return 4 if value is failed to read from the blob file or corrupted
     int append_key_value_for_multi_get(std::vector<::dsn::apps::key_value> &kvs,
                                        const rocksdb::Slice &key,
                                        const rocksdb::Slice &value,
-                                       ::dsn::apps::filter_type::type sort_key_filter_type,
-                                       const ::dsn::blob &sort_key_filter_pattern,
+                                       const pegasus_filter_matcher &sort_key_filter,
                                        uint32_t epoch_now,
                                        bool no_value);
 
+    // skip the keys which can not match the FT_MATCH_PREFIX filters on hash key and sort key
+    // by seeking
+    // return 0 if the key of the iterator may match
+    // return 1 if the iterator is moved forward to skip the keys which can not match
+    // return 2 if no more key may match
+    int seek_by_prefix_filters(rocksdb::Iterator *it,
+                               const pegasus_filter_matcher &hash_key_filter,
+                               const pegasus_filter_matcher &sort_key_filter);
+
+    // copy key and user data of raw_value (if !no_value) into kv with one allocation
+    rocksdb::Status copy_key_value(const ::dsn::blob &key,
+                                   const rocksdb::Slice &raw_value,
+                                   bool no_value,
+                                   ::dsn::apps::key_value &kv);
+
+    // the read options of the online reads, which do not fill the block cache if the cache
+    // priority of the table is low
+    const rocksdb::ReadOptions &read_options() const
+    {
+        return _fill_cache.load(std::memory_order_relaxed) ? _rd_opts : _no_fill_cache_rd_opts;
+    }
+
+    // extract user data of raw_value, which is read from the blob file if separated
+    rocksdb::Status extract_user_data(dsn::string_view raw_value, ::dsn::blob &user_data);
+    rocksdb::Status extract_user_data(std::string &&raw_value, ::dsn::blob &user_data);
+
+    // count the alive records of the hash key by iterating them
+    rocksdb::Status
+    count_sort_keys(const ::dsn::blob &hash_key, int64_t &count, uint64_t &expire_count);
+
     // return true if the filter type is supported
     bool is_filter_type_supported(::dsn::apps::filter_type::type filter_type);
 
-    // return true if the data is valid for the filter
-    bool validate_filter(::dsn::apps::filter_type::type filter_type,
-                         const ::dsn::blob &filter_pattern,
-                         const ::dsn::blob &value);
-
     // statistic the sst file info for this replica. return (-1,-1) if failed.
     std::pair<int64_t, int64_t> statistic_sst_size();
 
     void updating_rocksdb_sstsize();
 
+    // delete the blob files not referred any more, and update the blob counters.
+    void blob_gc();
+
+    // compact the key ranges of the sst files estimated to have many expired records, which
+    // may not be compacted for a long time, e.g. those in the bottommost level.
+    void ttl_compaction();
+
+    // update the memtable usage counters, and flush the memtable of this replica if the
+    // process-wide write buffer budget is exceeded and the memtable is large.
+    void updating_rocksdb_memtable_usage();
+
+    // expire the idle scan contexts, evict the least recently used ones if the memtables pinned
+    // by them exceed the limit, and update the scan context counters.
+    void updating_scan_context_cache();
+
+    // the memory of the memtables which are already flushed or switched out, but still pinned
+    // by iterators (mostly those of the scan contexts).
+    uint64_t pinned_memtable_usage();
+
     virtual void update_app_envs(const std::map<std::string, std::string> &envs);
 
     virtual void query_app_envs(/*out*/ std::map<std::string, std::string> &envs);
@@ -213,6 +280,13 @@ private:
 
     void update_usage_scenario(const std::map<std::string, std::string> &envs);
 
+    // the cache priority of the reads is changed on the running db, the other options of the
+    // storage profile take effect when the db is opened next time
+    void update_storage_profile(const std::map<std::string, std::string> &envs);
+
+    // the storage profile requested by `envs`, the invalid values are ignored
+    pegasus_storage_profile get_storage_profile(const std::map<std::string, std::string> &envs);
+
     // return finish time recorded in rocksdb
     uint64_t do_manual_compact(const rocksdb::CompactRangeOptions &options);
 
@@ -241,15 +315,35 @@ private:
     uint64_t _abnormal_multi_get_size_threshold;
     uint64_t _abnormal_multi_get_iterate_count_threshold;
 
-    KeyWithTTLCompactionFilter _key_ttl_compaction_filter;
+    std::shared_ptr<KeyWithTTLCompactionFilterFactory> _key_ttl_compaction_filter_factory;
     rocksdb::Options _db_opts;
     rocksdb::WriteOptions _wt_opts;
     rocksdb::ReadOptions _rd_opts;
+    rocksdb::ReadOptions _no_fill_cache_rd_opts;
+    // updated by the app envs while the reads are running, see read_options()
+    std::atomic_bool _fill_cache;
     std::string _usage_scenario;
+    // the table options of the server config, which the storage profiles are applied on
+    rocksdb::BlockBasedTableOptions _tbl_opts;
+    // the storage profile of the server config, used unless overridden by the app envs
+    pegasus_storage_profile _default_storage_profile;
+    // the storage profile in effect, the cache priority of which is changed on the running db
+    // only between low and normal, as high is applied when the db is opened
+    pegasus_storage_profile _storage_profile;
+    // the storage profile last requested by the app envs, which takes effect when the db is
+    // opened next time if different from the one in effect
+    pegasus_storage_profile _requested_storage_profile;
+
+    std::shared_ptr<pegasus_table_properties_collector_factory> _table_properties_collector_factory;
 
     rocksdb::DB *_db;
     volatile bool _is_open;
     uint32_t _value_schema_version;
+    uint64_t _value_compression_threshold;
+    // the values not smaller than this size are separated into the blob files, 0 if disabled
+    uint64_t _blob_value_threshold;
+    pegasus_blob_store::options _blob_opts;
+    std::shared_ptr<pegasus_blob_store> _blob_store;
     std::atomic<int64_t> _last_durable_decree;
 
     std::unique_ptr<pegasus_server_write> _server_write;
@@ -261,10 +355,48 @@ private:
     std::deque<int64_t> _checkpoints;           // ordered checkpoints
 
     pegasus_context_cache _context_cache;
+    // the server side limits of one scan rpc
+    pegasus_scan_limits _scan_limits;
+    // the read options and the time slice of the scans with full_scan set
+    rocksdb::ReadOptions _full_scan_rd_opts;
+    int32_t _full_scan_max_iteration_time_ms;
+    uint64_t _scan_context_max_idle_ns;
+    uint64_t _scan_context_max_pinned_bytes;
+
+    pegasus_row_cache _row_cache;
+    uint32_t _row_cache_multi_get_max_sort_keys;
+
+    // shared by all replicas in one process, nullptr if the write buffer manager is disabled
+    std::shared_ptr<pegasus_memtable_flush_picker> _memtable_flush_picker;
+
+    // false only if no record has TTL, then the values need not be read for checking expiration
+    std::atomic_bool _may_have_ttl_records;
+    // the hash keys estimated to be smaller than this size are counted exactly
+    // by approximate_sortkey_count
+    uint64_t _approximate_sortkey_count_exact_threshold;
 
     ::dsn::task_ptr _updating_rocksdb_sstsize_timer_task;
     uint32_t _updating_rocksdb_sstsize_interval_seconds;
 
+    ::dsn::task_ptr _updating_rocksdb_memtable_usage_timer_task;
+    uint32_t _updating_rocksdb_memtable_usage_interval_seconds;
+
+    ::dsn::task_ptr _updating_scan_context_cache_timer_task;
+    uint32_t _updating_scan_context_cache_interval_seconds;
+
+    ::dsn::task_ptr _blob_gc_timer_task;
+    uint32_t _blob_gc_interval_seconds;
+
+    ::dsn::task_ptr _ttl_compaction_timer_task;
+    uint32_t _ttl_compaction_interval_seconds;
+    double _ttl_compaction_expired_ratio_threshold;
+    uint32_t _ttl_compaction_max_file_count;
+    int32_t _ttl_compaction_max_concurrent_count;
+    // shared by all replicas in one pegasus server
+    std::atomic<int32_t> *_running_ttl_compaction_count;
+    // set when stopping, the running ttl compaction checks it between the key ranges
+    std::atomic_bool _ttl_compaction_stopping;
+
     pagasus_manual_compact_service _manual_compact_svc;
 
     dsn::task_tracker _tracker;
@@ -272,17 +404,33 @@ private:
     // perf counters
     ::dsn::perf_counter_wrapper _pfc_get_qps;
     ::dsn::perf_counter_wrapper _pfc_multi_get_qps;
+    ::dsn::perf_counter_wrapper _pfc_batch_get_qps;
     ::dsn::perf_counter_wrapper _pfc_scan_qps;
 
     ::dsn::perf_counter_wrapper _pfc_get_latency;
     ::dsn::perf_counter_wrapper _pfc_multi_get_latency;
+    ::dsn::perf_counter_wrapper _pfc_batch_get_latency;
     ::dsn::perf_counter_wrapper _pfc_scan_latency;
 
+    ::dsn::perf_counter_wrapper _pfc_row_cache_hit;
+    ::dsn::perf_counter_wrapper _pfc_row_cache_miss;
+
     ::dsn::perf_counter_wrapper _pfc_recent_expire_count;
     ::dsn::perf_counter_wrapper _pfc_recent_filter_count;
     ::dsn::perf_counter_wrapper _pfc_recent_abnormal_count;
     ::dsn::perf_counter_wrapper _pfc_sst_count;
     ::dsn::perf_counter_wrapper _pfc_sst_size;
+    ::dsn::perf_counter_wrapper _pfc_blob_count;
+    ::dsn::perf_counter_wrapper _pfc_blob_size;
+    ::dsn::perf_counter_wrapper _pfc_recent_ttl_compaction_count;
+    ::dsn::perf_counter_wrapper _pfc_memtable_usage;
+    ::dsn::perf_counter_wrapper _pfc_pinned_memtable_usage;
+    ::dsn::perf_counter_wrapper _pfc_scan_context_count;
+    ::dsn::perf_counter_wrapper _pfc_recent_scan_context_evict_count;
+    // shared by all replicas in this process
+    ::dsn::perf_counter_wrapper _pfc_node_memtable_usage;
+    ::dsn::perf_counter_wrapper _pfc_node_row_cache_usage;
+    ::dsn::perf_counter_wrapper _pfc_node_row_cache_evict_count;
 };
 }
 } // namespace
@@ -34,17 +34,21 @@ int pegasus_server_write::on_batched_write_requests(dsn_message_t *requests,
     }
 
     dsn::task_code rpc_code(dsn_msg_task_code(requests[0]));
-    if (rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_PUT) {
+    if (rpc_code == dsn::apps::RPC_RRDB_RRDB_DEL_RANGE) {
         dassert(count == 1, "");
-        auto rpc = multi_put_rpc::auto_reply(requests[0]);
-        on_multi_put(rpc);
+        auto rpc = del_range_rpc::auto_reply(requests[0]);
+        on_del_range(rpc);
         return rpc.response().error;
     }
-    if (rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_REMOVE) {
+    if (rpc_code == dsn::apps::RPC_RRDB_RRDB_CHECK_AND_SET) {
         dassert(count == 1, "");
-        auto rpc = multi_remove_rpc::auto_reply(requests[0]);
-        on_multi_remove(rpc);
-        return rpc.response().error;
+        auto rpc = check_and_set_rpc::auto_reply(requests[0]);
+        return on_check_and_set(rpc);
+    }
+    if (rpc_code == dsn::apps::RPC_RRDB_RRDB_CHECK_AND_MUTATE) {
+        dassert(count == 1, "");
+        auto rpc = check_and_mutate_rpc::auto_reply(requests[0]);
+        return on_check_and_mutate(rpc);
     }
 
     return on_batched_writes(requests, count, decree);
@@ -68,9 +72,22 @@ int pegasus_server_write::on_batched_writes(dsn_message_t *requests, int count,
                 auto rpc = remove_rpc::auto_reply(requests[i]);
                 on_single_remove_in_batch(rpc);
                 _remove_rpc_batch.emplace_back(std::move(rpc));
+            } else if (rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_PUT) {
+                auto rpc = multi_put_rpc::auto_reply(requests[i]);
+                on_multi_put_in_batch(rpc);
+                _multi_put_rpc_batch.emplace_back(std::move(rpc));
+            } else if (rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_REMOVE) {
+                auto rpc = multi_remove_rpc::auto_reply(requests[i]);
+                on_multi_remove_in_batch(rpc);
+                _multi_remove_rpc_batch.emplace_back(std::move(rpc));
+            } else if (rpc_code == dsn::apps::RPC_RRDB_RRDB_INCR) {
+                auto rpc = incr_rpc::auto_reply(requests[i]);
+                on_single_incr_in_batch(rpc);
+                _incr_rpc_batch.emplace_back(std::move(rpc));
             } else {
-                if (rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_PUT ||
-                    rpc_code == dsn::apps::RPC_RRDB_RRDB_MULTI_REMOVE) {
+                if (rpc_code == dsn::apps::RPC_RRDB_RRDB_DEL_RANGE ||
+                    rpc_code == dsn::apps::RPC_RRDB_RRDB_CHECK_AND_SET ||
+                    rpc_code == dsn::apps::RPC_RRDB_RRDB_CHECK_AND_MUTATE) {
                     dfatal("rpc code not allow batch: %s", rpc_code.to_string());
                 } else {
                     dfatal("rpc code not handled: %s", rpc_code.to_string());
@@ -84,6 +101,9 @@ int pegasus_server_write::on_batched_writes(dsn_message_t *requests, int count,
     // reply the batched RPCs
     _put_rpc_batch.clear();
     _remove_rpc_batch.clear();
+    _incr_rpc_batch.clear();
+    _multi_put_rpc_batch.clear();
+    _multi_remove_rpc_batch.clear();
     return err;
 }
 
@@ -111,5 +131,29 @@ void pegasus_server_write::request_key_check(int64_t decree, dsn_message_t m, co
     }
 }
 
+void pegasus_server_write::request_hash_key_check(int64_t decree,
+                                                  dsn_message_t m,
+                                                  const dsn::blob &hash_key)
+{
+    auto msg = (dsn::message_ex *)m;
+    if (msg->header->client.partition_hash != 0) {
+        dsn::blob key;
+        pegasus_generate_key(key, hash_key, dsn::blob());
+        uint64_t partition_hash = pegasus_key_hash(key);
+        dassert(msg->header->client.partition_hash == partition_hash,
+                "inconsistent partition hash");
+        int thread_hash = get_gpid().thread_hash();
+        dassert(msg->header->client.thread_hash == thread_hash, "inconsistent thread hash");
+    }
+
+    if (_verbose_log) {
+        ddebug_rocksdb("write",
+                       "decree={}, code={}, hash_key={}",
+                       decree,
+                       msg->local_rpc_code.to_string(),
+                       utils::c_escape_string(hash_key));
+    }
+}
+
 } // namespace server
 } // namespace pegasus
@@ -24,14 +24,22 @@ public:
                                   uint64_t timestamp);
 
 private:
-    void on_multi_put(multi_put_rpc &rpc)
+    void on_del_range(del_range_rpc &rpc)
     {
-        _write_svc->multi_put(_decree, rpc.request(), rpc.response());
+        request_hash_key_check(_decree, rpc.dsn_request(), rpc.request().hash_key);
+        _write_svc->del_range(_decree, rpc.request(), rpc.response());
     }
 
-    void on_multi_remove(multi_remove_rpc &rpc)
+    int on_check_and_set(check_and_set_rpc &rpc)
     {
-        _write_svc->multi_remove(_decree, rpc.request(), rpc.response());
+        request_hash_key_check(_decree, rpc.dsn_request(), rpc.request().hash_key);
+        return _write_svc->check_and_set(_decree, rpc.request(), rpc.response());
+    }
+
+    int on_check_and_mutate(check_and_mutate_rpc &rpc)
+    {
+        request_hash_key_check(_decree, rpc.dsn_request(), rpc.request().hash_key);
+        return _write_svc->check_and_mutate(_decree, rpc.request(), rpc.response());
     }
 
     /// Delay replying for the batched requests until all of them complete.
@@ -49,10 +57,31 @@ private:
         request_key_check(_decree, rpc.dsn_request(), rpc.request());
     }
 
+    void on_multi_put_in_batch(multi_put_rpc &rpc)
+    {
+        _write_svc->batch_multi_put(rpc.request(), rpc.response());
+        request_hash_key_check(_decree, rpc.dsn_request(), rpc.request().hash_key);
+    }
+
+    void on_multi_remove_in_batch(multi_remove_rpc &rpc)
+    {
+        _write_svc->batch_multi_remove(rpc.request(), rpc.response());
+        request_hash_key_check(_decree, rpc.dsn_request(), rpc.request().hash_key);
+    }
+
+    void on_single_incr_in_batch(incr_rpc &rpc)
+    {
+        _write_svc->batch_incr(rpc.request(), rpc.response());
+        request_key_check(_decree, rpc.dsn_request(), rpc.request().key);
+    }
+
     // Ensure that the write request is directed to the right partition.
     // In verbose mode it will log for every request.
     void request_key_check(int64_t decree, dsn_message_t m, const dsn::blob &key);
 
+    // Same as `request_key_check`, for the requests on multiple sort keys of a hash key.
+    void request_hash_key_check(int64_t decree, dsn_message_t m, const dsn::blob &hash_key);
+
 private:
     friend class pegasus_server_write_test;
     friend class pegasus_write_service_test;
@@ -60,6 +89,9 @@ private:
     std::unique_ptr<pegasus_write_service> _write_svc;
     std::vector<put_rpc> _put_rpc_batch;
     std::vector<remove_rpc> _remove_rpc_batch;
+    std::vector<incr_rpc> _incr_rpc_batch;
+    std::vector<multi_put_rpc> _multi_put_rpc_batch;
+    std::vector<multi_remove_rpc> _multi_remove_rpc_batch;
 
     int64_t _decree;
 
@@ -8,6 +8,7 @@
 #include <dsn/dist/replication/replication_service_app.h>
 #include "pegasus_counter_updater.h"
 #include "pegasus_perf_counter.h"
+#include "pegasus_server_impl.h"
 
 namespace pegasus {
 namespace server {
@@ -25,6 +26,7 @@ public:
 
     virtual ::dsn::error_code start(const std::vector<std::string> &args) override
     {
+        pegasus_server_impl::init_write_batching();
         ::dsn::error_code ret = ::dsn::replication::replication_service_app::start(args);
         if (ret == ::dsn::ERR_OK) {
             pegasus_counter_updater::instance().start();
@@ -0,0 +1,231 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "pegasus_storage_profile.h"
+
+#include <rocksdb/filter_policy.h>
+#include <dsn/utility/string_conv.h>
+#include <dsn/utility/strings.h>
+
+#include "base/pegasus_const.h"
+
+namespace pegasus {
+namespace server {
+
+static const std::string DEFAULT_BOTTOMMOST_COMPRESSION("default");
+
+static const std::map<std::string, rocksdb::CompressionType> compression_types = {
+    {"none", rocksdb::kNoCompression},
+    {"snappy", rocksdb::kSnappyCompression},
+    {"zlib", rocksdb::kZlibCompression},
+    {"bzip2", rocksdb::kBZip2Compression},
+    {"lz4", rocksdb::kLZ4Compression},
+    {"lz4hc", rocksdb::kLZ4HCCompression},
+    {"zstd", rocksdb::kZSTD},
+};
+
+static const std::map<std::string, pegasus_storage_profile::cache_priority> cache_priorities = {
+    {"low", pegasus_storage_profile::cache_priority::low},
+    {"normal", pegasus_storage_profile::cache_priority::normal},
+    {"high", pegasus_storage_profile::cache_priority::high},
+};
+
+// a single type compresses the levels >= 2 as the server config does, refer to
+// ColumnFamilyOptions::OptimizeLevelStyleCompaction(), or the types of each level are
+// separated by ','
+static bool parse_compression_per_level(const std::string &str,
+                                        std::vector<rocksdb::CompressionType> &types)
+{
+    std::vector<std::string> names;
+    dsn::utils::split_args(str.c_str(), names, ',');
+    if (names.empty()) {
+        return false;
+    }
+
+    std::vector<rocksdb::CompressionType> result;
+    for (const std::string &name : names) {
+        rocksdb::CompressionType type;
+        if (!pegasus_storage_profile::parse_compression(name, type)) {
+            return false;
+        }
+        result.push_back(type);
+    }
+    if (result.size() == 1 && result[0] != rocksdb::kNoCompression) {
+        result.insert(result.begin(), 2, rocksdb::kNoCompression);
+    }
+    types = std::move(result);
+    return true;
+}
+
+std::vector<std::string>
+pegasus_storage_profile::update(const std::map<std::string, std::string> &envs)
+{
+    std::vector<std::string> invalid_keys;
+    auto find = envs.find(ROCKSDB_ENV_COMPRESSION_KEY);
+    if (find != envs.end() && !parse_compression_per_level(find->second, compression_per_level)) {
+        invalid_keys.push_back(find->first);
+    }
+
+    find = envs.find(ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY);
+    if (find != envs.end()) {
+        if (find->second == DEFAULT_BOTTOMMOST_COMPRESSION) {
+            bottommost_compression = rocksdb::kDisableCompressionOption;
+        } else if (!parse_compression(find->second, bottommost_compression)) {
+            invalid_keys.push_back(find->first);
+        }
+    }
+
+    find = envs.find(ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY);
+    if (find != envs.end()) {
+        int32_t bits = 0;
+        if (dsn::buf2int32(find->second, bits) && bits >= 0 && bits <= 64) {
+            bloom_bits_per_key = bits;
+        } else {
+            invalid_keys.push_back(find->first);
+        }
+    }
+
+    find = envs.find(ROCKSDB_ENV_BLOCK_SIZE_KEY);
+    if (find != envs.end()) {
+        int64_t size = 0;
+        if (dsn::buf2int64(find->second, size) && size >= 1024 && size <= 64 * 1024 * 1024) {
+            block_size = size;
+        } else {
+            invalid_keys.push_back(find->first);
+        }
+    }
+
+    find = envs.find(ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY);
+    if (find != envs.end()) {
+        if (find->second == "true") {
+            cache_index_and_filter_blocks = true;
+        } else if (find->second == "false") {
+            cache_index_and_filter_blocks = false;
+        } else {
+            invalid_keys.push_back(find->first);
+        }
+    }
+
+    find = envs.find(ROCKSDB_ENV_CACHE_PRIORITY_KEY);
+    if (find != envs.end() && !parse_cache_priority(find->second, priority)) {
+        invalid_keys.push_back(find->first);
+    }
+    return invalid_keys;
+}
+
+void pegasus_storage_profile::apply(rocksdb::Options &opts,
+                                    rocksdb::BlockBasedTableOptions tbl_opts) const
+{
+    opts.compression_per_level.clear();
+    if (!compression_per_level.empty()) {
+        for (int i = 0; i < opts.num_levels; ++i) {
+            opts.compression_per_level.push_back(
+                compression_per_level[std::min<size_t>(i, compression_per_level.size() - 1)]);
+        }
+        opts.compression = compression_per_level.back();
+    }
+    opts.bottommost_compression = bottommost_compression;
+
+    if (bloom_bits_per_key > 0) {
+        tbl_opts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(bloom_bits_per_key, false));
+    } else {
+        tbl_opts.filter_policy.reset();
+    }
+    tbl_opts.block_size = block_size;
+    tbl_opts.cache_index_and_filter_blocks = cache_index_and_filter_blocks;
+    tbl_opts.cache_index_and_filter_blocks_with_high_priority = priority == cache_priority::high;
+    tbl_opts.pin_l0_filter_and_index_blocks_in_cache =
+        cache_index_and_filter_blocks && priority == cache_priority::high;
+    opts.table_factory.reset(rocksdb::NewBlockBasedTableFactory(tbl_opts));
+}
+
+void pegasus_storage_profile::to_envs(std::map<std::string, std::string> &envs) const
+{
+    std::string compression;
+    for (rocksdb::CompressionType type : compression_per_level) {
+        if (!compression.empty()) {
+            compression += ",";
+        }
+        compression += compression_name(type);
+    }
+    envs[ROCKSDB_ENV_COMPRESSION_KEY] = compression;
+    envs[ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY] =
+        bottommost_compression == rocksdb::kDisableCompressionOption
+            ? DEFAULT_BOTTOMMOST_COMPRESSION
+            : compression_name(bottommost_compression);
+    envs[ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY] = std::to_string(bloom_bits_per_key);
+    envs[ROCKSDB_ENV_BLOCK_SIZE_KEY] = std::to_string(block_size);
+    envs[ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY] =
+        cache_index_and_filter_blocks ? "true" : "false";
+    envs[ROCKSDB_ENV_CACHE_PRIORITY_KEY] = cache_priority_name(priority);
+}
+
+std::string pegasus_storage_profile::to_string() const
+{
+    std::map<std::string, std::string> envs;
+    to_envs(envs);
+    std::string result;
+    for (const auto &kv : envs) {
+        if (!result.empty()) {
+            result += ", ";
+        }
+        result += kv.first + "=" + kv.second;
+    }
+    return result;
+}
+
+bool pegasus_storage_profile::open_options_equal(const pegasus_storage_profile &o) const
+{
+    // the high priority of the index and filter blocks is applied when the db is opened
+    return compression_per_level == o.compression_per_level &&
+           bottommost_compression == o.bottommost_compression &&
+           bloom_bits_per_key == o.bloom_bits_per_key && block_size == o.block_size &&
+           cache_index_and_filter_blocks == o.cache_index_and_filter_blocks &&
+           (priority == cache_priority::high) == (o.priority == cache_priority::high);
+}
+
+/*static*/ bool pegasus_storage_profile::parse_compression(const std::string &name,
+                                                          rocksdb::CompressionType &type)
+{
+    auto find = compression_types.find(name);
+    if (find == compression_types.end()) {
+        return false;
+    }
+    type = find->second;
+    return true;
+}
+
+/*static*/ const char *pegasus_storage_profile::compression_name(rocksdb::CompressionType type)
+{
+    for (const auto &kv : compression_types) {
+        if (kv.second == type) {
+            return kv.first.c_str();
+        }
+    }
+    return "unknown";
+}
+
+/*static*/ bool pegasus_storage_profile::parse_cache_priority(const std::string &name,
+                                                             cache_priority &priority)
+{
+    auto find = cache_priorities.find(name);
+    if (find == cache_priorities.end()) {
+        return false;
+    }
+    priority = find->second;
+    return true;
+}
+
+/*static*/ const char *pegasus_storage_profile::cache_priority_name(cache_priority priority)
+{
+    for (const auto &kv : cache_priorities) {
+        if (kv.second == priority) {
+            return kv.first.c_str();
+        }
+    }
+    return "unknown";
+}
+
+} // namespace server
+} // namespace pegasus
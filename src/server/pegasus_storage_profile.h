@@ -0,0 +1,72 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include <rocksdb/options.h>
+#include <rocksdb/table.h>
+
+namespace pegasus {
+namespace server {
+
+/// The storage options of a table which can be set by the app envs, see ROCKSDB_ENV_*_KEY in
+/// base/pegasus_const.h. Only whether the reads fill the block cache, i.e. the cache priority
+/// between low and normal, takes effect on the running db, as the table options and the
+/// compression are applied when the db is opened.
+struct pegasus_storage_profile
+{
+    enum class cache_priority
+    {
+        // the reads do not fill the block cache, so the table does not evict the hot data of
+        // the others
+        low,
+        normal,
+        // the index and filter blocks are in the high priority pool of the block cache, and the
+        // ones of level 0 are pinned
+        high,
+    };
+
+    // the compression of each level, the last one is used for the levels beyond
+    std::vector<rocksdb::CompressionType> compression_per_level;
+    // kDisableCompressionOption if the bottommost level follows compression_per_level
+    rocksdb::CompressionType bottommost_compression = rocksdb::kDisableCompressionOption;
+    // 0 if the bloom filter is disabled
+    int bloom_bits_per_key = 10;
+    uint64_t block_size = 4 * 1024;
+    bool cache_index_and_filter_blocks = false;
+    cache_priority priority = cache_priority::normal;
+
+    /// Overrides the options set in `envs`.
+    /// \return the keys of the invalid values in `envs`, which are ignored.
+    std::vector<std::string> update(const std::map<std::string, std::string> &envs);
+
+    /// Sets the compression and the table factory of `opts`, `tbl_opts` is the base table
+    /// options of the server, e.g. with the block cache.
+    void apply(rocksdb::Options &opts, rocksdb::BlockBasedTableOptions tbl_opts) const;
+
+    void to_envs(std::map<std::string, std::string> &envs) const;
+
+    std::string to_string() const;
+
+    /// Whether the options applied when the db is opened are equal, i.e. all but whether the
+    /// reads fill the block cache.
+    bool open_options_equal(const pegasus_storage_profile &o) const;
+
+    bool operator==(const pegasus_storage_profile &o) const
+    {
+        return open_options_equal(o) && priority == o.priority;
+    }
+    bool operator!=(const pegasus_storage_profile &o) const { return !(*this == o); }
+
+    static bool parse_compression(const std::string &name, rocksdb::CompressionType &type);
+    static const char *compression_name(rocksdb::CompressionType type);
+    static bool parse_cache_priority(const std::string &name, cache_priority &priority);
+    static const char *cache_priority_name(cache_priority priority);
+};
+
+} // namespace server
+} // namespace pegasus
@@ -0,0 +1,197 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <cinttypes>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <string>
+#include <rocksdb/table_properties.h>
+
+#include "base/pegasus_utils.h"
+#include "base/pegasus_value_schema.h"
+
+namespace pegasus {
+namespace server {
+
+/// The count of the records with expire_ts > 0 in a sst file.
+const char *const TABLE_PROPERTY_TTL_RECORD_COUNT = "pegasus.ttl_record_count";
+
+/// The min and max expire_ts of the records with expire_ts > 0 in a sst file, 0 if no such
+/// record.
+const char *const TABLE_PROPERTY_MIN_EXPIRE_TS = "pegasus.min_expire_ts";
+const char *const TABLE_PROPERTY_MAX_EXPIRE_TS = "pegasus.max_expire_ts";
+
+/// The bytes of each blob file referred by the blob indexes in a sst file, formatted as
+/// "<file_number>:<bytes>,...", and empty if no blob index.
+const char *const TABLE_PROPERTY_BLOB_REFS = "pegasus.blob_refs";
+
+/// Collects the statistics of the records with TTL and the references to the blob files into
+/// the user properties of sst files, so that the statistics of a replica can be known without
+/// reading its data.
+class pegasus_table_properties_collector : public rocksdb::TablePropertiesCollector
+{
+public:
+    explicit pegasus_table_properties_collector(uint32_t value_schema_version)
+        : _value_schema_version(value_schema_version),
+          _ttl_record_count(0),
+          _min_expire_ts(0),
+          _max_expire_ts(0)
+    {
+    }
+
+    rocksdb::Status AddUserKey(const rocksdb::Slice &key,
+                               const rocksdb::Slice &value,
+                               rocksdb::EntryType type,
+                               rocksdb::SequenceNumber seq,
+                               uint64_t file_size) override
+    {
+        if (type != rocksdb::kEntryPut || value.size() < sizeof(uint32_t)) {
+            return rocksdb::Status::OK();
+        }
+        dsn::string_view raw_value = utils::to_string_view(value);
+        uint32_t expire_ts = pegasus_extract_expire_ts(_value_schema_version, raw_value);
+        if (expire_ts > 0) {
+            _min_expire_ts =
+                _ttl_record_count == 0 ? expire_ts : std::min(_min_expire_ts, expire_ts);
+            _max_expire_ts = std::max(_max_expire_ts, expire_ts);
+            _ttl_record_count++;
+        }
+        if (pegasus_value_is_blob_index(_value_schema_version, raw_value)) {
+            pegasus_blob_index index;
+            pegasus_extract_blob_index(_value_schema_version, raw_value, index);
+            _blob_refs[index.file_number] += index.size;
+        }
+        return rocksdb::Status::OK();
+    }
+
+    rocksdb::Status Finish(rocksdb::UserCollectedProperties *properties) override
+    {
+        *properties = GetReadableProperties();
+        return rocksdb::Status::OK();
+    }
+
+    rocksdb::UserCollectedProperties GetReadableProperties() const override
+    {
+        std::string blob_refs;
+        for (const auto &kv : _blob_refs) {
+            if (!blob_refs.empty()) {
+                blob_refs += ',';
+            }
+            blob_refs += std::to_string(kv.first) + ':' + std::to_string(kv.second);
+        }
+        return {{TABLE_PROPERTY_TTL_RECORD_COUNT, std::to_string(_ttl_record_count)},
+                {TABLE_PROPERTY_MIN_EXPIRE_TS, std::to_string(_min_expire_ts)},
+                {TABLE_PROPERTY_MAX_EXPIRE_TS, std::to_string(_max_expire_ts)},
+                {TABLE_PROPERTY_BLOB_REFS, blob_refs}};
+    }
+
+    const char *Name() const override { return "pegasus_table_properties_collector"; }
+
+    /// \return false only if all the tables are known to have no record with TTL.
+    static bool may_have_ttl_records(const rocksdb::TablePropertiesCollection &tables)
+    {
+        for (const auto &kv : tables) {
+            const rocksdb::UserCollectedProperties &props = kv.second->user_collected_properties;
+            auto iter = props.find(TABLE_PROPERTY_TTL_RECORD_COUNT);
+            // the tables generated by old versions have no such property
+            if (iter == props.end() || iter->second != "0") {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Estimates the ratio of the expired records in the table at `epoch_now`, supposing that
+    /// the expire_ts of the records with TTL are uniformly distributed between the min and the
+    /// max one. \return 0 if the table has no such properties.
+    static double estimate_expired_ratio(const rocksdb::TableProperties &table, uint32_t epoch_now)
+    {
+        const rocksdb::UserCollectedProperties &props = table.user_collected_properties;
+        auto count_iter = props.find(TABLE_PROPERTY_TTL_RECORD_COUNT);
+        auto min_iter = props.find(TABLE_PROPERTY_MIN_EXPIRE_TS);
+        auto max_iter = props.find(TABLE_PROPERTY_MAX_EXPIRE_TS);
+        if (count_iter == props.end() || min_iter == props.end() || max_iter == props.end() ||
+            table.num_entries == 0) {
+            return 0;
+        }
+        uint64_t ttl_record_count = strtoull(count_iter->second.c_str(), nullptr, 10);
+        uint32_t min_expire_ts = (uint32_t)strtoul(min_iter->second.c_str(), nullptr, 10);
+        uint32_t max_expire_ts = (uint32_t)strtoul(max_iter->second.c_str(), nullptr, 10);
+        if (ttl_record_count == 0 || epoch_now < min_expire_ts) {
+            return 0;
+        }
+
+        // the records with expire_ts <= epoch_now are expired
+        double expired_ttl_ratio = 1;
+        if (epoch_now < max_expire_ts) {
+            expired_ttl_ratio =
+                (double)(epoch_now - min_expire_ts + 1) / (max_expire_ts - min_expire_ts + 1);
+        }
+        return std::min(1.0, expired_ttl_ratio * ttl_record_count / table.num_entries);
+    }
+
+    /// Sums the bytes of each blob file referred by the tables into `refs`.
+    /// \return false if any table has no such property, then `refs` is incomplete.
+    static bool get_blob_refs(const rocksdb::TablePropertiesCollection &tables,
+                              std::map<uint64_t, uint64_t> &refs)
+    {
+        bool complete = true;
+        for (const auto &kv : tables) {
+            const rocksdb::UserCollectedProperties &props = kv.second->user_collected_properties;
+            auto iter = props.find(TABLE_PROPERTY_BLOB_REFS);
+            if (iter == props.end()) {
+                complete = false;
+                continue;
+            }
+            const char *p = iter->second.c_str();
+            uint64_t file_number = 0;
+            uint64_t bytes = 0;
+            int n = 0;
+            while (sscanf(p, "%" SCNu64 ":%" SCNu64 "%n", &file_number, &bytes, &n) == 2) {
+                refs[file_number] += bytes;
+                p += n;
+                if (*p != ',') {
+                    break;
+                }
+                p++;
+            }
+        }
+        return complete;
+    }
+
+private:
+    uint32_t _value_schema_version;
+    uint64_t _ttl_record_count;
+    uint32_t _min_expire_ts;
+    uint32_t _max_expire_ts;
+    std::map<uint64_t, uint64_t> _blob_refs;
+};
+
+class pegasus_table_properties_collector_factory
+    : public rocksdb::TablePropertiesCollectorFactory
+{
+public:
+    pegasus_table_properties_collector_factory() : _value_schema_version(0) {}
+
+    rocksdb::TablePropertiesCollector *
+    CreateTablePropertiesCollector(rocksdb::TablePropertiesCollectorFactory::Context) override
+    {
+        return new pegasus_table_properties_collector(_value_schema_version.load());
+    }
+
+    const char *Name() const override { return "pegasus_table_properties_collector_factory"; }
+
+    void set_value_schema_version(uint32_t version) { _value_schema_version.store(version); }
+
+private:
+    std::atomic<uint32_t> _value_schema_version;
+};
+
+} // namespace server
+} // namespace pegasus
@@ -33,6 +33,26 @@ pegasus_write_service::pegasus_write_service(pegasus_server_impl *server)
                                            COUNTER_TYPE_RATE,
                                            "statistic the qps of MULTI_REMOVE request");
 
+    name = fmt::format("del_range_qps@{}", str_gpid);
+    _pfc_del_range_qps.init_app_counter(
+        "app.pegasus", name.c_str(), COUNTER_TYPE_RATE, "statistic the qps of DEL_RANGE request");
+
+    name = fmt::format("incr_qps@{}", str_gpid);
+    _pfc_incr_qps.init_app_counter(
+        "app.pegasus", name.c_str(), COUNTER_TYPE_RATE, "statistic the qps of INCR request");
+
+    name = fmt::format("check_and_set_qps@{}", str_gpid);
+    _pfc_check_and_set_qps.init_app_counter("app.pegasus",
+                                            name.c_str(),
+                                            COUNTER_TYPE_RATE,
+                                            "statistic the qps of CHECK_AND_SET request");
+
+    name = fmt::format("check_and_mutate_qps@{}", str_gpid);
+    _pfc_check_and_mutate_qps.init_app_counter("app.pegasus",
+                                               name.c_str(),
+                                               COUNTER_TYPE_RATE,
+                                               "statistic the qps of CHECK_AND_MUTATE request");
+
     name = fmt::format("put_latency@{}", str_gpid);
     _pfc_put_latency.init_app_counter("app.pegasus",
                                       name.c_str(),
@@ -56,28 +76,65 @@ pegasus_write_service::pegasus_write_service(pegasus_server_impl *server)
                                                name.c_str(),
                                                COUNTER_TYPE_NUMBER_PERCENTILES,
                                                "statistic the latency of MULTI_REMOVE request");
+
+    name = fmt::format("del_range_latency@{}", str_gpid);
+    _pfc_del_range_latency.init_app_counter("app.pegasus",
+                                            name.c_str(),
+                                            COUNTER_TYPE_NUMBER_PERCENTILES,
+                                            "statistic the latency of DEL_RANGE request");
+
+    name = fmt::format("incr_latency@{}", str_gpid);
+    _pfc_incr_latency.init_app_counter("app.pegasus",
+                                       name.c_str(),
+                                       COUNTER_TYPE_NUMBER_PERCENTILES,
+                                       "statistic the latency of INCR request");
+
+    name = fmt::format("check_and_set_latency@{}", str_gpid);
+    _pfc_check_and_set_latency.init_app_counter("app.pegasus",
+                                                name.c_str(),
+                                                COUNTER_TYPE_NUMBER_PERCENTILES,
+                                                "statistic the latency of CHECK_AND_SET request");
+
+    name = fmt::format("check_and_mutate_latency@{}", str_gpid);
+    _pfc_check_and_mutate_latency.init_app_counter(
+        "app.pegasus",
+        name.c_str(),
+        COUNTER_TYPE_NUMBER_PERCENTILES,
+        "statistic the latency of CHECK_AND_MUTATE request");
 }
 
 pegasus_write_service::~pegasus_write_service() = default;
 
-void pegasus_write_service::multi_put(int64_t decree,
-                                      const dsn::apps::multi_put_request &update,
+void pegasus_write_service::del_range(int64_t decree,
+                                      const dsn::apps::del_range_request &update,
                                       dsn::apps::update_response &resp)
 {
     uint64_t start_time = dsn_now_ns();
-    _pfc_multi_put_qps->increment();
-    _impl->multi_put(decree, update, resp);
-    _pfc_multi_put_latency->set(dsn_now_ns() - start_time);
+    _pfc_del_range_qps->increment();
+    _impl->del_range(decree, update, resp);
+    _pfc_del_range_latency->set(dsn_now_ns() - start_time);
 }
 
-void pegasus_write_service::multi_remove(int64_t decree,
-                                         const dsn::apps::multi_remove_request &update,
-                                         dsn::apps::multi_remove_response &resp)
+int pegasus_write_service::check_and_set(int64_t decree,
+                                          const dsn::apps::check_and_set_request &update,
+                                          dsn::apps::check_and_set_response &resp)
 {
     uint64_t start_time = dsn_now_ns();
-    _pfc_multi_remove_qps->increment();
-    _impl->multi_remove(decree, update, resp);
-    _pfc_multi_remove_latency->set(dsn_now_ns() - start_time);
+    _pfc_check_and_set_qps->increment();
+    int err = _impl->check_and_set(decree, update, resp);
+    _pfc_check_and_set_latency->set(dsn_now_ns() - start_time);
+    return err;
+}
+
+int pegasus_write_service::check_and_mutate(int64_t decree,
+                                             const dsn::apps::check_and_mutate_request &update,
+                                             dsn::apps::check_and_mutate_response &resp)
+{
+    uint64_t start_time = dsn_now_ns();
+    _pfc_check_and_mutate_qps->increment();
+    int err = _impl->check_and_mutate(decree, update, resp);
+    _pfc_check_and_mutate_latency->set(dsn_now_ns() - start_time);
+    return err;
 }
 
 void pegasus_write_service::batch_put(const dsn::apps::update_request &update,
@@ -89,6 +146,15 @@ void pegasus_write_service::batch_put(const dsn::apps::update_request &update,
     _impl->batch_put(update, resp);
 }
 
+void pegasus_write_service::batch_multi_put(const dsn::apps::multi_put_request &update,
+                                            dsn::apps::update_response &resp)
+{
+    _pfc_multi_put_qps->increment();
+    _batch_perfcounters.push_back(_pfc_multi_put_latency.get());
+
+    _impl->batch_multi_put(update, resp);
+}
+
 void pegasus_write_service::batch_remove(const dsn::blob &key, dsn::apps::update_response &resp)
 {
     _pfc_remove_qps->increment();
@@ -97,6 +163,24 @@ void pegasus_write_service::batch_remove(const dsn::blob &key, dsn::apps::update
     _impl->batch_remove(key, resp);
 }
 
+void pegasus_write_service::batch_multi_remove(const dsn::apps::multi_remove_request &update,
+                                               dsn::apps::multi_remove_response &resp)
+{
+    _pfc_multi_remove_qps->increment();
+    _batch_perfcounters.push_back(_pfc_multi_remove_latency.get());
+
+    _impl->batch_multi_remove(update, resp);
+}
+
+void pegasus_write_service::batch_incr(const dsn::apps::incr_request &update,
+                                       dsn::apps::incr_response &resp)
+{
+    _pfc_incr_qps->increment();
+    _batch_perfcounters.push_back(_pfc_incr_latency.get());
+
+    _impl->batch_incr(update, resp);
+}
+
 int pegasus_write_service::batch_commit(int64_t decree)
 {
     dassert(_batch_start_time != 0, "batch_commit and batch_prepare must be called in pair");
@@ -121,12 +205,7 @@ void pegasus_write_service::batch_prepare()
     _batch_start_time = dsn_now_ns();
 }
 
-int pegasus_write_service::empty_put(int64_t decree)
-{
-    std::string empty_key, empty_value;
-    _impl->db_write_batch_put(empty_key, empty_value, 0);
-    return _impl->db_write(decree);
-}
+int pegasus_write_service::empty_put(int64_t decree) { return _impl->empty_put(decree); }
 
 } // namespace server
 } // namespace pegasus
@@ -26,13 +26,23 @@ public:
 
     ~pegasus_write_service();
 
-    void multi_put(int64_t decree,
-                   const dsn::apps::multi_put_request &update,
+    /// Delete all the records of a hash key within the sort key range,
+    /// it's applied as one range deletion of rocksdb.
+    void del_range(int64_t decree,
+                   const dsn::apps::del_range_request &update,
                    dsn::apps::update_response &resp);
 
-    void multi_remove(int64_t decree,
-                      const dsn::apps::multi_remove_request &update,
-                      dsn::apps::multi_remove_response &resp);
+    /// The check and the following write are done atomically:
+    /// the write is applied only if the check passes.
+    /// \returns 0 if success, non-0 if failure.
+    /// A failed check is not a failure, it's reported to the user by `resp.error`.
+    int check_and_set(int64_t decree,
+                      const dsn::apps::check_and_set_request &update,
+                      dsn::apps::check_and_set_response &resp);
+
+    int check_and_mutate(int64_t decree,
+                         const dsn::apps::check_and_mutate_request &update,
+                         dsn::apps::check_and_mutate_response &resp);
 
     /// Prepare for batch write.
     void batch_prepare();
@@ -46,8 +56,18 @@ public:
     /// the batch is not committed.
     void batch_put(const dsn::apps::update_request &update, dsn::apps::update_response &resp);
 
+    void batch_multi_put(const dsn::apps::multi_put_request &update,
+                         dsn::apps::update_response &resp);
+
     void batch_remove(const dsn::blob &key, dsn::apps::update_response &resp);
 
+    void batch_multi_remove(const dsn::apps::multi_remove_request &update,
+                            dsn::apps::multi_remove_response &resp);
+
+    /// The increment is applied on the latest value of the key, including
+    /// the updates staged earlier in the same batch.
+    void batch_incr(const dsn::apps::incr_request &update, dsn::apps::incr_response &resp);
+
     /// \returns 0 if success, non-0 if failure.
     /// If the batch contains no updates, 0 is returned.
     int batch_commit(int64_t decree);
@@ -69,11 +89,19 @@ private:
     ::dsn::perf_counter_wrapper _pfc_multi_put_qps;
     ::dsn::perf_counter_wrapper _pfc_remove_qps;
     ::dsn::perf_counter_wrapper _pfc_multi_remove_qps;
+    ::dsn::perf_counter_wrapper _pfc_del_range_qps;
+    ::dsn::perf_counter_wrapper _pfc_incr_qps;
+    ::dsn::perf_counter_wrapper _pfc_check_and_set_qps;
+    ::dsn::perf_counter_wrapper _pfc_check_and_mutate_qps;
 
     ::dsn::perf_counter_wrapper _pfc_put_latency;
     ::dsn::perf_counter_wrapper _pfc_multi_put_latency;
     ::dsn::perf_counter_wrapper _pfc_remove_latency;
     ::dsn::perf_counter_wrapper _pfc_multi_remove_latency;
+    ::dsn::perf_counter_wrapper _pfc_del_range_latency;
+    ::dsn::perf_counter_wrapper _pfc_incr_latency;
+    ::dsn::perf_counter_wrapper _pfc_check_and_set_latency;
+    ::dsn::perf_counter_wrapper _pfc_check_and_mutate_latency;
 
     std::vector<::dsn::perf_counter *> _batch_perfcounters;
 };
@@ -4,22 +4,18 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "pegasus_write_service.h"
 #include "pegasus_server_impl.h"
 #include "logging_utils.h"
 
+#include "base/pegasus_arena.h"
 #include "base/pegasus_key_schema.h"
 
 namespace pegasus {
 namespace server {
 
-static inline dsn::blob composite_raw_key(dsn::string_view hash_key, dsn::string_view sort_key)
-{
-    dsn::blob raw_key;
-    pegasus_generate_key(raw_key, hash_key, sort_key);
-    return raw_key;
-}
-
 class pegasus_write_service::impl : public dsn::replication::replica_base
 {
 public:
@@ -27,14 +23,27 @@ public:
         : replica_base(*server),
           _primary_address(server->_primary_address),
           _value_schema_version(server->_value_schema_version),
+          _batch_updates_built(false),
           _db(server->_db),
           _wt_opts(&server->_wt_opts),
-          _rd_opts(&server->_rd_opts)
+          _server(server),
+          _row_cache(&server->_row_cache),
+          _row_cache_dirty_all(false),
+          _may_have_ttl_records(&server->_may_have_ttl_records),
+          _blob_store(server->_blob_store.get()),
+          _blob_value_threshold(0),
+          _blob_appended(false),
+          _batch_error(0)
     {
+        _value_generator.set_compression_threshold(server->_value_compression_threshold);
+        // the blob index is only supported since value schema v2
+        if (_value_schema_version >= 2) {
+            _blob_value_threshold = server->_blob_value_threshold;
+        }
     }
 
-    void multi_put(int64_t decree,
-                   const dsn::apps::multi_put_request &update,
+    void del_range(int64_t decree,
+                   const dsn::apps::del_range_request &update,
                    dsn::apps::update_response &resp)
     {
         resp.app_id = get_gpid().get_app_id();
@@ -42,59 +51,261 @@ public:
         resp.decree = decree;
         resp.server = _primary_address;
 
-        if (update.kvs.empty()) {
-            // invalid argument
-            derror_replica("invalid argument for multi_put: decree = {}, error = empty kvs",
-                           decree);
+        // rocksdb range deletion is on [begin, end), the successor of a key is
+        // generated by appending a zero byte to the sort key.
+        dsn::blob begin_key;
+        if (update.start_inclusive) {
+            pegasus_generate_key(begin_key, update.hash_key, update.start_sort_key);
+        } else {
+            pegasus_generate_key(
+                begin_key, update.hash_key.to_string(), update.start_sort_key.to_string() + '\0');
+        }
+        dsn::blob end_key;
+        if (update.stop_sort_key.length() == 0) {
+            pegasus_generate_next_blob(end_key, update.hash_key);
+        } else if (update.stop_inclusive) {
+            pegasus_generate_key(
+                end_key, update.hash_key.to_string(), update.stop_sort_key.to_string() + '\0');
+        } else {
+            pegasus_generate_key(end_key, update.hash_key, update.stop_sort_key);
+        }
 
-            // an invalid operation shouldn't be added to latency calculation
-            resp.error = rocksdb::Status::kInvalidArgument;
+        rocksdb::Slice begin = utils::to_rocksdb_slice(begin_key);
+        rocksdb::Slice end = utils::to_rocksdb_slice(end_key);
+        if (begin.compare(end) >= 0) {
+            // empty range, write empty record to update rocksdb's last flushed decree
+            resp.error = empty_put(decree);
             return;
         }
 
-        for (auto &kv : update.kvs) {
-            resp.error = db_write_batch_put(composite_raw_key(update.hash_key, kv.key),
-                                            kv.value,
-                                            static_cast<uint32_t>(update.expire_ts_seconds));
-            if (resp.error != 0) {
-                return;
+        _batch.DeleteRange(begin, end);
+        if (_row_cache->enabled()) {
+            // the deleted keys are unknown, so drop all the cached records of this replica
+            _row_cache_dirty_all = true;
+        }
+        resp.error = db_write(decree);
+    }
+
+    int check_and_set(int64_t decree,
+                      const dsn::apps::check_and_set_request &update,
+                      dsn::apps::check_and_set_response &resp)
+    {
+        resp.app_id = get_gpid().get_app_id();
+        resp.partition_index = get_gpid().get_partition_index();
+        resp.decree = decree;
+        resp.server = _primary_address;
+
+        if (!is_check_type_supported(update.check_type)) {
+            derror_replica("invalid argument for check_and_set: decree = {}, error = "
+                           "check type {} not supported",
+                           decree,
+                           update.check_type);
+            resp.error = rocksdb::Status::kInvalidArgument;
+            // we should write empty record to update rocksdb's last flushed decree
+            return empty_put(decree);
+        }
+
+        dsn::blob check_key;
+        pegasus_generate_key(check_key, update.hash_key, update.check_sort_key);
+        bool value_exist = false;
+        dsn::blob check_value;
+        resp.error = db_get_check_value(check_key, value_exist, check_value);
+        if (resp.error != 0) {
+            return resp.error;
+        }
+
+        if (update.return_check_value) {
+            resp.check_value_returned = true;
+            if (value_exist) {
+                resp.check_value_exist = true;
+                resp.check_value = check_value;
             }
         }
 
+        bool invalid_argument = false;
+        bool passed = validate_check(
+            update.check_type, update.check_operand, value_exist, check_value, invalid_argument);
+
+        if (passed) {
+            // check passed, write new value
+            dsn::string_view set_key =
+                update.set_diff_sort_key
+                    ? composite_raw_key(update.hash_key, update.set_sort_key)
+                    : dsn::string_view(check_key.data(), check_key.length());
+            resp.error = db_write_batch_put(
+                set_key, update.set_value, static_cast<uint32_t>(update.set_expire_ts_seconds));
+        } else {
+            // check not passed, write empty record to update rocksdb's last flushed decree
+            resp.error = db_write_batch_put("", "", 0);
+        }
+        if (resp.error != 0) {
+            db_clear_batch();
+            return resp.error;
+        }
+
         resp.error = db_write(decree);
+        if (resp.error != 0) {
+            return resp.error;
+        }
+
+        if (!passed) {
+            // check not passed, return proper error code to user
+            resp.error =
+                invalid_argument ? rocksdb::Status::kInvalidArgument : rocksdb::Status::kTryAgain;
+        }
+        return 0;
     }
 
-    void multi_remove(int64_t decree,
-                      const dsn::apps::multi_remove_request &update,
-                      dsn::apps::multi_remove_response &resp)
+    int check_and_mutate(int64_t decree,
+                         const dsn::apps::check_and_mutate_request &update,
+                         dsn::apps::check_and_mutate_response &resp)
     {
         resp.app_id = get_gpid().get_app_id();
         resp.partition_index = get_gpid().get_partition_index();
         resp.decree = decree;
         resp.server = _primary_address;
 
-        if (update.sort_keys.empty()) {
-            // invalid argument
+        if (update.mutate_list.empty()) {
             derror_replica(
-                "invalid argument for multi_remove: decree = {}, error = empty sort keys", decree);
+                "invalid argument for check_and_mutate: decree = {}, error = empty mutate list",
+                decree);
+            resp.error = rocksdb::Status::kInvalidArgument;
+            // we should write empty record to update rocksdb's last flushed decree
+            return empty_put(decree);
+        }
+
+        for (int i = 0; i < update.mutate_list.size(); ++i) {
+            auto &mu = update.mutate_list[i];
+            if (mu.operation != dsn::apps::mutate_operation::MO_PUT &&
+                mu.operation != dsn::apps::mutate_operation::MO_DELETE) {
+                derror_replica("invalid argument for check_and_mutate: decree = {}, error = "
+                               "mutation[{}] uses invalid operation {}",
+                               decree,
+                               i,
+                               mu.operation);
+                resp.error = rocksdb::Status::kInvalidArgument;
+                // we should write empty record to update rocksdb's last flushed decree
+                return empty_put(decree);
+            }
+        }
 
-            // an invalid operation shouldn't be added to latency calculation
+        if (!is_check_type_supported(update.check_type)) {
+            derror_replica("invalid argument for check_and_mutate: decree = {}, error = "
+                           "check type {} not supported",
+                           decree,
+                           update.check_type);
             resp.error = rocksdb::Status::kInvalidArgument;
-            resp.count = 0;
-            return;
+            // we should write empty record to update rocksdb's last flushed decree
+            return empty_put(decree);
         }
 
-        for (auto &sort_key : update.sort_keys) {
-            // TODO(wutao1): check returned error
-            db_write_batch_delete(composite_raw_key(update.hash_key, sort_key));
+        dsn::blob check_key;
+        pegasus_generate_key(check_key, update.hash_key, update.check_sort_key);
+        bool value_exist = false;
+        dsn::blob check_value;
+        resp.error = db_get_check_value(check_key, value_exist, check_value);
+        if (resp.error != 0) {
+            return resp.error;
+        }
+
+        if (update.return_check_value) {
+            resp.check_value_returned = true;
+            if (value_exist) {
+                resp.check_value_exist = true;
+                resp.check_value = check_value;
+            }
+        }
+
+        bool invalid_argument = false;
+        bool passed = validate_check(
+            update.check_type, update.check_operand, value_exist, check_value, invalid_argument);
+
+        if (passed) {
+            // check passed, apply all the mutations in one write batch
+            for (auto &mu : update.mutate_list) {
+                dsn::string_view key = composite_raw_key(update.hash_key, mu.sort_key);
+                if (mu.operation == dsn::apps::mutate_operation::MO_PUT) {
+                    resp.error = db_write_batch_put(
+                        key, mu.value, static_cast<uint32_t>(mu.set_expire_ts_seconds));
+                } else {
+                    resp.error = db_write_batch_delete(key);
+                }
+                if (resp.error != 0) {
+                    break;
+                }
+            }
+        } else {
+            // check not passed, write empty record to update rocksdb's last flushed decree
+            resp.error = db_write_batch_put("", "", 0);
+        }
+        if (resp.error != 0) {
+            db_clear_batch();
+            return resp.error;
         }
 
         resp.error = db_write(decree);
         if (resp.error != 0) {
+            return resp.error;
+        }
+
+        if (!passed) {
+            // check not passed, return proper error code to user
+            resp.error =
+                invalid_argument ? rocksdb::Status::kInvalidArgument : rocksdb::Status::kTryAgain;
+        }
+        return 0;
+    }
+
+    void batch_multi_put(const dsn::apps::multi_put_request &update,
+                         dsn::apps::update_response &resp)
+    {
+        _update_responses.emplace_back(&resp);
+
+        if (update.kvs.empty()) {
+            // invalid argument
+            derror_replica("invalid argument for multi_put: error = empty kvs");
+            resp.error = rocksdb::Status::kInvalidArgument;
+            return;
+        }
+
+        // the puts of a multi_put are all or none in the batch. the save points are dropped
+        // when the batch is cleared.
+        _batch.SetSavePoint();
+        for (auto &kv : update.kvs) {
+            resp.error = db_write_batch_put(composite_raw_key(update.hash_key, kv.key),
+                                            kv.value,
+                                            static_cast<uint32_t>(update.expire_ts_seconds));
+            if (resp.error != 0) {
+                _batch.RollbackToSavePoint();
+                // the index of the batch may refer to the rolled back puts, rebuild it if needed
+                _batch_updates.clear();
+                _batch_updates_built = false;
+                return;
+            }
+        }
+    }
+
+    void batch_multi_remove(const dsn::apps::multi_remove_request &update,
+                            dsn::apps::multi_remove_response &resp)
+    {
+        _multi_remove_responses.emplace_back(&resp);
+
+        if (update.sort_keys.empty()) {
+            // invalid argument
+            derror_replica("invalid argument for multi_remove: error = empty sort keys");
+            resp.error = rocksdb::Status::kInvalidArgument;
             resp.count = 0;
-        } else {
-            resp.count = update.sort_keys.size();
+            return;
         }
+
+        for (auto &sort_key : update.sort_keys) {
+            resp.error = db_write_batch_delete(composite_raw_key(update.hash_key, sort_key));
+            if (resp.error != 0) {
+                resp.count = 0;
+                return;
+            }
+        }
+        resp.count = update.sort_keys.size();
     }
 
     inline void batch_put(const dsn::apps::update_request &update, dsn::apps::update_response &resp)
@@ -110,55 +321,431 @@ public:
         _update_responses.emplace_back(&resp);
     }
 
+    // An incr is a read-modify-write on the current value of the key. The updates staged
+    // in the pending batch are visible to it, so that several incrs on the same key within
+    // one batch are applied one after another.
+    void batch_incr(const dsn::apps::incr_request &update, dsn::apps::incr_response &resp)
+    {
+        _incr_responses.emplace_back(&resp);
+        resp.new_value = 0;
+
+        uint32_t epoch_now = utils::epoch_now();
+        uint32_t expire_ts = 0;
+        int64_t old_value = 0;
+
+        std::string raw_value;
+        rocksdb::Status status;
+        if (!db_get_in_batch(update.key, raw_value, status)) {
+            status = _db->Get(
+                _server->read_options(), utils::to_rocksdb_slice(update.key), &raw_value);
+        }
+        if (!status.ok() && !status.IsNotFound()) {
+            derror_rocksdb("get for incr", status.ToString(), "key: {}", update.key.to_string());
+            resp.error = status.code();
+            _batch_error = resp.error;
+            return;
+        }
+
+        if (status.ok()) {
+            expire_ts = pegasus_extract_expire_ts(_value_schema_version, raw_value);
+            if (check_if_record_expired(epoch_now, expire_ts)) {
+                // an expired record is regarded as not existing
+                expire_ts = 0;
+            } else {
+                dsn::blob user_data;
+                status = _blob_store->extract_user_data(
+                    _value_schema_version, dsn::string_view(raw_value), user_data);
+                if (!status.ok()) {
+                    derror_rocksdb(
+                        "read blob for incr", status.ToString(), "key: {}", update.key.to_string());
+                    resp.error = status.code();
+                    _batch_error = resp.error;
+                    return;
+                }
+                if (user_data.length() > 0 &&
+                    !utils::buf2int64(user_data.data(), user_data.length(), old_value)) {
+                    derror_replica("incr failed: old value \"{}\" is not an integer",
+                                   utils::c_escape_string(user_data));
+                    resp.error = rocksdb::Status::kInvalidArgument;
+                    return;
+                }
+            }
+        }
+
+        int64_t new_value = 0;
+        if (__builtin_add_overflow(old_value, update.increment, &new_value)) {
+            derror_replica("incr failed: old value {} plus increment {} overflows",
+                           old_value,
+                           update.increment);
+            resp.error = rocksdb::Status::kInvalidArgument;
+            return;
+        }
+
+        std::string new_data = std::to_string(new_value);
+        resp.error = db_write_batch_put(update.key, new_data, expire_ts);
+        resp.new_value = new_value;
+    }
+
     int batch_commit(int64_t decree)
     {
         int err = db_write(decree);
 
-        dsn::apps::update_response resp;
+        // The errors of the invalid requests in the batch are already set,
+        // they are kept unless the whole batch fails.
+        for (dsn::apps::update_response *uresp : _update_responses) {
+            fill_batch_response(*uresp, decree, err);
+        }
+        _update_responses.clear();
+
+        for (dsn::apps::multi_remove_response *mresp : _multi_remove_responses) {
+            fill_batch_response(*mresp, decree, err);
+            if (mresp->error != 0) {
+                mresp->count = 0;
+            }
+        }
+        _multi_remove_responses.clear();
+
+        for (dsn::apps::incr_response *iresp : _incr_responses) {
+            fill_batch_response(*iresp, decree, err);
+            if (iresp->error != 0) {
+                iresp->new_value = 0;
+            }
+        }
+        _incr_responses.clear();
+        return err;
+    }
+
+    template <typename TResponse>
+    void fill_batch_response(TResponse &resp, int64_t decree, int err)
+    {
         resp.app_id = get_gpid().get_app_id();
         resp.partition_index = get_gpid().get_partition_index();
         resp.decree = decree;
         resp.server = _primary_address;
-
-        for (dsn::apps::update_response *uresp : _update_responses) {
-            *uresp = resp;
+        if (err != 0) {
+            resp.error = err;
         }
-        _update_responses.clear();
-        return err;
+    }
+
+    // Write empty record to update rocksdb's last flushed decree, used when
+    // a write request changes nothing.
+    int empty_put(int64_t decree)
+    {
+        db_write_batch_put("", "", 0);
+        return db_write(decree);
+    }
+
+    // generate the rocksdb key in the arena of the pending batch, so that no heap allocation
+    // happens for each key. the key is valid until the batch is committed or cleared.
+    dsn::string_view composite_raw_key(dsn::string_view hash_key, dsn::string_view sort_key)
+    {
+        return pegasus_generate_key(_arena, hash_key, sort_key);
     }
 
     int db_write_batch_put(dsn::string_view raw_key, dsn::string_view value, uint32_t expire_sec)
     {
         rocksdb::Slice skey = utils::to_rocksdb_slice(raw_key);
         rocksdb::SliceParts skey_parts(&skey, 1);
-        rocksdb::SliceParts svalue =
-            _value_generator.generate_value(_value_schema_version, value, expire_sec);
+        rocksdb::SliceParts svalue;
+        if (_blob_value_threshold > 0 && value.length() >= _blob_value_threshold) {
+            // separate the large value into the blob file, only the blob index of it is put
+            // into rocksdb
+            dsn::string_view data = value;
+            value_compression_type type = _value_generator.compress_user_data(data);
+            pegasus_blob_index index;
+            rocksdb::Status status = _blob_store->append(raw_key, data, expire_sec, index);
+            if (!status.ok()) {
+                derror_rocksdb(
+                    "append blob", status.ToString(), "key: {}", utils::c_escape_string(raw_key));
+                _batch_error = status.code();
+                return _batch_error;
+            }
+            index.user_data_length = static_cast<uint32_t>(value.length());
+            svalue = _value_generator.generate_blob_index_value(expire_sec, type, index);
+            _blob_appended = true;
+        } else {
+            svalue = _value_generator.generate_value(_value_schema_version, value, expire_sec);
+        }
         _batch.Put(skey_parts, svalue);
+        if (_batch_updates_built) {
+            batch_update &u = _batch_updates[std::string(raw_key.data(), raw_key.length())];
+            u.deleted = false;
+            u.raw_value.clear();
+            for (int i = 0; i < svalue.num_parts; i++) {
+                u.raw_value.append(svalue.parts[i].data(), svalue.parts[i].size());
+            }
+        }
+        if (expire_sec > 0 && !_may_have_ttl_records->load(std::memory_order_relaxed)) {
+            _may_have_ttl_records->store(true);
+        }
+        if (_row_cache->enabled()) {
+            _row_cache_dirty_keys.emplace_back(_arena.copy(raw_key));
+        }
         return 0;
     }
 
     int db_write_batch_delete(dsn::string_view raw_key)
     {
         _batch.Delete(utils::to_rocksdb_slice(raw_key));
+        if (_batch_updates_built) {
+            batch_update &u = _batch_updates[std::string(raw_key.data(), raw_key.length())];
+            u.deleted = true;
+            u.raw_value.clear();
+        }
+        if (_row_cache->enabled()) {
+            _row_cache_dirty_keys.emplace_back(_arena.copy(raw_key));
+        }
         return 0;
     }
 
+    // Look up the latest update of `raw_key` staged in the pending write batch.
+    // Returns false if the key is not touched by the batch, then the caller should read the db.
+    // Otherwise `status` is OK with `raw_value` set if the last update is a put, or NotFound
+    // if the last update is a delete.
+    // The updates of the batch are indexed by the first lookup, and the index is maintained by
+    // the following writes of the batch, so that n incrs in a batch cost O(n).
+    bool db_get_in_batch(dsn::string_view raw_key, std::string &raw_value, rocksdb::Status &status)
+    {
+        struct batch_indexer : public rocksdb::WriteBatch::Handler
+        {
+            std::unordered_map<std::string, batch_update> *updates;
+
+            rocksdb::Status PutCF(uint32_t, const rocksdb::Slice &k, const rocksdb::Slice &v)
+                override
+            {
+                batch_update &u = (*updates)[k.ToString()];
+                u.deleted = false;
+                u.raw_value.assign(v.data(), v.size());
+                return rocksdb::Status::OK();
+            }
+
+            rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice &k) override
+            {
+                batch_update &u = (*updates)[k.ToString()];
+                u.deleted = true;
+                u.raw_value.clear();
+                return rocksdb::Status::OK();
+            }
+        };
+
+        if (_batch.Count() == 0) {
+            return false;
+        }
+
+        if (!_batch_updates_built) {
+            batch_indexer indexer;
+            indexer.updates = &_batch_updates;
+            status = _batch.Iterate(&indexer);
+            if (!status.ok()) {
+                // a corrupted batch, report it to the caller as a read error
+                _batch_updates.clear();
+                return true;
+            }
+            _batch_updates_built = true;
+        }
+
+        auto iter = _batch_updates.find(std::string(raw_key.data(), raw_key.length()));
+        if (iter == _batch_updates.end()) {
+            return false;
+        }
+        if (iter->second.deleted) {
+            status = rocksdb::Status::NotFound();
+        } else {
+            raw_value = iter->second.raw_value;
+        }
+        return true;
+    }
+
+    // Read the value to be checked by check_and_set/check_and_mutate.
+    // An expired record is regarded as not existing.
+    int db_get_check_value(const dsn::blob &check_key, bool &value_exist, dsn::blob &value)
+    {
+        std::string raw_value;
+        rocksdb::Status status =
+            _db->Get(_server->read_options(), utils::to_rocksdb_slice(check_key), &raw_value);
+        if (status.ok()) {
+            if (check_if_record_expired(_value_schema_version, utils::epoch_now(), raw_value)) {
+                value_exist = false;
+                return 0;
+            }
+            status = _blob_store->extract_user_data(
+                _value_schema_version, std::move(raw_value), value);
+            if (status.ok()) {
+                value_exist = true;
+                return 0;
+            }
+        }
+        value_exist = false;
+        if (status.IsNotFound()) {
+            return 0;
+        }
+        derror_rocksdb("get for check", status.ToString(), "key: {}", check_key.to_string());
+        return status.code();
+    }
+
+    static bool is_check_type_supported(dsn::apps::cas_check_type::type check_type)
+    {
+        return check_type >= dsn::apps::cas_check_type::CT_NO_CHECK &&
+               check_type <= dsn::apps::cas_check_type::CT_VALUE_INT_GREATER;
+    }
+
+    // \return true if the check passed.
+    // `invalid_argument` is set to true if the check can not be done, e.g. the check type
+    // is int compare but the value or the operand is not an integer.
+    static bool validate_check(dsn::apps::cas_check_type::type check_type,
+                               const dsn::blob &check_operand,
+                               bool value_exist,
+                               const dsn::blob &value,
+                               bool &invalid_argument)
+    {
+        invalid_argument = false;
+        switch (check_type) {
+        case dsn::apps::cas_check_type::CT_NO_CHECK:
+            return true;
+        case dsn::apps::cas_check_type::CT_VALUE_NOT_EXIST:
+            return !value_exist;
+        case dsn::apps::cas_check_type::CT_VALUE_NOT_EXIST_OR_EMPTY:
+            return !value_exist || value.length() == 0;
+        case dsn::apps::cas_check_type::CT_VALUE_EXIST:
+            return value_exist;
+        case dsn::apps::cas_check_type::CT_VALUE_NOT_EMPTY:
+            return value_exist && value.length() != 0;
+        case dsn::apps::cas_check_type::CT_VALUE_MATCH_ANYWHERE:
+        case dsn::apps::cas_check_type::CT_VALUE_MATCH_PREFIX:
+        case dsn::apps::cas_check_type::CT_VALUE_MATCH_POSTFIX: {
+            if (!value_exist) {
+                return false;
+            }
+            if (check_operand.length() == 0) {
+                return true;
+            }
+            if (value.length() < check_operand.length()) {
+                return false;
+            }
+            if (check_type == dsn::apps::cas_check_type::CT_VALUE_MATCH_ANYWHERE) {
+                return std::search(value.data(),
+                                   value.data() + value.length(),
+                                   check_operand.data(),
+                                   check_operand.data() + check_operand.length()) !=
+                       value.data() + value.length();
+            } else if (check_type == dsn::apps::cas_check_type::CT_VALUE_MATCH_PREFIX) {
+                return ::memcmp(value.data(), check_operand.data(), check_operand.length()) == 0;
+            } else { // check_type == dsn::apps::cas_check_type::CT_VALUE_MATCH_POSTFIX
+                return ::memcmp(value.data() + value.length() - check_operand.length(),
+                                check_operand.data(),
+                                check_operand.length()) == 0;
+            }
+        }
+        case dsn::apps::cas_check_type::CT_VALUE_BYTES_LESS:
+        case dsn::apps::cas_check_type::CT_VALUE_BYTES_LESS_OR_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_BYTES_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_BYTES_GREATER_OR_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_BYTES_GREATER: {
+            if (!value_exist) {
+                return false;
+            }
+            int c = utils::to_rocksdb_slice(value).compare(utils::to_rocksdb_slice(check_operand));
+            if (c < 0) {
+                return check_type <= dsn::apps::cas_check_type::CT_VALUE_BYTES_LESS_OR_EQUAL;
+            } else if (c == 0) {
+                return check_type >= dsn::apps::cas_check_type::CT_VALUE_BYTES_LESS_OR_EQUAL &&
+                       check_type <= dsn::apps::cas_check_type::CT_VALUE_BYTES_GREATER_OR_EQUAL;
+            } else { // c > 0
+                return check_type >= dsn::apps::cas_check_type::CT_VALUE_BYTES_GREATER_OR_EQUAL;
+            }
+        }
+        case dsn::apps::cas_check_type::CT_VALUE_INT_LESS:
+        case dsn::apps::cas_check_type::CT_VALUE_INT_LESS_OR_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_INT_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_INT_GREATER_OR_EQUAL:
+        case dsn::apps::cas_check_type::CT_VALUE_INT_GREATER: {
+            if (!value_exist) {
+                return false;
+            }
+            int64_t check_value_int = 0;
+            int64_t check_operand_int = 0;
+            if (value.length() == 0 || check_operand.length() == 0 ||
+                !utils::buf2int64(value.data(), value.length(), check_value_int) ||
+                !utils::buf2int64(
+                    check_operand.data(), check_operand.length(), check_operand_int)) {
+                invalid_argument = true;
+                return false;
+            }
+            if (check_value_int < check_operand_int) {
+                return check_type <= dsn::apps::cas_check_type::CT_VALUE_INT_LESS_OR_EQUAL;
+            } else if (check_value_int == check_operand_int) {
+                return check_type >= dsn::apps::cas_check_type::CT_VALUE_INT_LESS_OR_EQUAL &&
+                       check_type <= dsn::apps::cas_check_type::CT_VALUE_INT_GREATER_OR_EQUAL;
+            } else { // check_value_int > check_operand_int
+                return check_type >= dsn::apps::cas_check_type::CT_VALUE_INT_GREATER_OR_EQUAL;
+            }
+        }
+        default:
+            dassert(false, "unsupported check type: %d", check_type);
+        }
+        return false;
+    }
+
     // Apply the write batch into rocksdb.
     int db_write(int64_t decree)
     {
+        if (_batch_error != 0) {
+            // an I/O error of the blob store may not happen on the other replicas, so it fails
+            // the whole batch as a failed write of rocksdb, rather than the request only
+            derror_replica("abort the batch for the failure of blob store: decree = {}, "
+                           "error = {}",
+                           decree,
+                           _batch_error);
+            int err = _batch_error;
+            if (_blob_appended) {
+                // the blobs appended are not referred, which are garbage collected
+                _blob_store->commit(decree);
+                _blob_appended = false;
+            }
+            db_clear_batch();
+            return err;
+        }
+
         if (_batch.Count() == 0) {
-            return 0;
+            // all requests of the batch are invalid and change nothing, write empty record to
+            // update rocksdb's last flushed decree
+            db_write_batch_put("", "", 0);
         }
 
         _wt_opts->given_decree = static_cast<uint64_t>(decree);
+        bool row_cache_enabled = _row_cache->enabled();
+        if (row_cache_enabled) {
+            _row_cache->write_begin();
+        }
         auto status = _db->Write(*_wt_opts, &_batch);
         if (!status.ok()) {
             derror_rocksdb("write", status.ToString(), "decree: {}", decree);
         }
-        _batch.Clear();
+        if (_blob_appended) {
+            // the blobs appended are not referred if the write failed, which are garbage
+            // collected as well
+            _blob_store->commit(decree);
+            _blob_appended = false;
+        }
+        if (row_cache_enabled) {
+            // the written keys are invalidated even if the write failed, which is harmless
+            _row_cache->write_end(_row_cache_dirty_keys, _row_cache_dirty_all);
+        }
+        db_clear_batch();
         return status.code();
     }
 
+    void db_clear_batch()
+    {
+        _batch.Clear();
+        _batch_error = 0;
+        _batch_updates.clear();
+        _batch_updates_built = false;
+        _row_cache_dirty_keys.clear();
+        _row_cache_dirty_all = false;
+        _arena.reset();
+    }
+
 private:
     friend class pegasus_write_service_test;
 
@@ -166,14 +753,44 @@ private:
     const int _value_schema_version;
 
     rocksdb::WriteBatch _batch;
+    // the memory of the keys of the pending batch, reset after the batch is committed
+    pegasus_arena _arena;
+    // the latest update of each key in the pending batch, only built once read by an incr
+    struct batch_update
+    {
+        bool deleted;
+        std::string raw_value;
+    };
+    std::unordered_map<std::string, batch_update> _batch_updates;
+    bool _batch_updates_built;
     rocksdb::DB *_db;
     rocksdb::WriteOptions *_wt_opts;
-    const rocksdb::ReadOptions *_rd_opts;
+    // the read options of the server are updated by the app envs
+    const pegasus_server_impl *_server;
 
     pegasus_value_generator _value_generator;
 
+    // the keys written by the pending batch, which are erased from the row cache
+    // after the batch is committed.
+    pegasus_row_cache *_row_cache;
+    std::vector<dsn::string_view> _row_cache_dirty_keys;
+    bool _row_cache_dirty_all;
+
+    // set before writing any record with TTL
+    std::atomic_bool *_may_have_ttl_records;
+
+    pegasus_blob_store *_blob_store;
+    // the values not smaller than this size are separated into the blob files, 0 if disabled
+    uint64_t _blob_value_threshold;
+    // set if any blob is appended by the pending batch
+    bool _blob_appended;
+    // the error of the blob store met by the pending batch, which fails the whole batch
+    int _batch_error;
+
     // for setting update_response.error after committed.
     std::vector<dsn::apps::update_response *> _update_responses;
+    std::vector<dsn::apps::multi_remove_response *> _multi_remove_responses;
+    std::vector<dsn::apps::incr_response *> _incr_responses;
 };
 
 } // namespace server
@@ -0,0 +1,54 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/hashkey_transform.h"
+#include "base/pegasus_key_schema.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+
+TEST(hashkey_transform, transform)
+{
+    server::HashkeyTransform transform;
+
+    struct test_case
+    {
+        std::string hash_key;
+        std::string sort_key;
+    } tests[] = {
+        {"", ""}, {"", "sort"}, {"hash", ""}, {"hash", "sort"}, {"h", "hash_sort"},
+    };
+
+    for (auto &t : tests) {
+        dsn::blob key;
+        pegasus_generate_key(key, t.hash_key, t.sort_key);
+        rocksdb::Slice skey(key.data(), key.length());
+        ASSERT_TRUE(transform.InDomain(skey));
+
+        dsn::blob prefix;
+        pegasus_generate_key(prefix, t.hash_key, std::string());
+        rocksdb::Slice expected(prefix.data(), prefix.length());
+        rocksdb::Slice actual = transform.Transform(skey);
+        ASSERT_EQ(expected, actual);
+        ASSERT_TRUE(transform.InRange(actual));
+        ASSERT_EQ(t.sort_key.empty(), transform.InRange(skey));
+    }
+}
+
+TEST(hashkey_transform, not_in_domain)
+{
+    server::HashkeyTransform transform;
+
+    ASSERT_FALSE(transform.InDomain(rocksdb::Slice()));
+    ASSERT_FALSE(transform.InDomain(rocksdb::Slice("\0", 1)));
+
+    // the adjacent next key of hash key "a\xff" is truncated to [0x00 0x02 'b']
+    dsn::blob next;
+    pegasus_generate_next_blob(next, std::string("a\xff"));
+    rocksdb::Slice snext(next.data(), next.length());
+    ASSERT_EQ(3, snext.size());
+    ASSERT_FALSE(transform.InDomain(snext));
+    ASSERT_FALSE(transform.InRange(snext));
+}
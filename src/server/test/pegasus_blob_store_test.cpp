@@ -0,0 +1,342 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_blob_store.h"
+#include "server/pegasus_table_properties_collector.h"
+
+#include <dsn/utility/filesystem.h>
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+using namespace pegasus::server;
+
+class blob_store_test : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        dsn::utils::filesystem::remove_path(_dir);
+        ASSERT_TRUE(dsn::utils::filesystem::create_directory(_dir));
+        _opts.file_delete_delay_seconds = 0;
+        reopen();
+    }
+
+    void TearDown() override
+    {
+        _store.reset();
+        dsn::utils::filesystem::remove_path(_dir);
+    }
+
+    void reopen()
+    {
+        _store.reset(new pegasus_blob_store("blob_store_test", _dir, _opts));
+        ASSERT_TRUE(_store->open().ok());
+    }
+
+    pegasus_blob_index append(const std::string &key, const std::string &data, uint32_t expire_ts)
+    {
+        pegasus_blob_index index;
+        EXPECT_TRUE(_store->append(key, data, expire_ts, index).ok());
+        index.user_data_length = data.size();
+        return index;
+    }
+
+    std::string read(const pegasus_blob_index &index)
+    {
+        dsn::blob data;
+        EXPECT_TRUE(_store->read(index, data).ok());
+        return data.to_string();
+    }
+
+    // the tables referring `bytes` of the blob file
+    static rocksdb::TablePropertiesCollection tables_referring(uint64_t file_number,
+                                                               uint64_t bytes)
+    {
+        auto props = std::make_shared<rocksdb::TableProperties>();
+        props->user_collected_properties[TABLE_PROPERTY_BLOB_REFS] =
+            std::to_string(file_number) + ":" + std::to_string(bytes);
+        return {{"1.sst", props}};
+    }
+
+protected:
+    const std::string _dir = "./blob_store_test";
+    pegasus_blob_store::options _opts;
+    std::unique_ptr<pegasus_blob_store> _store;
+};
+
+TEST_F(blob_store_test, append_and_read)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    pegasus_blob_index index2 = append("key2", std::string(10000, 'v'), 100);
+    ASSERT_EQ(index1.file_number, index2.file_number);
+    ASSERT_EQ(6, index1.size);
+    ASSERT_EQ("value1", read(index1));
+    ASSERT_EQ(std::string(10000, 'v'), read(index2));
+    ASSERT_EQ(1, _store->file_count());
+
+    // corrupted index
+    dsn::blob data;
+    pegasus_blob_index index = index1;
+    index.crc++;
+    ASSERT_TRUE(_store->read(index, data).IsCorruption());
+    index = index1;
+    index.file_number++;
+    ASSERT_TRUE(_store->read(index, data).IsCorruption());
+
+    // the sealed file is read after reopened
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    pegasus_blob_index index3 = append("key3", "value3", 0);
+    ASSERT_NE(index1.file_number, index3.file_number);
+    reopen();
+    ASSERT_EQ(2, _store->file_count());
+    ASSERT_EQ("value1", read(index1));
+    ASSERT_EQ(std::string(10000, 'v'), read(index2));
+    ASSERT_EQ("value3", read(index3));
+
+    // the file number is not reused
+    pegasus_blob_index index4 = append("key4", "value4", 0);
+    ASSERT_GT(index4.file_number, index3.file_number);
+}
+
+TEST_F(blob_store_test, extract_user_data)
+{
+    std::string user_data(1000, 'v');
+    pegasus_value_generator gen;
+    gen.set_compression_threshold(100);
+    dsn::string_view data = user_data;
+    value_compression_type type = gen.compress_user_data(data);
+    ASSERT_EQ(value_compression_type::snappy, type);
+
+    pegasus_blob_index index;
+    ASSERT_TRUE(_store->append("key", data, 0, index).ok());
+    index.user_data_length = user_data.size();
+    rocksdb::SliceParts sparts = gen.generate_blob_index_value(0, type, index);
+    std::string raw_value;
+    for (int i = 0; i < sparts.num_parts; i++) {
+        raw_value += sparts.parts[i].ToString();
+    }
+
+    dsn::blob extracted;
+    ASSERT_TRUE(_store->extract_user_data(2, dsn::string_view(raw_value), extracted).ok());
+    ASSERT_EQ(user_data, extracted.to_string());
+
+    // the values not separated
+    sparts = gen.generate_value(2, "value", 0);
+    raw_value.clear();
+    for (int i = 0; i < sparts.num_parts; i++) {
+        raw_value += sparts.parts[i].ToString();
+    }
+    ASSERT_TRUE(_store->extract_user_data(2, std::move(raw_value), extracted).ok());
+    ASSERT_EQ("value", extracted.to_string());
+}
+
+TEST_F(blob_store_test, gc_by_refs)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    _store->commit(10);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    pegasus_blob_index index2 = append("key2", "value2", 0);
+    _store->commit(20);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    ASSERT_EQ(2, _store->file_count());
+
+    rocksdb::TablePropertiesCollection tables = tables_referring(index2.file_number, 6);
+
+    // the records of the files may be in the memtables
+    _store->gc(tables, 5, 0);
+    _store->gc(tables, 5, 0);
+    ASSERT_EQ(2, _store->file_count());
+
+    // the file not referred is marked obsolete first, then deleted after the delay
+    _store->gc(tables, 20, 0);
+    ASSERT_EQ(2, _store->file_count());
+    _store->gc(tables, 20, 0);
+    ASSERT_EQ(1, _store->file_count());
+    ASSERT_EQ("value2", read(index2));
+    dsn::blob data;
+    ASSERT_TRUE(_store->read(index1, data).IsCorruption());
+
+    // the files are kept if the references are unknown
+    tables["2.sst"] = std::make_shared<rocksdb::TableProperties>();
+    tables.erase("1.sst");
+    _store->gc(tables, 20, 0);
+    _store->gc(tables, 20, 0);
+    ASSERT_EQ(1, _store->file_count());
+}
+
+TEST_F(blob_store_test, gc_by_ttl)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 100);
+    append("key2", "value2", 200);
+    _store->commit(10);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    pegasus_blob_index index2 = append("key3", "value3", 0);
+    _store->commit(20);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+
+    // the max expire_ts is kept in the footer
+    reopen();
+
+    // all the files are still referred, as the expired records are not compacted yet
+    rocksdb::TablePropertiesCollection tables = tables_referring(index1.file_number, 12);
+    tables["2.sst"] = tables_referring(index2.file_number, 6)["1.sst"];
+    _store->gc(tables, 20, 150);
+    _store->gc(tables, 20, 150);
+    ASSERT_EQ(2, _store->file_count());
+
+    // all the records of the first file are expired
+    _store->gc(tables, 20, 200);
+    _store->gc(tables, 20, 200);
+    ASSERT_EQ(1, _store->file_count());
+    ASSERT_EQ("value3", read(index2));
+}
+
+TEST_F(blob_store_test, gc_with_reader_pins)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    _store->commit(10);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    pegasus_blob_index index2 = append("key2", "value2", 0);
+    _store->commit(20);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    rocksdb::TablePropertiesCollection tables = tables_referring(index2.file_number, 6);
+
+    // the reader pinned before the first file is obsolete may still read it
+    std::unique_ptr<pegasus_blob_store::reader_pin> old_pin(
+        new pegasus_blob_store::reader_pin(_store.get()));
+    _store->gc(tables, 20, 0);
+    // the reader pinned after does not block the deletion
+    std::unique_ptr<pegasus_blob_store::reader_pin> new_pin(
+        new pegasus_blob_store::reader_pin(_store.get()));
+    _store->gc(tables, 20, 0);
+    _store->gc(tables, 20, 0);
+    ASSERT_EQ(2, _store->file_count());
+    ASSERT_EQ("value1", read(index1));
+
+    old_pin.reset();
+    _store->gc(tables, 20, 0);
+    ASSERT_EQ(1, _store->file_count());
+    ASSERT_EQ("value2", read(index2));
+
+    // the reader pinned rounds ago still blocks the deletion of the files obsolete later
+    pegasus_blob_index index3 = append("key3", "value3", 0);
+    _store->commit(30);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    tables = tables_referring(index3.file_number, 6);
+    for (int i = 0; i < 3; i++) {
+        _store->gc(tables, 30, 0);
+    }
+    ASSERT_EQ(2, _store->file_count());
+    ASSERT_EQ("value2", read(index2));
+
+    // the round is not advanced while the old reader is alive, so the file is obsolete in the
+    // round of the readers pinned after it, which is passed by the next gc
+    new_pin.reset();
+    _store->gc(tables, 30, 0);
+    _store->gc(tables, 30, 0);
+    ASSERT_EQ(1, _store->file_count());
+    ASSERT_EQ("value3", read(index3));
+}
+
+TEST_F(blob_store_test, relocation)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    append("key2", std::string(1000, 'v'), 0);
+    _store->commit(10);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+
+    // only key1 is alive
+    rocksdb::TablePropertiesCollection tables = tables_referring(index1.file_number, 6);
+    {
+        pegasus_blob_store::relocation relocation(_store.get());
+        ASSERT_FALSE(relocation.need_relocate(index1));
+    }
+    _store->gc(tables, 10, 0);
+
+    pegasus_blob_index new_index;
+    {
+        pegasus_blob_store::relocation relocation(_store.get());
+        ASSERT_TRUE(relocation.need_relocate(index1));
+        ASSERT_TRUE(relocation.relocate("key1", 0, index1, new_index).ok());
+    }
+    ASSERT_NE(index1.file_number, new_index.file_number);
+    ASSERT_EQ(index1.user_data_length, new_index.user_data_length);
+    ASSERT_EQ("value1", read(new_index));
+
+    // the old file is deleted once the compaction refers to the new one
+    tables = tables_referring(new_index.file_number, 6);
+    _store->gc(tables, 10, 0);
+    _store->gc(tables, 10, 0);
+    ASSERT_EQ(1, _store->file_count());
+    ASSERT_EQ("value1", read(new_index));
+}
+
+TEST_F(blob_store_test, link_files)
+{
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    ASSERT_TRUE(_store->seal_active_file().ok());
+    pegasus_blob_index index2 = append("key2", "value2", 0);
+
+    std::string checkpoint_dir = _dir + "/checkpoint";
+    ASSERT_TRUE(dsn::utils::filesystem::create_directory(checkpoint_dir));
+    ASSERT_TRUE(_store->link_files(checkpoint_dir).ok());
+
+    // only the sealed files are linked
+    ASSERT_TRUE(dsn::utils::filesystem::file_exists(
+        checkpoint_dir + "/" + pegasus_blob_file_name(index1.file_number)));
+    ASSERT_FALSE(dsn::utils::filesystem::file_exists(
+        checkpoint_dir + "/" + pegasus_blob_file_name(index2.file_number)));
+
+    pegasus_blob_store checkpoint_store("blob_store_test", checkpoint_dir, _opts);
+    ASSERT_TRUE(checkpoint_store.open().ok());
+    ASSERT_EQ(1, checkpoint_store.file_count());
+    dsn::blob data;
+    ASSERT_TRUE(checkpoint_store.read(index1, data).ok());
+    ASSERT_EQ("value1", data.to_string());
+}
+
+TEST_F(blob_store_test, checkpoint)
+{
+    _opts.file_size = 1024;
+    reopen();
+    std::string checkpoint_dir = _dir + "/checkpoint";
+    auto checkpoint = [&](int64_t decree) {
+        dsn::utils::filesystem::remove_path(checkpoint_dir);
+        ASSERT_TRUE(dsn::utils::filesystem::create_directory(checkpoint_dir));
+        ASSERT_TRUE(_store->checkpoint(checkpoint_dir, decree).ok());
+    };
+    auto in_checkpoint = [&](const pegasus_blob_index &index) {
+        return dsn::utils::filesystem::file_exists(checkpoint_dir + "/" +
+                                                   pegasus_blob_file_name(index.file_number));
+    };
+
+    // the active file written after the checkpoint is not added or sealed
+    pegasus_blob_index index1 = append("key1", "value1", 0);
+    _store->commit(10);
+    checkpoint(9);
+    ASSERT_FALSE(in_checkpoint(index1));
+
+    // the small active file is copied, and is still appended after
+    checkpoint(10);
+    ASSERT_TRUE(in_checkpoint(index1));
+    pegasus_blob_index index2 = append("key2", "value2", 0);
+    _store->commit(11);
+    ASSERT_EQ(index1.file_number, index2.file_number);
+    {
+        pegasus_blob_store checkpoint_store("blob_store_test", checkpoint_dir, _opts);
+        ASSERT_TRUE(checkpoint_store.open().ok());
+        dsn::blob data;
+        ASSERT_TRUE(checkpoint_store.read(index1, data).ok());
+        ASSERT_EQ("value1", data.to_string());
+        ASSERT_FALSE(checkpoint_store.read(index2, data).ok());
+    }
+
+    // the large active file is sealed and linked
+    pegasus_blob_index index3 = append("key3", std::string(_opts.file_size / 4, 'v'), 0);
+    _store->commit(12);
+    checkpoint(12);
+    ASSERT_TRUE(in_checkpoint(index3));
+    pegasus_blob_index index4 = append("key4", "value4", 0);
+    ASSERT_NE(index3.file_number, index4.file_number);
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "base/pegasus_crc64.h"
+#include "base/pegasus_key_schema.h"
+
+#include <gtest/gtest.h>
+#include <dsn/utility/crc.h>
+
+using namespace pegasus;
+
+typedef uint64_t (*crc64_func)(const void *, size_t, uint64_t);
+
+static void check_equal(crc64_func func, const char *data, size_t len, uint64_t init_crc)
+{
+    ASSERT_EQ(dsn::utils::crc64_calc(data, len, init_crc), func(data, len, init_crc))
+        << "len = " << len << ", init_crc = " << init_crc;
+}
+
+static std::vector<crc64_func> all_funcs()
+{
+    std::vector<crc64_func> funcs = {
+        utils::crc64_calc, utils::crc64_calc_bytewise, utils::crc64_calc_slicing8};
+    if (utils::crc64_clmul_supported()) {
+        funcs.push_back(utils::crc64_calc_clmul);
+    }
+    return funcs;
+}
+
+TEST(crc64, all_short_inputs)
+{
+    // every input of no more than 2 bytes
+    for (crc64_func func : all_funcs()) {
+        char buf[2];
+        check_equal(func, buf, 0, 0);
+        for (int i = 0; i < 256; i++) {
+            buf[0] = static_cast<char>(i);
+            check_equal(func, buf, 1, 0);
+            for (int j = 0; j < 256; j++) {
+                buf[1] = static_cast<char>(j);
+                check_equal(func, buf, 2, 0);
+            }
+        }
+    }
+}
+
+TEST(crc64, random_inputs)
+{
+    std::string data;
+    for (int i = 0; i < 4096 + 16; i++) {
+        data.push_back(static_cast<char>(dsn_random32(0, 255)));
+    }
+
+    // every length up to 4096 at every alignment in 16 bytes
+    for (crc64_func func : all_funcs()) {
+        for (size_t len = 0; len <= 4096; len++) {
+            for (size_t offset = 0; offset < 16; offset++) {
+                uint64_t init_crc = offset % 2 == 0 ? 0 : dsn_random64(0, UINT64_MAX);
+                check_equal(func, data.data() + offset, len, init_crc);
+            }
+        }
+    }
+}
+
+TEST(crc64, key_hash)
+{
+    dsn::blob key;
+    pegasus_generate_key(key, std::string("hash_key"), std::string("sort_key"));
+    ASSERT_EQ(dsn::utils::crc64_calc("hash_key", 8, 0), pegasus_key_hash(key));
+
+    pegasus_generate_key(key, std::string(""), std::string("sort_key"));
+    ASSERT_EQ(dsn::utils::crc64_calc("sort_key", 8, 0), pegasus_key_hash(key));
+}
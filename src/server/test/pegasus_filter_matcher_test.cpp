@@ -0,0 +1,87 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_filter_matcher.h"
+
+#include <algorithm>
+#include <random>
+#include <gtest/gtest.h>
+
+using namespace pegasus::server;
+using ::dsn::apps::filter_type;
+
+TEST(filter_matcher, no_filter)
+{
+    ASSERT_TRUE(pegasus_filter_matcher().no_filter());
+    ASSERT_TRUE(pegasus_filter_matcher().match("abc"));
+
+    // empty pattern matches everything
+    for (auto type : {filter_type::FT_MATCH_ANYWHERE,
+                      filter_type::FT_MATCH_PREFIX,
+                      filter_type::FT_MATCH_POSTFIX}) {
+        pegasus_filter_matcher m(type, "");
+        ASSERT_TRUE(m.no_filter());
+        ASSERT_TRUE(m.match(""));
+        ASSERT_TRUE(m.match("abc"));
+    }
+}
+
+TEST(filter_matcher, prefix_and_postfix)
+{
+    pegasus_filter_matcher prefix(filter_type::FT_MATCH_PREFIX, "ab");
+    ASSERT_TRUE(prefix.match("ab"));
+    ASSERT_TRUE(prefix.match("abc"));
+    ASSERT_FALSE(prefix.match("a"));
+    ASSERT_FALSE(prefix.match("cab"));
+
+    pegasus_filter_matcher postfix(filter_type::FT_MATCH_POSTFIX, "ab");
+    ASSERT_TRUE(postfix.match("ab"));
+    ASSERT_TRUE(postfix.match("cab"));
+    ASSERT_FALSE(postfix.match("b"));
+    ASSERT_FALSE(postfix.match("abc"));
+}
+
+TEST(filter_matcher, anywhere)
+{
+    pegasus_filter_matcher m(filter_type::FT_MATCH_ANYWHERE, "user");
+    ASSERT_TRUE(m.match("user"));
+    ASSERT_TRUE(m.match("user_0001"));
+    ASSERT_TRUE(m.match("0001_user"));
+    ASSERT_TRUE(m.match("prefix_of_a_long_key_user_and_a_long_postfix_0123456789"));
+    ASSERT_FALSE(m.match("use"));
+    ASSERT_FALSE(m.match("prefix_of_a_long_key_usr_and_a_long_postfix_0123456789"));
+
+    // the pattern is at the last candidate position of a long key
+    std::string key(100, 'u');
+    ASSERT_FALSE(m.match(key));
+    key.replace(key.size() - 4, 4, "user");
+    ASSERT_TRUE(m.match(key));
+
+    // binary data
+    std::string pattern("\0\xff", 2);
+    std::string data("abc\0\xff", 5);
+    ASSERT_TRUE(pegasus_filter_matcher(filter_type::FT_MATCH_ANYWHERE, pattern).match(data));
+}
+
+TEST(filter_matcher, anywhere_random)
+{
+    std::mt19937 rng(0);
+    for (int i = 0; i < 200000; i++) {
+        // small alphabets make partial matches frequent
+        int alphabet = 2 + rng() % 3;
+        std::string key(rng() % 80, 'a');
+        std::string pattern(1 + rng() % 8, 'a');
+        for (char &c : key) {
+            c = static_cast<char>('a' + rng() % alphabet);
+        }
+        for (char &c : pattern) {
+            c = static_cast<char>('a' + rng() % alphabet);
+        }
+
+        bool expected =
+            std::search(key.begin(), key.end(), pattern.begin(), pattern.end()) != key.end();
+        pegasus_filter_matcher m(filter_type::FT_MATCH_ANYWHERE, pattern);
+        ASSERT_EQ(expected, m.match(key)) << "key = " << key << ", pattern = " << pattern;
+    }
+}
@@ -0,0 +1,199 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "base/pegasus_key_schema.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+
+static std::string generate_key(const std::string &hash_key, const std::string &sort_key)
+{
+    ::dsn::blob key;
+    pegasus_generate_key(key, hash_key, sort_key);
+    return key.to_string();
+}
+
+static bool start_with(const std::string &s, const std::string &prefix)
+{
+    return s.compare(0, prefix.length(), prefix) == 0;
+}
+
+TEST(key_schema, hash_key_prefix_seek_key)
+{
+    std::string seek_key;
+
+    // in the range
+    std::string key = generate_key("abc", "x");
+    ASSERT_FALSE(pegasus_hash_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+
+    // hash key shorter than prefix
+    key = generate_key("a", "zzz");
+    ASSERT_TRUE(pegasus_hash_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(generate_key("ab", ""), seek_key);
+
+    // before the range of the same length
+    key = generate_key("aa", "");
+    ASSERT_TRUE(pegasus_hash_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(generate_key("ab", ""), seek_key);
+
+    // after the range of the same length
+    key = generate_key("ba", "");
+    ASSERT_TRUE(pegasus_hash_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(std::string("\x00\x03" "ab", 4), seek_key);
+}
+
+TEST(key_schema, hash_key_prefix_seek_key_random)
+{
+    // check that the seeking skips exactly the keys which do not match
+    std::mt19937 rng(0);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 2000; i++) {
+        std::string hash_key(rng() % 5, 'a');
+        for (char &c : hash_key) {
+            c = static_cast<char>('a' + rng() % 3);
+        }
+        keys.push_back(generate_key(hash_key, std::to_string(rng() % 3)));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    for (std::string prefix : {"a", "b", "ab", "cc", "abc"}) {
+        std::vector<std::string> expected, actual;
+        for (const std::string &key : keys) {
+            ::dsn::blob hash_key, sort_key;
+            pegasus_restore_key(::dsn::blob(key.data(), 0, key.size()), hash_key, sort_key);
+            if (start_with(hash_key.to_string(), prefix)) {
+                expected.push_back(key);
+            }
+        }
+
+        auto it = keys.begin();
+        std::string seek_key;
+        while (it != keys.end()) {
+            if (!pegasus_hash_key_prefix_seek_key(it->data(), it->size(), prefix, seek_key)) {
+                actual.push_back(*it);
+                ++it;
+            } else if (seek_key.empty()) {
+                break;
+            } else {
+                ASSERT_GT(seek_key, *it);
+                it = std::lower_bound(keys.begin(), keys.end(), seek_key);
+            }
+        }
+        ASSERT_EQ(expected, actual) << "prefix = " << prefix;
+    }
+}
+
+TEST(key_schema, sort_key_prefix_seek_key)
+{
+    std::string seek_key;
+
+    // in the range
+    std::string key = generate_key("h", "abc");
+    ASSERT_FALSE(pegasus_sort_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+
+    // before the range
+    key = generate_key("h", "a");
+    ASSERT_TRUE(pegasus_sort_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(generate_key("h", "ab"), seek_key);
+    key = generate_key("h", "");
+    ASSERT_TRUE(pegasus_sort_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(generate_key("h", "ab"), seek_key);
+
+    // after the range, seek to the next hash key
+    key = generate_key("h", "b");
+    ASSERT_TRUE(pegasus_sort_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(generate_key("i", ""), seek_key);
+    key = generate_key("h\xff", "b");
+    ASSERT_TRUE(pegasus_sort_key_prefix_seek_key(key.data(), key.size(), "ab", seek_key));
+    ASSERT_EQ(std::string("\x00\x02i", 3), seek_key);
+}
+
+TEST(key_schema, sort_key_prefix_seek_key_random)
+{
+    // check that the seeking skips exactly the keys which do not match
+    std::mt19937 rng(0);
+    std::vector<std::string> keys;
+    for (int i = 0; i < 2000; i++) {
+        std::string hash_key(rng() % 3, 'a');
+        std::string sort_key(rng() % 4, 'a');
+        for (char &c : hash_key) {
+            c = static_cast<char>(rng() % 2 == 0 ? 'a' : '\xff');
+        }
+        for (char &c : sort_key) {
+            c = static_cast<char>('a' + rng() % 3);
+        }
+        keys.push_back(generate_key(hash_key, sort_key));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    for (std::string prefix : {"a", "b", "ab", "cc", "abc"}) {
+        std::vector<std::string> expected, actual;
+        for (const std::string &key : keys) {
+            ::dsn::blob hash_key, sort_key;
+            pegasus_restore_key(::dsn::blob(key.data(), 0, key.size()), hash_key, sort_key);
+            if (start_with(sort_key.to_string(), prefix)) {
+                expected.push_back(key);
+            }
+        }
+
+        auto it = keys.begin();
+        std::string seek_key;
+        while (it != keys.end()) {
+            if (!pegasus_sort_key_prefix_seek_key(it->data(), it->size(), prefix, seek_key)) {
+                actual.push_back(*it);
+                ++it;
+            } else {
+                ASSERT_GT(seek_key, *it);
+                it = std::lower_bound(keys.begin(), keys.end(), seek_key);
+            }
+        }
+        ASSERT_EQ(expected, actual) << "prefix = " << prefix;
+    }
+}
+
+TEST(key_schema, generate_key_in_buffer)
+{
+    for (const auto &hash_key : {std::string(), std::string("h"), std::string(300, 'h')}) {
+        for (const auto &sort_key : {std::string(), std::string("s"), std::string(5000, 's')}) {
+            std::string buf(pegasus_key_length(hash_key, sort_key), '\0');
+            ASSERT_EQ(buf.size(), pegasus_generate_key(&buf[0], hash_key, sort_key));
+            ASSERT_EQ(generate_key(hash_key, sort_key), buf);
+        }
+    }
+}
+
+TEST(key_schema, generate_key_in_arena)
+{
+    pegasus_arena arena(64);
+    for (int round = 0; round < 3; round++) {
+        std::vector<dsn::string_view> keys;
+        for (int i = 0; i < 100; i++) {
+            // some of them are larger than the block
+            std::string sort_key(i % 10 == 0 ? 100 : i % 7, 's');
+            keys.push_back(pegasus_generate_key(arena, "h" + std::to_string(i), sort_key));
+        }
+        // the keys are valid until reset
+        for (int i = 0; i < 100; i++) {
+            std::string sort_key(i % 10 == 0 ? 100 : i % 7, 's');
+            ASSERT_EQ(generate_key("h" + std::to_string(i), sort_key),
+                      std::string(keys[i].data(), keys[i].length()));
+        }
+        size_t block_count = arena.block_count();
+        arena.reset();
+        if (round > 0) {
+            // the blocks are reused
+            ASSERT_EQ(block_count, arena.block_count());
+        }
+    }
+
+    ASSERT_EQ(0u, arena.copy(dsn::string_view()).length());
+    dsn::string_view copied = arena.copy("abc");
+    ASSERT_EQ("abc", std::string(copied.data(), copied.length()));
+}
@@ -0,0 +1,44 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_memtable_flush_picker.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus::server;
+
+TEST(memtable_flush_picker_test, should_flush)
+{
+    pegasus_memtable_flush_picker picker;
+    picker.update("1.0", 100);
+    picker.update("1.1", 300);
+    picker.update("1.2", 200);
+    picker.update("1.3", 50);
+
+    // only the largest memtable is flushed if it frees enough
+    ASSERT_TRUE(picker.should_flush("1.1", 300, 0));
+    ASSERT_FALSE(picker.should_flush("1.2", 300, 0));
+    ASSERT_FALSE(picker.should_flush("1.0", 300, 0));
+
+    // the next largest ones are flushed until enough is freed
+    ASSERT_TRUE(picker.should_flush("1.1", 450, 0));
+    ASSERT_TRUE(picker.should_flush("1.2", 450, 0));
+    ASSERT_FALSE(picker.should_flush("1.0", 450, 0));
+    ASSERT_FALSE(picker.should_flush("1.3", 450, 0));
+
+    // the small memtables are never flushed
+    ASSERT_FALSE(picker.should_flush("1.3", 1000, 60));
+    ASSERT_TRUE(picker.should_flush("1.0", 1000, 60));
+
+    // the ties are broken by the replica names, so only one of them is flushed
+    picker.update("1.0", 300);
+    ASSERT_TRUE(picker.should_flush("1.0", 300, 0));
+    ASSERT_FALSE(picker.should_flush("1.1", 300, 0));
+
+    // the removed replica and the unknown one are not flushed
+    picker.remove("1.0");
+    ASSERT_FALSE(picker.should_flush("1.0", 1000, 0));
+    ASSERT_TRUE(picker.should_flush("1.1", 300, 0));
+    ASSERT_FALSE(picker.should_flush("2.0", 1000, 0));
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_row_cache.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus::server;
+
+class pegasus_row_cache_test : public ::testing::Test
+{
+public:
+    void SetUp() override
+    {
+        _cache = rocksdb::NewLRUCache(1024 * 1024);
+        _row_cache.init(_cache, 16);
+    }
+
+    std::shared_ptr<rocksdb::Cache> _cache;
+    pegasus_row_cache _row_cache;
+};
+
+TEST_F(pegasus_row_cache_test, insert_and_lookup)
+{
+    uint32_t expire_ts = 0;
+    dsn::blob user_data;
+    ASSERT_FALSE(_row_cache.lookup("key", expire_ts, user_data));
+
+    _row_cache.insert(_row_cache.read_begin(), "key", 100, "value");
+    ASSERT_TRUE(_row_cache.lookup("key", expire_ts, user_data));
+    ASSERT_EQ(100, expire_ts);
+    ASSERT_EQ("value", user_data.to_string());
+
+    // values larger than max_value_size are not cached
+    _row_cache.insert(_row_cache.read_begin(), "large", 0, std::string(17, 'v'));
+    ASSERT_FALSE(_row_cache.lookup("large", expire_ts, user_data));
+
+    // the records of different replicas are isolated
+    pegasus_row_cache other;
+    other.init(_cache, 16);
+    ASSERT_FALSE(other.lookup("key", expire_ts, user_data));
+
+    _row_cache.clear();
+    ASSERT_FALSE(_row_cache.lookup("key", expire_ts, user_data));
+}
+
+TEST_F(pegasus_row_cache_test, invalidate_by_write)
+{
+    uint32_t expire_ts = 0;
+    dsn::blob user_data;
+    _row_cache.insert(_row_cache.read_begin(), "k1", 0, "v1");
+    _row_cache.insert(_row_cache.read_begin(), "k2", 0, "v2");
+
+    _row_cache.write_begin();
+    _row_cache.write_end({"k1"}, false);
+    ASSERT_FALSE(_row_cache.lookup("k1", expire_ts, user_data));
+    ASSERT_TRUE(_row_cache.lookup("k2", expire_ts, user_data));
+
+    _row_cache.write_begin();
+    _row_cache.write_end({}, true);
+    ASSERT_FALSE(_row_cache.lookup("k2", expire_ts, user_data));
+}
+
+TEST_F(pegasus_row_cache_test, concurrent_write)
+{
+    uint32_t expire_ts = 0;
+    dsn::blob user_data;
+
+    // the record read while a write is in progress is not cached
+    _row_cache.write_begin();
+    _row_cache.insert(_row_cache.read_begin(), "key", 0, "old");
+    ASSERT_FALSE(_row_cache.lookup("key", expire_ts, user_data));
+    _row_cache.write_end({"key"}, false);
+
+    // the record read before a write is not cached
+    uint64_t ticket = _row_cache.read_begin();
+    _row_cache.write_begin();
+    _row_cache.write_end({"key"}, false);
+    _row_cache.insert(ticket, "key", 0, "old");
+    ASSERT_FALSE(_row_cache.lookup("key", expire_ts, user_data));
+
+    _row_cache.insert(_row_cache.read_begin(), "key", 0, "new");
+    ASSERT_TRUE(_row_cache.lookup("key", expire_ts, user_data));
+    ASSERT_EQ("new", user_data.to_string());
+}
@@ -0,0 +1,178 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "base/pegasus_scan_aggregator.h"
+#include "base/pegasus_key_schema.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+
+struct test_row
+{
+    std::string key;
+    size_t value_size;
+};
+
+static std::vector<test_row> generate_rows(int hash_key_count)
+{
+    std::vector<test_row> rows;
+    for (int i = 0; i < hash_key_count; i++) {
+        std::string hash_key = "h" + std::to_string(i);
+        for (int j = 0; j <= i % 7; j++) {
+            ::dsn::blob key;
+            pegasus_generate_key(key, hash_key, "s" + std::to_string(j));
+            rows.push_back({key.to_string(), (size_t)(i * 13 + j * 31) % 101});
+        }
+    }
+    return rows;
+}
+
+static ::dsn::apps::scan_aggregate aggregate(const std::vector<test_row> &rows, int top_count)
+{
+    pegasus_scan_aggregator aggregator(top_count, false);
+    for (const auto &row : rows) {
+        aggregator.add_row(row.key, row.value_size);
+    }
+    ::dsn::apps::scan_aggregate result;
+    aggregator.finish(result);
+    return result;
+}
+
+// aggregate the rows in rpcs of the given sizes on the server, and merge them on the client
+static ::dsn::apps::scan_aggregate
+aggregate_in_rpcs(const std::vector<test_row> &rows, int top_count, const std::vector<int> &sizes)
+{
+    pegasus_scan_aggregator merger(top_count, false);
+    size_t begin = 0;
+    for (int i = 0; begin < rows.size(); i++) {
+        size_t end = std::min(rows.size(), begin + sizes[i % sizes.size()]);
+        pegasus_scan_aggregator aggregator(top_count, true);
+        for (size_t j = begin; j < end; j++) {
+            aggregator.add_row(rows[j].key, rows[j].value_size);
+        }
+        ::dsn::apps::scan_aggregate part;
+        aggregator.finish(part);
+        EXPECT_LE(part.edge_hash_keys.size(), 2u);
+        EXPECT_EQ(rows[end - 1].key, part.last_key.to_string());
+        merger.merge(part);
+        begin = end;
+    }
+    ::dsn::apps::scan_aggregate result;
+    merger.finish(result);
+    return result;
+}
+
+static void check_equal(const ::dsn::apps::scan_aggregate &expected,
+                        const ::dsn::apps::scan_aggregate &actual)
+{
+    ASSERT_EQ(expected.row_count, actual.row_count);
+    ASSERT_EQ(expected.hash_key_size_sum, actual.hash_key_size_sum);
+    ASSERT_EQ(expected.hash_key_size_max, actual.hash_key_size_max);
+    ASSERT_EQ(expected.sort_key_size_sum, actual.sort_key_size_sum);
+    ASSERT_EQ(expected.sort_key_size_max, actual.sort_key_size_max);
+    ASSERT_EQ(expected.value_size_sum, actual.value_size_sum);
+    ASSERT_EQ(expected.value_size_max, actual.value_size_max);
+    ASSERT_EQ(expected.row_size_max, actual.row_size_max);
+    ASSERT_EQ(expected.hash_key_count, actual.hash_key_count);
+    ASSERT_EQ(expected.sort_key_count_max, actual.sort_key_count_max);
+    ASSERT_EQ(expected.top_rows.size(), actual.top_rows.size());
+    for (size_t i = 0; i < expected.top_rows.size(); i++) {
+        ASSERT_EQ(expected.top_rows[i].size, actual.top_rows[i].size);
+    }
+    ASSERT_EQ(expected.top_hash_keys.size(), actual.top_hash_keys.size());
+    for (size_t i = 0; i < expected.top_hash_keys.size(); i++) {
+        ASSERT_EQ(expected.top_hash_keys[i].size, actual.top_hash_keys[i].size);
+    }
+    ASSERT_TRUE(actual.edge_hash_keys.empty());
+    ASSERT_EQ(expected.last_key.to_string(), actual.last_key.to_string());
+}
+
+TEST(scan_aggregator, add_row)
+{
+    std::vector<test_row> rows = generate_rows(10);
+    ::dsn::apps::scan_aggregate result = aggregate(rows, 3);
+
+    ASSERT_EQ((int64_t)rows.size(), result.row_count);
+    ASSERT_EQ(10, result.hash_key_count);
+    ASSERT_EQ(7, result.sort_key_count_max);
+    int64_t row_size_sum = 0;
+    for (const auto &row : rows) {
+        row_size_sum += row.key.size() - 2 + row.value_size;
+    }
+    ASSERT_EQ(row_size_sum,
+              result.hash_key_size_sum + result.sort_key_size_sum + result.value_size_sum);
+
+    ASSERT_EQ(3u, result.top_rows.size());
+    ASSERT_EQ(result.row_size_max, result.top_rows[0].size);
+    ASSERT_GE(result.top_rows[0].size, result.top_rows[1].size);
+    ASSERT_GE(result.top_rows[1].size, result.top_rows[2].size);
+    ASSERT_EQ(3u, result.top_hash_keys.size());
+    ASSERT_GE(result.top_hash_keys[0].size, result.top_hash_keys[1].size);
+    ASSERT_GE(result.top_hash_keys[1].size, result.top_hash_keys[2].size);
+    ASSERT_EQ(rows.back().key, result.last_key.to_string());
+}
+
+TEST(scan_aggregator, no_top)
+{
+    ::dsn::apps::scan_aggregate result = aggregate(generate_rows(10), 0);
+    ASSERT_TRUE(result.top_rows.empty());
+    ASSERT_TRUE(result.top_hash_keys.empty());
+    ASSERT_EQ(10, result.hash_key_count);
+}
+
+TEST(scan_aggregator, empty)
+{
+    ::dsn::apps::scan_aggregate result = aggregate(std::vector<test_row>(), 3);
+    ASSERT_EQ(0, result.row_count);
+    ASSERT_EQ(0, result.hash_key_count);
+    ASSERT_TRUE(result.top_rows.empty());
+    ASSERT_TRUE(result.top_hash_keys.empty());
+
+    pegasus_scan_aggregator aggregator(3, true);
+    aggregator.finish(result);
+    ASSERT_TRUE(result.edge_hash_keys.empty());
+}
+
+TEST(scan_aggregator, edges)
+{
+    std::vector<test_row> rows = generate_rows(3);
+
+    // the first and the last hash keys are not counted
+    pegasus_scan_aggregator aggregator(3, true);
+    for (const auto &row : rows) {
+        aggregator.add_row(row.key, row.value_size);
+    }
+    ::dsn::apps::scan_aggregate part;
+    aggregator.finish(part);
+    ASSERT_EQ(1, part.hash_key_count);
+    ASSERT_EQ(2, part.sort_key_count_max);
+    ASSERT_EQ(1u, part.top_hash_keys.size());
+    ASSERT_EQ(2u, part.edge_hash_keys.size());
+    ASSERT_EQ("h0", part.edge_hash_keys[0].hash_key.to_string());
+    ASSERT_EQ(1, part.edge_hash_keys[0].sort_key_count);
+    ASSERT_EQ("h2", part.edge_hash_keys[1].hash_key.to_string());
+    ASSERT_EQ(3, part.edge_hash_keys[1].sort_key_count);
+
+    // only one hash key
+    pegasus_scan_aggregator aggregator2(3, true);
+    aggregator2.add_row(rows.back().key, rows.back().value_size);
+    aggregator2.finish(part);
+    ASSERT_EQ(0, part.hash_key_count);
+    ASSERT_EQ(1u, part.edge_hash_keys.size());
+    ASSERT_EQ("h2", part.edge_hash_keys[0].hash_key.to_string());
+}
+
+TEST(scan_aggregator, merge)
+{
+    std::vector<test_row> rows = generate_rows(100);
+    for (int top_count : {0, 1, 10}) {
+        ::dsn::apps::scan_aggregate expected = aggregate(rows, top_count);
+        // the hash keys are split over the rpcs at all kinds of positions
+        for (const std::vector<int> &sizes : std::vector<std::vector<int>>{
+                 {1}, {2}, {3, 1}, {5, 8, 13}, {7}, {50}, {1000}}) {
+            check_equal(expected, aggregate_in_rpcs(rows, top_count, sizes));
+        }
+    }
+}
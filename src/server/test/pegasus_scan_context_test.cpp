@@ -0,0 +1,118 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_scan_context.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus::server;
+
+TEST(scan_context, merge_limits)
+{
+    pegasus_scan_limits server_limits;
+    server_limits.max_iteration_count = 100;
+    server_limits.max_iteration_time_ns = 0;
+    server_limits.max_response_bytes = 1000;
+
+    // not limited by the request
+    pegasus_scan_limits limits = pegasus_scan_limits::merge(server_limits, 0, -1, 0);
+    ASSERT_EQ(100u, limits.max_iteration_count);
+    ASSERT_EQ(0u, limits.max_iteration_time_ns);
+    ASSERT_EQ(1000u, limits.max_response_bytes);
+
+    // the smaller ones are used
+    limits = pegasus_scan_limits::merge(server_limits, 10, 5, 2000);
+    ASSERT_EQ(10u, limits.max_iteration_count);
+    ASSERT_EQ(5000000u, limits.max_iteration_time_ns);
+    ASSERT_EQ(1000u, limits.max_response_bytes);
+}
+
+TEST(scan_context, limits_reached)
+{
+    uint64_t start_time = dsn_now_ns();
+
+    pegasus_scan_limits limits;
+    ASSERT_FALSE(limits.reached(1000000, 1000000, start_time - 1000000000));
+
+    limits.max_iteration_count = 10;
+    ASSERT_FALSE(limits.reached(9, 0, start_time));
+    ASSERT_TRUE(limits.reached(10, 0, start_time));
+
+    limits = pegasus_scan_limits();
+    limits.max_response_bytes = 100;
+    ASSERT_FALSE(limits.reached(1, 99, start_time));
+    ASSERT_TRUE(limits.reached(1, 100, start_time));
+
+    limits = pegasus_scan_limits();
+    limits.max_iteration_time_ns = 1000000;
+    // at least one record is iterated
+    ASSERT_FALSE(limits.reached(0, 0, start_time - 1000000000));
+    ASSERT_TRUE(limits.reached(1, 0, start_time - 1000000000));
+    ASSERT_FALSE(limits.reached(1, 0, dsn_now_ns()));
+}
+
+static std::unique_ptr<pegasus_scan_context> new_context(int32_t batch_size)
+{
+    return std::unique_ptr<pegasus_scan_context>(
+        new pegasus_scan_context(std::unique_ptr<pegasus_blob_store::reader_pin>(),
+                                 std::unique_ptr<rocksdb::Iterator>(),
+                                 std::string(),
+                                 false,
+                                 pegasus_filter_matcher(),
+                                 pegasus_filter_matcher(),
+                                 batch_size,
+                                 false,
+                                 pegasus_scan_limits(),
+                                 false,
+                                 0));
+}
+
+TEST(scan_context, cache_max_count)
+{
+    pegasus_context_cache cache;
+    cache.set_max_count(2);
+
+    int64_t h1 = cache.put(new_context(1));
+    int64_t h2 = cache.put(new_context(2));
+    ASSERT_EQ(2u, cache.size());
+
+    // the used context becomes the most recently used one
+    std::unique_ptr<pegasus_scan_context> c1 = cache.fetch(h1);
+    ASSERT_EQ(1, c1->batch_size);
+    h1 = cache.put(std::move(c1));
+
+    // the least recently used one is evicted
+    int64_t h3 = cache.put(new_context(3));
+    ASSERT_EQ(2u, cache.size());
+    ASSERT_EQ(nullptr, cache.fetch(h2));
+    ASSERT_EQ(1u, cache.fetch_evict_count());
+    ASSERT_EQ(0u, cache.fetch_evict_count());
+    ASSERT_EQ(1, cache.fetch(h1)->batch_size);
+    ASSERT_EQ(3, cache.fetch(h3)->batch_size);
+    ASSERT_EQ(0u, cache.size());
+}
+
+TEST(scan_context, cache_evict)
+{
+    pegasus_context_cache cache;
+    int64_t h1 = cache.put(new_context(1));
+    uint64_t put_time = dsn_now_ns();
+    int64_t h2 = cache.put(new_context(2));
+    int64_t h3 = cache.put(new_context(3));
+
+    // nothing is idle for long
+    cache.evict_idle(put_time, 1000000000);
+    ASSERT_EQ(3u, cache.size());
+
+    ASSERT_TRUE(cache.evict_lru());
+    ASSERT_EQ(nullptr, cache.fetch(h1));
+
+    h2 = cache.put(cache.fetch(h2));
+    cache.evict_idle(dsn_now_ns() + 2000000000, 1000000000);
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(nullptr, cache.fetch(h2));
+    ASSERT_EQ(nullptr, cache.fetch(h3));
+    ASSERT_EQ(3u, cache.fetch_evict_count());
+    ASSERT_FALSE(cache.evict_lru());
+}
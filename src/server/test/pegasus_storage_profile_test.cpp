@@ -0,0 +1,105 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_storage_profile.h"
+#include "base/pegasus_const.h"
+
+#include <algorithm>
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+using namespace pegasus::server;
+
+TEST(storage_profile_test, update)
+{
+    pegasus_storage_profile profile;
+    profile.compression_per_level = {rocksdb::kNoCompression};
+    ASSERT_TRUE(profile.update({}).empty());
+
+    std::map<std::string, std::string> envs = {
+        {ROCKSDB_ENV_COMPRESSION_KEY, "lz4"},
+        {ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY, "zstd"},
+        {ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY, "0"},
+        {ROCKSDB_ENV_BLOCK_SIZE_KEY, "16384"},
+        {ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY, "true"},
+        {ROCKSDB_ENV_CACHE_PRIORITY_KEY, "high"},
+    };
+    ASSERT_TRUE(profile.update(envs).empty());
+    // a single type compresses the levels >= 2
+    std::vector<rocksdb::CompressionType> compression_per_level = {
+        rocksdb::kNoCompression, rocksdb::kNoCompression, rocksdb::kLZ4Compression};
+    ASSERT_EQ(compression_per_level, profile.compression_per_level);
+    ASSERT_EQ(rocksdb::kZSTD, profile.bottommost_compression);
+    ASSERT_EQ(0, profile.bloom_bits_per_key);
+    ASSERT_EQ(16384, profile.block_size);
+    ASSERT_TRUE(profile.cache_index_and_filter_blocks);
+    ASSERT_EQ(pegasus_storage_profile::cache_priority::high, profile.priority);
+
+    // the reported envs are parsed to the same profile
+    std::map<std::string, std::string> reported;
+    profile.to_envs(reported);
+    ASSERT_EQ("none,none,lz4", reported[ROCKSDB_ENV_COMPRESSION_KEY]);
+    pegasus_storage_profile parsed;
+    ASSERT_TRUE(parsed.update(reported).empty());
+    ASSERT_EQ(profile, parsed);
+
+    // the invalid values are ignored
+    envs = {
+        {ROCKSDB_ENV_COMPRESSION_KEY, "none,gzip"},
+        {ROCKSDB_ENV_BOTTOMMOST_COMPRESSION_KEY, "default"},
+        {ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY, "-1"},
+        {ROCKSDB_ENV_BLOCK_SIZE_KEY, "4k"},
+        {ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY, "yes"},
+        {ROCKSDB_ENV_CACHE_PRIORITY_KEY, "low"},
+    };
+    std::vector<std::string> invalid_keys = profile.update(envs);
+    std::sort(invalid_keys.begin(), invalid_keys.end());
+    std::vector<std::string> expected_invalid_keys = {ROCKSDB_ENV_BLOCK_SIZE_KEY,
+                                                      ROCKSDB_ENV_BLOOM_BITS_PER_KEY_KEY,
+                                                      ROCKSDB_ENV_CACHE_INDEX_AND_FILTER_BLOCKS_KEY,
+                                                      ROCKSDB_ENV_COMPRESSION_KEY};
+    std::sort(expected_invalid_keys.begin(), expected_invalid_keys.end());
+    ASSERT_EQ(expected_invalid_keys, invalid_keys);
+    ASSERT_EQ(compression_per_level, profile.compression_per_level);
+    ASSERT_EQ(rocksdb::kDisableCompressionOption, profile.bottommost_compression);
+    ASSERT_EQ(16384, profile.block_size);
+    ASSERT_EQ(pegasus_storage_profile::cache_priority::low, profile.priority);
+}
+
+TEST(storage_profile_test, open_options_equal)
+{
+    pegasus_storage_profile profile1;
+    pegasus_storage_profile profile2;
+    ASSERT_EQ(profile1, profile2);
+
+    // the reads filling the block cache or not is changed on the running db
+    profile2.priority = pegasus_storage_profile::cache_priority::low;
+    ASSERT_NE(profile1, profile2);
+    ASSERT_TRUE(profile1.open_options_equal(profile2));
+
+    profile2.priority = pegasus_storage_profile::cache_priority::high;
+    ASSERT_FALSE(profile1.open_options_equal(profile2));
+
+    profile2 = profile1;
+    profile2.block_size *= 2;
+    ASSERT_FALSE(profile1.open_options_equal(profile2));
+}
+
+TEST(storage_profile_test, apply)
+{
+    pegasus_storage_profile profile;
+    profile.compression_per_level = {rocksdb::kNoCompression, rocksdb::kSnappyCompression};
+    profile.bottommost_compression = rocksdb::kZSTD;
+
+    rocksdb::Options opts;
+    opts.num_levels = 4;
+    profile.apply(opts, rocksdb::BlockBasedTableOptions());
+    std::vector<rocksdb::CompressionType> compression_per_level = {rocksdb::kNoCompression,
+                                                                   rocksdb::kSnappyCompression,
+                                                                   rocksdb::kSnappyCompression,
+                                                                   rocksdb::kSnappyCompression};
+    ASSERT_EQ(compression_per_level, opts.compression_per_level);
+    ASSERT_EQ(rocksdb::kZSTD, opts.bottommost_compression);
+    ASSERT_NE(nullptr, opts.table_factory);
+}
@@ -0,0 +1,135 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "server/pegasus_table_properties_collector.h"
+
+#include <gtest/gtest.h>
+
+using namespace pegasus;
+using namespace pegasus::server;
+
+static std::string generate_value(uint32_t expire_ts)
+{
+    pegasus_value_generator gen;
+    rocksdb::SliceParts sparts = gen.generate_value(0, "value", expire_ts);
+    std::string raw_value;
+    for (int i = 0; i < sparts.num_parts; i++) {
+        raw_value += sparts.parts[i].ToString();
+    }
+    return raw_value;
+}
+
+static std::shared_ptr<rocksdb::TableProperties>
+collect(const std::vector<std::pair<uint32_t, rocksdb::EntryType>> &records)
+{
+    pegasus_table_properties_collector collector(0);
+    for (const auto &r : records) {
+        EXPECT_TRUE(collector.AddUserKey("key", generate_value(r.first), r.second, 0, 0).ok());
+    }
+    auto props = std::make_shared<rocksdb::TableProperties>();
+    EXPECT_TRUE(collector.Finish(&props->user_collected_properties).ok());
+    return props;
+}
+
+TEST(table_properties_collector, ttl_record_count)
+{
+    auto props = collect({{0, rocksdb::kEntryPut},
+                          {100, rocksdb::kEntryPut},
+                          {200, rocksdb::kEntryPut},
+                          {0, rocksdb::kEntryDelete}});
+    ASSERT_EQ("2", props->user_collected_properties[TABLE_PROPERTY_TTL_RECORD_COUNT]);
+}
+
+TEST(table_properties_collector, expire_ts)
+{
+    auto props = collect({{0, rocksdb::kEntryPut},
+                          {200, rocksdb::kEntryPut},
+                          {100, rocksdb::kEntryPut},
+                          {300, rocksdb::kEntryPut}});
+    ASSERT_EQ("100", props->user_collected_properties[TABLE_PROPERTY_MIN_EXPIRE_TS]);
+    ASSERT_EQ("300", props->user_collected_properties[TABLE_PROPERTY_MAX_EXPIRE_TS]);
+
+    props = collect({{0, rocksdb::kEntryPut}});
+    ASSERT_EQ("0", props->user_collected_properties[TABLE_PROPERTY_MIN_EXPIRE_TS]);
+    ASSERT_EQ("0", props->user_collected_properties[TABLE_PROPERTY_MAX_EXPIRE_TS]);
+}
+
+TEST(table_properties_collector, estimate_expired_ratio)
+{
+    // half of the records have TTL, with expire_ts in [100, 199]
+    std::vector<std::pair<uint32_t, rocksdb::EntryType>> records;
+    for (uint32_t i = 0; i < 100; i++) {
+        records.emplace_back(100 + i, rocksdb::kEntryPut);
+        records.emplace_back(0, rocksdb::kEntryPut);
+    }
+    auto props = collect(records);
+    props->num_entries = records.size();
+    ASSERT_DOUBLE_EQ(0, pegasus_table_properties_collector::estimate_expired_ratio(*props, 99));
+    ASSERT_DOUBLE_EQ(0.25,
+                     pegasus_table_properties_collector::estimate_expired_ratio(*props, 149));
+    ASSERT_DOUBLE_EQ(0.5, pegasus_table_properties_collector::estimate_expired_ratio(*props, 199));
+    ASSERT_DOUBLE_EQ(0.5, pegasus_table_properties_collector::estimate_expired_ratio(*props, 500));
+
+    // no record with TTL
+    props = collect({{0, rocksdb::kEntryPut}});
+    props->num_entries = 1;
+    ASSERT_DOUBLE_EQ(0, pegasus_table_properties_collector::estimate_expired_ratio(*props, 500));
+
+    // the tables generated by old versions have no such properties
+    props = std::make_shared<rocksdb::TableProperties>();
+    props->num_entries = 1;
+    ASSERT_DOUBLE_EQ(0, pegasus_table_properties_collector::estimate_expired_ratio(*props, 500));
+}
+
+TEST(table_properties_collector, may_have_ttl_records)
+{
+    rocksdb::TablePropertiesCollection tables;
+    ASSERT_FALSE(pegasus_table_properties_collector::may_have_ttl_records(tables));
+
+    tables["1.sst"] = collect({{0, rocksdb::kEntryPut}});
+    ASSERT_FALSE(pegasus_table_properties_collector::may_have_ttl_records(tables));
+
+    // the tables generated by old versions are regarded as having records with TTL
+    tables["2.sst"] = std::make_shared<rocksdb::TableProperties>();
+    ASSERT_TRUE(pegasus_table_properties_collector::may_have_ttl_records(tables));
+
+    tables["2.sst"] = collect({{100, rocksdb::kEntryPut}});
+    ASSERT_TRUE(pegasus_table_properties_collector::may_have_ttl_records(tables));
+}
+
+TEST(table_properties_collector, blob_refs)
+{
+    pegasus_value_generator gen;
+    pegasus_table_properties_collector collector(2);
+    for (uint64_t file_number : {3, 5, 3}) {
+        pegasus_blob_index index;
+        index.file_number = file_number;
+        index.offset = 0;
+        index.size = 100 * file_number;
+        index.crc = 0;
+        index.user_data_length = 1000;
+        rocksdb::SliceParts sparts =
+            gen.generate_blob_index_value(0, value_compression_type::none, index);
+        std::string raw_value;
+        for (int i = 0; i < sparts.num_parts; i++) {
+            raw_value += sparts.parts[i].ToString();
+        }
+        ASSERT_TRUE(collector.AddUserKey("key", raw_value, rocksdb::kEntryPut, 0, 0).ok());
+    }
+    auto props = std::make_shared<rocksdb::TableProperties>();
+    ASSERT_TRUE(collector.Finish(&props->user_collected_properties).ok());
+    ASSERT_EQ("3:600,5:500", props->user_collected_properties[TABLE_PROPERTY_BLOB_REFS]);
+
+    rocksdb::TablePropertiesCollection tables;
+    tables["1.sst"] = props;
+    tables["2.sst"] = props;
+    std::map<uint64_t, uint64_t> refs;
+    ASSERT_TRUE(pegasus_table_properties_collector::get_blob_refs(tables, refs));
+    ASSERT_EQ((std::map<uint64_t, uint64_t>{{3, 1200}, {5, 1000}}), refs);
+
+    // the tables generated by old versions have unknown references
+    tables["3.sst"] = std::make_shared<rocksdb::TableProperties>();
+    refs.clear();
+    ASSERT_FALSE(pegasus_table_properties_collector::get_blob_refs(tables, refs));
+}
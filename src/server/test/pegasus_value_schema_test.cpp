@@ -4,6 +4,7 @@
 
 #include "base/pegasus_value_schema.h"
 
+#include <random>
 #include <gtest/gtest.h>
 
 using namespace pegasus;
@@ -20,6 +21,11 @@ TEST(value_schema, generate_and_extract_v1_v0)
         {0, 1000, ""},
         {0, std::numeric_limits<uint32_t>::max(), "pegasus"},
         {0, std::numeric_limits<uint32_t>::max(), ""},
+        {1, 1000, ""},
+        {1, std::numeric_limits<uint32_t>::max(), "pegasus"},
+        {1, std::numeric_limits<uint32_t>::max(), ""},
+        {2, 1000, ""},
+        {2, std::numeric_limits<uint32_t>::max(), "pegasus"},
     };
 
     for (auto &t : tests) {
@@ -34,8 +40,140 @@ TEST(value_schema, generate_and_extract_v1_v0)
 
         ASSERT_EQ(t.expire_ts, pegasus_extract_expire_ts(t.value_schema_version, raw_value));
 
+        // extract without copy, user data refers to the memory of raw_value
+        dsn::blob user_data_view;
+        ASSERT_TRUE(pegasus_extract_user_data(
+                        t.value_schema_version, dsn::string_view(raw_value), user_data_view)
+                        .ok());
+        ASSERT_EQ(t.user_data, user_data_view.to_string());
+        ASSERT_EQ(raw_value.data() + pegasus_value_header_length(t.value_schema_version),
+                  user_data_view.data());
+
+        dsn::blob user_data;
+        ASSERT_TRUE(
+            pegasus_extract_user_data(t.value_schema_version, std::move(raw_value), user_data)
+                .ok());
+        ASSERT_EQ(t.user_data, user_data.to_string());
+    }
+}
+
+static std::string generate_raw_value(pegasus_value_generator &gen,
+                                      const std::string &user_data,
+                                      uint32_t expire_ts)
+{
+    rocksdb::SliceParts sparts = gen.generate_value(1, user_data, expire_ts);
+    std::string raw_value;
+    for (int i = 0; i < sparts.num_parts; i++) {
+        raw_value += sparts.parts[i].ToString();
+    }
+    return raw_value;
+}
+
+TEST(value_schema, generate_and_extract_v1_compressed)
+{
+    std::string compressible;
+    for (int i = 0; compressible.size() < 10000; i++) {
+        compressible += "{\"id\":" + std::to_string(i) + ",\"name\":\"pegasus\"},";
+    }
+    std::string incompressible;
+    std::mt19937 rng(0);
+    for (int i = 0; i < 10000; i++) {
+        incompressible.push_back(static_cast<char>(rng()));
+    }
+
+    pegasus_value_generator gen;
+    gen.set_compression_threshold(1000);
+    struct test_case
+    {
+        std::string user_data;
+        bool compressed;
+    } tests[] = {
+        {compressible, true},
+        {compressible.substr(0, 1000), true},
+        // smaller than the threshold
+        {compressible.substr(0, 999), false},
+        // compression does not save enough
+        {incompressible, false},
+    };
+
+    for (auto &t : tests) {
+        std::string raw_value = generate_raw_value(gen, t.user_data, 1000);
+        ASSERT_EQ(t.compressed, raw_value.size() < t.user_data.size());
+        ASSERT_EQ(t.compressed ? 1 : 0, pegasus_extract_value_flags(1, raw_value));
+        ASSERT_EQ(1000, pegasus_extract_expire_ts(1, raw_value));
+        size_t length = 0;
+        ASSERT_TRUE(pegasus_extract_user_data_length(1, raw_value, length).ok());
+        ASSERT_EQ(t.user_data.size(), length);
+
+        dsn::blob user_data_view;
+        ASSERT_TRUE(pegasus_extract_user_data(1, dsn::string_view(raw_value), user_data_view).ok());
+        ASSERT_EQ(t.user_data, user_data_view.to_string());
+
         dsn::blob user_data;
-        pegasus_extract_user_data(t.value_schema_version, std::move(raw_value), user_data);
+        ASSERT_TRUE(pegasus_extract_user_data(1, std::move(raw_value), user_data).ok());
         ASSERT_EQ(t.user_data, user_data.to_string());
     }
+
+    // never compressed in v0, or with no threshold
+    gen.set_compression_threshold(0);
+    ASSERT_EQ(compressible.size() + 5, generate_raw_value(gen, compressible, 0).size());
+    rocksdb::SliceParts sparts = gen.generate_value(0, compressible, 0);
+    ASSERT_EQ(compressible, sparts.parts[1].ToString());
+
+    // the corrupted compressed value is reported rather than crashing the server
+    gen.set_compression_threshold(1000);
+    std::string raw_value = generate_raw_value(gen, compressible, 0);
+    ASSERT_EQ(1, pegasus_extract_value_flags(1, raw_value));
+    raw_value.resize(raw_value.size() / 2);
+    dsn::blob user_data_view;
+    ASSERT_TRUE(
+        pegasus_extract_user_data(1, dsn::string_view(raw_value), user_data_view).IsCorruption());
+    size_t length = 0;
+    ASSERT_TRUE(pegasus_extract_user_data_length(1, raw_value, length).ok());
+    // the varint of the uncompressed length is truncated
+    raw_value.resize(pegasus_value_header_length(1) + 1);
+    raw_value.back() = '\x80';
+    ASSERT_TRUE(pegasus_extract_user_data_length(1, raw_value, length).IsCorruption());
+    dsn::blob user_data;
+    ASSERT_TRUE(pegasus_extract_user_data(1, std::move(raw_value), user_data).IsCorruption());
+}
+
+TEST(value_schema, generate_and_extract_v2_blob_index)
+{
+    pegasus_blob_index index;
+    index.file_number = 12;
+    index.offset = std::numeric_limits<uint64_t>::max() - 1;
+    index.size = 100;
+    index.crc = 0xdeadbeef;
+    index.user_data_length = 1000;
+
+    pegasus_value_generator gen;
+    rocksdb::SliceParts sparts =
+        gen.generate_blob_index_value(1000, value_compression_type::snappy, index);
+    std::string raw_value;
+    for (int i = 0; i < sparts.num_parts; i++) {
+        raw_value += sparts.parts[i].ToString();
+    }
+    ASSERT_EQ(pegasus_value_header_length(2) + pegasus_blob_index::ENCODED_LENGTH,
+              raw_value.size());
+    ASSERT_EQ(1000, pegasus_extract_expire_ts(2, raw_value));
+    ASSERT_TRUE(pegasus_value_is_blob_index(2, raw_value));
+    ASSERT_EQ(static_cast<uint8_t>(value_compression_type::snappy),
+              pegasus_extract_value_flags(2, raw_value) & VALUE_FLAGS_COMPRESSION_MASK);
+
+    pegasus_blob_index extracted;
+    pegasus_extract_blob_index(2, raw_value, extracted);
+    ASSERT_EQ(index.file_number, extracted.file_number);
+    ASSERT_EQ(index.offset, extracted.offset);
+    ASSERT_EQ(index.size, extracted.size);
+    ASSERT_EQ(index.crc, extracted.crc);
+    ASSERT_EQ(index.user_data_length, extracted.user_data_length);
+    size_t length = 0;
+    ASSERT_TRUE(pegasus_extract_user_data_length(2, raw_value, length).ok());
+    ASSERT_EQ(index.user_data_length, length);
+
+    // the values without blob index
+    std::string value = generate_raw_value(gen, "pegasus", 0);
+    ASSERT_FALSE(pegasus_value_is_blob_index(2, value));
+    ASSERT_FALSE(pegasus_value_is_blob_index(0, raw_value));
 }
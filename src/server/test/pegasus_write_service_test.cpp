@@ -2,6 +2,8 @@
 // This source code is licensed under the Apache License Version 2.0, which
 // can be found in the LICENSE file in the root directory of this source tree.
 
+#include <limits>
+
 #include "base/pegasus_key_schema.h"
 #include "pegasus_server_test_base.h"
 #include "server/pegasus_server_write.h"
@@ -23,6 +25,24 @@ public:
         _write_svc = _server_write->_write_svc.get();
     }
 
+    int multi_put(int64_t decree,
+                  const dsn::apps::multi_put_request &request,
+                  dsn::apps::update_response &response)
+    {
+        _write_svc->batch_prepare();
+        _write_svc->batch_multi_put(request, response);
+        return _write_svc->batch_commit(decree);
+    }
+
+    int multi_remove(int64_t decree,
+                     const dsn::apps::multi_remove_request &request,
+                     dsn::apps::multi_remove_response &response)
+    {
+        _write_svc->batch_prepare();
+        _write_svc->batch_multi_remove(request, response);
+        return _write_svc->batch_commit(decree);
+    }
+
     void test_multi_put()
     {
         dsn::apps::multi_put_request request;
@@ -33,7 +53,7 @@ public:
 
         // alarm for empty request
         request.hash_key = dsn::blob(hash_key.data(), 0, hash_key.size());
-        _write_svc->multi_put(decree, request, response);
+        multi_put(decree, request, response);
         ASSERT_EQ(response.error, rocksdb::Status::kInvalidArgument);
 
         constexpr int kv_num = 100;
@@ -51,7 +71,7 @@ public:
             request.kvs.back().value.assign(value[i].data(), 0, value[i].size());
         }
 
-        _write_svc->multi_put(decree, request, response);
+        multi_put(decree, request, response);
         ASSERT_EQ(response.error, 0);
         ASSERT_EQ(response.app_id, _gpid.get_app_id());
         ASSERT_EQ(response.partition_index, _gpid.get_partition_index());
@@ -68,7 +88,7 @@ public:
 
         // alarm for empty request
         request.hash_key = dsn::blob(hash_key.data(), 0, hash_key.size());
-        _write_svc->multi_remove(decree, request, response);
+        multi_remove(decree, request, response);
         ASSERT_EQ(response.error, rocksdb::Status::kInvalidArgument);
 
         constexpr int kv_num = 100;
@@ -83,13 +103,76 @@ public:
             request.sort_keys.back().assign(sort_key[i].data(), 0, sort_key[i].size());
         }
 
-        _write_svc->multi_remove(decree, request, response);
+        multi_remove(decree, request, response);
         ASSERT_EQ(response.error, 0);
         ASSERT_EQ(response.app_id, _gpid.get_app_id());
         ASSERT_EQ(response.partition_index, _gpid.get_partition_index());
         ASSERT_EQ(response.decree, decree);
     }
 
+    void test_del_range()
+    {
+        int64_t decree = 10;
+        std::string hash_key = "hash_key";
+
+        constexpr int kv_num = 10;
+        std::string sort_key[kv_num];
+        std::string value = "value";
+
+        dsn::apps::multi_put_request put_request;
+        dsn::apps::update_response response;
+        put_request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        for (int i = 0; i < kv_num; i++) {
+            sort_key[i] = "sort_key_" + std::to_string(i);
+            put_request.kvs.emplace_back();
+            put_request.kvs.back().key.assign(sort_key[i].data(), 0, sort_key[i].size());
+            put_request.kvs.back().value.assign(value.data(), 0, value.size());
+        }
+        multi_put(decree, put_request, response);
+        ASSERT_EQ(response.error, 0);
+
+        auto exists = [this, &hash_key](const std::string &sort_key) {
+            dsn::blob key;
+            pegasus_generate_key(key, hash_key, sort_key);
+            std::string raw_value;
+            rocksdb::Status s = _write_svc->_impl->_db->Get(
+                _server->read_options(), utils::to_rocksdb_slice(key), &raw_value);
+            return s.ok();
+        };
+
+        // delete (sort_key_2, sort_key_5]
+        dsn::apps::del_range_request request;
+        request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        request.start_sort_key.assign(sort_key[2].data(), 0, sort_key[2].size());
+        request.stop_sort_key.assign(sort_key[5].data(), 0, sort_key[5].size());
+        request.start_inclusive = false;
+        request.stop_inclusive = true;
+        _write_svc->del_range(decree + 1, request, response);
+        ASSERT_EQ(response.error, 0);
+        ASSERT_EQ(response.decree, decree + 1);
+        for (int i = 0; i < kv_num; i++) {
+            ASSERT_EQ(exists(sort_key[i]), i <= 2 || i > 5) << sort_key[i];
+        }
+
+        // empty range
+        request.start_sort_key.assign(sort_key[8].data(), 0, sort_key[8].size());
+        request.stop_sort_key.assign(sort_key[7].data(), 0, sort_key[7].size());
+        _write_svc->del_range(decree + 2, request, response);
+        ASSERT_EQ(response.error, 0);
+        ASSERT_TRUE(exists(sort_key[7]));
+        ASSERT_TRUE(exists(sort_key[8]));
+
+        // delete [sort_key_7, max)
+        request.start_sort_key.assign(sort_key[7].data(), 0, sort_key[7].size());
+        request.stop_sort_key = dsn::blob();
+        request.start_inclusive = true;
+        _write_svc->del_range(decree + 3, request, response);
+        ASSERT_EQ(response.error, 0);
+        for (int i = 0; i < kv_num; i++) {
+            ASSERT_EQ(exists(sort_key[i]), i <= 2 || (i > 5 && i < 7)) << sort_key[i];
+        }
+    }
+
     void test_batched_writes()
     {
         int64_t decree = 10;
@@ -129,13 +212,360 @@ public:
             ASSERT_EQ(resp.decree, decree);
         }
     }
+
+    void test_batched_multi_writes()
+    {
+        int64_t decree = 10;
+        std::string hash_key = "hash_key";
+        std::string sort_key[3] = {"sort_key_0", "sort_key_1", "sort_key_2"};
+        std::string value = "value";
+
+        dsn::apps::multi_put_request put_request;
+        put_request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        for (auto &sk : sort_key) {
+            put_request.kvs.emplace_back();
+            put_request.kvs.back().key.assign(sk.data(), 0, sk.size());
+            put_request.kvs.back().value.assign(value.data(), 0, value.size());
+        }
+
+        dsn::apps::multi_remove_request remove_request;
+        remove_request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        remove_request.sort_keys.emplace_back(sort_key[0].data(), 0, sort_key[0].size());
+
+        dsn::apps::multi_put_request empty_put_request;
+        empty_put_request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+
+        dsn::apps::update_request single_put_request;
+        pegasus::pegasus_generate_key(single_put_request.key, hash_key, std::string("single"));
+        single_put_request.value.assign(value.data(), 0, value.size());
+
+        // multi-key writes are coalesced with single-key writes into one decree
+        dsn::apps::update_response put_response, empty_put_response, single_put_response;
+        dsn::apps::multi_remove_response remove_response;
+        {
+            _write_svc->batch_prepare();
+            _write_svc->batch_multi_put(put_request, put_response);
+            _write_svc->batch_put(single_put_request, single_put_response);
+            _write_svc->batch_multi_put(empty_put_request, empty_put_response);
+            _write_svc->batch_multi_remove(remove_request, remove_response);
+            ASSERT_EQ(_write_svc->batch_commit(decree), 0);
+        }
+
+        ASSERT_EQ(put_response.error, 0);
+        ASSERT_EQ(put_response.decree, decree);
+        ASSERT_EQ(single_put_response.error, 0);
+        ASSERT_EQ(single_put_response.decree, decree);
+        ASSERT_EQ(remove_response.error, 0);
+        ASSERT_EQ(remove_response.count, 1);
+        ASSERT_EQ(remove_response.decree, decree);
+        ASSERT_EQ(remove_response.app_id, _gpid.get_app_id());
+        ASSERT_EQ(remove_response.partition_index, _gpid.get_partition_index());
+        // an invalid request doesn't fail the others in the batch
+        ASSERT_EQ(empty_put_response.error, rocksdb::Status::kInvalidArgument);
+        ASSERT_EQ(empty_put_response.decree, decree);
+
+        // a batch of invalid requests only still persists its decree
+        dsn::apps::multi_remove_request empty_remove_request;
+        empty_remove_request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        {
+            _write_svc->batch_prepare();
+            _write_svc->batch_multi_put(empty_put_request, empty_put_response);
+            _write_svc->batch_multi_remove(empty_remove_request, remove_response);
+            ASSERT_EQ(_write_svc->batch_commit(decree + 1), 0);
+        }
+        ASSERT_EQ(empty_put_response.error, rocksdb::Status::kInvalidArgument);
+        ASSERT_EQ(remove_response.error, rocksdb::Status::kInvalidArgument);
+        ASSERT_TRUE(_server->_db->Flush(rocksdb::FlushOptions()).ok());
+        ASSERT_EQ(decree + 1, _server->_db->GetLastFlushedDecree());
+    }
+
+    void test_batched_incr()
+    {
+        int64_t decree = 10;
+        dsn::blob key;
+        pegasus::pegasus_generate_key(key, std::string("hash_key"), std::string("incr_sort_key"));
+
+        std::array<dsn::apps::incr_response, 3> responses;
+        {
+            // incrs on the same key in one batch see each other's result
+            _write_svc->batch_prepare();
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 100;
+            _write_svc->batch_incr(req, responses[0]);
+            req.increment = -1;
+            _write_svc->batch_incr(req, responses[1]);
+            req.increment = 10;
+            _write_svc->batch_incr(req, responses[2]);
+            ASSERT_EQ(_write_svc->batch_commit(decree), 0);
+        }
+        ASSERT_EQ(responses[0].new_value, 100);
+        ASSERT_EQ(responses[1].new_value, 99);
+        ASSERT_EQ(responses[2].new_value, 109);
+        for (const dsn::apps::incr_response &resp : responses) {
+            ASSERT_EQ(resp.error, 0);
+            ASSERT_EQ(resp.app_id, _gpid.get_app_id());
+            ASSERT_EQ(resp.partition_index, _gpid.get_partition_index());
+            ASSERT_EQ(resp.decree, decree);
+        }
+
+        // incr after remove in the same batch starts from 0
+        dsn::apps::update_response remove_resp;
+        dsn::apps::incr_response incr_resp;
+        {
+            _write_svc->batch_prepare();
+            _write_svc->batch_remove(key, remove_resp);
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 1;
+            _write_svc->batch_incr(req, incr_resp);
+            ASSERT_EQ(_write_svc->batch_commit(decree + 1), 0);
+        }
+        ASSERT_EQ(incr_resp.error, 0);
+        ASSERT_EQ(incr_resp.new_value, 1);
+
+        // incr on a non-integer value fails without affecting the batch
+        dsn::apps::update_response put_resp;
+        std::string value = "abc";
+        {
+            _write_svc->batch_prepare();
+            dsn::apps::update_request put_req;
+            put_req.key = key;
+            put_req.value.assign(value.data(), 0, value.size());
+            _write_svc->batch_put(put_req, put_resp);
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 1;
+            _write_svc->batch_incr(req, incr_resp);
+            ASSERT_EQ(_write_svc->batch_commit(decree + 2), 0);
+        }
+        ASSERT_EQ(put_resp.error, 0);
+        ASSERT_EQ(incr_resp.error, rocksdb::Status::kInvalidArgument);
+        ASSERT_EQ(incr_resp.decree, decree + 2);
+
+        // incr overflows
+        std::array<dsn::apps::incr_response, 2> overflow_responses;
+        {
+            _write_svc->batch_prepare();
+            _write_svc->batch_remove(key, remove_resp);
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = std::numeric_limits<int64_t>::max();
+            _write_svc->batch_incr(req, overflow_responses[0]);
+            req.increment = 1;
+            _write_svc->batch_incr(req, overflow_responses[1]);
+            ASSERT_EQ(_write_svc->batch_commit(decree + 3), 0);
+        }
+        ASSERT_EQ(overflow_responses[0].error, 0);
+        ASSERT_EQ(overflow_responses[0].new_value, std::numeric_limits<int64_t>::max());
+        ASSERT_EQ(overflow_responses[1].error, rocksdb::Status::kInvalidArgument);
+    }
+
+    void test_batch_of_invalid_incrs()
+    {
+        int64_t decree = 10;
+        dsn::blob key;
+        pegasus::pegasus_generate_key(key, std::string("hash_key"), std::string("incr_sort_key"));
+
+        dsn::apps::update_response put_resp;
+        {
+            _write_svc->batch_prepare();
+            dsn::apps::update_request put_req;
+            put_req.key = key;
+            put_req.value.assign("abc", 0, 3);
+            _write_svc->batch_put(put_req, put_resp);
+            ASSERT_EQ(_write_svc->batch_commit(decree), 0);
+        }
+        ASSERT_EQ(put_resp.error, 0);
+
+        // the batch writes nothing as all the incrs fail, but the decree is still persisted
+        std::array<dsn::apps::incr_response, 2> responses;
+        {
+            _write_svc->batch_prepare();
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 1;
+            for (dsn::apps::incr_response &resp : responses) {
+                _write_svc->batch_incr(req, resp);
+            }
+            ASSERT_EQ(_write_svc->batch_commit(decree + 1), 0);
+        }
+        for (const dsn::apps::incr_response &resp : responses) {
+            ASSERT_EQ(resp.error, rocksdb::Status::kInvalidArgument);
+            ASSERT_EQ(resp.decree, decree + 1);
+        }
+        ASSERT_TRUE(_server->_db->Flush(rocksdb::FlushOptions()).ok());
+        ASSERT_EQ(decree + 1, _server->_db->GetLastFlushedDecree());
+    }
+
+    void test_batch_failed_by_blob_store()
+    {
+        int64_t decree = 10;
+        dsn::blob key;
+        pegasus::pegasus_generate_key(key, std::string("hash_key"), std::string("blob_sort_key"));
+
+        // an I/O error of the blob store fails the whole batch, nothing is written
+        dsn::apps::update_response put_resp;
+        dsn::apps::incr_response incr_resp;
+        {
+            _write_svc->batch_prepare();
+            dsn::apps::update_request put_req;
+            put_req.key = key;
+            put_req.value.assign("1", 0, 1);
+            _write_svc->batch_put(put_req, put_resp);
+            // as if the blob of the following request fails to be appended
+            _write_svc->_impl->_batch_error = rocksdb::Status::kIOError;
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 1;
+            _write_svc->batch_incr(req, incr_resp);
+            ASSERT_EQ(_write_svc->batch_commit(decree), rocksdb::Status::kIOError);
+        }
+        ASSERT_EQ(put_resp.error, rocksdb::Status::kIOError);
+        ASSERT_EQ(put_resp.decree, decree);
+        ASSERT_EQ(incr_resp.error, rocksdb::Status::kIOError);
+        ASSERT_EQ(incr_resp.new_value, 0);
+
+        // the error is cleared with the batch
+        {
+            _write_svc->batch_prepare();
+            dsn::apps::incr_request req;
+            req.key = key;
+            req.increment = 1;
+            _write_svc->batch_incr(req, incr_resp);
+            ASSERT_EQ(_write_svc->batch_commit(decree + 1), 0);
+        }
+        ASSERT_EQ(incr_resp.error, 0);
+        ASSERT_EQ(incr_resp.new_value, 1);
+    }
+
+    void test_check_and_set()
+    {
+        int64_t decree = 10;
+        std::string hash_key = "hash_key";
+        std::string check_sort_key = "check_sort_key";
+        std::string set_sort_key = "set_sort_key";
+        std::string operand = "10";
+        std::string value = "9";
+
+        dsn::apps::check_and_set_request request;
+        request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        request.check_sort_key.assign(check_sort_key.data(), 0, check_sort_key.size());
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_NOT_EXIST;
+        request.set_value.assign(value.data(), 0, value.size());
+        request.return_check_value = true;
+
+        // value not exist: check passed
+        dsn::apps::check_and_set_response response;
+        ASSERT_EQ(_write_svc->check_and_set(decree, request, response), 0);
+        ASSERT_EQ(response.error, 0);
+        ASSERT_TRUE(response.check_value_returned);
+        ASSERT_FALSE(response.check_value_exist);
+        ASSERT_EQ(response.decree, decree);
+
+        // value exists now: check not passed
+        response = dsn::apps::check_and_set_response();
+        ASSERT_EQ(_write_svc->check_and_set(decree + 1, request, response), 0);
+        ASSERT_EQ(response.error, rocksdb::Status::kTryAgain);
+        ASSERT_TRUE(response.check_value_exist);
+        ASSERT_EQ(response.check_value.to_string(), value);
+
+        // int compare: 9 < 10, set a different sort key
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_INT_LESS;
+        request.check_operand.assign(operand.data(), 0, operand.size());
+        request.set_diff_sort_key = true;
+        request.set_sort_key.assign(set_sort_key.data(), 0, set_sort_key.size());
+        response = dsn::apps::check_and_set_response();
+        ASSERT_EQ(_write_svc->check_and_set(decree + 2, request, response), 0);
+        ASSERT_EQ(response.error, 0);
+
+        // bytes compare: "9" > "10"
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_BYTES_GREATER;
+        response = dsn::apps::check_and_set_response();
+        ASSERT_EQ(_write_svc->check_and_set(decree + 3, request, response), 0);
+        ASSERT_EQ(response.error, 0);
+
+        // int compare on a non-integer operand
+        std::string invalid_operand = "abc";
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_INT_EQUAL;
+        request.check_operand.assign(invalid_operand.data(), 0, invalid_operand.size());
+        response = dsn::apps::check_and_set_response();
+        ASSERT_EQ(_write_svc->check_and_set(decree + 4, request, response), 0);
+        ASSERT_EQ(response.error, rocksdb::Status::kInvalidArgument);
+    }
+
+    void test_check_and_mutate()
+    {
+        int64_t decree = 10;
+        std::string hash_key = "hash_key";
+        std::string check_sort_key = "check_sort_key";
+        std::string sort_key[2] = {"sort_key_0", "sort_key_1"};
+        std::string value = "value";
+
+        dsn::apps::check_and_mutate_request request;
+        request.hash_key.assign(hash_key.data(), 0, hash_key.size());
+        request.check_sort_key.assign(check_sort_key.data(), 0, check_sort_key.size());
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_NOT_EXIST;
+
+        // alarm for empty mutate list
+        dsn::apps::check_and_mutate_response response;
+        ASSERT_EQ(_write_svc->check_and_mutate(decree, request, response), 0);
+        ASSERT_EQ(response.error, rocksdb::Status::kInvalidArgument);
+
+        for (auto &sk : sort_key) {
+            request.mutate_list.emplace_back();
+            request.mutate_list.back().operation = dsn::apps::mutate_operation::MO_PUT;
+            request.mutate_list.back().sort_key.assign(sk.data(), 0, sk.size());
+            request.mutate_list.back().value.assign(value.data(), 0, value.size());
+        }
+        request.mutate_list.emplace_back();
+        request.mutate_list.back().operation = dsn::apps::mutate_operation::MO_DELETE;
+        request.mutate_list.back().sort_key.assign(sort_key[1].data(), 0, sort_key[1].size());
+
+        response = dsn::apps::check_and_mutate_response();
+        ASSERT_EQ(_write_svc->check_and_mutate(decree + 1, request, response), 0);
+        ASSERT_EQ(response.error, 0);
+        ASSERT_EQ(response.decree, decree + 1);
+
+        // check the key that is just put
+        request.check_sort_key.assign(sort_key[0].data(), 0, sort_key[0].size());
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_MATCH_PREFIX;
+        request.check_operand.assign(value.data(), 0, 3);
+        response = dsn::apps::check_and_mutate_response();
+        ASSERT_EQ(_write_svc->check_and_mutate(decree + 2, request, response), 0);
+        ASSERT_EQ(response.error, 0);
+
+        // the last mutation removes sort_key_1
+        request.check_sort_key.assign(sort_key[1].data(), 0, sort_key[1].size());
+        request.check_type = dsn::apps::cas_check_type::CT_VALUE_EXIST;
+        response = dsn::apps::check_and_mutate_response();
+        ASSERT_EQ(_write_svc->check_and_mutate(decree + 3, request, response), 0);
+        ASSERT_EQ(response.error, rocksdb::Status::kTryAgain);
+    }
 };
 
 TEST_F(pegasus_write_service_test, multi_put) { test_multi_put(); }
 
 TEST_F(pegasus_write_service_test, multi_remove) { test_multi_remove(); }
 
+TEST_F(pegasus_write_service_test, del_range) { test_del_range(); }
+
 TEST_F(pegasus_write_service_test, batched_writes) { test_batched_writes(); }
 
+TEST_F(pegasus_write_service_test, batched_multi_writes) { test_batched_multi_writes(); }
+
+TEST_F(pegasus_write_service_test, batched_incr) { test_batched_incr(); }
+
+TEST_F(pegasus_write_service_test, batch_of_invalid_incrs) { test_batch_of_invalid_incrs(); }
+
+TEST_F(pegasus_write_service_test, batch_failed_by_blob_store)
+{
+    test_batch_failed_by_blob_store();
+}
+
+TEST_F(pegasus_write_service_test, check_and_set) { test_check_and_set(); }
+
+TEST_F(pegasus_write_service_test, check_and_mutate) { test_check_and_mutate(); }
+
 } // namespace server
 } // namespace pegasus
@@ -44,53 +44,8 @@ DEFINE_TASK_CODE(LPC_SCAN_DATA, TASK_PRIORITY_COMMON, ::dsn::THREAD_POOL_DEFAULT
 enum scan_data_operator
 {
     SCAN_COPY,
-    SCAN_CLEAR,
-    SCAN_COUNT
+    SCAN_CLEAR
 };
-class top_container
-{
-public:
-    struct top_heap_item
-    {
-        std::string hash_key;
-        std::string sort_key;
-        long row_size;
-        top_heap_item(std::string &&hash_key_, std::string &&sort_key_, long row_size_)
-            : hash_key(std::move(hash_key_)), sort_key(std::move(sort_key_)), row_size(row_size_)
-        {
-        }
-    };
-    struct top_heap_compare
-    {
-        bool operator()(top_heap_item i1, top_heap_item i2) { return i1.row_size < i2.row_size; }
-    };
-    typedef std::priority_queue<top_heap_item, std::vector<top_heap_item>, top_heap_compare>
-        top_heap;
-
-    top_container(int count) : _count(count) {}
-
-    void push(std::string &&hash_key, std::string &&sort_key, long row_size)
-    {
-        dsn::utils::auto_lock<dsn::utils::ex_lock_nr> l(_lock);
-        if (_heap.size() < _count) {
-            _heap.emplace(std::move(hash_key), std::move(sort_key), row_size);
-        } else {
-            const top_heap_item &top = _heap.top();
-            if (top.row_size < row_size) {
-                _heap.pop();
-                _heap.emplace(std::move(hash_key), std::move(sort_key), row_size);
-            }
-        }
-    }
-
-    top_heap &all() { return _heap; }
-
-private:
-    int _count;
-    top_heap _heap;
-    dsn::utils::ex_lock_nr _lock;
-};
-
 struct scan_data_context
 {
     scan_data_operator op;
@@ -103,25 +58,13 @@ struct scan_data_context
     std::atomic_long split_rows;
     std::atomic_long split_request_count;
     std::atomic_bool split_completed;
-    bool stat_size;
-    std::atomic_long hash_key_size_sum;
-    std::atomic_long hash_key_size_max;
-    std::atomic_long sort_key_size_sum;
-    std::atomic_long sort_key_size_max;
-    std::atomic_long value_size_sum;
-    std::atomic_long value_size_max;
-    std::atomic_long row_size_max;
-    int top_count;
-    top_container top_rows;
     scan_data_context(scan_data_operator op_,
                       int split_id_,
                       int max_batch_count_,
                       int timeout_ms_,
                       pegasus::pegasus_client::pegasus_scanner_wrapper scanner_,
                       pegasus::pegasus_client *client_,
-                      std::atomic_bool *error_occurred_,
-                      bool stat_size_ = false,
-                      int top_count_ = 0)
+                      std::atomic_bool *error_occurred_)
         : op(op_),
           split_id(split_id_),
           max_batch_count(max_batch_count_),
@@ -131,29 +74,10 @@ struct scan_data_context
           error_occurred(error_occurred_),
           split_rows(0),
           split_request_count(0),
-          split_completed(false),
-          stat_size(stat_size_),
-          hash_key_size_sum(0),
-          hash_key_size_max(0),
-          sort_key_size_sum(0),
-          sort_key_size_max(0),
-          value_size_sum(0),
-          value_size_max(0),
-          row_size_max(0),
-          top_count(top_count_),
-          top_rows(top_count_)
+          split_completed(false)
     {
     }
 };
-inline void update_atomic_max(std::atomic_long &max, long value)
-{
-    while (true) {
-        long old = max.load();
-        if (value <= old || max.compare_exchange_weak(old, value)) {
-            break;
-        }
-    }
-}
 inline void scan_data_next(scan_data_context *context)
 {
     while (!context->split_completed.load() && !context->error_occurred->load() &&
@@ -211,27 +135,6 @@ inline void scan_data_next(scan_data_context *context)
                         },
                         context->timeout_ms);
                     break;
-                case SCAN_COUNT:
-                    context->split_rows++;
-                    if (context->stat_size) {
-                        long hash_key_size = hash_key.size();
-                        context->hash_key_size_sum += hash_key_size;
-                        update_atomic_max(context->hash_key_size_max, hash_key_size);
-                        long sort_key_size = sort_key.size();
-                        context->sort_key_size_sum += sort_key_size;
-                        update_atomic_max(context->sort_key_size_max, sort_key_size);
-                        long value_size = value.size();
-                        context->value_size_sum += value_size;
-                        update_atomic_max(context->value_size_max, value_size);
-                        long row_size = hash_key_size + sort_key_size + value_size;
-                        update_atomic_max(context->row_size_max, row_size);
-                        if (context->top_count > 0) {
-                            context->top_rows.push(
-                                std::move(hash_key), std::move(sort_key), row_size);
-                        }
-                    }
-                    scan_data_next(context);
-                    break;
                 default:
                     dassert(false, "op = %d", context->op);
                     break;
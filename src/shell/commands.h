@@ -944,16 +944,36 @@ inline bool exist(command_executor *e, shell_context *sc, arguments args)
 
 inline bool sortkey_count(command_executor *e, shell_context *sc, arguments args)
 {
-    if (args.argc != 2) {
+    static struct option long_options[] = {{"approximate", no_argument, 0, 'a'}, {0, 0, 0, 0}};
+
+    bool approximate = false;
+    optind = 0;
+    while (true) {
+        int option_index = 0;
+        int c;
+        c = getopt_long(args.argc, args.argv, "a", long_options, &option_index);
+        if (c == -1)
+            break;
+        switch (c) {
+        case 'a':
+            approximate = true;
+            break;
+        default:
+            return false;
+        }
+    }
+    if (optind != args.argc - 1) {
         return false;
     }
 
-    std::string hash_key = args.argv[1];
+    std::string hash_key = args.argv[optind];
     if (!unescape_str(hash_key))
         return true;
     int64_t count;
     pegasus::pegasus_client::internal_info info;
-    int ret = sc->pg_client->sortkey_count(hash_key, count, sc->timeout_ms, &info);
+    int ret = approximate
+                  ? sc->pg_client->approximate_sortkey_count(hash_key, count, sc->timeout_ms, &info)
+                  : sc->pg_client->sortkey_count(hash_key, count, sc->timeout_ms, &info);
     if (ret != pegasus::PERR_OK) {
         fprintf(stderr, "ERROR: %s\n", sc->pg_client->get_error_string(ret));
     } else {
@@ -1205,6 +1225,36 @@ inline bool multi_del_range(command_executor *e, shell_context *sc, arguments ar
     fprintf(stderr, "silent: %s\n", silent ? "true" : "false");
     fprintf(stderr, "\n");
 
+    // without sort key filter, the whole range is deleted on the server side at once, unless
+    // the deleted sort keys should be written into the output file, which needs a scan.
+    if (options.sort_key_filter_type == pegasus::pegasus_client::FT_NO_FILTER && file == stderr) {
+        pegasus::pegasus_client::internal_info info;
+        int ret = sc->pg_client->del_range(hash_key,
+                                           start_sort_key,
+                                           stop_sort_key,
+                                           options.start_inclusive,
+                                           options.stop_inclusive,
+                                           sc->timeout_ms,
+                                           &info);
+        if (ret != pegasus::PERR_OK) {
+            fprintf(stderr,
+                    "ERROR: delete range failed: %s {app_id=%d, partition_index=%d, server=%s}\n",
+                    sc->pg_client->get_error_string(ret),
+                    info.app_id,
+                    info.partition_index,
+                    info.server.c_str());
+        } else {
+            fprintf(stderr,
+                    "OK, sort key range deleted {app_id=%d, partition_index=%d, decree=%ld, "
+                    "server=%s}.\n",
+                    info.app_id,
+                    info.partition_index,
+                    info.decree,
+                    info.server.c_str());
+        }
+        return true;
+    }
+
     int count = 0;
     bool error_occured = false;
     pegasus::pegasus_client::pegasus_scanner *scanner = nullptr;
@@ -1648,6 +1698,8 @@ inline bool full_scan(command_executor *e, shell_context *sc, arguments args)
     int i = 0;
     std::vector<pegasus::pegasus_client::pegasus_scanner *> scanners;
     options.timeout_ms = timeout_ms;
+    options.full_scan = true;
+    options.prefetch_batch_count = 1;
     int ret = sc->pg_client->get_unordered_scanners(10000, options, scanners);
     if (ret != pegasus::PERR_OK) {
         fprintf(file, "ERROR: %s\n", sc->pg_client->get_error_string(ret));
@@ -1837,6 +1889,8 @@ inline bool copy_data(command_executor *e, shell_context *sc, arguments args)
     std::vector<pegasus::pegasus_client::pegasus_scanner *> scanners;
     pegasus::pegasus_client::scan_options options;
     options.timeout_ms = timeout_ms;
+    options.full_scan = true;
+    options.prefetch_batch_count = 1;
     ret = sc->pg_client->get_unordered_scanners(max_split_count, options, scanners);
     if (ret != pegasus::PERR_OK) {
         fprintf(stderr,
@@ -2000,6 +2054,8 @@ inline bool clear_data(command_executor *e, shell_context *sc, arguments args)
     pegasus::pegasus_client::scan_options options;
     options.timeout_ms = timeout_ms;
     options.no_value = true;
+    options.full_scan = true;
+    options.prefetch_batch_count = 1;
     int ret = sc->pg_client->get_unordered_scanners(max_split_count, options, scanners);
     if (ret != pegasus::PERR_OK) {
         fprintf(
@@ -2085,14 +2141,12 @@ inline bool clear_data(command_executor *e, shell_context *sc, arguments args)
 inline bool count_data(command_executor *e, shell_context *sc, arguments args)
 {
     static struct option long_options[] = {{"max_split_count", required_argument, 0, 's'},
-                                           {"max_batch_count", required_argument, 0, 'b'},
                                            {"timeout_ms", required_argument, 0, 't'},
                                            {"stat_size", no_argument, 0, 'z'},
                                            {"top_count", required_argument, 0, 'c'},
                                            {0, 0, 0, 0}};
 
     int max_split_count = 100000000;
-    int max_batch_count = 500;
     int timeout_ms = sc->timeout_ms;
     bool stat_size = false;
     int top_count = 0;
@@ -2101,7 +2155,7 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
     while (true) {
         int option_index = 0;
         int c;
-        c = getopt_long(args.argc, args.argv, "s:b:t:zc:", long_options, &option_index);
+        c = getopt_long(args.argc, args.argv, "s:t:zc:", long_options, &option_index);
         if (c == -1)
             break;
         switch (c) {
@@ -2111,12 +2165,6 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
                 return false;
             }
             break;
-        case 'b':
-            if (!::pegasus::utils::buf2int(optarg, strlen(optarg), max_batch_count)) {
-                fprintf(stderr, "parse %s as max_batch_count failed\n", optarg);
-                return false;
-            }
-            break;
         case 't':
             if (!::pegasus::utils::buf2int(optarg, strlen(optarg), timeout_ms)) {
                 fprintf(stderr, "parse %s as timeout_ms failed\n", optarg);
@@ -2142,11 +2190,6 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
         return false;
     }
 
-    if (max_batch_count <= 0) {
-        fprintf(stderr, "ERROR: max_batch_count should no less than 0\n");
-        return false;
-    }
-
     if (timeout_ms <= 0) {
         fprintf(stderr, "ERROR: timeout_ms should no less than 0\n");
         return false;
@@ -2155,7 +2198,6 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
     fprintf(stderr, "INFO: cluster_name = %s\n", sc->pg_client->get_cluster_name());
     fprintf(stderr, "INFO: app_name = %s\n", sc->pg_client->get_app_name());
     fprintf(stderr, "INFO: max_split_count = %d\n", max_split_count);
-    fprintf(stderr, "INFO: max_batch_count = %d\n", max_batch_count);
     fprintf(stderr, "INFO: timeout_ms = %d\n", timeout_ms);
     fprintf(stderr, "INFO: stat_size = %s\n", stat_size ? "true" : "false");
     fprintf(stderr, "INFO: top_count = %d\n", top_count);
@@ -2164,6 +2206,7 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
     pegasus::pegasus_client::scan_options options;
     options.timeout_ms = timeout_ms;
     options.no_value = !stat_size;
+    options.full_scan = true;
     int ret = sc->pg_client->get_unordered_scanners(max_split_count, options, scanners);
     if (ret != pegasus::PERR_OK) {
         fprintf(
@@ -2173,179 +2216,148 @@ inline bool count_data(command_executor *e, shell_context *sc, arguments args)
     int split_count = scanners.size();
     fprintf(stderr, "INFO: open app scanner succeed, split_count = %d\n", split_count);
 
-    std::atomic_bool error_occurred(false);
-    std::vector<scan_data_context *> contexts;
-    for (int i = 0; i < scanners.size(); i++) {
-        scan_data_context *context = new scan_data_context(SCAN_COUNT,
-                                                           i,
-                                                           max_batch_count,
-                                                           timeout_ms,
-                                                           scanners[i]->get_smart_wrapper(),
-                                                           sc->pg_client,
-                                                           &error_occurred,
-                                                           stat_size,
-                                                           top_count);
-        contexts.push_back(context);
-        dsn::tasking::enqueue(LPC_SCAN_DATA, nullptr, std::bind(scan_data_next, context));
+    // the rows are aggregated on the servers, and only the aggregates are returned
+    std::atomic_int completed_split_count(0);
+    std::vector<int> split_errors(split_count, pegasus::PERR_OK);
+    std::vector<pegasus::pegasus_client::scan_aggregate> split_aggregates(split_count);
+    std::vector<std::atomic_long> split_rows(split_count);
+    for (int i = 0; i < split_count; i++) {
+        split_rows[i].store(0);
+        scanners[i]->get_smart_wrapper()->async_aggregate(
+            top_count,
+            [&, i](int ret,
+                   pegasus::pegasus_client::scan_aggregate &&aggregate,
+                   pegasus::pegasus_client::internal_info &&info) {
+                if (ret != pegasus::PERR_OK) {
+                    fprintf(stderr,
+                            "ERROR: split[%d] aggregate failed: %s\n",
+                            i,
+                            sc->pg_client->get_error_string(ret));
+                }
+                split_errors[i] = ret;
+                split_rows[i].store(aggregate.row_count);
+                split_aggregates[i] = std::move(aggregate);
+                completed_split_count++;
+            });
     }
 
     int sleep_seconds = 0;
-    long last_total_rows = 0;
-    while (true) {
+    while (completed_split_count.load() < split_count) {
         std::this_thread::sleep_for(std::chrono::seconds(1));
         sleep_seconds++;
-        int completed_split_count = 0;
         long cur_total_rows = 0;
-        for (int i = 0; i < scanners.size(); i++) {
-            cur_total_rows += contexts[i]->split_rows.load();
-            if (contexts[i]->split_request_count.load() == 0)
-                completed_split_count++;
-        }
-        if (error_occurred.load()) {
-            fprintf(stderr,
-                    "INFO: processed for %d seconds, (%d/%d) splits, total %ld rows, last second "
-                    "%ld rows, error occurred, terminating...\n",
-                    sleep_seconds,
-                    completed_split_count,
-                    split_count,
-                    cur_total_rows,
-                    cur_total_rows - last_total_rows);
-        } else {
-            fprintf(stderr,
-                    "INFO: processed for %d seconds, (%d/%d) splits, total %ld rows, last second "
-                    "%ld rows\n",
-                    sleep_seconds,
-                    completed_split_count,
-                    split_count,
-                    cur_total_rows,
-                    cur_total_rows - last_total_rows);
+        for (int i = 0; i < split_count; i++) {
+            cur_total_rows += split_rows[i].load();
         }
-        if (completed_split_count == scanners.size())
-            break;
-        last_total_rows = cur_total_rows;
-        if (stat_size && sleep_seconds % 10 == 0) {
-            long total_rows = 0;
-            long hash_key_size_sum = 0;
-            long hash_key_size_max = 0;
-            long sort_key_size_sum = 0;
-            long sort_key_size_max = 0;
-            long value_size_sum = 0;
-            long value_size_max = 0;
-            long row_size_max = 0;
-            for (int i = 0; i < scanners.size(); i++) {
-                total_rows += contexts[i]->split_rows.load();
-                hash_key_size_sum += contexts[i]->hash_key_size_sum.load();
-                hash_key_size_max =
-                    std::max(contexts[i]->hash_key_size_max.load(), hash_key_size_max);
-                sort_key_size_sum += contexts[i]->sort_key_size_sum.load();
-                sort_key_size_max =
-                    std::max(contexts[i]->sort_key_size_max.load(), sort_key_size_max);
-                value_size_sum += contexts[i]->value_size_sum.load();
-                value_size_max = std::max(contexts[i]->value_size_max.load(), value_size_max);
-                row_size_max = std::max(contexts[i]->row_size_max.load(), row_size_max);
-            }
-            long row_size_sum = hash_key_size_sum + sort_key_size_sum + value_size_sum;
-            double hash_key_size_avg =
-                total_rows == 0 ? 0.0 : (double)hash_key_size_sum / total_rows;
-            double sort_key_size_avg =
-                total_rows == 0 ? 0.0 : (double)sort_key_size_sum / total_rows;
-            double value_size_avg = total_rows == 0 ? 0.0 : (double)value_size_sum / total_rows;
-            double row_size_avg = total_rows == 0 ? 0.0 : (double)row_size_sum / total_rows;
-            fprintf(stderr, "[row].count = %ld\n", total_rows);
-            fprintf(stderr, "[hash_key].size_sum = %ld\n", hash_key_size_sum);
-            fprintf(stderr, "[hash_key].size_max = %ld\n", hash_key_size_max);
-            fprintf(stderr, "[hash_key].size_avg = %.2f\n", hash_key_size_avg);
-            fprintf(stderr, "[sort_key].size_sum = %ld\n", sort_key_size_sum);
-            fprintf(stderr, "[sort_key].size_max = %ld\n", sort_key_size_max);
-            fprintf(stderr, "[sort_key].size_avg = %.2f\n", sort_key_size_avg);
-            fprintf(stderr, "[value].size_sum = %ld\n", value_size_sum);
-            fprintf(stderr, "[value].size_max = %ld\n", value_size_max);
-            fprintf(stderr, "[value].size_avg = %.2f\n", value_size_avg);
-            fprintf(stderr, "[row].size_sum = %ld\n", row_size_sum);
-            fprintf(stderr, "[row].size_max = %ld\n", row_size_max);
-            fprintf(stderr, "[row].size_avg = %.2f\n", row_size_avg);
-        }
-    }
-
-    if (error_occurred.load()) {
+        fprintf(stderr,
+                "INFO: processed for %d seconds, (%d/%d) splits, total %ld rows in the "
+                "completed splits\n",
+                sleep_seconds,
+                completed_split_count.load(),
+                split_count,
+                cur_total_rows);
+    }
+
+    bool error_occurred = false;
+    pegasus::pegasus_client::scan_aggregate total;
+    for (int i = 0; i < split_count; i++) {
+        if (split_errors[i] != pegasus::PERR_OK) {
+            error_occurred = true;
+            continue;
+        }
+        const pegasus::pegasus_client::scan_aggregate &a = split_aggregates[i];
+        fprintf(stderr, "INFO: split[%d]: %ld rows\n", i, (long)a.row_count);
+        total.row_count += a.row_count;
+        total.hash_key_count += a.hash_key_count;
+        total.sort_key_count_max = std::max(a.sort_key_count_max, total.sort_key_count_max);
+        total.hash_key_size_sum += a.hash_key_size_sum;
+        total.hash_key_size_max = std::max(a.hash_key_size_max, total.hash_key_size_max);
+        total.sort_key_size_sum += a.sort_key_size_sum;
+        total.sort_key_size_max = std::max(a.sort_key_size_max, total.sort_key_size_max);
+        total.value_size_sum += a.value_size_sum;
+        total.value_size_max = std::max(a.value_size_max, total.value_size_max);
+        total.row_size_max = std::max(a.row_size_max, total.row_size_max);
+        // the rows and the hash keys of different splits are disjoint
+        total.top_rows.insert(total.top_rows.end(), a.top_rows.begin(), a.top_rows.end());
+        total.top_hash_keys.insert(
+            total.top_hash_keys.end(), a.top_hash_keys.begin(), a.top_hash_keys.end());
+    }
+    if (error_occurred) {
         fprintf(stderr, "ERROR: error occurred, terminate processing\n");
     }
 
-    long total_rows = 0;
-    long hash_key_size_sum = 0;
-    long hash_key_size_max = 0;
-    long sort_key_size_sum = 0;
-    long sort_key_size_max = 0;
-    long value_size_sum = 0;
-    long value_size_max = 0;
-    long row_size_max = 0;
-    for (int i = 0; i < scanners.size(); i++) {
-        fprintf(stderr, "INFO: split[%d]: %ld rows\n", i, contexts[i]->split_rows.load());
-        total_rows += contexts[i]->split_rows.load();
-        if (stat_size) {
-            hash_key_size_sum += contexts[i]->hash_key_size_sum.load();
-            hash_key_size_max = std::max(contexts[i]->hash_key_size_max.load(), hash_key_size_max);
-            sort_key_size_sum += contexts[i]->sort_key_size_sum.load();
-            sort_key_size_max = std::max(contexts[i]->sort_key_size_max.load(), sort_key_size_max);
-            value_size_sum += contexts[i]->value_size_sum.load();
-            value_size_max = std::max(contexts[i]->value_size_max.load(), value_size_max);
-            row_size_max = std::max(contexts[i]->row_size_max.load(), row_size_max);
-        }
-    }
-
+    long total_rows = total.row_count;
     fprintf(stderr,
             "\nCount %s, total %ld rows.\n",
-            error_occurred.load() ? "terminated" : "done",
+            error_occurred ? "terminated" : "done",
             total_rows);
+    double sort_key_count_avg =
+        total.hash_key_count == 0 ? 0.0 : (double)total_rows / total.hash_key_count;
+    fprintf(stderr, "[hash_key].count = %ld\n", (long)total.hash_key_count);
+    fprintf(stderr, "[hash_key].sort_key_count_max = %ld\n", (long)total.sort_key_count_max);
+    fprintf(stderr, "[hash_key].sort_key_count_avg = %.2f\n", sort_key_count_avg);
 
     if (stat_size) {
+        long hash_key_size_sum = total.hash_key_size_sum;
+        long sort_key_size_sum = total.sort_key_size_sum;
+        long value_size_sum = total.value_size_sum;
         long row_size_sum = hash_key_size_sum + sort_key_size_sum + value_size_sum;
         double hash_key_size_avg = total_rows == 0 ? 0.0 : (double)hash_key_size_sum / total_rows;
         double sort_key_size_avg = total_rows == 0 ? 0.0 : (double)sort_key_size_sum / total_rows;
         double value_size_avg = total_rows == 0 ? 0.0 : (double)value_size_sum / total_rows;
         double row_size_avg = total_rows == 0 ? 0.0 : (double)row_size_sum / total_rows;
         fprintf(stderr, "[hash_key].size_sum = %ld\n", hash_key_size_sum);
-        fprintf(stderr, "[hash_key].size_max = %ld\n", hash_key_size_max);
+        fprintf(stderr, "[hash_key].size_max = %ld\n", (long)total.hash_key_size_max);
         fprintf(stderr, "[hash_key].size_avg = %.2f\n", hash_key_size_avg);
         fprintf(stderr, "[sort_key].size_sum = %ld\n", sort_key_size_sum);
-        fprintf(stderr, "[sort_key].size_max = %ld\n", sort_key_size_max);
+        fprintf(stderr, "[sort_key].size_max = %ld\n", (long)total.sort_key_size_max);
         fprintf(stderr, "[sort_key].size_avg = %.2f\n", sort_key_size_avg);
         fprintf(stderr, "[value].size_sum = %ld\n", value_size_sum);
-        fprintf(stderr, "[value].size_max = %ld\n", value_size_max);
+        fprintf(stderr, "[value].size_max = %ld\n", (long)total.value_size_max);
         fprintf(stderr, "[value].size_avg = %.2f\n", value_size_avg);
         fprintf(stderr, "[row].size_sum = %ld\n", row_size_sum);
-        fprintf(stderr, "[row].size_max = %ld\n", row_size_max);
+        fprintf(stderr, "[row].size_max = %ld\n", (long)total.row_size_max);
         fprintf(stderr, "[row].size_avg = %.2f\n", row_size_avg);
         if (top_count > 0) {
-            top_container::top_heap heap;
-            for (int i = 0; i < scanners.size(); i++) {
-                top_container::top_heap &h = contexts[i]->top_rows.all();
-                while (!h.empty()) {
-                    heap.push(h.top());
-                    h.pop();
-                }
-            }
-            for (int i = 1; i <= top_count && !heap.empty(); i++) {
-                const top_container::top_heap_item &item = heap.top();
+            std::sort(total.top_rows.begin(),
+                      total.top_rows.end(),
+                      [](const pegasus::pegasus_client::scan_aggregate::row_stat &a,
+                         const pegasus::pegasus_client::scan_aggregate::row_stat &b) {
+                          return a.size > b.size;
+                      });
+            for (int i = 1; i <= top_count && i <= total.top_rows.size(); i++) {
+                const auto &row = total.top_rows[i - 1];
                 fprintf(stderr,
                         "[top][%d].hash_key = \"%s\"\n",
                         i,
-                        pegasus::utils::c_escape_string(item.hash_key, sc->escape_all).c_str());
+                        pegasus::utils::c_escape_string(row.hash_key, sc->escape_all).c_str());
                 fprintf(stderr,
                         "[top][%d].sort_key = \"%s\"\n",
                         i,
-                        pegasus::utils::c_escape_string(item.sort_key, sc->escape_all).c_str());
-                fprintf(stderr, "[top][%d].row_size = %ld\n", i, item.row_size);
-                heap.pop();
+                        pegasus::utils::c_escape_string(row.sort_key, sc->escape_all).c_str());
+                fprintf(stderr, "[top][%d].row_size = %ld\n", i, (long)row.size);
+            }
+            std::sort(total.top_hash_keys.begin(),
+                      total.top_hash_keys.end(),
+                      [](const pegasus::pegasus_client::scan_aggregate::hash_key_stat &a,
+                         const pegasus::pegasus_client::scan_aggregate::hash_key_stat &b) {
+                          return a.size > b.size;
+                      });
+            for (int i = 1; i <= top_count && i <= total.top_hash_keys.size(); i++) {
+                const auto &stat = total.top_hash_keys[i - 1];
+                fprintf(stderr,
+                        "[top_hash_key][%d].hash_key = \"%s\"\n",
+                        i,
+                        pegasus::utils::c_escape_string(stat.hash_key, sc->escape_all).c_str());
+                fprintf(stderr,
+                        "[top_hash_key][%d].sort_key_count = %ld\n",
+                        i,
+                        (long)stat.sort_key_count);
+                fprintf(stderr, "[top_hash_key][%d].size = %ld\n", i, (long)stat.size);
             }
         }
     }
 
-    for (int i = 0; i < scanners.size(); i++) {
-        delete contexts[i];
-    }
-    contexts.clear();
-
     return true;
 }
 
@@ -2423,9 +2435,51 @@ inline bool local_get(command_executor *e, shell_context *sc, arguments args)
     if (!status.ok()) {
         fprintf(stderr, "ERROR: get failed: %s\n", status.ToString().c_str());
     } else {
-        uint32_t expire_ts = pegasus::pegasus_extract_expire_ts(0, value);
+        uint32_t version = db->GetValueSchemaVersion();
+        uint32_t expire_ts = pegasus::pegasus_extract_expire_ts(version, value);
         dsn::blob user_data;
-        pegasus::pegasus_extract_user_data(0, std::move(value), user_data);
+        if (pegasus::pegasus_value_is_blob_index(version, value)) {
+            // the value is separated into the blob file in the db directory
+            pegasus::pegasus_blob_index index;
+            pegasus::pegasus_extract_blob_index(version, value, index);
+            std::string blob_path =
+                db_path + "/" + pegasus::pegasus_blob_file_name(index.file_number);
+            std::unique_ptr<rocksdb::RandomAccessFile> file;
+            std::shared_ptr<char> buf(dsn::utils::make_shared_array<char>(index.size + 1));
+            rocksdb::Slice data;
+            status = rocksdb::Env::Default()->NewRandomAccessFile(
+                blob_path, &file, rocksdb::EnvOptions());
+            if (status.ok()) {
+                status = file->Read(index.offset, index.size, &data, buf.get());
+            }
+            if (!status.ok() || data.size() != index.size) {
+                fprintf(stderr,
+                        "ERROR: read blob file %s failed: %s\n",
+                        blob_path.c_str(),
+                        status.ToString().c_str());
+                delete db;
+                return true;
+            }
+            if (data.data() != buf.get()) {
+                ::memcpy(buf.get(), data.data(), data.size());
+            }
+            bool decompressed = false;
+            status = pegasus::pegasus_decompress_user_data(
+                pegasus::pegasus_extract_value_flags(version, value),
+                dsn::string_view(buf.get(), index.size),
+                user_data,
+                decompressed);
+            if (status.ok() && !decompressed) {
+                user_data.assign(std::move(buf), 0, index.size);
+            }
+        } else {
+            status = pegasus::pegasus_extract_user_data(version, std::move(value), user_data);
+        }
+        if (!status.ok()) {
+            fprintf(stderr, "ERROR: extract value failed: %s\n", status.ToString().c_str());
+            delete db;
+            return true;
+        }
         fprintf(stderr,
                 "%u : \"%s\"\n",
                 expire_ts,
@@ -2444,7 +2498,6 @@ inline bool sst_dump(command_executor *e, shell_context *sc, arguments args)
 }
 
 static const char *INDENT = "  ";
-DEFINE_TASK_CODE_RPC(RPC_RRDB_RRDB_INCR, TASK_PRIORITY_COMMON, ::dsn::THREAD_POOL_DEFAULT)
 inline bool mlog_dump(command_executor *e, shell_context *sc, arguments args)
 {
     static struct option long_options[] = {{"detailed", no_argument, 0, 'd'},
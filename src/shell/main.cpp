@@ -166,7 +166,9 @@ command_executor commands[] = {
     },
     {
         "multi_del_range",
-        "delete multiple values under sort key range for a single hash key",
+        "delete multiple values under sort key range for a single hash key, "
+        "the range is deleted on server side without listing the deleted sort keys "
+        "if neither sort key filter nor output file is specified",
         "<hash_key> <start_sort_key> <stop_sort_key> "
         "[-a|--start_inclusive true|false] [-b|--stop_inclusive true|false] "
         "[-s|--sort_key_filter_type anywhere|prefix|postfix] "
@@ -178,7 +180,10 @@ command_executor commands[] = {
         "exist", "check value exist", "<hash_key> <sort_key>", data_operations,
     },
     {
-        "count", "get sort key count for a single hash key", "<hash_key>", data_operations,
+        "count",
+        "get sort key count for a single hash key",
+        "<hash_key> [-a|--approximate]",
+        data_operations,
     },
     {
         "ttl", "query ttl for a specific key", "<hash_key> <sort_key>", data_operations,
@@ -222,8 +227,8 @@ command_executor commands[] = {
     {
         "count_data",
         "get app row count",
-        "[-s|--max_split_count num] [-b|--max_batch_count num] "
-        "[-t|--timeout_ms num] [-z|--stat_size] [-c|--top_count num]",
+        "[-s|--max_split_count num] [-t|--timeout_ms num] [-z|--stat_size] "
+        "[-c|--top_count num]",
         data_operations,
     },
     {
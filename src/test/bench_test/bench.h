@@ -0,0 +1,76 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace pegasus {
+namespace bench {
+
+struct benchmark
+{
+    std::string name;
+    std::function<void()> func;
+};
+
+std::vector<benchmark> &all_benchmarks();
+
+struct benchmark_registrar
+{
+    benchmark_registrar(const char *name, std::function<void()> func)
+    {
+        all_benchmarks().push_back({name, std::move(func)});
+    }
+};
+
+// Defines a benchmark which can be run by "pegasus_bench <name>".
+#define PEGASUS_BENCHMARK(name)                                                                    \
+    static void bench_##name();                                                                    \
+    static ::pegasus::bench::benchmark_registrar bench_registrar_##name(#name, bench_##name);      \
+    static void bench_##name()
+
+// Keeps the result of the benchmarked code from being optimized out.
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs `func` for `iterations` times and prints the average time per iteration,
+// and the throughput if `bytes_per_iteration` is given.
+inline void run(const std::string &label,
+                uint64_t iterations,
+                const std::function<void()> &func,
+                uint64_t bytes_per_iteration = 0)
+{
+    // warm up
+    for (uint64_t i = 0; i < iterations / 10 + 1; i++) {
+        func();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) {
+        func();
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start)
+                    .count() /
+                iterations;
+    if (bytes_per_iteration > 0) {
+        printf("%-48s %12.2f ns/op %10.2f MB/s\n",
+               label.c_str(),
+               ns,
+               bytes_per_iteration * 1e3 / ns);
+    } else {
+        printf("%-48s %12.2f ns/op\n", label.c_str(), ns);
+    }
+}
+
+} // namespace bench
+} // namespace pegasus
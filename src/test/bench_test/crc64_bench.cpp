@@ -0,0 +1,38 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "bench.h"
+
+#include <dsn/utility/crc.h>
+#include "base/pegasus_crc64.h"
+
+using namespace pegasus;
+
+PEGASUS_BENCHMARK(crc64)
+{
+    std::string data(4096, 'x');
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<char>(i * 131 + 7);
+    }
+
+    typedef uint64_t (*crc64_func)(const void *, size_t, uint64_t);
+    std::vector<std::pair<std::string, crc64_func>> funcs = {
+        {"dsn::utils::crc64_calc", dsn::utils::crc64_calc},
+        {"crc64_calc_slicing8", utils::crc64_calc_slicing8},
+        {"crc64_calc", utils::crc64_calc}};
+    if (utils::crc64_clmul_supported()) {
+        funcs.emplace_back("crc64_calc_clmul", utils::crc64_calc_clmul);
+    }
+
+    // hash keys are usually short
+    for (size_t len : {8, 16, 32, 64, 256, 4096}) {
+        for (const auto &f : funcs) {
+            crc64_func func = f.second;
+            bench::run(f.first + "/" + std::to_string(len),
+                       100000000 / (len + 16),
+                       [&]() { bench::do_not_optimize(func(data.data(), len, 0)); },
+                       len);
+        }
+    }
+}
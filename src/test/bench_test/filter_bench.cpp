@@ -0,0 +1,79 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "bench.h"
+
+#include <string.h>
+#include "server/pegasus_filter_matcher.h"
+
+using namespace pegasus;
+
+// the brute force search used before pegasus_filter_matcher
+static bool brute_force_search(const std::string &key, const std::string &pattern)
+{
+    const char *a1 = key.data();
+    int l1 = key.length();
+    const char *a2 = pattern.data();
+    int l2 = pattern.length();
+    for (int i = 0; i <= l1 - l2; ++i) {
+        int j = 0;
+        while (j < l2 && a1[i + j] == a2[j])
+            ++j;
+        if (j == l2)
+            return true;
+    }
+    return false;
+}
+
+PEGASUS_BENCHMARK(filter)
+{
+    // keys like "user_0000001234_profile_..." where the pattern mostly does not match,
+    // which is the common case of the full table scans with filters
+    const int key_count = 1024;
+    for (size_t key_len : {16, 32, 64, 128, 512}) {
+        std::vector<std::string> keys;
+        for (int i = 0; i < key_count; i++) {
+            std::string key = "user_" + std::to_string(1000000000 + i * 7919) + "_profile_";
+            while (key.size() < key_len) {
+                key += "field_" + std::to_string(i % 97) + "_";
+            }
+            key.resize(key_len);
+            keys.emplace_back(std::move(key));
+        }
+
+        for (std::string pattern : {"_", "pr", "_profile_x", "user_1000007919_profile"}) {
+            std::string suffix = "/" + std::to_string(key_len) + "/" + pattern;
+            uint64_t iterations = 20000000 / (key_len + 16) / key_count + 1;
+            uint64_t bytes = key_len * key_count;
+
+            bench::run("brute_force" + suffix,
+                       iterations,
+                       [&]() {
+                           for (const std::string &key : keys) {
+                               bench::do_not_optimize(brute_force_search(key, pattern));
+                           }
+                       },
+                       bytes);
+            bench::run("memmem" + suffix,
+                       iterations,
+                       [&]() {
+                           for (const std::string &key : keys) {
+                               bench::do_not_optimize(::memmem(
+                                   key.data(), key.size(), pattern.data(), pattern.size()));
+                           }
+                       },
+                       bytes);
+            server::pegasus_filter_matcher matcher(::dsn::apps::filter_type::FT_MATCH_ANYWHERE,
+                                                   pattern);
+            bench::run("pegasus_filter_matcher" + suffix,
+                       iterations,
+                       [&]() {
+                           for (const std::string &key : keys) {
+                               bench::do_not_optimize(matcher.match(key));
+                           }
+                       },
+                       bytes);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <stdlib.h>
+#include "base/pegasus_arena.h"
+#include "base/pegasus_key_schema.h"
+
+using namespace pegasus;
+
+// count the heap allocations of the whole program, to compare the allocations per key, this is
+// why key_bench is built as its own binary
+static std::atomic<uint64_t> allocation_count(0);
+
+void *operator new(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void *p = malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size == 0 ? 1 : size);
+}
+
+void *operator new[](size_t size) { return operator new(size); }
+
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept
+{
+    return operator new(size, tag);
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+void operator delete(void *p, const std::nothrow_t &) noexcept { free(p); }
+
+void operator delete[](void *p) noexcept { free(p); }
+
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+void operator delete[](void *p, const std::nothrow_t &) noexcept { free(p); }
+
+#ifdef __cpp_aligned_new
+void *operator new(size_t size, std::align_val_t align)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    void *p = nullptr;
+    if (posix_memalign(&p, std::max(static_cast<size_t>(align), sizeof(void *)), size) != 0) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new[](size_t size, std::align_val_t align) { return operator new(size, align); }
+
+void operator delete(void *p, std::align_val_t) noexcept { free(p); }
+
+void operator delete(void *p, size_t, std::align_val_t) noexcept { free(p); }
+
+void operator delete[](void *p, std::align_val_t) noexcept { free(p); }
+
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { free(p); }
+#endif
+
+// build the keys of one multi_set request as the write service does, that is, the rocksdb key
+// to put into the write batch, and the copy of it to erase from the row cache after committed
+PEGASUS_BENCHMARK(write_batch_key)
+{
+    std::string hash_key = "user_1234567890";
+    for (int kv_count : {1, 10, 100, 1000}) {
+        std::vector<std::string> sort_keys;
+        for (int i = 0; i < kv_count; i++) {
+            sort_keys.push_back("sort_key_" + std::to_string(i));
+        }
+        uint64_t iterations = 10000000 / kv_count;
+
+        // one blob for each key, which is allocated by pegasus_generate_key()
+        std::vector<std::string> dirty_keys;
+        auto blob_keys = [&]() {
+            for (const auto &sort_key : sort_keys) {
+                ::dsn::blob key;
+                pegasus_generate_key(key, hash_key, sort_key);
+                bench::do_not_optimize(key.data());
+                dirty_keys.emplace_back(key.data(), key.length());
+            }
+            dirty_keys.clear();
+        };
+
+        // the keys are allocated in the arena which is reset for each batch
+        pegasus_arena arena;
+        std::vector<dsn::string_view> arena_dirty_keys;
+        auto arena_keys = [&]() {
+            for (const auto &sort_key : sort_keys) {
+                dsn::string_view key = pegasus_generate_key(arena, hash_key, sort_key);
+                bench::do_not_optimize(key.data());
+                arena_dirty_keys.emplace_back(arena.copy(key));
+            }
+            arena_dirty_keys.clear();
+            arena.reset();
+        };
+
+        for (const auto &f : std::vector<std::pair<std::string, std::function<void()>>>{
+                 {"blob", blob_keys}, {"arena", arena_keys}}) {
+            uint64_t count_before = allocation_count.load();
+            bench::run(f.first + "/" + std::to_string(kv_count) + " kvs", iterations, f.second);
+            // bench::run() calls the function (iterations + iterations / 10 + 1) times
+            uint64_t calls = iterations + iterations / 10 + 1;
+            printf("%-48s %12.2f allocs/kv\n",
+                   (f.first + "/" + std::to_string(kv_count) + " kvs").c_str(),
+                   (double)(allocation_count.load() - count_before) / calls / kv_count);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "bench.h"
+
+#include <string.h>
+
+namespace pegasus {
+namespace bench {
+
+std::vector<benchmark> &all_benchmarks()
+{
+    static std::vector<benchmark> benchmarks;
+    return benchmarks;
+}
+
+} // namespace bench
+} // namespace pegasus
+
+using namespace pegasus::bench;
+
+// Usage: pegasus_bench [name...]
+// Runs the given benchmarks, or all of them if no name is given.
+int main(int argc, char **argv)
+{
+    int run_count = 0;
+    for (const benchmark &b : all_benchmarks()) {
+        bool selected = (argc == 1);
+        for (int i = 1; i < argc && !selected; i++) {
+            selected = (b.name == argv[i]);
+        }
+        if (selected) {
+            printf("===== %s =====\n", b.name.c_str());
+            b.func();
+            run_count++;
+        }
+    }
+
+    if (run_count == 0) {
+        printf("no benchmark matched, available benchmarks:\n");
+        for (const benchmark &b : all_benchmarks()) {
+            printf("  %s\n", b.name.c_str());
+        }
+        return 1;
+    }
+    return 0;
+}
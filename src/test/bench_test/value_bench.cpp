@@ -0,0 +1,65 @@
+// Copyright (c) 2017, Xiaomi, Inc.  All rights reserved.
+// This source code is licensed under the Apache License Version 2.0, which
+// can be found in the LICENSE file in the root directory of this source tree.
+
+#include "bench.h"
+
+#include "base/pegasus_value_schema.h"
+
+using namespace pegasus;
+
+// a json document of about `size` bytes, like the large values usually stored
+static std::string generate_json_value(size_t size)
+{
+    std::string value = "[";
+    for (int i = 0; value.size() < size; i++) {
+        value += "{\"id\":" + std::to_string(i * 7919) + ",\"name\":\"user_" +
+                 std::to_string(i % 1000) + "\",\"tags\":[\"pegasus\",\"" +
+                 std::to_string(i % 13) + "\"],\"score\":" + std::to_string(i % 100) + "},";
+    }
+    value.back() = ']';
+    return value;
+}
+
+// generate the rocksdb value as the write service does, and extract the user data from it as
+// the read path does, in v0 and in v1 with the large values compressed
+PEGASUS_BENCHMARK(value_compression)
+{
+    for (size_t size : {1024, 16 * 1024, 200 * 1024}) {
+        std::string user_data = generate_json_value(size);
+        uint64_t iterations = 2000000000 / (size * 100) + 1;
+
+        for (int version : {0, 1}) {
+            std::string label = "v" + std::to_string(version) + "/" + std::to_string(size);
+            pegasus_value_generator gen;
+            gen.set_compression_threshold(version == 0 ? 0 : 1024);
+
+            bench::run(label + " generate",
+                       iterations,
+                       [&]() {
+                           rocksdb::SliceParts sparts = gen.generate_value(version, user_data, 0);
+                           bench::do_not_optimize(sparts.parts[sparts.num_parts - 1].data());
+                       },
+                       user_data.size());
+
+            std::string raw_value;
+            rocksdb::SliceParts sparts = gen.generate_value(version, user_data, 0);
+            for (int i = 0; i < sparts.num_parts; i++) {
+                raw_value.append(sparts.parts[i].data(), sparts.parts[i].size());
+            }
+            bench::run(label + " extract",
+                       iterations,
+                       [&]() {
+                           dsn::blob value;
+                           pegasus_extract_user_data(version, dsn::string_view(raw_value), value);
+                           bench::do_not_optimize(value.data());
+                       },
+                       user_data.size());
+
+            printf("%-48s %12zu bytes %10.2f%% of user data\n",
+                   (label + " stored").c_str(),
+                   raw_value.size(),
+                   raw_value.size() * 100.0 / user_data.size());
+        }
+    }
+}
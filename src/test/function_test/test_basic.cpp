@@ -7,6 +7,8 @@
 #include <vector>
 #include <climits>
 #include <map>
+#include <memory>
+#include <set>
 
 #include <dsn/service_api_c.h>
 #include <unistd.h>
@@ -1117,6 +1119,104 @@ TEST(basic, multi_get_reverse)
     ASSERT_EQ(0, count);
 }
 
+// fetch all the pages of the pager, and return the count of them
+static int fetch_all_pages(const std::string &hash_key,
+                           const pegasus_client::multi_get_options &options,
+                           int max_fetch_count,
+                           std::map<std::string, std::string> &values)
+{
+    pegasus_client::multi_get_pager *pager = nullptr;
+    int ret = client->get_multi_get_pager(hash_key, "", "", options, pager, max_fetch_count, -1);
+    EXPECT_EQ(PERR_OK, ret);
+    if (ret != PERR_OK) {
+        return 0;
+    }
+    std::unique_ptr<pegasus_client::multi_get_pager> holder(pager);
+    int page_count = 0;
+    std::map<std::string, std::string> page;
+    while ((ret = pager->next_page(page)) == PERR_OK) {
+        page_count++;
+        EXPECT_LE((int)page.size(), max_fetch_count);
+        for (auto &kv : page) {
+            // no record is fetched twice
+            EXPECT_TRUE(values.emplace(kv.first, kv.second).second);
+        }
+    }
+    EXPECT_EQ(PERR_SCAN_COMPLETE, ret);
+    return page_count;
+}
+
+TEST(basic, multi_get_pager)
+{
+    // multi_set
+    std::map<std::string, std::string> kvs;
+    kvs[""] = "0";
+    kvs["1"] = "1";
+    kvs["1-abcdefg"] = "1-abcdefg";
+    kvs["2"] = "2";
+    kvs["2-abcdefg"] = "2-abcdefg";
+    kvs["3"] = "3";
+    kvs["3-efghijk"] = "3-efghijk";
+    kvs["4"] = "4";
+    kvs["4-hijklmn"] = "4-hijklmn";
+    kvs["5"] = "5";
+    kvs["5-hijklmn"] = "5-hijklmn";
+    kvs["6"] = "6";
+    kvs["7"] = "7";
+    int ret = client->multi_set("basic_test_multi_get_pager", kvs);
+    ASSERT_EQ(PERR_OK, ret);
+
+    // invalid hash key
+    pegasus_client::multi_get_options options;
+    pegasus_client::multi_get_pager *pager = nullptr;
+    ret = client->get_multi_get_pager("", "", "", options, pager);
+    ASSERT_EQ(PERR_INVALID_HASH_KEY, ret);
+
+    // forward and reverse, in pages of all sizes
+    for (bool reverse : {false, true}) {
+        for (int max_fetch_count : {1, 2, 5, 13, 100}) {
+            options = pegasus_client::multi_get_options();
+            options.reverse = reverse;
+            std::map<std::string, std::string> new_values;
+            int page_count =
+                fetch_all_pages("basic_test_multi_get_pager", options, max_fetch_count, new_values);
+            ASSERT_EQ(kvs, new_values);
+            ASSERT_LE(page_count, 13 / max_fetch_count + 1);
+        }
+    }
+
+    // the records filtered out are not returned in any page
+    for (bool reverse : {false, true}) {
+        options = pegasus_client::multi_get_options();
+        options.reverse = reverse;
+        options.sort_key_filter_type = pegasus_client::FT_MATCH_POSTFIX;
+        options.sort_key_filter_pattern = "abcdefg";
+        std::map<std::string, std::string> new_values;
+        fetch_all_pages("basic_test_multi_get_pager", options, 1, new_values);
+        ASSERT_EQ(2, (int)new_values.size());
+        ASSERT_EQ("1-abcdefg", new_values["1-abcdefg"]);
+        ASSERT_EQ("2-abcdefg", new_values["2-abcdefg"]);
+    }
+
+    // no value
+    options = pegasus_client::multi_get_options();
+    options.no_value = true;
+    std::map<std::string, std::string> new_values;
+    fetch_all_pages("basic_test_multi_get_pager", options, 3, new_values);
+    ASSERT_EQ(13, (int)new_values.size());
+    ASSERT_EQ("", new_values["7"]);
+
+    // multi_del
+    std::set<std::string> sortkeys;
+    for (auto &kv : kvs) {
+        sortkeys.insert(kv.first);
+    }
+    int64_t deleted_count;
+    ret = client->multi_del("basic_test_multi_get_pager", sortkeys, deleted_count);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(13, deleted_count);
+}
+
 TEST(basic, multi_set_get_del)
 {
     // multi_set
@@ -1615,4 +1715,293 @@ TEST(basic, multi_set_get_del_async)
     ASSERT_EQ(0, count);
 }
 
+TEST(basic, batch_get)
+{
+    // set
+    std::vector<std::pair<std::string, std::string>> keys;
+    for (int i = 0; i < 10; i++) {
+        std::string hash_key = "basic_test_batch_get_hash_key_" + std::to_string(i);
+        std::string sort_key = "basic_test_batch_get_sort_key_" + std::to_string(i);
+        std::string value = "basic_test_batch_get_value_" + std::to_string(i);
+        int ret = client->set(hash_key, sort_key, value);
+        ASSERT_EQ(PERR_OK, ret);
+        keys.emplace_back(hash_key, sort_key);
+    }
+    keys.emplace_back("basic_test_batch_get_hash_key_0", "basic_test_batch_get_not_exist");
+
+    // batch_get
+    std::map<std::pair<std::string, std::string>, std::string> values;
+    int ret = client->batch_get(keys, values);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(10, values.size());
+    for (int i = 0; i < 10; i++) {
+        auto it = values.find(keys[i]);
+        ASSERT_NE(values.end(), it);
+        ASSERT_EQ("basic_test_batch_get_value_" + std::to_string(i), it->second);
+    }
+
+    // batch_get with empty keys
+    ret = client->batch_get(std::vector<std::pair<std::string, std::string>>(), values);
+    ASSERT_EQ(PERR_INVALID_VALUE, ret);
+
+    // async_batch_get
+    std::atomic_bool callbacked(false);
+    client->async_batch_get(
+        keys, [&](int err, std::map<std::pair<std::string, std::string>, std::string> &&values) {
+            ASSERT_EQ(PERR_OK, err);
+            ASSERT_EQ(10, values.size());
+            callbacked.store(true, std::memory_order_seq_cst);
+        });
+    while (!callbacked.load(std::memory_order_seq_cst))
+        usleep(100);
+
+    // del
+    for (int i = 0; i < 10; i++) {
+        ret = client->del(keys[i].first, keys[i].second);
+        ASSERT_EQ(PERR_OK, ret);
+    }
+
+    // batch_get
+    ret = client->batch_get(keys, values);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_TRUE(values.empty());
+}
+
+TEST(basic, del_range)
+{
+    std::string hash_key = "basic_test_del_range_hash_key";
+    std::map<std::string, std::string> kvs;
+    for (int i = 0; i < 10; i++) {
+        kvs["basic_test_del_range_sort_key_" + std::to_string(i)] = "value";
+    }
+    int ret = client->multi_set(hash_key, kvs);
+    ASSERT_EQ(PERR_OK, ret);
+
+    // delete [sort_key_3, sort_key_6)
+    ret = client->del_range(
+        hash_key, "basic_test_del_range_sort_key_3", "basic_test_del_range_sort_key_6");
+    ASSERT_EQ(PERR_OK, ret);
+    int64_t count = 0;
+    ret = client->sortkey_count(hash_key, count);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(7, count);
+
+    // delete all
+    ret = client->del_range(hash_key, "", "");
+    ASSERT_EQ(PERR_OK, ret);
+    ret = client->sortkey_count(hash_key, count);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(0, count);
+}
+
+TEST(basic, incr)
+{
+    std::string hash_key = "basic_test_incr_hash_key";
+    std::string sort_key = "basic_test_incr_sort_key";
+    client->del(hash_key, sort_key);
+
+    // incr on not existing key starts from 0
+    int64_t new_value = 0;
+    int ret = client->incr(hash_key, sort_key, 100, new_value);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(100, new_value);
+
+    ret = client->incr(hash_key, sort_key, -1, new_value);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(99, new_value);
+
+    std::string value;
+    ret = client->get(hash_key, sort_key, value);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ("99", value);
+
+    // ttl is kept
+    ret = client->set(hash_key, sort_key, "10", 5000, 1000);
+    ASSERT_EQ(PERR_OK, ret);
+    ret = client->incr(hash_key, sort_key, 0, new_value);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ(10, new_value);
+    int ttl_seconds = 0;
+    ret = client->ttl(hash_key, sort_key, ttl_seconds);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_LT(0, ttl_seconds);
+
+    // not an integer
+    ret = client->set(hash_key, sort_key, "abc");
+    ASSERT_EQ(PERR_OK, ret);
+    ret = client->incr(hash_key, sort_key, 1, new_value);
+    ASSERT_EQ(PERR_INVALID_ARGUMENT, ret);
+
+    // overflow
+    ret = client->set(hash_key, sort_key, std::to_string(INT64_MAX));
+    ASSERT_EQ(PERR_OK, ret);
+    ret = client->incr(hash_key, sort_key, 1, new_value);
+    ASSERT_EQ(PERR_INVALID_ARGUMENT, ret);
+
+    // async_incr
+    ret = client->del(hash_key, sort_key);
+    ASSERT_EQ(PERR_OK, ret);
+    std::atomic_bool callbacked(false);
+    client->async_incr(hash_key, sort_key, 7, [&](int err, int64_t value, internal_info &&info) {
+        ASSERT_EQ(PERR_OK, err);
+        ASSERT_EQ(7, value);
+        ASSERT_GT(info.decree, 0);
+        callbacked.store(true, std::memory_order_seq_cst);
+    });
+    while (!callbacked.load(std::memory_order_seq_cst))
+        usleep(100);
+
+    ret = client->del(hash_key, sort_key);
+    ASSERT_EQ(PERR_OK, ret);
+}
+
+TEST(basic, check_and_set)
+{
+    std::string hash_key = "basic_test_check_and_set_hash_key";
+    std::string check_sort_key = "basic_test_check_and_set_check_sort_key";
+    std::string set_sort_key = "basic_test_check_and_set_set_sort_key";
+    client->del(hash_key, check_sort_key);
+    client->del(hash_key, set_sort_key);
+
+    pegasus_client::check_and_set_options options;
+    pegasus_client::check_and_set_results results;
+    options.return_check_value = true;
+
+    // set if not exist
+    int ret = client->check_and_set(hash_key,
+                                    check_sort_key,
+                                    pegasus_client::CT_VALUE_NOT_EXIST,
+                                    "",
+                                    check_sort_key,
+                                    "1",
+                                    options,
+                                    results);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_TRUE(results.set_succeed);
+    ASSERT_TRUE(results.check_value_returned);
+    ASSERT_FALSE(results.check_value_exist);
+
+    // check not passed
+    ret = client->check_and_set(hash_key,
+                                check_sort_key,
+                                pegasus_client::CT_VALUE_NOT_EXIST,
+                                "",
+                                check_sort_key,
+                                "2",
+                                options,
+                                results);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_FALSE(results.set_succeed);
+    ASSERT_TRUE(results.check_value_exist);
+    ASSERT_EQ("1", results.check_value);
+
+    // int compare, set a different sort key
+    ret = client->check_and_set(hash_key,
+                                check_sort_key,
+                                pegasus_client::CT_VALUE_INT_EQUAL,
+                                "1",
+                                set_sort_key,
+                                "3",
+                                options,
+                                results);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_TRUE(results.set_succeed);
+    std::string value;
+    ret = client->get(hash_key, set_sort_key, value);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_EQ("3", value);
+
+    // int compare with invalid operand
+    ret = client->check_and_set(hash_key,
+                                check_sort_key,
+                                pegasus_client::CT_VALUE_INT_EQUAL,
+                                "abc",
+                                set_sort_key,
+                                "4",
+                                options,
+                                results);
+    ASSERT_EQ(PERR_INVALID_ARGUMENT, ret);
+
+    ASSERT_EQ(PERR_OK, client->del(hash_key, check_sort_key));
+    ASSERT_EQ(PERR_OK, client->del(hash_key, set_sort_key));
+}
+
+TEST(basic, check_and_mutate)
+{
+    std::string hash_key = "basic_test_check_and_mutate_hash_key";
+    std::string check_sort_key = "basic_test_check_and_mutate_check_sort_key";
+    client->del(hash_key, check_sort_key);
+
+    pegasus_client::mutations mutations;
+    pegasus_client::check_and_mutate_options options;
+    pegasus_client::check_and_mutate_results results;
+
+    // empty mutations
+    int ret = client->check_and_mutate(hash_key,
+                                       check_sort_key,
+                                       pegasus_client::CT_VALUE_NOT_EXIST,
+                                       "",
+                                       mutations,
+                                       options,
+                                       results);
+    ASSERT_EQ(PERR_INVALID_ARGUMENT, ret);
+
+    mutations.set(check_sort_key, "v1");
+    mutations.set("sort_key_1", "v1");
+    mutations.set("sort_key_2", "v2");
+    mutations.del("sort_key_2");
+    ret = client->check_and_mutate(hash_key,
+                                   check_sort_key,
+                                   pegasus_client::CT_VALUE_NOT_EXIST,
+                                   "",
+                                   mutations,
+                                   options,
+                                   results);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_TRUE(results.mutate_succeed);
+
+    std::string value;
+    ASSERT_EQ(PERR_OK, client->get(hash_key, "sort_key_1", value));
+    ASSERT_EQ("v1", value);
+    ASSERT_EQ(PERR_NOT_FOUND, client->get(hash_key, "sort_key_2", value));
+
+    // check not passed, nothing mutated
+    pegasus_client::mutations mutations2;
+    mutations2.del("sort_key_1");
+    ret = client->check_and_mutate(hash_key,
+                                   check_sort_key,
+                                   pegasus_client::CT_VALUE_BYTES_EQUAL,
+                                   "v2",
+                                   mutations2,
+                                   options,
+                                   results);
+    ASSERT_EQ(PERR_OK, ret);
+    ASSERT_FALSE(results.mutate_succeed);
+    ASSERT_EQ(PERR_OK, client->get(hash_key, "sort_key_1", value));
+
+    ASSERT_EQ(PERR_OK, client->del(hash_key, check_sort_key));
+    ASSERT_EQ(PERR_OK, client->del(hash_key, "sort_key_1"));
+}
+
+TEST(basic, approximate_sortkey_count)
+{
+    const std::string hash_key = "basic_test_approximate_sortkey_count";
+    std::map<std::string, std::string> kvs;
+    for (int i = 0; i < 10; i++) {
+        kvs["sort_key_" + std::to_string(i)] = "value_" + std::to_string(i);
+    }
+    ASSERT_EQ(PERR_OK, client->multi_set(hash_key, kvs));
+
+    // small hash keys are counted exactly
+    int64_t count = 0;
+    ASSERT_EQ(PERR_OK, client->approximate_sortkey_count(hash_key, count));
+    ASSERT_EQ(10, count);
+
+    ASSERT_EQ(PERR_OK, client->del_range(hash_key, "", ""));
+    ASSERT_EQ(PERR_OK, client->approximate_sortkey_count(hash_key, count));
+    ASSERT_EQ(0, count);
+
+    ASSERT_EQ(PERR_INVALID_HASH_KEY, client->approximate_sortkey_count("", count));
+}
+
 void test_basic_global_init() {}
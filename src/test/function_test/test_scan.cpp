@@ -2,6 +2,7 @@
 // This source code is licensed under the Apache License Version 2.0, which
 // can be found in the LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
 #include <cstdlib>
 #include <string>
 #include <vector>
@@ -392,4 +393,237 @@ TEST(scan, OVERALL)
     compare(data, base);
 }
 
+TEST(scan, HASH_KEY_PREFIX_FILTER)
+{
+    ddebug("TEST HASH_KEY_PREFIX_FILTER...");
+    // hash keys of different lengths start with the prefix
+    std::string prefix = expected_hash_key.substr(0, 1);
+    pegasus_client::scan_options options;
+    options.hash_key_filter_type = pegasus_client::FT_MATCH_PREFIX;
+    options.hash_key_filter_pattern = prefix;
+    std::map<std::string, std::map<std::string, std::string>> data;
+    std::vector<pegasus_client::pegasus_scanner *> scanners;
+    int ret = client->get_unordered_scanners(3, options, scanners);
+    ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                      << client->get_error_string(ret);
+
+    std::string hash_key;
+    std::string sort_key;
+    std::string value;
+    for (auto scanner : scanners) {
+        ASSERT_NE(nullptr, scanner);
+        while (!(ret = (scanner->next(hash_key, sort_key, value))))
+            check_and_put(data, hash_key, sort_key, value);
+        ASSERT_EQ(PERR_SCAN_COMPLETE, ret) << "Error occurred when scan. error="
+                                           << client->get_error_string(ret);
+        delete scanner;
+    }
+
+    std::map<std::string, std::map<std::string, std::string>> expected;
+    for (const auto &kv : base) {
+        if (kv.first.compare(0, prefix.length(), prefix) == 0) {
+            expected.insert(kv);
+        }
+    }
+    compare(data, expected);
+}
+
+TEST(scan, SORT_KEY_PREFIX_FILTER)
+{
+    ddebug("TEST SORT_KEY_PREFIX_FILTER...");
+    std::string prefix = base[expected_hash_key].begin()->first.substr(0, 1);
+    pegasus_client::scan_options options;
+    options.sort_key_filter_type = pegasus_client::FT_MATCH_PREFIX;
+    options.sort_key_filter_pattern = prefix;
+    std::map<std::string, std::map<std::string, std::string>> data;
+    std::vector<pegasus_client::pegasus_scanner *> scanners;
+    int ret = client->get_unordered_scanners(3, options, scanners);
+    ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                      << client->get_error_string(ret);
+
+    std::string hash_key;
+    std::string sort_key;
+    std::string value;
+    for (auto scanner : scanners) {
+        ASSERT_NE(nullptr, scanner);
+        while (!(ret = (scanner->next(hash_key, sort_key, value))))
+            check_and_put(data, hash_key, sort_key, value);
+        ASSERT_EQ(PERR_SCAN_COMPLETE, ret) << "Error occurred when scan. error="
+                                           << client->get_error_string(ret);
+        delete scanner;
+    }
+
+    std::map<std::string, std::map<std::string, std::string>> expected;
+    for (const auto &kv : base) {
+        for (const auto &sort_kv : kv.second) {
+            if (sort_kv.first.compare(0, prefix.length(), prefix) == 0) {
+                expected[kv.first].insert(sort_kv);
+            }
+        }
+    }
+    compare(data, expected);
+}
+
+TEST(scan, RPC_LIMITS)
+{
+    ddebug("TEST RPC_LIMITS...");
+    // the scan returns early in every rpc, and continues until all data is returned
+    pegasus_client::scan_options options;
+    options.max_iteration_count = 10;
+    options.max_response_bytes = 1000;
+    options.sort_key_filter_type = pegasus_client::FT_MATCH_ANYWHERE;
+    options.sort_key_filter_pattern = "a";
+    std::map<std::string, std::map<std::string, std::string>> data;
+    std::vector<pegasus_client::pegasus_scanner *> scanners;
+    int ret = client->get_unordered_scanners(3, options, scanners);
+    ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                      << client->get_error_string(ret);
+
+    std::string hash_key;
+    std::string sort_key;
+    std::string value;
+    for (auto scanner : scanners) {
+        ASSERT_NE(nullptr, scanner);
+        while (!(ret = (scanner->next(hash_key, sort_key, value))))
+            check_and_put(data, hash_key, sort_key, value);
+        ASSERT_EQ(PERR_SCAN_COMPLETE, ret) << "Error occurred when scan. error="
+                                           << client->get_error_string(ret);
+        delete scanner;
+    }
+
+    std::map<std::string, std::map<std::string, std::string>> expected;
+    for (const auto &kv : base) {
+        for (const auto &sort_kv : kv.second) {
+            if (sort_kv.first.find("a") != std::string::npos) {
+                expected[kv.first].insert(sort_kv);
+            }
+        }
+    }
+    compare(data, expected);
+}
+
+TEST(scan, FULL_SCAN)
+{
+    ddebug("TEST FULL_SCAN...");
+    // the full scan returns the same data as the normal one, only in shorter time slices
+    pegasus_client::scan_options options;
+    options.full_scan = true;
+    std::map<std::string, std::map<std::string, std::string>> data;
+    std::vector<pegasus_client::pegasus_scanner *> scanners;
+    int ret = client->get_unordered_scanners(3, options, scanners);
+    ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                      << client->get_error_string(ret);
+
+    std::string hash_key;
+    std::string sort_key;
+    std::string value;
+    for (auto scanner : scanners) {
+        ASSERT_NE(nullptr, scanner);
+        while (!(ret = (scanner->next(hash_key, sort_key, value))))
+            check_and_put(data, hash_key, sort_key, value);
+        ASSERT_EQ(PERR_SCAN_COMPLETE, ret) << "Error occurred when scan. error="
+                                           << client->get_error_string(ret);
+        delete scanner;
+    }
+    compare(data, base);
+}
+
+TEST(scan, PREFETCH)
+{
+    ddebug("TEST PREFETCH...");
+    // the batches are fetched ahead in small batches, and the scanners can be deleted with the
+    // prefetch rpcs in flight
+    for (int prefetch_batch_count : {1, 3}) {
+        pegasus_client::scan_options options;
+        options.batch_size = 10;
+        options.prefetch_batch_count = prefetch_batch_count;
+        options.prefetch_max_bytes = 1000;
+        std::map<std::string, std::map<std::string, std::string>> data;
+        std::vector<pegasus_client::pegasus_scanner *> scanners;
+        int ret = client->get_unordered_scanners(3, options, scanners);
+        ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                          << client->get_error_string(ret);
+
+        std::string hash_key;
+        std::string sort_key;
+        std::string value;
+        for (auto scanner : scanners) {
+            ASSERT_NE(nullptr, scanner);
+            while (!(ret = (scanner->next(hash_key, sort_key, value))))
+                check_and_put(data, hash_key, sort_key, value);
+            ASSERT_EQ(PERR_SCAN_COMPLETE, ret) << "Error occurred when scan. error="
+                                               << client->get_error_string(ret);
+            delete scanner;
+        }
+        compare(data, base);
+
+        ret = client->get_unordered_scanners(3, options, scanners);
+        ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                          << client->get_error_string(ret);
+        for (auto scanner : scanners) {
+            ASSERT_NE(nullptr, scanner);
+            for (int i = 0; i < 15; i++) {
+                ret = scanner->next(hash_key, sort_key, value);
+                ASSERT_EQ(PERR_OK, ret) << "Error occurred when scan. error="
+                                        << client->get_error_string(ret);
+            }
+            ASSERT_TRUE(scanner->safe_destructible());
+            delete scanner;
+        }
+    }
+}
+
+TEST(scan, AGGREGATE)
+{
+    ddebug("TEST AGGREGATE...");
+    // the rows are aggregated on the server side, in several rpcs for each partition
+    pegasus_client::scan_options options;
+    options.max_iteration_count = 100;
+    std::vector<pegasus_client::pegasus_scanner *> scanners;
+    int ret = client->get_unordered_scanners(3, options, scanners);
+    ASSERT_EQ(0, ret) << "Error occurred when getting scanner. error="
+                      << client->get_error_string(ret);
+
+    int64_t row_count = 0;
+    int64_t hash_key_count = 0;
+    int64_t sort_key_count_max = 0;
+    int64_t row_size_max = 0;
+    for (auto scanner : scanners) {
+        ASSERT_NE(nullptr, scanner);
+        pegasus_client::scan_aggregate aggregate;
+        ret = scanner->aggregate(3, aggregate);
+        ASSERT_EQ(PERR_OK, ret) << "Error occurred when aggregate. error="
+                                << client->get_error_string(ret);
+        row_count += aggregate.row_count;
+        hash_key_count += aggregate.hash_key_count;
+        sort_key_count_max = std::max(sort_key_count_max, aggregate.sort_key_count_max);
+        row_size_max = std::max(row_size_max, aggregate.row_size_max);
+        ASSERT_LE(aggregate.top_rows.size(), 3u);
+        for (const auto &row : aggregate.top_rows) {
+            ASSERT_EQ((int64_t)(row.hash_key.size() + row.sort_key.size() +
+                                base[row.hash_key][row.sort_key].size()),
+                      row.size);
+        }
+        delete scanner;
+    }
+
+    int64_t expected_row_count = 0;
+    int64_t expected_sort_key_count_max = 0;
+    int64_t expected_row_size_max = 0;
+    for (const auto &kv : base) {
+        expected_row_count += kv.second.size();
+        expected_sort_key_count_max =
+            std::max<int64_t>(expected_sort_key_count_max, kv.second.size());
+        for (const auto &sort_kv : kv.second) {
+            expected_row_size_max = std::max<int64_t>(
+                expected_row_size_max,
+                kv.first.size() + sort_kv.first.size() + sort_kv.second.size());
+        }
+    }
+    ASSERT_EQ(expected_row_count, row_count);
+    ASSERT_EQ((int64_t)base.size(), hash_key_count);
+    ASSERT_EQ(expected_sort_key_count_max, sort_key_count_max);
+    ASSERT_EQ(expected_row_size_max, row_size_max);
+}
+
 void test_scan_global_init() { testing::AddGlobalTestEnvironment(new InitData()); }